@@ -58,6 +58,15 @@ else ()
 option (ENABLE_MPI "Enable the compilation of the MPI communication code" off)
 endif ()
 
+#################################
+## Multithreaded CPU execution with OpenMP
+find_package(OpenMP QUIET)
+if (OPENMP_FOUND)
+option(ENABLE_OPENMP "Enable multithreaded execution of the CPU code paths with OpenMP" on)
+else (OPENMP_FOUND)
+option(ENABLE_OPENMP "Enable multithreaded execution of the CPU code paths with OpenMP" off)
+endif (OPENMP_FOUND)
+
 #################################
 ## Optionally enable documentation build
 OPTION(ENABLE_DOXYGEN "Enables building of documentation with doxygen" OFF)
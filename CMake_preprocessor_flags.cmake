@@ -39,5 +39,9 @@ if (ENABLE_MPI)
     endif(ENABLE_MPI_CUDA)
 endif(ENABLE_MPI)
 
+if (ENABLE_OPENMP)
+    add_definitions (-DENABLE_OPENMP)
+endif(ENABLE_OPENMP)
+
 # define this as a main hoomd build (as opposed to a plugin build)
 add_definitions(-DBUILDING_HOOMD)
@@ -0,0 +1,198 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file AsyncWriter.cc
+    \brief Defines the AsyncWriter class
+*/
+
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+
+#include "AsyncWriter.h"
+
+using namespace std;
+
+boost::weak_ptr<AsyncWriter> AsyncWriter::s_shared;
+boost::mutex AsyncWriter::s_shared_mutex;
+
+/*! \param exec_conf Execution configuration, used to display error messages
+    \param max_queued Maximum number of jobs waiting to be written before enqueue() blocks
+*/
+AsyncWriter::AsyncWriter(boost::shared_ptr<const ExecutionConfiguration> exec_conf, unsigned int max_queued)
+    : m_exec_conf(exec_conf), m_queue(max_queued), m_num_pending(0)
+    {
+    if (max_queued == 0)
+        {
+        m_exec_conf->msg->error() << "AsyncWriter: the queue must hold at least one job" << endl;
+        throw runtime_error("Error initializing AsyncWriter");
+        }
+
+    m_exec_conf->msg->notice(5) << "Constructing AsyncWriter" << endl;
+    m_thread = boost::thread(boost::bind(&AsyncWriter::run, this));
+    }
+
+/*! All jobs that are still queued are written before the thread terminates. Errors that occur at this point can
+    no longer be rethrown and are only displayed.
+*/
+AsyncWriter::~AsyncWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying AsyncWriter" << endl;
+
+    // a NULL job tells the thread to quit after it has finished the jobs in front of it
+    m_queue.push(boost::shared_ptr<AsyncWriteJob>());
+    m_thread.join();
+
+    if (!m_error.empty())
+        m_exec_conf->msg->error() << m_error << endl;
+    }
+
+/*! \param job Job to write
+
+    Blocks while the queue is full.
+*/
+void AsyncWriter::enqueue(boost::shared_ptr<AsyncWriteJob> job)
+    {
+    checkError();
+
+        {
+        boost::mutex::scoped_lock lock(m_mutex);
+        m_num_pending++;
+        }
+
+    m_queue.push(job);
+    }
+
+void AsyncWriter::flush()
+    {
+        {
+        boost::mutex::scoped_lock lock(m_mutex);
+        while (m_num_pending > 0)
+            m_done.wait(lock);
+        }
+
+    checkError();
+    }
+
+/*! \param exec_conf Execution configuration for the writer, in case it needs to be created
+    \returns The writer shared by all analyzers
+
+    The shared writer is created on first use and lives as long as an analyzer holds a reference to it.
+*/
+boost::shared_ptr<AsyncWriter> AsyncWriter::getShared(boost::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    boost::mutex::scoped_lock lock(s_shared_mutex);
+    boost::shared_ptr<AsyncWriter> writer = s_shared.lock();
+    if (!writer)
+        {
+        writer = boost::shared_ptr<AsyncWriter>(new AsyncWriter(exec_conf));
+        s_shared = writer;
+        }
+    return writer;
+    }
+
+void AsyncWriter::flushShared()
+    {
+    boost::shared_ptr<AsyncWriter> writer;
+        {
+        boost::mutex::scoped_lock lock(s_shared_mutex);
+        writer = s_shared.lock();
+        }
+
+    if (writer)
+        writer->flush();
+    }
+
+void AsyncWriter::run()
+    {
+    while (true)
+        {
+        boost::shared_ptr<AsyncWriteJob> job = m_queue.wait_and_pop();
+        if (!job)
+            break;
+
+        string error;
+        try
+            {
+            job->write();
+            }
+        catch (std::exception const & ex)
+            {
+            error = ex.what();
+            }
+
+        // release the staged data before signaling completion
+        job.reset();
+
+        boost::mutex::scoped_lock lock(m_mutex);
+        if (!error.empty() && m_error.empty())
+            m_error = error;
+        m_num_pending--;
+        m_done.notify_all();
+        }
+    }
+
+/*! Only the first error is reported, the writer is ready for new jobs afterwards.
+*/
+void AsyncWriter::checkError()
+    {
+    string error;
+        {
+        boost::mutex::scoped_lock lock(m_mutex);
+        error.swap(m_error);
+        }
+
+    if (!error.empty())
+        {
+        m_exec_conf->msg->error() << error << endl;
+        throw runtime_error("Error writing output file");
+        }
+    }
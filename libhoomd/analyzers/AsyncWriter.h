@@ -0,0 +1,150 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file AsyncWriter.h
+    \brief Declares the AsyncWriter class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/utility.hpp>
+#include <boost/thread.hpp>
+
+#include "ExecutionConfiguration.h"
+#include "WorkQueue.h"
+
+#ifndef __ASYNC_WRITER_H__
+#define __ASYNC_WRITER_H__
+
+//! A unit of output work executed on the AsyncWriter thread
+/*! Analyzers that write asynchronously copy everything they need to write a frame into a derived job class
+    on the calling thread. write() is then called later on the writer thread and must not touch ParticleData,
+    SystemDefinition or the Messenger: it may only use the data staged in the job. Errors are reported by
+    throwing a std::exception, the message of which is displayed on the main thread.
+
+    \ingroup analyzers
+*/
+class AsyncWriteJob : boost::noncopyable
+    {
+    public:
+        //! Destructor
+        virtual ~AsyncWriteJob() {};
+
+        //! Format and write the staged data
+        virtual void write() = 0;
+    };
+
+//! Background thread that performs file output for analyzers
+/*! File formatting, compression and the write itself can take seconds for large systems. AsyncWriter moves this
+    work off of the critical path of System::run(): an analyzer stages the data for a frame in an AsyncWriteJob and
+    hands it to enqueue(), which returns immediately. A single worker thread executes the jobs in the order in
+    which they were enqueued.
+
+    The number of jobs waiting to be written is bounded by \a max_queued. When the queue is full, enqueue() blocks
+    until the writer has caught up, so the memory held by staged frames stays bounded even if the disk cannot keep
+    up with the output rate. With the default of one queued job, at most two frames are in flight: one being written
+    and one waiting (double buffering).
+
+    All analyzers share one writer through getShared(), so output to different files is serialized on one thread.
+    System::run() calls flushShared() at the end of a run, so that all files are complete when run() returns.
+
+    If a job throws, the error is remembered and rethrown as a std::runtime_error on the next call to enqueue() or
+    flush() on the main thread.
+
+    \ingroup analyzers
+*/
+class AsyncWriter : boost::noncopyable
+    {
+    public:
+        //! Start the writer thread
+        AsyncWriter(boost::shared_ptr<const ExecutionConfiguration> exec_conf, unsigned int max_queued=1);
+
+        //! Write all pending jobs and stop the writer thread
+        ~AsyncWriter();
+
+        //! Hand a job to the writer thread
+        void enqueue(boost::shared_ptr<AsyncWriteJob> job);
+
+        //! Wait until all enqueued jobs have been written
+        void flush();
+
+        //! Get the writer shared by all analyzers
+        static boost::shared_ptr<AsyncWriter> getShared(boost::shared_ptr<const ExecutionConfiguration> exec_conf);
+
+        //! Flush the shared writer, if it exists
+        static void flushShared();
+
+    private:
+        boost::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration for messages
+        WorkQueue< boost::shared_ptr<AsyncWriteJob> > m_queue;       //!< Jobs waiting to be written
+        boost::thread m_thread;                 //!< The writer thread
+        boost::mutex m_mutex;                   //!< Protects m_num_pending and m_error
+        boost::condition_variable m_done;       //!< Signaled when a job finishes
+        unsigned int m_num_pending;             //!< Number of jobs enqueued but not yet finished
+        std::string m_error;                    //!< Error message of a failed job (empty if none)
+
+        //! Main loop of the writer thread
+        void run();
+
+        //! Rethrow the error of a failed job on the calling thread
+        void checkError();
+
+        static boost::weak_ptr<AsyncWriter> s_shared; //!< The writer returned by getShared()
+        static boost::mutex s_shared_mutex;           //!< Protects s_shared
+    };
+
+#endif
@@ -65,8 +65,12 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
+#include "HOOMDMPI.h"
 #endif
 
+#include <algorithm>
+#include <sstream>
+
 #include <boost/python.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
@@ -78,12 +82,16 @@ using namespace std;
 #define NFILE_POS 8L
 // File position of NSTEP in DCD header
 #define NSTEP_POS 20L
+// Size of the DCD file header
+#define FILE_HEADER_SIZE 276L
+// Size of the header of every frame
+#define FRAME_HEADER_SIZE 56L
 
 //! simple helper function to write an integer
 /*! \param file file to write to
     \param val integer to write
 */
-static void write_int(fstream &file, unsigned int val)
+static void write_int(ostream &file, unsigned int val)
     {
     file.write((char *)&val, sizeof(unsigned int));
     }
@@ -119,8 +127,8 @@ DCDDumpWriter::DCDDumpWriter(boost::shared_ptr<SystemDefinition> sysdef,
                              bool overwrite)
     : Analyzer(sysdef), m_fname(fname), m_start_timestep(0), m_period(period), m_group(group),
     m_rigid_data(sysdef->getRigidData()), m_num_frames_written(0), m_last_written_step(0), m_appending(false),
-      m_unwrap_full(false), m_unwrap_rigid(false), m_angle(false),
-      m_overwrite(overwrite), m_is_initialized(false)
+      m_unwrap_full(false), m_unwrap_rigid(false), m_angle(false), m_mpiio(true),
+      m_overwrite(overwrite), m_is_initialized(false), m_staging_buffer(NULL)
     {
     m_exec_conf->msg->notice(5) << "Constructing DCDDumpWriter: " << fname << " " << period << " " << overwrite << endl;
     }
@@ -158,7 +166,9 @@ void DCDDumpWriter::initFileIO()
         m_appending = true;
         }
 
-    m_staging_buffer = new float[m_pdata->getNGlobal()];
+    // the staging buffer holds the coordinates of all particles, it is only needed if they are written by one rank
+    if (! useMPIIO())
+        m_staging_buffer = new float[m_pdata->getNGlobal()];
     m_is_initialized = true;
 
     m_nglobal = m_pdata->getNGlobal();
@@ -172,6 +182,15 @@ DCDDumpWriter::~DCDDumpWriter()
         delete[] m_staging_buffer;
     }
 
+bool DCDDumpWriter::useMPIIO() const
+    {
+#ifdef ENABLE_MPI
+    return m_comm && m_mpiio;
+#else
+    return false;
+#endif
+    }
+
 /*! \param timestep Current time step of the simulation
     The very first call to analyze() will result in the creation (or overwriting) of the
     file fname and the writing of the current timestep snapshot. After that, each call to analyze
@@ -182,6 +201,17 @@ void DCDDumpWriter::analyze(unsigned int timestep)
     if (m_prof)
         m_prof->push("Dump DCD");
 
+#ifdef ENABLE_MPI
+    if (useMPIIO())
+        {
+        analyzeMPIIO(timestep);
+
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+#endif
+
     // take particle data snapshot
     SnapshotParticleData snapshot(m_pdata->getNGlobal());
 
@@ -251,11 +281,204 @@ void DCDDumpWriter::analyze(unsigned int timestep)
         m_prof->pop();
     }
 
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step of the simulation
+
+    The position of every group member in the file follows from its index in the (tag ordered) group. Every rank
+    sorts the coordinates of its members by that index, and writes them through a file view that selects their
+    positions in the x, y and z blocks of the frame. The root processor writes the headers and the block markers.
+*/
+void DCDDumpWriter::analyzeMPIIO(unsigned int timestep)
+    {
+    const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    bool is_root = m_exec_conf->isRoot();
+
+    if (m_unwrap_rigid)
+        {
+        m_exec_conf->msg->error() << "dump.dcd: Unwrap of rigid bodies in DCD files is currently not supported in MPI simulations" << endl;
+        throw runtime_error("Error writing DCD file");
+        }
+
+    if (! m_is_initialized)
+        {
+        // the header of an existing file is read by the root processor
+        if (is_root)
+            initFileIO();
+
+        bcast(m_appending, 0, mpi_comm);
+        bcast(m_num_frames_written, 0, mpi_comm);
+        bcast(m_start_timestep, 0, mpi_comm);
+        bcast(m_last_written_step, 0, mpi_comm);
+        m_nglobal = m_pdata->getNGlobal();
+        m_is_initialized = true;
+        }
+
+    if (m_nglobal != m_pdata->getNGlobal())
+        {
+        m_exec_conf->msg->error() << "analyze.dcd: Change in number of particles unsupported by DCD file format."
+            << std::endl;
+        throw std::runtime_error("Error writing DCD file");
+        }
+
+    if (m_num_frames_written == 0)
+        m_start_timestep = timestep;
+    else
+        {
+        if (m_appending && timestep <= m_last_written_step)
+            {
+            if (is_root)
+                m_exec_conf->msg->warning() << "dump.dcd: not writing output at timestep " << timestep << " because the file reports that it already has data up to step " << m_last_written_step << endl;
+            return;
+            }
+
+        // verify the period on subsequent frames
+        if (is_root && (timestep - m_start_timestep) % m_period != 0)
+            m_exec_conf->msg->warning() << "dump.dcd: writing time step " << timestep << " which is not specified in the period of the DCD file: " << m_start_timestep << " + i * " << m_period << endl;
+        }
+
+    unsigned int nparticles = m_group->getNumMembersGlobal();
+
+    // collect the coordinates of the local group members, together with their index in the output
+    unsigned int n_local = m_group->getNumMembers();
+    std::vector<unsigned int> member_idx(n_local);
+    for (unsigned int j = 0; j < n_local; j++)
+        member_idx[j] = m_group->getMemberIndex(j);
+
+    std::vector< std::pair<unsigned int, unsigned int> > out_idx(n_local); // (index in the output, local index)
+        {
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_member_tags(m_group->getMemberTags(), access_location::host, access_mode::read);
+        for (unsigned int j = 0; j < n_local; j++)
+            {
+            unsigned int tag = h_tag.data[member_idx[j]];
+            unsigned int group_idx = std::lower_bound(h_member_tags.data, h_member_tags.data + nparticles, tag)
+                - h_member_tags.data;
+            assert(group_idx < nparticles && h_member_tags.data[group_idx] == tag);
+            out_idx[j] = std::make_pair(group_idx, member_idx[j]);
+            }
+        }
+
+    // file views need to be monotonically increasing
+    std::sort(out_idx.begin(), out_idx.end());
+
+    std::vector<int> displs(n_local);
+    std::vector<float> coords(3*n_local);
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+
+        const BoxDim& box = m_pdata->getGlobalBox();
+        Scalar3 origin = m_pdata->getOrigin();
+        int3 o_image = m_pdata->getOriginImage();
+
+        for (unsigned int j = 0; j < n_local; j++)
+            {
+            unsigned int idx = out_idx[j].second;
+            displs[j] = out_idx[j].first;
+
+            // positions relative to the origin, as in the snapshot
+            Scalar3 pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - origin;
+            int3 image = make_int3(h_image.data[idx].x - o_image.x,
+                                   h_image.data[idx].y - o_image.y,
+                                   h_image.data[idx].z - o_image.z);
+            box.wrap(pos, image);
+
+            if (m_unwrap_full)
+                pos = box.shift(pos, image);
+
+            coords[j] = float(pos.x);
+            coords[n_local + j] = float(pos.y);
+            coords[2*n_local + j] = float(pos.z);
+
+            // m_angle set to True turns on a hack where the particle orientation angle is written out to the z component
+            if (m_angle)
+                {
+                Scalar s = 1;
+                if (h_orientation.data[idx].w < 0)
+                    s = -1;
+
+                coords[2*n_local + j] = acosf(h_orientation.data[idx].x) * 2 * s;
+                }
+            }
+        }
+
+    MPI_File fh;
+    int ret = MPI_File_open(mpi_comm, const_cast<char *>(m_fname.c_str()), MPI_MODE_WRONLY | MPI_MODE_CREATE,
+        MPI_INFO_NULL, &fh);
+    if (ret != MPI_SUCCESS)
+        {
+        m_exec_conf->msg->error() << "dump.dcd: Error opening DCD file " << m_fname << endl;
+        throw runtime_error("Error writing DCD file");
+        }
+
+    // truncate the file on the first frame written
+    if (m_num_frames_written == 0)
+        MPI_File_set_size(fh, 0);
+
+    MPI_Offset block_size = 2*sizeof(unsigned int) + MPI_Offset(nparticles)*sizeof(float);
+    MPI_Offset frame_offset = FILE_HEADER_SIZE + MPI_Offset(m_num_frames_written)*(FRAME_HEADER_SIZE + 3*block_size);
+
+    if (is_root)
+        {
+        MPI_Status status;
+        if (m_num_frames_written == 0)
+            {
+            std::ostringstream header;
+            write_file_header(header);
+            std::string str = header.str();
+            assert(str.size() == FILE_HEADER_SIZE);
+            MPI_File_write_at(fh, 0, const_cast<char *>(str.data()), str.size(), MPI_BYTE, &status);
+            }
+
+        std::ostringstream frame_header;
+        write_frame_header(frame_header);
+        std::string str = frame_header.str();
+        assert(str.size() == FRAME_HEADER_SIZE);
+        MPI_File_write_at(fh, frame_offset, const_cast<char *>(str.data()), str.size(), MPI_BYTE, &status);
+
+        // the size markers around every coordinate block
+        unsigned int block_len = nparticles*sizeof(float);
+        for (unsigned int block = 0; block < 3; block++)
+            {
+            MPI_Offset block_offset = frame_offset + FRAME_HEADER_SIZE + block*block_size;
+            MPI_File_write_at(fh, block_offset, &block_len, 1, MPI_UNSIGNED, &status);
+            MPI_File_write_at(fh, block_offset + sizeof(unsigned int) + block_len, &block_len, 1, MPI_UNSIGNED, &status);
+            }
+
+        // update the header with the number of frames written
+        unsigned int num_frames = m_num_frames_written + 1;
+        MPI_File_write_at(fh, NFILE_POS, &num_frames, 1, MPI_UNSIGNED, &status);
+        MPI_File_write_at(fh, NSTEP_POS, &timestep, 1, MPI_UNSIGNED, &status);
+        }
+
+    // every rank writes its slice of the x, y and z blocks
+    MPI_Datatype filetype;
+    MPI_Type_create_indexed_block(n_local, 1, n_local ? &displs.front() : NULL, MPI_FLOAT, &filetype);
+    MPI_Type_commit(&filetype);
+
+    float dummy;
+    for (unsigned int block = 0; block < 3; block++)
+        {
+        MPI_Offset disp = frame_offset + FRAME_HEADER_SIZE + block*block_size + sizeof(unsigned int);
+        MPI_File_set_view(fh, disp, MPI_FLOAT, filetype, const_cast<char *>("native"), MPI_INFO_NULL);
+
+        MPI_Status status;
+        MPI_File_write_all(fh, n_local ? &coords[block*n_local] : &dummy, n_local, MPI_FLOAT, &status);
+        }
+
+    MPI_Type_free(&filetype);
+    MPI_File_close(&fh);
+
+    m_num_frames_written++;
+    }
+#endif
+
 /*! \param file File to write to
     Writes the initial DCD header to the beginning of the file. This must be
     called on a newly created (or truncated file).
 */
-void DCDDumpWriter::write_file_header(std::fstream &file)
+void DCDDumpWriter::write_file_header(std::ostream &file)
     {
     // the first 4 bytes in the file must be 84
     write_int(file, 84);
@@ -319,7 +542,7 @@ void DCDDumpWriter::write_file_header(std::fstream &file)
     Writes the header that precedes each snapshot in the file. This header
     includes information on the box size of the simulation.
 */
-void DCDDumpWriter::write_frame_header(std::fstream &file)
+void DCDDumpWriter::write_frame_header(std::ostream &file)
     {
     double unitcell[6];
     BoxDim box = m_pdata->getGlobalBox();
@@ -478,6 +701,7 @@ void export_DCDDumpWriter()
     .def("setUnwrapFull", &DCDDumpWriter::setUnwrapFull)
     .def("setUnwrapRigid", &DCDDumpWriter::setUnwrapRigid)
     .def("setAngleZ", &DCDDumpWriter::setAngleZ)
+    .def("setMPIIO", &DCDDumpWriter::setMPIIO)
     ;
     }
 
@@ -88,6 +88,11 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     Due to a limitation in the DCD format, the time step period between calls to
     analyze() \b must be specified up front. If analyze() detects that this period is
     not being maintained, it will print a warning but continue.
+
+    In MPI simulations, the frames are by default written collectively with MPI-IO. Every rank computes the
+    position in the file of the group members it owns, and writes its slice of the x, y and z blocks directly,
+    so that no particle data needs to be gathered on the root processor. Only the headers are written by the root
+    processor. With setMPIIO(false), a snapshot is gathered and written by the root processor instead.
     \ingroup analyzers
 */
 class DCDDumpWriter : public Analyzer
@@ -124,6 +129,12 @@ class DCDDumpWriter : public Analyzer
             m_angle = enable;
             }
 
+        //! Set whether frames are written collectively with MPI-IO in MPI simulations
+        void setMPIIO(bool enable)
+            {
+            m_mpiio = enable;
+            }
+
     private:
         std::string m_fname;                //!< The file name we are writing to
         unsigned int m_start_timestep;      //!< First time step written to the file
@@ -136,6 +147,7 @@ class DCDDumpWriter : public Analyzer
         bool m_unwrap_full;                 //!< True if coordinates should be written out fully unwrapped in the box
         bool m_unwrap_rigid;                //!< True if rigid bodies should be written out unwrapped
         bool m_angle;                       //!< True if the z-component should be set to the orientation angle
+        bool m_mpiio;                       //!< True if frames are written collectively with MPI-IO
 
         bool m_overwrite;                   //!< True if file should be overwritten
         bool m_is_initialized;              //!< True if file IO has been initialized
@@ -146,9 +158,9 @@ class DCDDumpWriter : public Analyzer
         // helper functions
 
         //! Initalizes the file header
-        void write_file_header(std::fstream &file);
+        void write_file_header(std::ostream &file);
         //! Writes the frame header
-        void write_frame_header(std::fstream &file);
+        void write_frame_header(std::ostream &file);
         //! Writes the particle positions for a frame
         void write_frame_data(std::fstream &file, const SnapshotParticleData& snapshot);
         //! Updates the file header
@@ -156,6 +168,14 @@ class DCDDumpWriter : public Analyzer
         //! Initializes the output file for writing
         void initFileIO();
 
+        //! Returns true if the frames are written with MPI-IO
+        bool useMPIIO() const;
+
+#ifdef ENABLE_MPI
+        //! Writes a frame collectively from all ranks
+        void analyzeMPIIO(unsigned int timestep);
+#endif
+
     };
 
 //! Exports the DCDDumpWriter class to python
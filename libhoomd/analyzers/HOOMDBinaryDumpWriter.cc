@@ -76,6 +76,9 @@ using namespace boost::python;
 #include "HOOMDBinaryDumpWriter.h"
 #include "BondedGroupData.h"
 #include "WallData.h"
+#include "AsyncWriter.h"
+#include "HOOMDBinaryInitializer.h"
+#include "SnapshotSystemData.h"
 
 using namespace std;
 using namespace boost;
@@ -96,7 +99,8 @@ static void write_string(ostream &f, const string& str)
     \note .timestep.xml will be apended to the end of \a base_fname when analyze() is called.
 */
 HOOMDBinaryDumpWriter::HOOMDBinaryDumpWriter(boost::shared_ptr<SystemDefinition> sysdef, std::string base_fname)
-        : Analyzer(sysdef), m_base_fname(base_fname), m_alternating(false), m_cur_file(1), m_enable_compression(false)
+        : Analyzer(sysdef), m_base_fname(base_fname), m_alternating(false), m_cur_file(1), m_enable_compression(false),
+          m_aligned(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing HOOMDBinaryDumpWriter: " << base_fname << endl;
     }
@@ -106,11 +110,81 @@ HOOMDBinaryDumpWriter::~HOOMDBinaryDumpWriter()
     m_exec_conf->msg->notice(5) << "Destroying HOOMDBinaryDumpWriter" << endl;
     }
 
+//! Staged contents of one binary dump file
+/*! The file is serialized into memory on the calling thread. Compression and the write to disk are left to
+    write(), which may run on the AsyncWriter thread.
+*/
+class HOOMDBinaryDumpWriterJob : public AsyncWriteJob
+    {
+    public:
+        //! Compress and write the file
+        virtual void write();
+
+        std::string fname;          //!< File name to write
+        std::string data;           //!< Uncompressed contents of the file
+        bool enable_compression;    //!< True if the file should be gzip compressed
+    };
+
+void HOOMDBinaryDumpWriterJob::write()
+    {
+    // setup the file output for compression
+    filtering_ostream f;
+    #ifdef ENABLE_ZLIB
+    if (enable_compression)
+        f.push(gzip_compressor());
+    #endif
+    f.push(file_sink(fname.c_str(), ios::out | ios::binary));
+
+    if (!f.good())
+        throw runtime_error("dump.bin: Unable to open dump file for writing: " + fname);
+
+    f.write(data.data(), data.size());
+
+    if (!f.good())
+        throw runtime_error("dump.bin: I/O error writing HOOMD dump file");
+    }
+
+//! Helper function to fill in the type names of a bonded group snapshot
+template<class Data>
+static void fill_type_mapping(typename Data::Snapshot& snapshot, boost::shared_ptr<Data> data)
+    {
+    snapshot.type_mapping.clear();
+    for (unsigned int i = 0; i < data->getNTypes(); i++)
+        snapshot.type_mapping.push_back(data->getNameByType(i));
+    }
+
 /*! \param fname File name to write
     \param timestep Current time step of the simulation
+    \returns The serialized file, ready to be written (NULL on non-root ranks with aligned output)
 */
-void HOOMDBinaryDumpWriter::writeFile(std::string fname, unsigned int timestep)
+boost::shared_ptr<AsyncWriteJob> HOOMDBinaryDumpWriter::stageFile(const std::string& fname, unsigned int timestep)
     {
+    boost::shared_ptr<HOOMDBinaryDumpWriterJob> job(new HOOMDBinaryDumpWriterJob);
+    job->fname = fname;
+
+    if (m_aligned)
+        {
+        // take the snapshot on all ranks, the root writes the file
+        boost::shared_ptr<SnapshotSystemData> snapshot = m_sysdef->takeSnapshot(true, true, true, true, true, true,
+                                                                                true, true);
+        if (m_exec_conf->getRank() != 0)
+            return boost::shared_ptr<AsyncWriteJob>();
+
+        // the snapshots of the bonded groups do not include the type names
+        fill_type_mapping(snapshot->bond_data, m_sysdef->getBondData());
+        fill_type_mapping(snapshot->angle_data, m_sysdef->getAngleData());
+        fill_type_mapping(snapshot->dihedral_data, m_sysdef->getDihedralData());
+        fill_type_mapping(snapshot->improper_data, m_sysdef->getImproperData());
+
+        ostringstream f(ios::out | ios::binary);
+        writeAlignedData(f, *snapshot, timestep);
+
+        // aligned files are never compressed, so they can be mapped
+        job->data = f.str();
+        job->enable_compression = false;
+        return job;
+        }
+
     // check the file extension and warn the user
     string ext = fname.substr(fname.size()-3, fname.size());
     bool gz_ext = false;
@@ -128,20 +202,41 @@ void HOOMDBinaryDumpWriter::writeFile(std::string fname, unsigned int timestep)
         m_exec_conf->msg->warning() << "init.read_bin will not recognize that this file is uncompressed" << endl;
         }
 
-    // setup the file output for compression
-    filtering_ostream f;
-    #ifdef ENABLE_ZLIB
-    if (m_enable_compression)
-        f.push(gzip_compressor());
-    #endif
-    f.push(file_sink(fname.c_str(), ios::out | ios::binary));
+    ostringstream f(ios::out | ios::binary);
+    writeData(f, timestep);
 
-    if (!f.good())
+    job->data = f.str();
+    job->enable_compression = m_enable_compression;
+    return job;
+    }
+
+/*! \param fname File name to write
+    \param timestep Current time step of the simulation
+
+    The file is written before this method returns, regardless of setAsyncOutput().
+*/
+void HOOMDBinaryDumpWriter::writeFile(std::string fname, unsigned int timestep)
+    {
+    boost::shared_ptr<AsyncWriteJob> job = stageFile(fname, timestep);
+    if (!job)
+        return;
+
+    try
+        {
+        job->write();
+        }
+    catch (std::runtime_error const & ex)
         {
-        m_exec_conf->msg->error() << "dump.bin: Unable to open dump file for writing: " << fname << endl;
+        m_exec_conf->msg->error() << ex.what() << endl;
         throw runtime_error("Error writing hoomd binary dump file");
         }
+    }
 
+/*! \param f Stream to write to
+    \param timestep Current time step of the simulation
+*/
+void HOOMDBinaryDumpWriter::writeData(std::ostream& f, unsigned int timestep)
+    {
     // write a magic number identifying the file format
     unsigned int magic = 0x444d4f48;
     f.write((char*)&magic, sizeof(unsigned int));
@@ -422,13 +517,173 @@ void HOOMDBinaryDumpWriter::writeFile(std::string fname, unsigned int timestep)
 
         }
     }
+    }
+
+//! Helper function to write zero bytes up to the next aligned offset
+static void write_padding(ostream &f, uint64_t &offset)
+    {
+    static const char zeros[hoomd_bin_aligned::alignment] = {0};
+    uint64_t n = (hoomd_bin_aligned::alignment - offset % hoomd_bin_aligned::alignment) % hoomd_bin_aligned::alignment;
+    f.write(zeros, n);
+    offset += n;
+    }
+
+//! Helper function to write one per-particle array of an aligned file
+template<class T>
+static void write_array(ostream &f, const std::vector<T>& array, uint64_t &offset)
+    {
+    if (array.size())
+        f.write((const char*)&array[0], array.size()*sizeof(T));
+    offset += array.size()*sizeof(T);
+    write_padding(f, offset);
+    }
+
+//! Helper function to write the type names and members of a bonded group snapshot
+template<class Snapshot>
+static void write_groups(ostream &f, const Snapshot& snapshot)
+    {
+    unsigned int ntypes = snapshot.type_mapping.size();
+    f.write((char*)&ntypes, sizeof(unsigned int));
+    for (unsigned int i = 0; i < ntypes; i++)
+        write_string(f, snapshot.type_mapping[i]);
+
+    unsigned int n = snapshot.groups.size();
+    f.write((char*)&n, sizeof(unsigned int));
+    for (unsigned int i = 0; i < n; i++)
+        {
+        f.write((char*)&snapshot.type_id[i], sizeof(unsigned int));
+        f.write((char*)snapshot.groups[i].tag, sizeof(snapshot.groups[i].tag));
+        }
+    }
+
+/*! \param f Stream to write to
+    \param snapshot Snapshot of the system, with the type mappings of the bonded groups filled in
+    \param timestep Current time step of the simulation
+
+    See \ref page_bin_aligned_format for the layout.
+*/
+void HOOMDBinaryDumpWriter::writeAlignedData(std::ostream& f, const SnapshotSystemData& snapshot, unsigned int timestep)
+    {
+    const SnapshotParticleData& pdata = snapshot.particle_data;
+    unsigned int np = pdata.size;
+
+    // the per-particle arrays follow the header, each starting at an aligned offset
+    uint64_t offset = 8*sizeof(unsigned int) + 6*sizeof(Scalar) + (hoomd_bin_field::num_fields+2)*sizeof(uint64_t);
+    uint64_t field_offset[hoomd_bin_field::num_fields];
+    uint64_t data_offset = offset + (hoomd_bin_aligned::alignment - offset % hoomd_bin_aligned::alignment)
+                                    % hoomd_bin_aligned::alignment;
+    for (unsigned int i = 0; i < hoomd_bin_field::num_fields; i++)
+        {
+        field_offset[i] = data_offset;
+        data_offset += uint64_t(np)*hoomd_bin_field::getElementSize(i);
+        data_offset += (hoomd_bin_aligned::alignment - data_offset % hoomd_bin_aligned::alignment)
+                       % hoomd_bin_aligned::alignment;
+        }
+    uint64_t tail_offset = data_offset;
+
+    // serialize the tail first, the header records the size of the file
+    ostringstream tail(ios::out | ios::binary);
+    {
+    unsigned int ntypes = pdata.type_mapping.size();
+    tail.write((char*)&ntypes, sizeof(unsigned int));
+    for (unsigned int i = 0; i < ntypes; i++)
+        write_string(tail, pdata.type_mapping[i]);
+
+    unsigned int ni = snapshot.integrator_data.size();
+    tail.write((char*)&ni, sizeof(unsigned int));
+    for (unsigned int j = 0; j < ni; j++)
+        {
+        const IntegratorVariables& v = snapshot.integrator_data[j];
+        write_string(tail, v.type);
+
+        unsigned int nv = (unsigned int)v.variable.size();
+        tail.write((char*)&nv, sizeof(unsigned int));
+        for (unsigned int k=0; k<nv; k++)
+            {
+            Scalar var = v.variable[k];
+            tail.write((char*)&var, sizeof(Scalar));
+            }
+        }
+
+    write_groups(tail, snapshot.bond_data);
+    write_groups(tail, snapshot.angle_data);
+    write_groups(tail, snapshot.dihedral_data);
+    write_groups(tail, snapshot.improper_data);
+
+    unsigned int nw = snapshot.wall_data.size();
+    tail.write((char*)&nw, sizeof(unsigned int));
+    for (unsigned int i = 0; i < nw; i++)
+        {
+        const Wall& wall = snapshot.wall_data[i];
+        tail.write((char*)&(wall.origin_x), sizeof(Scalar));
+        tail.write((char*)&(wall.origin_y), sizeof(Scalar));
+        tail.write((char*)&(wall.origin_z), sizeof(Scalar));
+        tail.write((char*)&(wall.normal_x), sizeof(Scalar));
+        tail.write((char*)&(wall.normal_y), sizeof(Scalar));
+        tail.write((char*)&(wall.normal_z), sizeof(Scalar));
+        }
+
+    // the rigid bodies are stored as in version 3, which also writes the unused w components
+    const SnapshotRigidData& rdata = snapshot.rigid_data;
+    unsigned int n_bodies = rdata.size;
+    tail.write((char*)&n_bodies, sizeof(unsigned int));
+    Scalar zero = Scalar(0.0);
+    for (unsigned int body = 0; body < n_bodies; body++)
+        {
+        tail.write((char*)&rdata.com[body], sizeof(Scalar3));
+        tail.write((char*)&zero, sizeof(Scalar));
+        tail.write((char*)&rdata.vel[body], sizeof(Scalar3));
+        tail.write((char*)&zero, sizeof(Scalar));
+        tail.write((char*)&rdata.angmom[body], sizeof(Scalar3));
+        tail.write((char*)&zero, sizeof(Scalar));
+        tail.write((char*)&rdata.body_image[body], sizeof(int3));
+        }
+    }
+    string tail_data = tail.str();
+    uint64_t file_size = tail_offset + tail_data.size();
+
+    // write the header
+    unsigned int header[8];
+    header[0] = hoomd_bin_aligned::magic;
+    header[1] = hoomd_bin_aligned::version;
+    header[2] = timestep;
+    header[3] = snapshot.dimensions;
+    header[4] = sizeof(Scalar);
+    header[5] = np;
+    header[6] = hoomd_bin_field::num_fields;
+    header[7] = 0;
+    f.write((char*)header, sizeof(header));
+
+    const BoxDim& box = snapshot.global_box;
+    Scalar3 L = box.getL();
+    Scalar tilt[6] = {L.x, L.y, L.z, box.getTiltFactorXY(), box.getTiltFactorXZ(), box.getTiltFactorYZ()};
+    f.write((char*)tilt, sizeof(tilt));
+
+    f.write((char*)field_offset, sizeof(field_offset));
+    f.write((char*)&tail_offset, sizeof(uint64_t));
+    f.write((char*)&file_size, sizeof(uint64_t));
+    write_padding(f, offset);
+
+    // write the per-particle arrays in the order of hoomd_bin_field
+    write_array(f, pdata.pos, offset);
+    write_array(f, pdata.vel, offset);
+    write_array(f, pdata.accel, offset);
+    write_array(f, pdata.type, offset);
+    write_array(f, pdata.mass, offset);
+    write_array(f, pdata.charge, offset);
+    write_array(f, pdata.diameter, offset);
+    write_array(f, pdata.image, offset);
+    write_array(f, pdata.body, offset);
+    write_array(f, pdata.orientation, offset);
+    assert(offset == tail_offset);
+
+    f.write(tail_data.data(), tail_data.size());
 
     if (!f.good())
         {
         m_exec_conf->msg->error() << "dump.bin: I/O error writing HOOMD dump file" << endl;
         throw runtime_error("Error writing HOOMD dump file");
         }
-
     }
 
 /*! \param timestep Current time step of the simulation
@@ -439,21 +694,21 @@ void HOOMDBinaryDumpWriter::analyze(unsigned int timestep)
     if (m_prof)
         m_prof->push("Dump BIN");
 
+    string fname;
     if (!m_alternating)
         {
         ostringstream full_fname;
         string filetype = ".bin";
-        if (m_enable_compression)
+        if (m_enable_compression && !m_aligned)
             filetype += ".gz";
 
         // Generate a filename with the timestep padded to ten zeros
         full_fname << m_base_fname << "." << setfill('0') << setw(10) << timestep << filetype;
-        writeFile(full_fname.str(), timestep);
+        fname = full_fname.str();
         }
     else
         {
         // write out to m_fname1 and m_fname2, alternating between the two
-        string fname;
         if (m_cur_file == 1)
             {
             fname = m_fname1;
@@ -464,9 +719,18 @@ void HOOMDBinaryDumpWriter::analyze(unsigned int timestep)
             fname = m_fname2;
             m_cur_file = 1;
             }
-        writeFile(fname, timestep);
         }
 
+    if (m_writer)
+        {
+        // non-root ranks only take part in the snapshot of aligned output
+        boost::shared_ptr<AsyncWriteJob> job = stageFile(fname, timestep);
+        if (job)
+            m_writer->enqueue(job);
+        }
+    else
+        writeFile(fname, timestep);
+
     if (m_prof)
         m_prof->pop();
     }
@@ -481,6 +745,21 @@ void HOOMDBinaryDumpWriter::setAlternatingWrites(const std::string& fname1, cons
     m_fname2 = fname2;
     }
 
+/*! \param enable Set to true to compress and write the files of subsequent calls to analyze() on the shared
+    AsyncWriter thread
+*/
+void HOOMDBinaryDumpWriter::setAsyncOutput(bool enable)
+    {
+    if (enable && !m_writer)
+        m_writer = AsyncWriter::getShared(m_exec_conf);
+    else if (!enable && m_writer)
+        {
+        // files written by this analyzer must be complete when it switches back to synchronous output
+        m_writer->flush();
+        m_writer.reset();
+        }
+    }
+
 /* \param enable_compression Set to true to enable compression, falst to disable it
 */
 void HOOMDBinaryDumpWriter::enableCompression(bool enable_compression)
@@ -504,6 +783,8 @@ void export_HOOMDBinaryDumpWriter()
     .def("writeFile", &HOOMDBinaryDumpWriter::writeFile)
     .def("setAlternatingWrites", &HOOMDBinaryDumpWriter::setAlternatingWrites)
     .def("enableCompression", &HOOMDBinaryDumpWriter::enableCompression)
+    .def("setAsyncOutput", &HOOMDBinaryDumpWriter::setAsyncOutput)
+    .def("enableAlignedOutput", &HOOMDBinaryDumpWriter::enableAlignedOutput)
     ;
     }
 
@@ -62,11 +62,15 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/shared_ptr.hpp>
 
 #include "Analyzer.h"
+#include "AsyncWriter.h"
 #include "BondedGroupData.h"
 
 #ifndef __HOOMD_BINARY_DUMP_WRITER_H__
 #define __HOOMD_BINARY_DUMP_WRITER_H__
 
+//! Forward declaration of SnapshotSystemData
+struct SnapshotSystemData;
+
 //! Analyzer for writing out HOOMD  dump files
 /*! HOOMDBinaryDumpWriter can be used to write out xml files containing various levels of information
     of the current time step of the simulation. At a minimum, the current time step and box
@@ -86,6 +90,13 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
     Future versions will include the ability to dump forces on each particle to the file also.
 
+    With enableAlignedOutput(), files are written uncompressed in the aligned format (\ref page_bin_aligned_format),
+    which HOOMDBinaryInitializer reads by memory-mapping the file. Aligned output is written from a snapshot of the
+    whole system, and is therefore also supported in MPI simulations.
+
+    With setAsyncOutput(), analyze() only serializes the data into memory, and the compression and the write to
+    disk are done on the AsyncWriter thread. writeFile() always writes synchronously.
+
     For information on the structure of the xml file format: see \ref page_dev_info
     Although, HOOMD's  user guide probably has a more up to date documentation on the format.
     \ingroup analyzers
@@ -107,6 +118,13 @@ class HOOMDBinaryDumpWriter : public Analyzer
         void setAlternatingWrites(const std::string& fname1, const std::string& fname2);
         //! Enable or disable gzip compression of the binary output files
         void enableCompression(bool enable_compression);
+        //! Enables/disables writing the files on the background writer thread
+        void setAsyncOutput(bool enable);
+        //! Enable or disable output in the aligned (memory-mappable) format
+        void enableAlignedOutput(bool enable)
+            {
+            m_aligned = enable;
+            }
     private:
         std::string m_base_fname;   //!< String used to store the file name of the XML file
         std::string m_fname1;       //!< File name for the first file to write to in alternating mode
@@ -114,6 +132,15 @@ class HOOMDBinaryDumpWriter : public Analyzer
         bool m_alternating;         //!< True if we are to write to m_fname1 and m_fname in an alternating fasion
         unsigned int m_cur_file;    //!< Current index of the file we are writing to (1 or 2)
         bool m_enable_compression;  //!< True if gzip compression should be enabled
+        bool m_aligned;             //!< True if files are written in the aligned format
+        boost::shared_ptr<AsyncWriter> m_writer; //!< Writer thread for asynchronous output (NULL if disabled)
+
+        //! Serialize a file into memory
+        boost::shared_ptr<AsyncWriteJob> stageFile(const std::string& fname, unsigned int timestep);
+        //! Write the contents of a file to a stream
+        void writeData(std::ostream& f, unsigned int timestep);
+        //! Write the contents of an aligned file to a stream
+        void writeAlignedData(std::ostream& f, const SnapshotSystemData& snapshot, unsigned int timestep);
         };
 
 //! Exports the HOOMDBinaryDumpWriter class to python
@@ -70,6 +70,7 @@ using namespace boost::python;
 #include "HOOMDDumpWriter.h"
 #include "BondedGroupData.h"
 #include "WallData.h"
+#include "AsyncWriter.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -203,44 +204,72 @@ void HOOMDDumpWriter::setOutputMomentInertia(bool enable)
     m_output_moment_inertia = enable;
     }
 
-/*! \param fname File name to write
-    \param timestep Current time step of the simulation
+/*! \param enable Set to true to write the files of subsequent calls to analyze() on the shared AsyncWriter thread
 */
-void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
+void HOOMDDumpWriter::setAsyncOutput(bool enable)
     {
-    // acquire the particle data
-    SnapshotParticleData snapshot(m_pdata->getNGlobal());
-
-    m_pdata->takeSnapshot(snapshot);
-
-    BondData::Snapshot bdata_snapshot(m_sysdef->getBondData()->getNGlobal());
-    if (m_output_bond) m_sysdef->getBondData()->takeSnapshot(bdata_snapshot);
-
-    AngleData::Snapshot adata_snapshot(m_sysdef->getAngleData()->getNGlobal());
-    if (m_output_angle) m_sysdef->getAngleData()->takeSnapshot(adata_snapshot);
-
-    DihedralData::Snapshot ddata_snapshot(m_sysdef->getDihedralData()->getNGlobal());
-    if (m_output_dihedral) m_sysdef->getDihedralData()->takeSnapshot(ddata_snapshot);
-
-    ImproperData::Snapshot idata_snapshot(m_sysdef->getImproperData()->getNGlobal());
-    if (m_output_improper) m_sysdef->getImproperData()->takeSnapshot(idata_snapshot);
-
-#ifdef ENABLE_MPI
-    // only the root processor writes the output file
-    if (m_pdata->getDomainDecomposition() && ! m_exec_conf->isRoot())
-        return;
-#endif
+    if (enable && !m_writer)
+        m_writer = AsyncWriter::getShared(m_exec_conf);
+    else if (!enable && m_writer)
+        {
+        // files written by this analyzer must be complete when it switches back to synchronous output
+        m_writer->flush();
+        m_writer.reset();
+        }
+    }
 
+//! Staged data of one hoomd_xml file
+/*! HOOMDDumpWriter copies everything it writes into a HOOMDDumpWriterJob, so that the formatting of the file can
+    be done on the AsyncWriter thread while the simulation continues.
+*/
+class HOOMDDumpWriterJob : public AsyncWriteJob
+    {
+    public:
+        //! Format and write the file
+        virtual void write();
+
+        std::string fname;                      //!< File name to write
+        unsigned int timestep;                  //!< Time step of the frame
+        unsigned int dimensions;                //!< Number of dimensions of the system
+        BoxDim box;                             //!< Global simulation box
+        SnapshotParticleData snapshot;          //!< Particle data
+        BondData::Snapshot bdata_snapshot;      //!< Bonds
+        AngleData::Snapshot adata_snapshot;     //!< Angles
+        DihedralData::Snapshot ddata_snapshot;  //!< Dihedrals
+        ImproperData::Snapshot idata_snapshot;  //!< Impropers
+        std::vector<Wall> walls;                //!< Walls
+
+        bool output_position;       //!< true if the particle positions should be written
+        bool output_image;          //!< true if the particle images should be written
+        bool output_velocity;       //!< true if the particle velocities should be written
+        bool output_mass;           //!< true if the particle masses should be written
+        bool output_diameter;       //!< true if the particle diameters should be written
+        bool output_type;           //!< true if the particle types should be written
+        bool output_bond;           //!< true if the bonds should be written
+        bool output_angle;          //!< true if the angles should be written
+        bool output_wall;           //!< true if the walls should be written
+        bool output_dihedral;       //!< true if dihedrals should be written
+        bool output_improper;       //!< true if impropers should be written
+        bool output_accel;          //!< true if acceleration should be written
+        bool output_body;           //!< true if body should be written
+        bool output_charge;         //!< true if charge should be written
+        bool output_orientation;    //!< true if orientation should be written
+        bool output_moment_inertia; //!< true if moment_inertia should be written
+        Scalar vizsigma;            //!< vizsigma value to write out to xml files
+        bool vizsigma_set;          //!< true if vizsigma has been set
+    };
+
+/*! Errors are reported by throwing a std::runtime_error carrying the message for the user. This method may run
+    on the AsyncWriter thread, so it only uses the staged data.
+*/
+void HOOMDDumpWriterJob::write()
+    {
     // open the file for writing
     ofstream f(fname.c_str());
 
     if (!f.good())
-        {
-        m_exec_conf->msg->error() << "dump.xml: Unable to open dump file for writing: " << fname << endl;
-        throw runtime_error("Error writting hoomd_xml dump file");
-        }
+        throw runtime_error("dump.xml: Unable to open dump file for writing: " + fname);
 
-    BoxDim box = m_pdata->getGlobalBox();
     Scalar3 L = box.getL();
     Scalar xy = box.getTiltFactorXY();
     Scalar xz = box.getTiltFactorXZ();
@@ -250,10 +279,10 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     f << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << "\n";
     f << "<hoomd_xml version=\"1.5\">" << "\n";
     f << "<configuration time_step=\"" << timestep << "\" "
-      << "dimensions=\"" << m_sysdef->getNDimensions() << "\" "
-      << "natoms=\"" << m_pdata->getNGlobal() << "\" ";
-    if (m_vizsigma_set)
-        f << "vizsigma=\"" << m_vizsigma << "\" ";
+      << "dimensions=\"" << dimensions << "\" "
+      << "natoms=\"" << snapshot.size << "\" ";
+    if (vizsigma_set)
+        f << "vizsigma=\"" << vizsigma << "\" ";
     f << ">" << "\n";
     f << "<box " << "lx=\"" << L.x << "\" ly=\""<< L.y << "\" lz=\""<< L.z
       << "\" xy=\"" << xy << "\" xz=\"" << xz << "\" yz=\"" << yz << "\"/>" << "\n";
@@ -261,10 +290,10 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     f.precision(12);
 
     // If the position flag is true output the position of all particles to the file
-    if (m_output_position)
+    if (output_position)
         {
-        f << "<position num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        f << "<position num=\"" << snapshot.size << "\">" << "\n";
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             Scalar3 pos = snapshot.pos[j];
 
@@ -272,18 +301,17 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
 
             if (!f.good())
                 {
-                m_exec_conf->msg->error() << "dump.xml: I/O error while writing HOOMD dump file" << endl;
-                throw runtime_error("Error writting HOOMD dump file");
+                throw runtime_error("dump.xml: I/O error while writing HOOMD dump file");
                 }
             }
         f <<"</position>" << "\n";
         }
 
     // If the image flag is true, output the image of each particle to the file
-    if (m_output_image)
+    if (output_image)
         {
-        f << "<image num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        f << "<image num=\"" << snapshot.size << "\">" << "\n";
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             int3 image = snapshot.image[j];
 
@@ -291,26 +319,24 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
 
             if (!f.good())
                 {
-                m_exec_conf->msg->error() << "dump.xml: I/O error while writing HOOMD dump file" << endl;
-                throw runtime_error("Error writting HOOMD dump file");
+                throw runtime_error("dump.xml: I/O error while writing HOOMD dump file");
                 }
             }
         f <<"</image>" << "\n";
         }
 
     // If the velocity flag is true output the velocity of all particles to the file
-    if (m_output_velocity)
+    if (output_velocity)
         {
-        f <<"<velocity num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f <<"<velocity num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             Scalar3 vel = snapshot.vel[j];
             f << vel.x << " " << vel.y << " " << vel.z << "\n";
             if (!f.good())
                 {
-                m_exec_conf->msg->error() << "dump.xml: I/O error while writing HOOMD dump file" << endl;
-                throw runtime_error("Error writting HOOMD dump file");
+                throw runtime_error("dump.xml: I/O error while writing HOOMD dump file");
                 }
             }
 
@@ -318,19 +344,18 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
         }
 
     // If the velocity flag is true output the velocity of all particles to the file
-    if (m_output_accel)
+    if (output_accel)
         {
-        f <<"<acceleration num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f <<"<acceleration num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             Scalar3 accel = snapshot.accel[j];
 
             f << accel.x << " " << accel.y << " " << accel.z << "\n";
             if (!f.good())
                 {
-                m_exec_conf->msg->error() << "dump.xml: I/O error while writing HOOMD dump file" << endl;
-                throw runtime_error("Error writting HOOMD dump file");
+                throw runtime_error("dump.xml: I/O error while writing HOOMD dump file");
                 }
             }
 
@@ -338,19 +363,18 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
         }
 
     // If the mass flag is true output the mass of all particles to the file
-    if (m_output_mass)
+    if (output_mass)
         {
-        f <<"<mass num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f <<"<mass num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             Scalar mass = snapshot.mass[j];
 
             f << mass << "\n";
             if (!f.good())
                 {
-                m_exec_conf->msg->error() << "dump.xml: I/O error while writing HOOMD dump file" << endl;
-                throw runtime_error("Error writting HOOMD dump file");
+                throw runtime_error("dump.xml: I/O error while writing HOOMD dump file");
                 }
             }
 
@@ -358,18 +382,17 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
         }
 
     // If the diameter flag is true output the mass of all particles to the file
-    if (m_output_diameter)
+    if (output_diameter)
         {
-        f <<"<diameter num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f <<"<diameter num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             Scalar diameter = snapshot.diameter[j];
             f << diameter << "\n";
             if (!f.good())
                 {
-                m_exec_conf->msg->error() << "dump.xml: I/O error while writing HOOMD dump file" << endl;
-                throw runtime_error("Error writting HOOMD dump file");
+                throw runtime_error("dump.xml: I/O error while writing HOOMD dump file");
                 }
             }
 
@@ -377,22 +400,22 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
         }
 
     // If the Type flag is true output the types of all particles to an xml file
-    if  (m_output_type)
+    if  (output_type)
         {
-        f <<"<type num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        f <<"<type num=\"" << snapshot.size << "\">" << "\n";
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             unsigned int type = snapshot.type[j];
-            f << m_pdata->getNameByType(type) << "\n";
+            f << snapshot.type_mapping[type] << "\n";
             }
         f <<"</type>" << "\n";
         }
 
     // If the body flag is true output the bodies of all particles to an xml file
-    if  (m_output_body)
+    if  (output_body)
         {
-        f <<"<body num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        f <<"<body num=\"" << snapshot.size << "\">" << "\n";
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             unsigned int body;
             int out;
@@ -408,51 +431,48 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
         }
 
     // if the bond flag is true, output the bonds to the xml file
-    if (m_output_bond)
+    if (output_bond)
         {
         f << "<bond num=\"" << bdata_snapshot.groups.size() << "\">" << "\n";
-        boost::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
 
         // loop over all bonds and write them out
         for (unsigned int i = 0; i < bdata_snapshot.groups.size(); i++)
             {
             BondData::members_t bond = bdata_snapshot.groups[i];
             unsigned int bond_type = bdata_snapshot.type_id[i];
-            f << bond_data->getNameByType(bond_type) << " " << bond.tag[0] << " " << bond.tag[1] << "\n";
+            f << bdata_snapshot.type_mapping[bond_type] << " " << bond.tag[0] << " " << bond.tag[1] << "\n";
             }
 
         f << "</bond>" << "\n";
         }
 
     // if the angle flag is true, output the angles to the xml file
-    if (m_output_angle)
+    if (output_angle)
         {
         f << "<angle num=\"" << adata_snapshot.groups.size() << "\">" << "\n";
-        boost::shared_ptr<AngleData> angle_data = m_sysdef->getAngleData();
 
         // loop over all angles and write them out
         for (unsigned int i = 0; i < adata_snapshot.groups.size(); i++)
             {
             AngleData::members_t angle = adata_snapshot.groups[i];
             unsigned int angle_type = adata_snapshot.type_id[i];
-            f << angle_data->getNameByType(angle_type) << " " << angle.tag[0]  << " " << angle.tag[1] << " " << angle.tag[2] << "\n";
+            f << adata_snapshot.type_mapping[angle_type] << " " << angle.tag[0]  << " " << angle.tag[1] << " " << angle.tag[2] << "\n";
             }
 
         f << "</angle>" << "\n";
         }
 
     // if dihedral is true, write out dihedrals to the xml file
-    if (m_output_dihedral)
+    if (output_dihedral)
         {
         f << "<dihedral num=\"" << ddata_snapshot.groups.size() << "\">" << "\n";
-        boost::shared_ptr<DihedralData> dihedral_data = m_sysdef->getDihedralData();
 
         // loop over all angles and write them out
         for (unsigned int i = 0; i < ddata_snapshot.groups.size(); i++)
             {
             DihedralData::members_t dihedral = ddata_snapshot.groups[i];
             unsigned int dihedral_type = ddata_snapshot.type_id[i];
-            f << dihedral_data->getNameByType(dihedral_type) << " " << dihedral.tag[0]  << " " << dihedral.tag[1] << " "
+            f << ddata_snapshot.type_mapping[dihedral_type] << " " << dihedral.tag[0]  << " " << dihedral.tag[1] << " "
             << dihedral.tag[2] << " " << dihedral.tag[3] << "\n";
             }
 
@@ -460,17 +480,16 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
         }
 
     // if improper is true, write out impropers to the xml file
-    if (m_output_improper)
+    if (output_improper)
         {
         f << "<improper num=\"" << idata_snapshot.groups.size() << "\">" << "\n";
-        boost::shared_ptr<ImproperData> improper_data = m_sysdef->getImproperData();
 
         // loop over all angles and write them out
         for (unsigned int i = 0; i < idata_snapshot.groups.size(); i++)
             {
             ImproperData::members_t improper = idata_snapshot.groups[i];
             unsigned int improper_type = idata_snapshot.type_id[i];
-            f << improper_data->getNameByType(improper_type) << " " << improper.tag[0]  << " " << improper.tag[1] << " "
+            f << idata_snapshot.type_mapping[improper_type] << " " << improper.tag[0]  << " " << improper.tag[1] << " "
             << improper.tag[2] << " " << improper.tag[3] << "\n";
             }
 
@@ -478,15 +497,14 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
         }
 
     // if the wall flag is true, output the walls to the xml file
-    if (m_output_wall)
+    if (output_wall)
         {
         f << "<wall>" << "\n";
-        boost::shared_ptr<WallData> wall_data = m_sysdef->getWallData();
 
         // loop over all walls and write them out
-        for (unsigned int i = 0; i < wall_data->getNumWalls(); i++)
+        for (unsigned int i = 0; i < walls.size(); i++)
             {
-            Wall wall = wall_data->getWall(i);
+            const Wall& wall = walls[i];
             f << "<coord ox=\"" << wall.origin_x << "\" oy=\"" << wall.origin_y << "\" oz=\"" << wall.origin_z <<
             "\" nx=\"" << wall.normal_x << "\" ny=\"" << wall.normal_y << "\" nz=\"" << wall.normal_z << "\" />" << "\n";
             }
@@ -494,18 +512,17 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
         }
 
     // If the charge flag is true output the mass of all particles to the file
-    if (m_output_charge)
+    if (output_charge)
         {
-        f <<"<charge num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f <<"<charge num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             Scalar charge = snapshot.charge[j];
             f << charge << "\n";
             if (!f.good())
                 {
-                m_exec_conf->msg->error() << "dump.xml: I/O error while writing HOOMD dump file" << endl;
-                throw runtime_error("Error writting HOOMD dump file");
+                throw runtime_error("dump.xml: I/O error while writing HOOMD dump file");
                 }
             }
 
@@ -513,30 +530,29 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
         }
 
     // if the orientation flag is set, write out the orientation quaternion to the XML file
-    if (m_output_orientation)
+    if (output_orientation)
         {
-        f << "<orientation num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f << "<orientation num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int j = 0; j < m_pdata->getNGlobal(); j++)
+        for (unsigned int j = 0; j < snapshot.size; j++)
             {
             // use the rtag data to output the particles in the order they were read in
             Scalar4 orientation = snapshot.orientation[j];
             f << orientation.x << " " << orientation.y << " " << orientation.z << " " << orientation.w << "\n";
             if (!f.good())
                 {
-                m_exec_conf->msg->error() << "dump.xml: I/O error while writing HOOMD dump file" << endl;
-                throw runtime_error("Error writting HOOMD dump file");
+                throw runtime_error("dump.xml: I/O error while writing HOOMD dump file");
                 }
             }
         f << "</orientation>" << "\n";
         }
 
     // if the moment_inertia flag is set, write out the orientation quaternion to the XML file
-    if (m_output_moment_inertia)
+    if (output_moment_inertia)
         {
-        f << "<moment_inertia num=\"" << m_pdata->getNGlobal() << "\">" << "\n";
+        f << "<moment_inertia num=\"" << snapshot.size << "\">" << "\n";
 
-        for (unsigned int i = 0; i < m_pdata->getNGlobal(); i++)
+        for (unsigned int i = 0; i < snapshot.size; i++)
             {
             // inertia tensors are stored by tag
             InertiaTensor I = snapshot.inertia_tensor[i];
@@ -546,8 +562,7 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
 
             if (!f.good())
                 {
-                m_exec_conf->msg->error() << "dump.xml: I/O error while writing HOOMD dump file" << endl;
-                throw runtime_error("Error writting HOOMD dump file");
+                throw runtime_error("dump.xml: I/O error while writing HOOMD dump file");
                 }
             }
         f << "</moment_inertia>" << "\n";
@@ -557,17 +572,130 @@ void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
     f << "</hoomd_xml>" << "\n";
 
     if (!f.good())
+        throw runtime_error("dump.xml: I/O error while writing HOOMD dump file");
+
+    f.close();
+    }
+
+/*! \param fname File name to write
+    \param timestep Current time step of the simulation
+    \returns The staged data for the file, or a NULL pointer on non-root ranks
+
+    This is a collective call when running with a domain decomposition.
+*/
+boost::shared_ptr<AsyncWriteJob> HOOMDDumpWriter::stageFile(const std::string& fname, unsigned int timestep)
+    {
+    boost::shared_ptr<HOOMDDumpWriterJob> job(new HOOMDDumpWriterJob);
+
+    // acquire the particle data
+    job->snapshot.resize(m_pdata->getNGlobal());
+    m_pdata->takeSnapshot(job->snapshot);
+
+    if (m_output_bond)
         {
-                m_exec_conf->msg->error() << "dump.xml: I/O error while writing HOOMD dump file" << endl;
-        throw runtime_error("Error writting HOOMD dump file");
+        boost::shared_ptr<BondData> bond_data = m_sysdef->getBondData();
+        job->bdata_snapshot.resize(bond_data->getNGlobal());
+        bond_data->takeSnapshot(job->bdata_snapshot);
+        job->bdata_snapshot.type_mapping.clear();
+        for (unsigned int i = 0; i < bond_data->getNTypes(); i++)
+            job->bdata_snapshot.type_mapping.push_back(bond_data->getNameByType(i));
         }
 
-    f.close();
+    if (m_output_angle)
+        {
+        boost::shared_ptr<AngleData> angle_data = m_sysdef->getAngleData();
+        job->adata_snapshot.resize(angle_data->getNGlobal());
+        angle_data->takeSnapshot(job->adata_snapshot);
+        job->adata_snapshot.type_mapping.clear();
+        for (unsigned int i = 0; i < angle_data->getNTypes(); i++)
+            job->adata_snapshot.type_mapping.push_back(angle_data->getNameByType(i));
+        }
+
+    if (m_output_dihedral)
+        {
+        boost::shared_ptr<DihedralData> dihedral_data = m_sysdef->getDihedralData();
+        job->ddata_snapshot.resize(dihedral_data->getNGlobal());
+        dihedral_data->takeSnapshot(job->ddata_snapshot);
+        job->ddata_snapshot.type_mapping.clear();
+        for (unsigned int i = 0; i < dihedral_data->getNTypes(); i++)
+            job->ddata_snapshot.type_mapping.push_back(dihedral_data->getNameByType(i));
+        }
+
+    if (m_output_improper)
+        {
+        boost::shared_ptr<ImproperData> improper_data = m_sysdef->getImproperData();
+        job->idata_snapshot.resize(improper_data->getNGlobal());
+        improper_data->takeSnapshot(job->idata_snapshot);
+        job->idata_snapshot.type_mapping.clear();
+        for (unsigned int i = 0; i < improper_data->getNTypes(); i++)
+            job->idata_snapshot.type_mapping.push_back(improper_data->getNameByType(i));
+        }
+
+#ifdef ENABLE_MPI
+    // only the root processor writes the output file
+    if (m_pdata->getDomainDecomposition() && ! m_exec_conf->isRoot())
+        return boost::shared_ptr<AsyncWriteJob>();
+#endif
 
+    if (m_output_wall)
+        {
+        boost::shared_ptr<WallData> wall_data = m_sysdef->getWallData();
+        for (unsigned int i = 0; i < wall_data->getNumWalls(); i++)
+            job->walls.push_back(wall_data->getWall(i));
+        }
+
+    job->fname = fname;
+    job->timestep = timestep;
+    job->dimensions = m_sysdef->getNDimensions();
+    job->box = m_pdata->getGlobalBox();
+
+    job->output_position = m_output_position;
+    job->output_image = m_output_image;
+    job->output_velocity = m_output_velocity;
+    job->output_mass = m_output_mass;
+    job->output_diameter = m_output_diameter;
+    job->output_type = m_output_type;
+    job->output_bond = m_output_bond;
+    job->output_angle = m_output_angle;
+    job->output_wall = m_output_wall;
+    job->output_dihedral = m_output_dihedral;
+    job->output_improper = m_output_improper;
+    job->output_accel = m_output_accel;
+    job->output_body = m_output_body;
+    job->output_charge = m_output_charge;
+    job->output_orientation = m_output_orientation;
+    job->output_moment_inertia = m_output_moment_inertia;
+    job->vizsigma = m_vizsigma;
+    job->vizsigma_set = m_vizsigma_set;
+
+    return job;
+    }
+
+/*! \param fname File name to write
+    \param timestep Current time step of the simulation
+
+    The file is written before this method returns, regardless of setAsyncOutput().
+*/
+void HOOMDDumpWriter::writeFile(std::string fname, unsigned int timestep)
+    {
+    boost::shared_ptr<AsyncWriteJob> job = stageFile(fname, timestep);
+    if (!job)
+        return;
+
+    try
+        {
+        job->write();
+        }
+    catch (std::runtime_error const & ex)
+        {
+        m_exec_conf->msg->error() << ex.what() << endl;
+        throw runtime_error("Error writing hoomd_xml dump file");
+        }
     }
 
 /*! \param timestep Current time step of the simulation
-    Writes a snapshot of the current state of the ParticleData to a hoomd_xml file.
+    Writes a snapshot of the current state of the ParticleData to a hoomd_xml file. With asynchronous output
+    enabled, the file is written later on the AsyncWriter thread.
 */
 void HOOMDDumpWriter::analyze(unsigned int timestep)
     {
@@ -579,7 +707,16 @@ void HOOMDDumpWriter::analyze(unsigned int timestep)
 
     // Generate a filename with the timestep padded to ten zeros
     full_fname << m_base_fname << "." << setfill('0') << setw(10) << timestep << filetype;
-    writeFile(full_fname.str(), timestep);
+
+    if (m_writer)
+        {
+        // only copy the data here and leave the formatting to the writer thread
+        boost::shared_ptr<AsyncWriteJob> job = stageFile(full_fname.str(), timestep);
+        if (job)
+            m_writer->enqueue(job);
+        }
+    else
+        writeFile(full_fname.str(), timestep);
 
     if (m_prof)
         m_prof->pop();
@@ -605,6 +742,7 @@ void export_HOOMDDumpWriter()
     .def("setOutputCharge", &HOOMDDumpWriter::setOutputCharge)
     .def("setOutputOrientation", &HOOMDDumpWriter::setOutputOrientation)
     .def("setVizSigma", &HOOMDDumpWriter::setVizSigma)
+    .def("setAsyncOutput", &HOOMDDumpWriter::setAsyncOutput)
     .def("writeFile", &HOOMDDumpWriter::writeFile)
     ;
     }
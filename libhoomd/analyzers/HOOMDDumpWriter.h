@@ -62,6 +62,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/shared_ptr.hpp>
 
 #include "Analyzer.h"
+#include "AsyncWriter.h"
 
 #ifndef __HOOMD_DUMP_WRITER_H__
 #define __HOOMD_DUMP_WRITER_H__
@@ -85,6 +86,9 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
     Future versions will include the ability to dump forces on each particle to the file also.
 
+    With setAsyncOutput(), analyze() only copies the data for the file and the formatting and writing is done on
+    the AsyncWriter thread. writeFile() always writes synchronously.
+
     For information on the structure of the xml file format: see \ref page_dev_info
     Although, HOOMD's  user guide probably has a more up to date documentation on the format.
     \ingroup analyzers
@@ -139,6 +143,9 @@ class HOOMDDumpWriter : public Analyzer
             m_vizsigma_set = true;
             }
 
+        //! Enables/disables writing the files on the background writer thread
+        void setAsyncOutput(bool enable);
+
         //! Writes a file at the current time step
         void writeFile(std::string fname, unsigned int timestep);
     private:
@@ -161,6 +168,10 @@ class HOOMDDumpWriter : public Analyzer
         bool m_output_moment_inertia;  //!< true if moment_inertia should be written
         Scalar m_vizsigma;          //!< vizsigma value to write out to xml files
         bool m_vizsigma_set;        //!< true if vizsigma has been set
+        boost::shared_ptr<AsyncWriter> m_writer; //!< Writer thread for asynchronous output (NULL if disabled)
+
+        //! Copy the data for a file
+        boost::shared_ptr<AsyncWriteJob> stageFile(const std::string& fname, unsigned int timestep);
         };
 
 //! Exports the HOOMDDumpWriter class to python
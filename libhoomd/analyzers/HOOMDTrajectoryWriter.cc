@@ -0,0 +1,555 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file HOOMDTrajectoryWriter.cc
+    \brief Defines the HOOMDTrajectoryWriter class
+*/
+
+#ifdef WIN32
+#pragma warning( push )
+#pragma warning( disable : 4244 )
+#endif
+
+#include <boost/python.hpp>
+using namespace boost::python;
+
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#ifdef ENABLE_ZLIB
+#include <boost/iostreams/filter/zlib.hpp>
+#endif
+
+#include "HOOMDTrajectoryWriter.h"
+#include "HOOMDTrajectoryReader.h"
+#include "BondedGroupData.h"
+
+using namespace std;
+using namespace boost::iostreams;
+
+//! Helper function to append a value to a block
+template<class T>
+static void append(std::string& s, const T& val)
+    {
+    s.append((const char *)&val, sizeof(T));
+    }
+
+//! Helper function to append an array to a block
+template<class T>
+static void append(std::string& s, const std::vector<T>& v)
+    {
+    if (v.size())
+        s.append((const char *)&v[0], sizeof(T)*v.size());
+    }
+
+//! Helper function to append a list of names to a block
+static void append_names(std::string& s, const std::vector<std::string>& names)
+    {
+    append(s, (unsigned int)names.size());
+    for (unsigned int i = 0; i < names.size(); i++)
+        {
+        append(s, (unsigned int)names[i].size());
+        s.append(names[i]);
+        }
+    }
+
+//! Helper function to append a bonded group snapshot to a block
+template<class Snapshot>
+static void append_groups(std::string& s, const Snapshot& snap)
+    {
+    append_names(s, snap.type_mapping);
+    append(s, (unsigned int)snap.groups.size());
+    append(s, snap.type_id);
+    append(s, snap.groups);
+    }
+
+//! Helper function to take a snapshot of bonded groups including the type names
+template<class Data>
+static void take_group_snapshot(boost::shared_ptr<Data> data, typename Data::Snapshot& snap)
+    {
+    snap.resize(data->getNGlobal());
+    data->takeSnapshot(snap);
+    snap.type_mapping.clear();
+    for (unsigned int i = 0; i < data->getNTypes(); i++)
+        snap.type_mapping.push_back(data->getNameByType(i));
+    }
+
+//! An open HOOMD trajectory file
+/*! HOOMDTrajectoryFile keeps the state needed to append frames: the frame index, and the data and location of the
+    blocks that are only written when they change. It is shared between HOOMDTrajectoryWriter and the jobs it
+    hands to the AsyncWriter. open() is only called on the main thread, writeFrame() only by one thread at a time.
+*/
+class HOOMDTrajectoryFile : boost::noncopyable
+    {
+    public:
+        //! Constructor
+        HOOMDTrajectoryFile(const std::string& fname, bool overwrite)
+            : m_fname(fname), m_overwrite(overwrite), m_open(false), m_end(0)
+            {
+            for (unsigned int i = 0; i < traj_block::num_blocks; i++)
+                {
+                m_written[i] = false;
+                m_last_offset[i] = 0;
+                }
+            }
+
+        //! Test if the file has been opened
+        bool isOpen() const
+            {
+            return m_open;
+            }
+
+        //! Open the file for writing
+        void open(boost::shared_ptr<const ExecutionConfiguration> exec_conf);
+
+        //! Append a frame
+        void writeFrame(unsigned int timestep, unsigned int N, const std::vector<std::string>& blocks,
+                        const std::vector<bool>& present, bool compress);
+
+    private:
+        std::string m_fname;                        //!< File name
+        bool m_overwrite;                           //!< True if an existing file should be overwritten
+        bool m_open;                                //!< True if the file has been opened
+        std::fstream m_file;                        //!< The file
+        uint64_t m_end;                             //!< File offset of the end of the last frame
+        std::vector<uint64_t> m_frame_offsets;      //!< File offsets of all frames
+        bool m_written[traj_block::num_blocks];             //!< True if the block has been written to the file
+        std::string m_last_data[traj_block::num_blocks];    //!< Last written data of each block
+        uint64_t m_last_offset[traj_block::num_blocks];     //!< File offset of the last written copy of each block
+    };
+
+/*! \param exec_conf Execution configuration, used for messages
+
+    An existing file is appended to unless \a overwrite was set. Anything after the last complete frame (such as
+    a frame that was cut short when a previous job was killed) is truncated.
+*/
+void HOOMDTrajectoryFile::open(boost::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    bool append = !m_overwrite && boost::filesystem::exists(m_fname) && boost::filesystem::file_size(m_fname) > 0;
+
+    if (append)
+        {
+        exec_conf->msg->notice(3) << "dump.traj: Appending to existing file " << m_fname << endl;
+
+            {
+            HOOMDTrajectoryReader reader(exec_conf, m_fname);
+            m_frame_offsets = reader.getFrameOffsets();
+            }
+
+        m_end = traj_format::file_header_size;
+        if (m_frame_offsets.size())
+            {
+            ifstream f(m_fname.c_str(), ios::in | ios::binary);
+            uint64_t frame_size = 0;
+            f.seekg(m_frame_offsets.back() + 4*sizeof(unsigned int));
+            f.read((char *)&frame_size, sizeof(uint64_t));
+            m_end = m_frame_offsets.back() + frame_size;
+            }
+
+        boost::filesystem::resize_file(m_fname, m_end);
+        m_file.open(m_fname.c_str(), ios::in | ios::out | ios::binary);
+        }
+    else
+        {
+        exec_conf->msg->notice(3) << "dump.traj: Overwriting " << m_fname << endl;
+        m_file.open(m_fname.c_str(), ios::in | ios::out | ios::trunc | ios::binary);
+
+        unsigned int header[4] = { traj_format::file_magic, traj_format::version, sizeof(Scalar), 0 };
+        m_file.write((const char *)header, sizeof(header));
+        m_end = traj_format::file_header_size;
+        }
+
+    if (!m_file.good())
+        {
+        exec_conf->msg->error() << "dump.traj: Unable to open file for writing: " << m_fname << endl;
+        throw runtime_error("Error writing trajectory file");
+        }
+
+    m_open = true;
+    }
+
+/*! \param timestep Time step of the frame
+    \param N Number of particles
+    \param blocks Data of every block, indexed by traj_block::Enum
+    \param present Flags indicating which entries of \a blocks are part of this frame
+    \param compress Set to true to compress blocks
+
+    Blocks with ids of traj_block::type_names and higher are only written if they differ from the previously
+    written copy. The frame, the new frame index and the trailer are written with a single pass over the end of
+    the file, the previous index is overwritten.
+*/
+void HOOMDTrajectoryFile::writeFrame(unsigned int timestep, unsigned int N, const std::vector<std::string>& blocks,
+                                     const std::vector<bool>& present, bool compress)
+    {
+    // determine the block directory, and encode the blocks that need to be written
+    std::vector<unsigned int> entry_id;
+    std::vector<int> entry_new;              // index into new_blocks, or -1 for a reference to an older block
+    std::vector<std::string> new_blocks;
+    std::vector<unsigned int> new_flags;
+
+    for (unsigned int id = 0; id < traj_block::num_blocks; id++)
+        {
+        bool is_static = id >= traj_block::type_names;
+        if (!present[id])
+            {
+            // static blocks that are no longer staged keep referring to their last copy
+            if (is_static && m_written[id])
+                {
+                entry_id.push_back(id);
+                entry_new.push_back(-1);
+                }
+            continue;
+            }
+
+        entry_id.push_back(id);
+        if (is_static && m_written[id] && blocks[id] == m_last_data[id])
+            {
+            entry_new.push_back(-1);
+            continue;
+            }
+
+        entry_new.push_back((int)new_blocks.size());
+        unsigned int flags = 0;
+        std::string stored;
+        #ifdef ENABLE_ZLIB
+        if (compress && blocks[id].size() > 0)
+            {
+            filtering_ostream f;
+            f.push(zlib_compressor());
+            f.push(boost::iostreams::back_inserter(stored));
+            f.write(blocks[id].data(), blocks[id].size());
+            f.reset();
+
+            // keep the compressed block only if it actually saves space
+            if (stored.size() < blocks[id].size())
+                flags |= traj_format::block_compressed;
+            else
+                stored.clear();
+            }
+        #endif
+        if (!(flags & traj_format::block_compressed))
+            stored = blocks[id];
+
+        new_blocks.push_back(stored);
+        new_flags.push_back(flags);
+        }
+
+    // lay out the frame
+    unsigned int n_entries = entry_id.size();
+    uint64_t frame_offset = m_end;
+    uint64_t pos = frame_offset + traj_format::frame_header_size + n_entries*traj_format::dir_entry_size;
+    std::vector<uint64_t> new_offsets(new_blocks.size());
+    for (unsigned int i = 0; i < new_blocks.size(); i++)
+        {
+        new_offsets[i] = pos;
+        pos += traj_format::block_header_size + new_blocks[i].size();
+        }
+    uint64_t frame_size = pos - frame_offset;
+
+    // assemble the frame in memory
+    std::string frame;
+    frame.reserve(frame_size);
+    append(frame, (unsigned int)traj_format::frame_magic);
+    append(frame, timestep);
+    append(frame, N);
+    append(frame, n_entries);
+    append(frame, frame_size);
+
+    for (unsigned int i = 0; i < n_entries; i++)
+        {
+        unsigned int id = entry_id[i];
+        append(frame, id);
+        append(frame, (unsigned int)0);
+        append(frame, entry_new[i] >= 0 ? new_offsets[entry_new[i]] : m_last_offset[id]);
+        }
+
+    for (unsigned int i = 0; i < n_entries; i++)
+        {
+        if (entry_new[i] < 0)
+            continue;
+
+        unsigned int id = entry_id[i];
+        const std::string& stored = new_blocks[entry_new[i]];
+        append(frame, id);
+        append(frame, new_flags[entry_new[i]]);
+        append(frame, (uint64_t)blocks[id].size());
+        append(frame, (uint64_t)stored.size());
+        frame.append(stored);
+        }
+
+    // write the frame followed by the index and the trailer
+    std::vector<uint64_t> frame_offsets(m_frame_offsets);
+    frame_offsets.push_back(frame_offset);
+    uint64_t index_offset = frame_offset + frame_size;
+
+    append(frame, frame_offsets);
+    append(frame, index_offset);
+    append(frame, (unsigned int)frame_offsets.size());
+    append(frame, (unsigned int)traj_format::index_magic);
+
+    m_file.seekp(frame_offset);
+    m_file.write(frame.data(), frame.size());
+    m_file.flush();
+
+    if (!m_file.good())
+        throw runtime_error("dump.traj: I/O error while writing " + m_fname);
+
+    // the frame is on disk, update the state
+    m_frame_offsets.swap(frame_offsets);
+    m_end = index_offset;
+    for (unsigned int i = 0; i < n_entries; i++)
+        {
+        if (entry_new[i] < 0)
+            continue;
+
+        unsigned int id = entry_id[i];
+        m_written[id] = true;
+        m_last_offset[id] = new_offsets[entry_new[i]];
+        if (id >= traj_block::type_names)
+            m_last_data[id] = blocks[id];
+        }
+    }
+
+//! Staged data of one trajectory frame
+/*! The blocks are encoded and written in write(), which may run on the AsyncWriter thread.
+*/
+class HOOMDTrajectoryWriterJob : public AsyncWriteJob
+    {
+    public:
+        //! Encode the blocks and append the frame to the file
+        virtual void write();
+
+        boost::shared_ptr<HOOMDTrajectoryFile> file;    //!< File to write to
+        unsigned int timestep;                  //!< Time step of the frame
+        unsigned int dimensions;                //!< Number of dimensions of the system
+        BoxDim box;                             //!< Global simulation box
+        SnapshotParticleData snapshot;          //!< Particle data
+        BondData::Snapshot bdata_snapshot;      //!< Bonds
+        AngleData::Snapshot adata_snapshot;     //!< Angles
+        DihedralData::Snapshot ddata_snapshot;  //!< Dihedrals
+        ImproperData::Snapshot idata_snapshot;  //!< Impropers
+        bool output_velocity;       //!< true if the particle velocities should be written
+        bool output_image;          //!< true if the particle images should be written
+        bool output_orientation;    //!< true if the particle orientations should be written
+        bool enable_compression;    //!< true if blocks should be compressed
+    };
+
+void HOOMDTrajectoryWriterJob::write()
+    {
+    std::vector<std::string> blocks(traj_block::num_blocks);
+    std::vector<bool> present(traj_block::num_blocks, true);
+
+    std::string& box_block = blocks[traj_block::box];
+    Scalar3 L = box.getL();
+    append(box_block, dimensions);
+    append(box_block, L.x);
+    append(box_block, L.y);
+    append(box_block, L.z);
+    append(box_block, box.getTiltFactorXY());
+    append(box_block, box.getTiltFactorXZ());
+    append(box_block, box.getTiltFactorYZ());
+
+    append(blocks[traj_block::position], snapshot.pos);
+
+    if (output_velocity)
+        append(blocks[traj_block::velocity], snapshot.vel);
+    present[traj_block::velocity] = output_velocity;
+
+    if (output_image)
+        append(blocks[traj_block::image], snapshot.image);
+    present[traj_block::image] = output_image;
+
+    if (output_orientation)
+        append(blocks[traj_block::orientation], snapshot.orientation);
+    present[traj_block::orientation] = output_orientation;
+
+    append_names(blocks[traj_block::type_names], snapshot.type_mapping);
+    append(blocks[traj_block::type], snapshot.type);
+    append(blocks[traj_block::mass], snapshot.mass);
+    append(blocks[traj_block::charge], snapshot.charge);
+    append(blocks[traj_block::diameter], snapshot.diameter);
+    append(blocks[traj_block::body], snapshot.body);
+
+    append_groups(blocks[traj_block::bond], bdata_snapshot);
+    append_groups(blocks[traj_block::angle], adata_snapshot);
+    append_groups(blocks[traj_block::dihedral], ddata_snapshot);
+    append_groups(blocks[traj_block::improper], idata_snapshot);
+
+    file->writeFrame(timestep, snapshot.size, blocks, present, enable_compression);
+    }
+
+/*! \param sysdef SystemDefinition containing the ParticleData to dump
+    \param fname File name to write to
+    \param overwrite If true, an existing file is overwritten. If false, frames are appended to it.
+*/
+HOOMDTrajectoryWriter::HOOMDTrajectoryWriter(boost::shared_ptr<SystemDefinition> sysdef,
+                                             const std::string &fname,
+                                             bool overwrite)
+    : Analyzer(sysdef), m_file(new HOOMDTrajectoryFile(fname, overwrite)), m_output_velocity(true),
+      m_output_image(true), m_output_orientation(false), m_enable_compression(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing HOOMDTrajectoryWriter: " << fname << " " << overwrite << endl;
+    }
+
+HOOMDTrajectoryWriter::~HOOMDTrajectoryWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying HOOMDTrajectoryWriter" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    This is a collective call when running with a domain decomposition.
+*/
+void HOOMDTrajectoryWriter::analyze(unsigned int timestep)
+    {
+    if (m_prof)
+        m_prof->push("Dump traj");
+
+    boost::shared_ptr<HOOMDTrajectoryWriterJob> job(new HOOMDTrajectoryWriterJob);
+
+    job->snapshot.resize(m_pdata->getNGlobal());
+    m_pdata->takeSnapshot(job->snapshot);
+    take_group_snapshot(m_sysdef->getBondData(), job->bdata_snapshot);
+    take_group_snapshot(m_sysdef->getAngleData(), job->adata_snapshot);
+    take_group_snapshot(m_sysdef->getDihedralData(), job->ddata_snapshot);
+    take_group_snapshot(m_sysdef->getImproperData(), job->idata_snapshot);
+
+#ifdef ENABLE_MPI
+    // only the root processor writes the output file
+    if (m_pdata->getDomainDecomposition() && ! m_exec_conf->isRoot())
+        {
+        if (m_prof)
+            m_prof->pop();
+        return;
+        }
+#endif
+
+    if (!m_file->isOpen())
+        m_file->open(m_exec_conf);
+
+    job->file = m_file;
+    job->timestep = timestep;
+    job->dimensions = m_sysdef->getNDimensions();
+    job->box = m_pdata->getGlobalBox();
+    job->output_velocity = m_output_velocity;
+    job->output_image = m_output_image;
+    job->output_orientation = m_output_orientation;
+    job->enable_compression = m_enable_compression;
+
+    if (m_writer)
+        m_writer->enqueue(job);
+    else
+        {
+        try
+            {
+            job->write();
+            }
+        catch (std::runtime_error const & ex)
+            {
+            m_exec_conf->msg->error() << ex.what() << endl;
+            throw runtime_error("Error writing trajectory file");
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param enable Set to true to zlib compress the blocks of subsequent frames
+*/
+void HOOMDTrajectoryWriter::enableCompression(bool enable)
+    {
+    #ifdef ENABLE_ZLIB
+    m_enable_compression = enable;
+    #else
+    m_enable_compression = false;
+    if (enable)
+        {
+        m_exec_conf->msg->warning() << "dump.traj: This build of hoomd was compiled with ENABLE_ZLIB=off." << endl;
+        m_exec_conf->msg->warning() << "trajectory data will NOT be compressed" << endl;
+        }
+    #endif
+    }
+
+/*! \param enable Set to true to compress and write the frames of subsequent calls to analyze() on the shared
+    AsyncWriter thread
+*/
+void HOOMDTrajectoryWriter::setAsyncOutput(bool enable)
+    {
+    if (enable && !m_writer)
+        m_writer = AsyncWriter::getShared(m_exec_conf);
+    else if (!enable && m_writer)
+        {
+        // frames written by this analyzer must be complete when it switches back to synchronous output
+        m_writer->flush();
+        m_writer.reset();
+        }
+    }
+
+void export_HOOMDTrajectoryWriter()
+    {
+    class_<HOOMDTrajectoryWriter, boost::shared_ptr<HOOMDTrajectoryWriter>, bases<Analyzer>, boost::noncopyable>
+    ("HOOMDTrajectoryWriter", init< boost::shared_ptr<SystemDefinition>, std::string, bool>())
+    .def("setOutputVelocity", &HOOMDTrajectoryWriter::setOutputVelocity)
+    .def("setOutputImage", &HOOMDTrajectoryWriter::setOutputImage)
+    .def("setOutputOrientation", &HOOMDTrajectoryWriter::setOutputOrientation)
+    .def("enableCompression", &HOOMDTrajectoryWriter::enableCompression)
+    .def("setAsyncOutput", &HOOMDTrajectoryWriter::setAsyncOutput)
+    ;
+    }
+
+#ifdef WIN32
+#pragma warning( pop )
+#endif
@@ -0,0 +1,142 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file HOOMDTrajectoryWriter.h
+    \brief Declares the HOOMDTrajectoryWriter class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <string>
+
+#include <boost/shared_ptr.hpp>
+
+#include "Analyzer.h"
+#include "AsyncWriter.h"
+
+#ifndef __HOOMD_TRAJECTORY_WRITER_H__
+#define __HOOMD_TRAJECTORY_WRITER_H__
+
+//! Forward declaration of the open trajectory file
+class HOOMDTrajectoryFile;
+
+//! Analyzer for writing HOOMD trajectory files
+/*! HOOMDTrajectoryWriter appends one frame to a HOOMD trajectory file (see \ref page_traj_format) every time
+    analyze() is called. Frames can be read back in any order with HOOMDTrajectoryReader.
+
+    The box and the particle positions are written in every frame. Velocities, images and orientations are
+    written in every frame if enabled with setOutputVelocity(), setOutputImage() and setOutputOrientation().
+    Types, masses, charges, diameters, bodies and the bonded topology are written only in the frames in which
+    they change, the other frames refer back to the last written copy.
+
+    With enableCompression(), every block is zlib compressed if that makes it smaller.
+
+    If the file already exists and \a overwrite is false, new frames are appended to it. The first appended frame
+    contains all blocks.
+
+    In MPI simulations, a snapshot is gathered and written by the root processor. With setAsyncOutput(), the
+    compression and the write are done on the AsyncWriter thread.
+
+    \ingroup analyzers
+*/
+class HOOMDTrajectoryWriter : public Analyzer
+    {
+    public:
+        //! Construct the writer
+        HOOMDTrajectoryWriter(boost::shared_ptr<SystemDefinition> sysdef,
+                              const std::string &fname,
+                              bool overwrite=false);
+
+        //! Destructor
+        ~HOOMDTrajectoryWriter();
+
+        //! Write out the data for the current timestep
+        void analyze(unsigned int timestep);
+
+        //! Enables/disables the writing of particle velocities
+        void setOutputVelocity(bool enable)
+            {
+            m_output_velocity = enable;
+            }
+
+        //! Enables/disables the writing of particle images
+        void setOutputImage(bool enable)
+            {
+            m_output_image = enable;
+            }
+
+        //! Enables/disables the writing of particle orientations
+        void setOutputOrientation(bool enable)
+            {
+            m_output_orientation = enable;
+            }
+
+        //! Enables/disables zlib compression of the blocks
+        void enableCompression(bool enable);
+
+        //! Enables/disables writing the frames on the background writer thread
+        void setAsyncOutput(bool enable);
+
+    private:
+        boost::shared_ptr<HOOMDTrajectoryFile> m_file; //!< The file we are writing to
+        bool m_output_velocity;     //!< true if the particle velocities should be written
+        bool m_output_image;        //!< true if the particle images should be written
+        bool m_output_orientation;  //!< true if the particle orientations should be written
+        bool m_enable_compression;  //!< true if blocks should be compressed
+        boost::shared_ptr<AsyncWriter> m_writer; //!< Writer thread for asynchronous output (NULL if disabled)
+    };
+
+//! Exports the HOOMDTrajectoryWriter class to python
+void export_HOOMDTrajectoryWriter();
+
+#endif
@@ -68,6 +68,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Initializers.h"
 #include "HOOMDInitializer.h"
 #include "HOOMDBinaryInitializer.h"
+#include "HOOMDTrajectoryReader.h"
 #include "RandomGenerator.h"
 #include "Compute.h"
 #include "CellList.h"
@@ -92,6 +93,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "IMDInterface.h"
 #include "HOOMDDumpWriter.h"
 #include "HOOMDBinaryDumpWriter.h"
+#include "HOOMDTrajectoryWriter.h"
 #include "PDBDumpWriter.h"
 #include "MOL2DumpWriter.h"
 #include "DCDDumpWriter.h"
@@ -165,6 +167,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #include "DomainDecomposition.h"
+#include "LoadBalancer.h"
 #include "HOOMDMPI.h"
 #ifdef ENABLE_CUDA
 #include "CommunicatorGPU.h"
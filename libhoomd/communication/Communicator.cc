@@ -821,6 +821,7 @@ Communicator::Communicator(boost::shared_ptr<SystemDefinition> sysdef,
             m_diameter_copybuf(m_exec_conf),
             m_velocity_copybuf(m_exec_conf),
             m_orientation_copybuf(m_exec_conf),
+            m_body_copybuf(m_exec_conf),
             m_plan_copybuf(m_exec_conf),
             m_tag_copybuf(m_exec_conf),
             m_r_ghost(Scalar(0.0)),
@@ -828,6 +829,8 @@ Communicator::Communicator(boost::shared_ptr<SystemDefinition> sysdef,
             m_plan(m_exec_conf),
             m_last_flags(0),
             m_comm_pending(false),
+            m_num_update_fields(0),
+            m_persistent_update(true),
             m_bond_comm(*this, m_sysdef->getBondData()),
             m_angle_comm(*this, m_sysdef->getAngleData()),
             m_dihedral_comm(*this, m_sysdef->getDihedralData()),
@@ -851,6 +854,8 @@ Communicator::Communicator(boost::shared_ptr<SystemDefinition> sysdef,
         m_copy_ghosts[dir].swap(copy_ghosts);
         m_num_copy_ghosts[dir] = 0;
         m_num_recv_ghosts[dir] = 0;
+        m_num_forward_ghosts[dir] = 0;
+        m_num_recv_forward_ghosts[dir] = 0;
         }
 
     // connect to particle sort signal
@@ -917,6 +922,7 @@ Communicator::Communicator(boost::shared_ptr<SystemDefinition> sysdef,
 Communicator::~Communicator()
     {
     m_exec_conf->msg->notice(5) << "Destroying Communicator";
+    freePersistentRequests();
     m_sort_connection.disconnect();
     m_bond_connection.disconnect();
     m_angle_connection.disconnect();
@@ -1065,6 +1071,10 @@ void Communicator::communicate(unsigned int timestep)
         {
         // *after* synchronization, but only if particles do not migrate
         beginUpdateGhosts(timestep);
+
+        // compute everything that does not involve ghosts while the update is in flight
+        m_interior_compute_callbacks(timestep);
+
         finishUpdateGhosts(timestep);
 
         m_compute_callbacks(timestep);
@@ -1225,6 +1235,9 @@ void Communicator::exchangeGhosts()
 
     m_exec_conf->msg->notice(7) << "Communicator: exchange ghosts" << std::endl;
 
+    // the ghost lists change, so the persistent requests of the ghost update have to be set up again
+    freePersistentRequests();
+
     const BoxDim& box = m_pdata->getBox();
 
     // Sending ghosts proceeds in two stages:
@@ -1313,6 +1326,7 @@ void Communicator::exchangeGhosts()
     m_diameter_copybuf.resize(m_pdata->getN());
     m_velocity_copybuf.resize(m_pdata->getN());
     m_orientation_copybuf.resize(m_pdata->getN());
+    m_body_copybuf.resize(m_pdata->getN());
 
     // ghost particle flags
     CommFlags flags = getFlags();
@@ -1322,6 +1336,7 @@ void Communicator::exchangeGhosts()
         if (! isCommunicating(dir) ) continue;
 
         m_num_copy_ghosts[dir] = 0;
+        m_num_forward_ghosts[dir] = 0;
 
         // resize array of ghost particle tags
         unsigned int max_copy_ghosts = m_pdata->getN() + m_pdata->getNGhosts();
@@ -1334,6 +1349,7 @@ void Communicator::exchangeGhosts()
         m_diameter_copybuf.resize(max_copy_ghosts);
         m_velocity_copybuf.resize(max_copy_ghosts);
         m_orientation_copybuf.resize(max_copy_ghosts);
+        m_body_copybuf.resize(max_copy_ghosts);
 
 
             {
@@ -1343,6 +1359,7 @@ void Communicator::exchangeGhosts()
             ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
             ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
             ArrayHandle<unsigned int>  h_plan(m_plan, access_location::host, access_mode::read);
 
@@ -1353,6 +1370,7 @@ void Communicator::exchangeGhosts()
             ArrayHandle<Scalar> h_diameter_copybuf(m_diameter_copybuf, access_location::host, access_mode::overwrite);
             ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
             ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
+            ArrayHandle<unsigned int> h_body_copybuf(m_body_copybuf, access_location::host, access_mode::overwrite);
 
             for (unsigned int idx = 0; idx < m_pdata->getN() + m_pdata->getNGhosts(); idx++)
                 {
@@ -1365,10 +1383,16 @@ void Communicator::exchangeGhosts()
                     h_diameter_copybuf.data[m_num_copy_ghosts[dir]] = h_diameter.data[idx];
                     h_velocity_copybuf.data[m_num_copy_ghosts[dir]] = h_vel.data[idx];
                     h_orientation_copybuf.data[m_num_copy_ghosts[dir]] = h_orientation.data[idx];
+                    h_body_copybuf.data[m_num_copy_ghosts[dir]] = h_body.data[idx];
                     h_plan_copybuf.data[m_num_copy_ghosts[dir]] = h_plan.data[idx];
 
                     h_copy_ghosts.data[m_num_copy_ghosts[dir]] = h_tag.data[idx];
                     m_num_copy_ghosts[dir]++;
+
+                    // ghosts are stored after the local particles, so the forwarded ghosts
+                    // are always at the end of the copy list
+                    if (idx >= m_pdata->getN())
+                        m_num_forward_ghosts[dir]++;
                     }
                 }
             }
@@ -1385,8 +1409,8 @@ void Communicator::exchangeGhosts()
             m_prof->push("MPI send/recv");
 
         // communicate size of the message that will contain the particle data
-        MPI_Request reqs[14];
-        MPI_Status status[14];
+        MPI_Request reqs[16];
+        MPI_Status status[16];
 
         MPI_Isend(&m_num_copy_ghosts[dir],
             sizeof(unsigned int),
@@ -1402,7 +1426,23 @@ void Communicator::exchangeGhosts()
             0,
             m_mpi_comm,
             &reqs[1]);
-        MPI_Waitall(2, reqs, status);
+
+        // the ghost update needs to know how many of the received ghosts have been forwarded
+        MPI_Isend(&m_num_forward_ghosts[dir],
+            sizeof(unsigned int),
+            MPI_BYTE,
+            send_neighbor,
+            8,
+            m_mpi_comm,
+            &reqs[2]);
+        MPI_Irecv(&m_num_recv_forward_ghosts[dir],
+            sizeof(unsigned int),
+            MPI_BYTE,
+            recv_neighbor,
+            8,
+            m_mpi_comm,
+            &reqs[3]);
+        MPI_Waitall(4, reqs, status);
 
         if (m_prof)
             m_prof->pop();
@@ -1428,6 +1468,7 @@ void Communicator::exchangeGhosts()
             ArrayHandle<Scalar> h_diameter_copybuf(m_diameter_copybuf, access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_body_copybuf(m_body_copybuf, access_location::host, access_mode::read);
 
             ArrayHandle<unsigned int> h_plan(m_plan, access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
@@ -1435,6 +1476,7 @@ void Communicator::exchangeGhosts()
             ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+            ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::readwrite);
             ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::readwrite);
 
             unsigned int nreq = 0;
@@ -1560,6 +1602,24 @@ void Communicator::exchangeGhosts()
                     &reqs[nreq++]);
                 }
 
+            if (flags[comm_flag::body])
+                {
+                MPI_Isend(h_body_copybuf.data,
+                    m_num_copy_ghosts[dir]*sizeof(unsigned int),
+                    MPI_BYTE,
+                    send_neighbor,
+                    11,
+                    m_mpi_comm,
+                    &reqs[nreq++]);
+                MPI_Irecv(h_body.data + start_idx,
+                    m_num_recv_ghosts[dir]*sizeof(unsigned int),
+                    MPI_BYTE,
+                    recv_neighbor,
+                    11,
+                    m_mpi_comm,
+                    &reqs[nreq++]);
+                }
+
             MPI_Waitall(nreq, reqs, status);
             }
 
@@ -1603,7 +1663,109 @@ void Communicator::exchangeGhosts()
         m_prof->pop();
     }
 
+//! Get the array of a field updated with the ghosts
+const GPUArray<Scalar4>& Communicator::getUpdateFieldArray(unsigned int field)
+    {
+    switch (field)
+        {
+        case 0:
+            return m_pdata->getPositions();
+        case 1:
+            return m_pdata->getVelocities();
+        default:
+            return m_pdata->getOrientationArray();
+        }
+    }
+
+void Communicator::layoutUpdateBuffers()
+    {
+    unsigned int n_send_tot = 0;
+    unsigned int n_recv_tot = 0;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        for (unsigned int f = 0; f < 3; f++)
+            {
+            m_update_send_offs[3*dir+f] = n_send_tot;
+            m_update_recv_offs[3*dir+f] = n_recv_tot;
+            if (isCommunicating(dir) && f < m_num_update_fields)
+                {
+                n_send_tot += m_num_copy_ghosts[dir];
+                n_recv_tot += m_num_recv_ghosts[dir];
+                }
+            }
+
+    // the buffers only ever grow, and keep at least one element so that they can always be addressed
+    if (m_update_sendbuf.size() < n_send_tot + 1)
+        m_update_sendbuf.resize(n_send_tot + 1);
+    if (m_update_recvbuf.size() < n_recv_tot + 1)
+        m_update_recvbuf.resize(n_recv_tot + 1);
+    }
+
+/*! The requests for the ghosts that are local particles are stored first, those for the forwarded ghosts
+    after them. For every direction, the send and receive requests of all updated fields are contiguous,
+    so that they can be started with a single call to MPI_Startall().
+
+    \pre layoutUpdateBuffers() has been called with the current ghost lists
+ */
+void Communicator::initPersistentRequests()
+    {
+    freePersistentRequests();
+    m_persistent_reqs.assign(2*2*3*6, MPI_REQUEST_NULL);
+
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        if (! isCommunicating(dir) ) continue;
+
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+
+        unsigned int n_send_local = m_num_copy_ghosts[dir] - m_num_forward_ghosts[dir];
+        unsigned int n_recv_local = m_num_recv_ghosts[dir] - m_num_recv_forward_ghosts[dir];
+
+        for (unsigned int f = 0; f < m_num_update_fields; f++)
+            {
+            Scalar4 *sendbuf = &m_update_sendbuf.front() + m_update_send_offs[3*dir+f];
+            Scalar4 *recvbuf = &m_update_recvbuf.front() + m_update_recv_offs[3*dir+f];
+
+            // ghosts that are local particles
+            int tag = 1 + 6*dir + f;
+            MPI_Send_init(sendbuf, n_send_local*sizeof(Scalar4), MPI_BYTE, send_neighbor, tag, m_mpi_comm,
+                &m_persistent_reqs[2*(3*dir+f)]);
+            MPI_Recv_init(recvbuf, n_recv_local*sizeof(Scalar4), MPI_BYTE, recv_neighbor, tag, m_mpi_comm,
+                &m_persistent_reqs[2*(3*dir+f)+1]);
+
+            // forwarded ghosts
+            tag = 1 + 6*dir + 3 + f;
+            MPI_Send_init(sendbuf + n_send_local, m_num_forward_ghosts[dir]*sizeof(Scalar4), MPI_BYTE,
+                send_neighbor, tag, m_mpi_comm, &m_persistent_reqs[2*3*6 + 2*(3*dir+f)]);
+            MPI_Recv_init(recvbuf + n_recv_local, m_num_recv_forward_ghosts[dir]*sizeof(Scalar4), MPI_BYTE,
+                recv_neighbor, tag, m_mpi_comm, &m_persistent_reqs[2*3*6 + 2*(3*dir+f)+1]);
+            }
+        }
+    }
+
+void Communicator::freePersistentRequests()
+    {
+    for (unsigned int i = 0; i < m_persistent_reqs.size(); ++i)
+        if (m_persistent_reqs[i] != MPI_REQUEST_NULL)
+            MPI_Request_free(&m_persistent_reqs[i]);
+
+    m_persistent_reqs.clear();
+    }
+
 //! update positions of ghost particles
+/*! The data of all fields and directions is packed into a single send buffer, and all messages for ghosts
+    that are local particles are posted at once. They are received into a separate buffer, so that the particle
+    data arrays are not accessed by MPI while the communication is in flight.
+
+    In persistent mode (see setPersistentGhostUpdate()), the buffer layout and the requests are only set up again
+    after the ghost lists or the updated fields have changed, and are merely restarted otherwise.
+ */
 void Communicator::beginUpdateGhosts(unsigned int timestep)
     {
     // we have a current m_copy_ghosts liss which contain the indices of particles
@@ -1613,73 +1775,121 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
 
     m_exec_conf->msg->notice(7) << "Communicator: update ghosts" << std::endl;
 
-    // update data in these arrays
+    // only non-permanent fields (position, velocity, orientation) need to be considered here
+    // charge and diameter are not updated during a run
+    CommFlags flags = getFlags();
+    unsigned int fields[3];
+    unsigned int num_fields = 0;
+    if (flags[comm_flag::position]) fields[num_fields++] = 0;
+    if (flags[comm_flag::velocity]) fields[num_fields++] = 1;
+    if (flags[comm_flag::orientation]) fields[num_fields++] = 2;
+
+    bool fields_changed = (num_fields != m_num_update_fields) ||
+        ! std::equal(fields, fields + num_fields, m_update_fields);
+    std::copy(fields, fields + num_fields, m_update_fields);
+    m_num_update_fields = num_fields;
+
+    // the persistent requests remain valid as long as the ghost lists and the fields do not change
+    if (fields_changed)
+        freePersistentRequests();
+
+    if (! m_persistent_update || m_persistent_reqs.empty())
+        {
+        layoutUpdateBuffers();
+
+        if (m_persistent_update)
+            initPersistentRequests();
+        }
 
-    unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
         if (! isCommunicating(dir) ) continue;
 
-        CommFlags flags = getFlags();
+        unsigned int n_send_local = m_num_copy_ghosts[dir] - m_num_forward_ghosts[dir];
 
-        if (flags[comm_flag::position])
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+
+        for (unsigned int f = 0; f < m_num_update_fields; f++)
             {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_field(getUpdateFieldArray(m_update_fields[f]), access_location::host, access_mode::read);
 
-            // copy positions of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            // copy data of the local particles into the send buffer
+            Scalar4 *sendbuf = &m_update_sendbuf.front() + m_update_send_offs[3*dir+f];
+            for (unsigned int ghost_idx = 0; ghost_idx < n_send_local; ghost_idx++)
                 {
                 unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
-
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
-
-                // copy position into send buffer
-                h_pos_copybuf.data[ghost_idx] = h_pos.data[idx];
+                assert(idx < m_pdata->getN());
+                sendbuf[ghost_idx] = h_field.data[idx];
                 }
             }
+        }
 
-        if (flags[comm_flag::velocity])
-            {
-            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_velocity_copybuf(m_velocity_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    if (m_prof)
+        m_prof->push("MPI send/recv");
 
-            // copy velocity of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
-                {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+    if (! m_persistent_update)
+        m_reqs.assign(6*3*2, MPI_REQUEST_NULL);
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        if (! isCommunicating(dir) ) continue;
 
-                // copy velocityition into send buffer
-                h_velocity_copybuf.data[ghost_idx] = h_vel.data[idx];
-                }
+        if (m_persistent_update)
+            {
+            MPI_Startall(2*m_num_update_fields, &m_persistent_reqs[2*3*dir]);
+            continue;
             }
 
-        if (flags[comm_flag::orientation])
-            {
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::overwrite);
-            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
-            ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
-            // copy orientation of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
-                {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+        unsigned int n_send_local = m_num_copy_ghosts[dir] - m_num_forward_ghosts[dir];
+        unsigned int n_recv_local = m_num_recv_ghosts[dir] - m_num_recv_forward_ghosts[dir];
 
-                // copy orientation into send buffer
-                h_orientation_copybuf.data[ghost_idx] = h_orientation.data[idx];
-                }
+        for (unsigned int f = 0; f < m_num_update_fields; f++)
+            {
+            int tag = 1 + 6*dir + f;
+            MPI_Isend(&m_update_sendbuf.front() + m_update_send_offs[3*dir+f], n_send_local*sizeof(Scalar4), MPI_BYTE,
+                send_neighbor, tag, m_mpi_comm, &m_reqs[2*(3*dir+f)]);
+            MPI_Irecv(&m_update_recvbuf.front() + m_update_recv_offs[3*dir+f], n_recv_local*sizeof(Scalar4), MPI_BYTE,
+                recv_neighbor, tag, m_mpi_comm, &m_reqs[2*(3*dir+f)+1]);
             }
+        }
+
+    if (m_prof)
+        m_prof->pop();
 
+    m_comm_pending = true;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+//! Finish the update of the ghost particles
+/*! The directions are completed in order. Before the forwarded ghosts of a direction are sent, all previous
+    directions have been received, so the forwarded ghosts are current.
+ */
+void Communicator::finishUpdateGhosts(unsigned int timestep)
+    {
+    if (! m_comm_pending)
+        return;
+
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
+
+    unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
+
+    for (unsigned int dir = 0; dir < 6; dir ++)
+        {
+        if (! isCommunicating(dir) ) continue;
 
         unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
@@ -1690,91 +1900,304 @@ void Communicator::beginUpdateGhosts(unsigned int timestep)
         else
             recv_neighbor = m_decomposition->getNeighborRank(dir-1);
 
+        unsigned int n_send_local = m_num_copy_ghosts[dir] - m_num_forward_ghosts[dir];
+        unsigned int n_recv_local = m_num_recv_ghosts[dir] - m_num_recv_forward_ghosts[dir];
+
+        MPI_Request reqs[6];
+        MPI_Status status[6];
+        unsigned int nreq = 0;
+
+        if (m_num_forward_ghosts[dir] || m_num_recv_forward_ghosts[dir])
+            {
+            // copy the data of ghosts received in a previous direction into the send buffer
+                {
+                ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+                ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+                for (unsigned int f = 0; f < m_num_update_fields; f++)
+                    {
+                    ArrayHandle<Scalar4> h_field(getUpdateFieldArray(m_update_fields[f]), access_location::host, access_mode::read);
 
-        unsigned int start_idx;
+                    Scalar4 *sendbuf = &m_update_sendbuf.front() + m_update_send_offs[3*dir+f];
+                    for (unsigned int ghost_idx = n_send_local; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                        {
+                        unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                        assert(idx >= m_pdata->getN() && idx < m_pdata->getN() + num_tot_recv_ghosts);
+                        sendbuf[ghost_idx] = h_field.data[idx];
+                        }
+                    }
+                }
+
+            if (m_prof)
+                m_prof->push("MPI send/recv");
+
+            if (m_persistent_update)
+                {
+                MPI_Request *persistent_reqs = &m_persistent_reqs[2*3*6 + 2*3*dir];
+                MPI_Startall(2*m_num_update_fields, persistent_reqs);
+                MPI_Waitall(2*m_num_update_fields, persistent_reqs, status);
+                }
+            else
+                {
+                for (unsigned int f = 0; f < m_num_update_fields; f++)
+                    {
+                    int tag = 1 + 6*dir + 3 + f;
+                    MPI_Isend(&m_update_sendbuf.front() + m_update_send_offs[3*dir+f] + n_send_local,
+                        m_num_forward_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, tag, m_mpi_comm, &reqs[nreq++]);
+                    MPI_Irecv(&m_update_recvbuf.front() + m_update_recv_offs[3*dir+f] + n_recv_local,
+                        m_num_recv_forward_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, tag, m_mpi_comm, &reqs[nreq++]);
+                    }
+                MPI_Waitall(nreq, reqs, status);
+                }
+
+            if (m_prof)
+                m_prof->pop();
+            }
 
         if (m_prof)
             m_prof->push("MPI send/recv");
 
-        start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        // complete the messages of this direction posted in beginUpdateGhosts()
+        MPI_Status stats[6];
+        MPI_Request *dir_reqs = m_persistent_update ? &m_persistent_reqs[2*3*dir] : &m_reqs[2*3*dir];
+        MPI_Waitall(2*m_num_update_fields, dir_reqs, stats);
 
-        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+        if (m_prof)
+            m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*m_num_update_fields*sizeof(Scalar4));
 
-        size_t sz = 0;
-        // only non-permanent fields (position, velocity, orientation) need to be considered here
-        // charge and diameter are not updated during a run
-        if (flags[comm_flag::position])
+        // write the received data directly into the particle data arrays
+        unsigned int start_idx = m_pdata->getN() + num_tot_recv_ghosts;
+        for (unsigned int f = 0; f < m_num_update_fields; f++)
             {
-            MPI_Request reqs[2];
-            MPI_Status status[2];
+            ArrayHandle<Scalar4> h_field(getUpdateFieldArray(m_update_fields[f]), access_location::host, access_mode::readwrite);
 
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_pos_copybuf(m_pos_copybuf, access_location::host, access_mode::read);
+            const Scalar4 *recvbuf = &m_update_recvbuf.front() + m_update_recv_offs[3*dir+f];
+            std::copy(recvbuf, recvbuf + m_num_recv_ghosts[dir], h_field.data + start_idx);
 
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_pos_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 1, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_pos.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 1, m_mpi_comm, &reqs[1]);
-            MPI_Waitall(2, reqs, status);
+            // wrap particle positions
+            if (m_update_fields[f] == 0)
+                {
+                const BoxDim shifted_box = getShiftedBox();
+                for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
+                    {
+                    Scalar4& pos = h_field.data[idx];
 
-            sz += sizeof(Scalar4);
+                    // wrap particles received across a global boundary
+                    int3 img = make_int3(0,0,0);
+                    shifted_box.wrap(pos, img);
+                    }
+                }
             }
 
-        if (flags[comm_flag::velocity])
-            {
-            MPI_Request reqs[2];
-            MPI_Status status[2];
+        num_tot_recv_ghosts += m_num_recv_ghosts[dir];
+        } // end dir loop
 
-            ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_vel_copybuf(m_velocity_copybuf, access_location::host, access_mode::read);
+    m_comm_pending = false;
 
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_vel_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 2, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_vel.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 2, m_mpi_comm, &reqs[1]);
-            MPI_Waitall(2, reqs, status);
+    if (m_prof)
+        m_prof->pop();
+    }
 
-            sz += sizeof(Scalar4);
-            }
+/*! The ghosts are received in the order of the directions, and a ghost received in one direction may be forwarded in
+    a later one (e.g. the corner ghosts). The directions are therefore processed in reverse order: when the
+    contributions to the ghosts received in a direction are sent back, those from the ranks they have been forwarded
+    to have already been added.
+ */
+void Communicator::reduceGhostForces(const GPUArray<Scalar4>& force, const GPUArray<Scalar>& virial,
+    bool include_virial)
+    {
+    if (m_prof)
+        m_prof->push("comm_ghost_reduce");
 
-        if (flags[comm_flag::orientation])
-            {
-            MPI_Request reqs[2];
-            MPI_Status status[2];
+    m_exec_conf->msg->notice(7) << "Communicator: reduce ghost forces" << std::endl;
 
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_orientation_copybuf(m_orientation_copybuf, access_location::host, access_mode::read);
+    unsigned int ghost_begin[6];
+    getGhostBegin(ghost_begin);
+
+    // force and energy, followed by the six virial components
+    const unsigned int n_values = include_virial ? 10 : 4;
+    const unsigned int virial_pitch = virial.getPitch();
+
+    ArrayHandle<Scalar4> h_force(force, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_virial(virial, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    for (int dir = 5; dir >= 0; dir--)
+        {
+        if (! isCommunicating(dir) ) continue;
 
-            // exchange particle data, write directly to the particle data arrays
-            MPI_Isend(h_orientation_copybuf.data, m_num_copy_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, send_neighbor, 3, m_mpi_comm, &reqs[0]);
-            MPI_Irecv(h_orientation.data + start_idx, m_num_recv_ghosts[dir]*sizeof(Scalar4), MPI_BYTE, recv_neighbor, 3, m_mpi_comm, &reqs[1]);
-            MPI_Waitall(2, reqs, status);
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
 
-            sz += sizeof(Scalar4);
+        // we return the contributions to the ghosts received from recv_neighbor, and receive those to the
+        // particles we sent to send_neighbor
+        unsigned int n_send = m_num_recv_ghosts[dir];
+        unsigned int n_recv = m_num_copy_ghosts[dir];
+
+        // the buffers only ever grow, and keep at least one element so that they can always be addressed
+        if (m_reverse_sendbuf.size() < n_values*n_send + 1)
+            m_reverse_sendbuf.resize(n_values*n_send + 1);
+        if (m_reverse_recvbuf.size() < n_values*n_recv + 1)
+            m_reverse_recvbuf.resize(n_values*n_recv + 1);
+
+        for (unsigned int k = 0; k < n_send; k++)
+            {
+            unsigned int idx = ghost_begin[dir] + k;
+            Scalar *buf = &m_reverse_sendbuf[n_values*k];
+
+            Scalar4 f = h_force.data[idx];
+            buf[0] = f.x;
+            buf[1] = f.y;
+            buf[2] = f.z;
+            buf[3] = f.w;
+
+            if (include_virial)
+                for (unsigned int l = 0; l < 6; l++)
+                    buf[4+l] = h_virial.data[l*virial_pitch+idx];
             }
 
         if (m_prof)
-            m_prof->pop(0, (m_num_recv_ghosts[dir]+m_num_copy_ghosts[dir])*sz);
+            m_prof->push("MPI send/recv");
 
+        MPI_Request reqs[2];
+        MPI_Status status[2];
 
-        // wrap particle positions (only if copying positions)
-        if (flags[comm_flag::position])
+        MPI_Isend(&m_reverse_sendbuf.front(),
+            n_values*n_send*sizeof(Scalar),
+            MPI_BYTE,
+            recv_neighbor,
+            9,
+            m_mpi_comm,
+            &reqs[0]);
+        MPI_Irecv(&m_reverse_recvbuf.front(),
+            n_values*n_recv*sizeof(Scalar),
+            MPI_BYTE,
+            send_neighbor,
+            9,
+            m_mpi_comm,
+            &reqs[1]);
+        MPI_Waitall(2, reqs, status);
+
+        if (m_prof)
+            m_prof->pop();
+
+        // add the contributions to the particles we sent, which may themselves be ghosts that are forwarded
+        ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+
+        for (unsigned int k = 0; k < n_recv; k++)
             {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+            unsigned int idx = h_rtag.data[h_copy_ghosts.data[k]];
+            assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+            const Scalar *buf = &m_reverse_recvbuf[n_values*k];
+
+            Scalar4& f = h_force.data[idx];
+            f.x += buf[0];
+            f.y += buf[1];
+            f.z += buf[2];
+            f.w += buf[3];
+
+            if (include_virial)
+                for (unsigned int l = 0; l < 6; l++)
+                    h_virial.data[l*virial_pitch+idx] += buf[4+l];
+            }
+        } // end dir loop
 
-            const BoxDim shifted_box = getShiftedBox();
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
-                {
-                Scalar4& pos = h_pos.data[idx];
+    if (m_prof)
+        m_prof->pop();
+    }
 
-                // wrap particles received across a global boundary
-                int3 img = make_int3(0,0,0);
-                shifted_box.wrap(pos, img);
+void Communicator::updateGhostValues(const GPUArray<Scalar>& values)
+    {
+    if (m_prof)
+        m_prof->push("comm_ghost_values");
+
+    m_exec_conf->msg->notice(7) << "Communicator: update ghost values" << std::endl;
+
+    unsigned int ghost_begin[6];
+    getGhostBegin(ghost_begin);
+
+    ArrayHandle<Scalar> h_values(values, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        if (! isCommunicating(dir) ) continue;
+
+        unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
+
+        // we receive from the direction opposite to the one we send to
+        unsigned int recv_neighbor;
+        if (dir % 2 == 0)
+            recv_neighbor = m_decomposition->getNeighborRank(dir+1);
+        else
+            recv_neighbor = m_decomposition->getNeighborRank(dir-1);
+
+        // the buffer only ever grows, and keeps at least one element so that it can always be addressed
+        if (m_values_sendbuf.size() < m_num_copy_ghosts[dir] + 1)
+            m_values_sendbuf.resize(m_num_copy_ghosts[dir] + 1);
+
+            {
+            // the particles sent in this direction may be ghosts received in a previous one
+            ArrayHandle<unsigned int> h_copy_ghosts(m_copy_ghosts[dir], access_location::host, access_mode::read);
+            for (unsigned int k = 0; k < m_num_copy_ghosts[dir]; k++)
+                {
+                unsigned int idx = h_rtag.data[h_copy_ghosts.data[k]];
+                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+                m_values_sendbuf[k] = h_values.data[idx];
                 }
             }
 
-        } // end dir loop
+        if (m_prof)
+            m_prof->push("MPI send/recv");
+
+        MPI_Request reqs[2];
+        MPI_Status status[2];
+
+        MPI_Isend(&m_values_sendbuf.front(),
+            m_num_copy_ghosts[dir]*sizeof(Scalar),
+            MPI_BYTE,
+            send_neighbor,
+            10,
+            m_mpi_comm,
+            &reqs[0]);
+        MPI_Irecv(h_values.data + ghost_begin[dir],
+            m_num_recv_ghosts[dir]*sizeof(Scalar),
+            MPI_BYTE,
+            recv_neighbor,
+            10,
+            m_mpi_comm,
+            &reqs[1]);
+        MPI_Waitall(2, reqs, status);
 
         if (m_prof)
             m_prof->pop();
+        } // end dir loop
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param ghost_begin Array of six indices to hold the first ghost of every direction
+
+    The ghosts of every direction are stored contiguously after the local particles, in the order they have been
+    received in.
+ */
+void Communicator::getGhostBegin(unsigned int *ghost_begin)
+    {
+    unsigned int n_ghost_end = m_pdata->getN();
+    for (unsigned int dir = 0; dir < 6; dir++)
+        {
+        ghost_begin[dir] = n_ghost_end;
+        if (isCommunicating(dir))
+            n_ghost_end += m_num_recv_ghosts[dir];
+        }
+    assert(n_ghost_end == m_pdata->getN() + m_pdata->getNGhosts());
     }
 
 void Communicator::removeGhostParticleTags()
@@ -1795,28 +2218,28 @@ const BoxDim Communicator::getShiftedBox() const
     BoxDim shifted_box = m_pdata->getGlobalBox();
     Scalar3 f= make_scalar3(0.5,0.5,0.5);
 
-    Scalar3 shift = m_pdata->getBox().getNearestPlaneDistance()/
-        shifted_box.getNearestPlaneDistance()/2.0;
+    // center the shifted box on the local domain, which need not lie in the
+    // middle of its half of the global box if the domains are non-uniform
+    Scalar3 center = shifted_box.makeFraction(m_pdata->getBox().makeCoordinates(make_scalar3(0.5,0.5,0.5)));
 
     Scalar tol = 0.0001;
-    shift += tol*make_scalar3(1.0,1.0,1.0);
 
     for (unsigned int dir = 0; dir < 6; dir ++)
         {
         if (m_decomposition->isAtBoundary(dir) &&  isCommunicating(dir))
             {
             if (dir == face_east)
-                f.x += shift.x;
+                f.x = center.x + tol;
             else if (dir == face_west)
-                f.x -= shift.x;
+                f.x = center.x - tol;
             else if (dir == face_north)
-                f.y += shift.y;
+                f.y = center.y + tol;
             else if (dir == face_south)
-                f.y -= shift.y;
+                f.y = center.y - tol;
             else if (dir == face_up)
-                f.z += shift.z;
+                f.z = center.z + tol;
             else if (dir == face_down)
-                f.z -= shift.z;
+                f.z = center.z - tol;
             }
         }
     Scalar3 dx = shifted_box.makeCoordinates(f);
@@ -1847,6 +2270,7 @@ void export_Communicator()
     class_<Communicator, boost::shared_ptr<Communicator>, boost::noncopyable>("Communicator",
            init<boost::shared_ptr<SystemDefinition>,
                 boost::shared_ptr<DomainDecomposition> >())
+    .def("setPersistentGhostUpdate", &Communicator::setPersistentGhostUpdate)
     ;
     }
 #endif // ENABLE_MPI
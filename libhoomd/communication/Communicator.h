@@ -107,7 +107,8 @@ struct comm_flag
         charge,      //! Bit id in CommFlags for particle charge
         diameter,    //! Bit id in CommFlags for particle diameter
         velocity,    //! Bit id in CommFlags for particle velocity
-        orientation  //! Bit id in CommFlags for particle orientation
+        orientation, //! Bit id in CommFlags for particle orientation
+        body         //! Bit id in CommFlags for particle body id
         };
     };
 
@@ -293,6 +294,23 @@ class Communicator
             return m_local_compute_callbacks.connect(subscriber);
             }
 
+        //! Subscribe to list of call-backs for computation on particles that do not interact with ghosts
+        /*!
+         * In steps without particle migration, the subscribers are called while the non-blocking ghost update
+         * is in flight, i.e. after beginUpdateGhosts() and before finishUpdateGhosts(). Ghost particle data
+         * must not be accessed by the subscribers, but the neighbor list is guaranteed not to be rebuilt
+         * in this time step. The typical subscriber computes the forces on all particles that have no ghost
+         * neighbors, leaving the remaining particles for after the ghost update.
+         *
+         * \param subscriber The callback
+         * \returns a connection to this class
+         */
+        boost::signals2::connection addInteriorComputeCallback(
+            const boost::function<void (unsigned int timestep)>& subscriber)
+            {
+            return m_interior_compute_callbacks.connect(subscriber);
+            }
+
         //! Subscribe to list of *optional* call-backs for computation using ghost particles
         /*!
          * Subscribe to a list of call-backs that precompute quantities using information about ghost particles
@@ -331,6 +349,12 @@ class Communicator
             m_r_ghost = ghost_width;
             }
 
+        //! Return the width of the ghost layer
+        Scalar getGhostLayerWidth() const
+            {
+            return m_r_ghost;
+            }
+
         //! Set skin layer width
         /*! \param r_buff The width of the skin buffer
          */
@@ -347,6 +371,19 @@ class Communicator
             return m_r_buff;
             }
 
+        //! Enable or disable persistent requests for the ghost update
+        /*! With persistent communication, the messages of the ghost update are set up once after every ghost
+            exchange using MPI_Send_init() and MPI_Recv_init(), and are only started and completed in every
+            time step. Between neighbor list rebuilds, the ghost lists and message sizes do not change.
+
+            \param enable True if persistent requests should be used
+         */
+        void setPersistentGhostUpdate(bool enable)
+            {
+            freePersistentRequests();
+            m_persistent_update = enable;
+            }
+
         //! Get the ghost communication flags
         CommFlags getFlags() { return m_flags; }
 
@@ -384,6 +421,10 @@ class Communicator
          * additional computation or communication during the update substep. To complete
          * the communication, call finishUpdateGhosts()
          *
+         * Only the ghosts that are local particles of this rank are sent here. Ghosts that are forwarded
+         * (i.e. that have been received from another neighbor in a previous direction, like the corner
+         * ghosts) are sent in finishUpdateGhosts(), once they have arrived.
+         *
          * \param timestep The time step
          *
          * \pre The ghost exchange list has been constructed in a previous time step, using exchangeGhosts().
@@ -394,12 +435,43 @@ class Communicator
         /*! Finish ghost update
          *
          * \param timestep The time step
+         *
+         * \post The ghost particle data is current, and all messages posted by beginUpdateGhosts() have completed
          */
-        virtual void finishUpdateGhosts(unsigned int timestep)
-            {
-            // the base class implementation is currently empty
-            m_comm_pending = false;
-            }
+        virtual void finishUpdateGhosts(unsigned int timestep);
+
+        /*! Add the forces on ghost particles to the particles they are copies of (reverse communication)
+         *
+         * Force computes that apply Newton's third law across domain boundaries accumulate forces on ghost
+         * particles. This method sends these contributions back along the route of the last ghost exchange,
+         * in the opposite direction and order, and adds them to the owning ranks' particles. Forwarded ghosts
+         * pass their contributions on to their sender before it sends them back in turn.
+         *
+         * This is a collective call, all ranks have to call it at the same time.
+         *
+         * \param force Force and energy array, indexed by local and ghost particle
+         * \param virial Virial array, indexed by local and ghost particle
+         * \param include_virial If true, the per-particle virial is reduced along with the forces and energies
+         *
+         * \pre The ghost exchange lists are those of the last call to exchangeGhosts()
+         * \post The ghost contributions have been added to the local particles of their owners
+         */
+        void reduceGhostForces(const GPUArray<Scalar4>& force, const GPUArray<Scalar>& virial, bool include_virial);
+
+        /*! Copy a per-particle value of every particle to its ghosts on the neighboring ranks
+         *
+         * This is used for intermediate results of a force computation that are needed for the ghost particles,
+         * such as the derivative of the embedding function of EAM. The values are sent along the routes of the last
+         * ghost exchange, in the same order.
+         *
+         * This is a collective call, all ranks have to call it at the same time.
+         *
+         * \param values Per-particle values, indexed by local and ghost particle
+         *
+         * \pre The ghost exchange lists are those of the last call to exchangeGhosts()
+         * \post The ghost entries of \a values are those of the particles they are copies of
+         */
+        void updateGhostValues(const GPUArray<Scalar>& values);
 
         /*! This methods finds all the particles that are no longer inside the domain
          * boundaries and transfers them to neighboring processors.
@@ -558,12 +630,15 @@ class Communicator
         GPUVector<Scalar> m_diameter_copybuf;     //!< Buffer for particle diameters to be copied
         GPUVector<Scalar4> m_velocity_copybuf;    //!< Buffer for particle velocities to be copied
         GPUVector<Scalar4> m_orientation_copybuf; //!< Buffer for particle orientation to be copied
+        GPUVector<unsigned int> m_body_copybuf;   //!< Buffer for particle body ids to be copied
         GPUVector<unsigned int> m_plan_copybuf;  //!< Buffer for particle plans
         GPUVector<unsigned int> m_tag_copybuf;    //!< Buffer for particle tags
 
         GPUVector<unsigned int> m_copy_ghosts[6]; //!< Per-direction list of indices of particles to send as ghosts
         unsigned int m_num_copy_ghosts[6];       //!< Number of local particles that are sent to neighboring processors
         unsigned int m_num_recv_ghosts[6];       //!< Number of ghosts received per direction
+        unsigned int m_num_forward_ghosts[6];    //!< Number of ghosts sent per direction that are themselves ghosts
+        unsigned int m_num_recv_forward_ghosts[6]; //!< Number of forwarded ghosts received per direction
 
         BoxDim m_global_box;                     //!< Global simulation box
         Scalar m_r_ghost;                        //!< Width of ghost layer
@@ -580,6 +655,9 @@ class Communicator
         boost::signals2::signal<void (unsigned int timestep)>
             m_local_compute_callbacks;   //!< List of functions that can be overlapped with communication
 
+        boost::signals2::signal<void (unsigned int timestep)>
+            m_interior_compute_callbacks;   //!< List of functions that are overlapped with the ghost update
+
         boost::signals2::signal<void (unsigned int timestep)>
             m_compute_callbacks;   //!< List of functions that are called after ghost communication
 
@@ -647,6 +725,37 @@ class Communicator
         std::vector<pdata_element> m_sendbuf;  //!< Buffer for particles that are sent
         std::vector<pdata_element> m_recvbuf;  //!< Buffer for particles that are received
 
+        /* Non-blocking ghost update */
+        std::vector<Scalar4> m_update_sendbuf;   //!< Send buffer for the ghost update (all directions and fields)
+        std::vector<Scalar4> m_update_recvbuf;   //!< Receive buffer for the ghost update (all directions and fields)
+        unsigned int m_update_send_offs[6*3];    //!< Offset of every direction and field in the send buffer
+        unsigned int m_update_recv_offs[6*3];    //!< Offset of every direction and field in the receive buffer
+        unsigned int m_update_fields[3];         //!< Fields (0: position, 1: velocity, 2: orientation) that are updated
+        unsigned int m_num_update_fields;        //!< Number of fields that are updated
+
+        bool m_persistent_update;                //!< True if the ghost update uses persistent requests
+        std::vector<MPI_Request> m_persistent_reqs; //!< Persistent requests for local and forwarded ghosts
+
+        /* Reverse communication of ghost forces */
+        std::vector<Scalar> m_reverse_sendbuf;   //!< Send buffer for the ghost force reduction
+        std::vector<Scalar> m_reverse_recvbuf;   //!< Receive buffer for the ghost force reduction
+        std::vector<Scalar> m_values_sendbuf;    //!< Send buffer for the update of per-particle values
+
+        //! Get the index of the first ghost received in every direction
+        void getGhostBegin(unsigned int *ghost_begin);
+
+        //! Get the array of a field updated with the ghosts
+        const GPUArray<Scalar4>& getUpdateFieldArray(unsigned int field);
+
+        //! Compute the offsets of all directions and fields in the ghost update buffers, and grow the buffers
+        void layoutUpdateBuffers();
+
+        //! Set up the persistent requests for the ghost update
+        void initPersistentRequests();
+
+        //! Free the persistent requests, e.g. after the ghost lists have changed
+        void freePersistentRequests();
+
         /* Communication of bonded groups */
         GroupCommunicator<BondData> m_bond_comm;    //!< Communication helper for bonds
         friend class GroupCommunicator<BondData>;
@@ -64,6 +64,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/serialization/set.hpp>
 
+#include <algorithm>
+
 using namespace boost::python;
 
 //! Constructor
@@ -144,6 +146,17 @@ DomainDecomposition::DomainDecomposition(boost::shared_ptr<ExecutionConfiguratio
     // Initialize domain indexer
     m_index = Index3D(m_nx,m_ny,m_nz);
 
+    // the domains are initially of equal size
+    m_cumulative_frac_x.resize(m_nx+1);
+    m_cumulative_frac_y.resize(m_ny+1);
+    m_cumulative_frac_z.resize(m_nz+1);
+    for (unsigned int i = 0; i <= m_nx; i++)
+        m_cumulative_frac_x[i] = Scalar(i)/Scalar(m_nx);
+    for (unsigned int i = 0; i <= m_ny; i++)
+        m_cumulative_frac_y[i] = Scalar(i)/Scalar(m_ny);
+    for (unsigned int i = 0; i <= m_nz; i++)
+        m_cumulative_frac_z[i] = Scalar(i)/Scalar(m_nz);
+
     // map cartesian grid onto ranks
     GPUArray<unsigned int> cart_ranks(nranks, m_exec_conf);
     m_cart_ranks.swap(cart_ranks);
@@ -365,16 +378,17 @@ const BoxDim DomainDecomposition::calculateLocalBox(const BoxDim & global_box)
 
     // calculate the local box dimensions by sub-dividing the cartesian lattice
     Scalar3 L = global_box.getL();
-    Scalar3 L_local = L / make_scalar3(m_nx, m_ny, m_nz);
 
     // position of this domain in the grid
     Scalar3 lo_g = global_box.getLo();
     Scalar3 lo, hi;
-    lo.x = lo_g.x + (double)m_grid_pos.x * L_local.x;
-    lo.y = lo_g.y + (double)m_grid_pos.y * L_local.y;
-    lo.z = lo_g.z + (double)m_grid_pos.z * L_local.z;
+    lo.x = lo_g.x + m_cumulative_frac_x[m_grid_pos.x] * L.x;
+    lo.y = lo_g.y + m_cumulative_frac_y[m_grid_pos.y] * L.y;
+    lo.z = lo_g.z + m_cumulative_frac_z[m_grid_pos.z] * L.z;
 
-    hi = lo + L_local;
+    hi.x = lo_g.x + m_cumulative_frac_x[m_grid_pos.x+1] * L.x;
+    hi.y = lo_g.y + m_cumulative_frac_y[m_grid_pos.y+1] * L.y;
+    hi.z = lo_g.z + m_cumulative_frac_z[m_grid_pos.z+1] * L.z;
 
     // set periodic flags
     // we are periodic in a direction along which there is only one box
@@ -387,6 +401,44 @@ const BoxDim DomainDecomposition::calculateLocalBox(const BoxDim & global_box)
     return box;
     }
 
+/*! \param dir Direction (0: x, 1: y, 2: z)
+    \param cum_frac Cumulative fractions of the global box length at which the domains start, must be n+1 increasing
+           values from 0 to 1
+
+    All ranks must set identical values. The local box has to be recomputed afterwards (ParticleData::updateLocalBox()),
+    and the particles have to be migrated to their new domains.
+ */
+void DomainDecomposition::setCumulativeFractions(unsigned int dir, const std::vector<Scalar>& cum_frac)
+    {
+    assert(dir < 3);
+    std::vector<Scalar>& frac = (dir == 0) ? m_cumulative_frac_x : ((dir == 1) ? m_cumulative_frac_y : m_cumulative_frac_z);
+
+    bool valid = (cum_frac.size() == frac.size() && cum_frac.front() == Scalar(0.0) && cum_frac.back() == Scalar(1.0));
+    for (unsigned int i = 1; valid && i < cum_frac.size(); i++)
+        valid = cum_frac[i] > cum_frac[i-1];
+
+    if (!valid)
+        {
+        m_exec_conf->msg->error() << "comm: Invalid domain boundaries along direction " << dir << std::endl;
+        throw std::runtime_error("Error setting domain boundaries");
+        }
+
+    frac = cum_frac;
+    }
+
+//! Find the domain containing a fractional coordinate
+/*! \param cum_frac Cumulative fractions of the domain boundaries
+    \param f Fractional coordinate
+    \returns the index of the domain, coordinates outside [0,1) are mapped onto the first domain
+*/
+static unsigned int findDomain(const std::vector<Scalar>& cum_frac, Scalar f)
+    {
+    unsigned int n = cum_frac.size() - 1;
+    unsigned int i = std::upper_bound(cum_frac.begin(), cum_frac.end(), f) - cum_frac.begin();
+    if (i == 0 || i > n) return 0;
+    return i-1;
+    }
+
 unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box, Scalar3 pos)
     {
     // get fractional coordinates in the global box
@@ -403,14 +455,9 @@ unsigned int DomainDecomposition::placeParticle(const BoxDim& global_box, Scalar
         }
 
     // compute the box the particle should be placed into
-    unsigned ix = f.x*m_nx;
-    if (ix == m_nx) ix = 0;
-
-    unsigned iy = f.y*m_ny;
-    if (iy == m_ny) iy = 0;
-
-    unsigned iz = f.z*m_nz;
-    if (iz == m_nz) iz = 0;
+    unsigned ix = findDomain(m_cumulative_frac_x, f.x);
+    unsigned iy = findDomain(m_cumulative_frac_y, f.y);
+    unsigned iz = findDomain(m_cumulative_frac_z, f.z);
 
     ArrayHandle<unsigned int> h_cart_ranks(m_cart_ranks, access_location::host, access_mode::read);
     unsigned int rank = h_cart_ranks.data[m_index(ix, iy, iz)];
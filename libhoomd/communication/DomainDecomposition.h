@@ -63,6 +63,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "GPUArray.h"
 
 #include <set>
+#include <vector>
 
 /*! \ingroup communication
 */
@@ -78,6 +79,11 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *  such as to minimize surface area between domains, while utilizing all processors in the MPI communicator.
  *
  *  The initialization of the domain decomposition scheme is performed in the constructor.
+ *
+ *  The boundaries between the domains are planes of constant fractional coordinate in the global box. Along every
+ *  direction, they are stored as the cumulative fractions of the box length at which the domains start, and are
+ *  initially spaced uniformly. They can be shifted (e.g. by a LoadBalancer) with setCumulativeFractions(). Since
+ *  all boundaries along a direction are shared by the entire slab of domains, the processor grid stays cartesian.
  */
 class DomainDecomposition
     {
@@ -131,6 +137,21 @@ class DomainDecomposition
         //! Get the dimensions of the local simulation box
         const BoxDim calculateLocalBox(const BoxDim& global_box);
 
+        //! Get the cumulative fractions of the global box length at which the domains along a direction start
+        /*! \param dir Direction (0: x, 1: y, 2: z)
+         *  \returns a vector of n+1 values from 0 to 1, where n is the number of domains along \a dir
+         */
+        const std::vector<Scalar>& getCumulativeFractions(unsigned int dir) const
+            {
+            assert(dir < 3);
+            if (dir == 0) return m_cumulative_frac_x;
+            else if (dir == 1) return m_cumulative_frac_y;
+            else return m_cumulative_frac_z;
+            }
+
+        //! Set the cumulative fractions of the global box length at which the domains along a direction start
+        void setCumulativeFractions(unsigned int dir, const std::vector<Scalar>& cum_frac);
+
         //! Get the rank for a particle to be placed
         /*! \param pos Particle position
          * \returns the rank of the processor that should receive the particle
@@ -142,6 +163,10 @@ class DomainDecomposition
         unsigned int m_ny;           //!< Number of processors along the y-axis
         unsigned int m_nz;           //!< Number of processors along the z-axis
 
+        std::vector<Scalar> m_cumulative_frac_x; //!< Cumulative fractions of the box length of the domains along x
+        std::vector<Scalar> m_cumulative_frac_y; //!< Cumulative fractions of the box length of the domains along y
+        std::vector<Scalar> m_cumulative_frac_z; //!< Cumulative fractions of the box length of the domains along z
+
         uint3 m_grid_pos;            //!< Position of this domain in the grid
         Index3D m_index;             //!< Index to the 3D processor grid
         Index3D m_node_grid;         //!< Indexer of the grid of nodes
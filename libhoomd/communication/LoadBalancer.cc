@@ -0,0 +1,270 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: jglaser
+
+/*! \file LoadBalancer.cc
+    \brief Defines the LoadBalancer class
+*/
+
+#ifdef ENABLE_MPI
+#include "LoadBalancer.h"
+#include "Communicator.h"
+
+#include <boost/python.hpp>
+using namespace boost::python;
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+/*! \param sysdef System definition
+    \param decomposition Domain decomposition whose boundaries are adjusted
+*/
+LoadBalancer::LoadBalancer(boost::shared_ptr<SystemDefinition> sysdef,
+                           boost::shared_ptr<DomainDecomposition> decomposition)
+    : Updater(sysdef), m_decomposition(decomposition), m_tolerance(Scalar(1.05)), m_n_bins_per_slab(16)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LoadBalancer" << endl;
+
+    assert(m_decomposition);
+    m_enable[0] = m_enable[1] = m_enable[2] = true;
+    }
+
+LoadBalancer::~LoadBalancer()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LoadBalancer" << endl;
+    }
+
+/*! \param dir Direction (0: x, 1: y, 2: z)
+    \param n_bin Output, the number of particles in every bin along \a dir
+
+    Every slab of domains is subdivided into m_n_bins_per_slab bins of equal width.
+*/
+void LoadBalancer::countParticles(unsigned int dir, std::vector<unsigned int>& n_bin)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    uint3 grid_pos = m_decomposition->getGridPos();
+    unsigned int n_dir[3] = {di.getW(), di.getH(), di.getD()};
+    unsigned int pos[3] = {grid_pos.x, grid_pos.y, grid_pos.z};
+
+    const std::vector<Scalar>& frac = m_decomposition->getCumulativeFractions(dir);
+    Scalar lo = frac[pos[dir]];
+    Scalar width = frac[pos[dir]+1] - lo;
+
+    n_bin.assign(n_dir[dir]*m_n_bins_per_slab, 0);
+    unsigned int *n_local = &n_bin[pos[dir]*m_n_bins_per_slab];
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        Scalar4 postype = h_pos.data[i];
+        Scalar3 f = global_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+        Scalar f_dir = (dir == 0) ? f.x : ((dir == 1) ? f.y : f.z);
+
+        // particles that have left the domain since the last migration are counted in the outermost bins
+        int bin = int((f_dir - lo)/width*Scalar(m_n_bins_per_slab));
+        bin = std::max(0, std::min(int(m_n_bins_per_slab)-1, bin));
+        n_local[bin]++;
+        }
+
+    MPI_Allreduce(MPI_IN_PLACE, &n_bin.front(), n_bin.size(), MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+    }
+
+/*! \param dir Direction (0: x, 1: y, 2: z)
+    \param n_bin Number of particles in every bin along \a dir
+    \param cum_frac Output, the new cumulative fractions of the domain boundaries
+    \returns true if the boundaries have been changed
+
+    The cumulative number of particles as a function of the fractional coordinate is interpolated linearly between
+    the bin edges, and inverted to find the boundaries that divide the particles evenly.
+*/
+bool LoadBalancer::adjustBoundaries(unsigned int dir, const std::vector<unsigned int>& n_bin,
+                                    std::vector<Scalar>& cum_frac)
+    {
+    const std::vector<Scalar>& old_frac = m_decomposition->getCumulativeFractions(dir);
+    unsigned int n = old_frac.size() - 1;
+    unsigned int n_bins = n_bin.size();
+    assert(n_bins == n*m_n_bins_per_slab);
+
+    unsigned int n_total = 0;
+    unsigned int n_max = 0;
+    for (unsigned int i = 0; i < n; i++)
+        {
+        unsigned int n_slab = 0;
+        for (unsigned int j = 0; j < m_n_bins_per_slab; j++)
+            n_slab += n_bin[i*m_n_bins_per_slab + j];
+        n_total += n_slab;
+        n_max = std::max(n_max, n_slab);
+        }
+
+    // nothing to do if the slabs are balanced within the tolerance
+    if (n_total == 0 || Scalar(n_max) <= m_tolerance*Scalar(n_total)/Scalar(n))
+        return false;
+
+    // the slabs must remain wide enough for the ghost layer
+    Scalar min_frac(0.0);
+    if (m_comm)
+        {
+        Scalar3 L = m_pdata->getGlobalBox().getNearestPlaneDistance();
+        Scalar L_dir = (dir == 0) ? L.x : ((dir == 1) ? L.y : L.z);
+        min_frac = Scalar(2.2)*m_comm->getGhostLayerWidth()/L_dir;
+        }
+
+    cum_frac = old_frac;
+    unsigned int bin = 0;
+    Scalar n_below(0.0);
+    for (unsigned int k = 1; k < n; k++)
+        {
+        Scalar target = Scalar(k)*Scalar(n_total)/Scalar(n);
+        while (bin < n_bins-1 && n_below + Scalar(n_bin[bin]) < target)
+            n_below += Scalar(n_bin[bin++]);
+
+        Scalar f(0.5);
+        if (n_bin[bin] > 0)
+            f = std::min(Scalar(1.0), std::max(Scalar(0.0), (target - n_below)/Scalar(n_bin[bin])));
+
+        unsigned int slab = bin / m_n_bins_per_slab;
+        Scalar bin_width = (old_frac[slab+1] - old_frac[slab])/Scalar(m_n_bins_per_slab);
+        Scalar b = old_frac[slab] + (Scalar(bin % m_n_bins_per_slab) + f)*bin_width;
+
+        // particles may only move to neighboring domains
+        Scalar lo = old_frac[k] - (old_frac[k] - old_frac[k-1])/Scalar(3.0);
+        Scalar hi = old_frac[k] + (old_frac[k+1] - old_frac[k])/Scalar(3.0);
+        cum_frac[k] = std::min(hi, std::max(lo, b));
+        }
+
+    for (unsigned int k = 1; k < n; k++)
+        cum_frac[k] = std::max(cum_frac[k], cum_frac[k-1] + min_frac);
+    for (unsigned int k = n-1; k > 0; k--)
+        cum_frac[k] = std::min(cum_frac[k], cum_frac[k+1] - min_frac);
+
+    return !std::equal(cum_frac.begin(), cum_frac.end(), old_frac.begin());
+    }
+
+/*! \returns the ratio of the maximum number of particles on any rank to the average number of particles per rank
+*/
+Scalar LoadBalancer::getImbalance()
+    {
+    unsigned int n_max = m_pdata->getN();
+    MPI_Allreduce(MPI_IN_PLACE, &n_max, 1, MPI_UNSIGNED, MPI_MAX, m_exec_conf->getMPICommunicator());
+
+    Scalar n_avg = Scalar(m_pdata->getNGlobal())/Scalar(m_exec_conf->getNRanks());
+    return n_avg > Scalar(0.0) ? Scalar(n_max)/n_avg : Scalar(1.0);
+    }
+
+/*! \param timestep Current time step of the simulation
+*/
+void LoadBalancer::update(unsigned int timestep)
+    {
+    if (m_prof) m_prof->push("Balance");
+
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    unsigned int n_dir[3] = {di.getW(), di.getH(), di.getD()};
+
+    bool changed = false;
+    std::vector<unsigned int> n_bin;
+    std::vector<Scalar> cum_frac;
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        if (!m_enable[dir] || n_dir[dir] == 1)
+            continue;
+
+        countParticles(dir, n_bin);
+        if (adjustBoundaries(dir, n_bin, cum_frac))
+            {
+            m_decomposition->setCumulativeFractions(dir, cum_frac);
+            changed = true;
+            }
+        }
+
+    if (changed)
+        {
+        m_exec_conf->msg->notice(6) << "LoadBalancer: adjusted domain boundaries at timestep " << timestep << endl;
+
+        // move the particles to their new domains in the next communication step
+        m_pdata->updateLocalBox();
+        if (m_comm)
+            m_comm->forceMigrate();
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+std::vector< std::string > LoadBalancer::getProvidedLogQuantities()
+    {
+    std::vector< std::string > list;
+    list.push_back("load_imbalance");
+    return list;
+    }
+
+/*! \param quantity Name of the log quantity to get
+    \param timestep Current time step of the simulation
+*/
+Scalar LoadBalancer::getLogValue(const std::string& quantity, unsigned int timestep)
+    {
+    if (quantity == "load_imbalance")
+        return getImbalance();
+
+    m_exec_conf->msg->error() << "update.balance: " << quantity << " is not a valid log quantity" << endl;
+    throw runtime_error("Error getting log value");
+    }
+
+void export_LoadBalancer()
+    {
+    class_<LoadBalancer, boost::shared_ptr<LoadBalancer>, bases<Updater>, boost::noncopyable>
+    ("LoadBalancer", init< boost::shared_ptr<SystemDefinition>, boost::shared_ptr<DomainDecomposition> >())
+    .def("setTolerance", &LoadBalancer::setTolerance)
+    .def("enableDirection", &LoadBalancer::enableDirection)
+    .def("getImbalance", &LoadBalancer::getImbalance)
+    ;
+    }
+#endif // ENABLE_MPI
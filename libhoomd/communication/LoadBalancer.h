@@ -0,0 +1,148 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: jglaser
+
+/*! \file LoadBalancer.h
+    \brief Declares an updater that adjusts the domain boundaries to balance the number of particles per rank
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifdef ENABLE_MPI
+
+#ifndef __LOADBALANCER_H__
+#define __LOADBALANCER_H__
+
+#include "Updater.h"
+#include "DomainDecomposition.h"
+
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+//! Shifts the boundaries of the domain decomposition so that every rank holds a similar number of particles
+/*! In systems with density gradients (droplets, interfaces, sedimentation), a uniform domain decomposition leaves
+    some ranks with many more particles than others. The LoadBalancer periodically measures the number of particles
+    in every slab of domains along each direction and moves the boundaries between the slabs, so that the slabs
+    hold equal numbers of particles. To locate the new boundaries, every slab is subdivided into a number of bins,
+    and the density inside each bin is assumed to be uniform.
+
+    All ranks perform the same computation on the globally reduced particle counts, so the new boundaries are
+    identical on every rank. To guarantee that the particles only need to be sent to direct neighbors by
+    Communicator::migrateParticles(), a boundary is never moved by more than a third of the width of the adjacent slabs.
+    Several updates may therefore be necessary to balance a strongly inhomogeneous system. Slabs are kept at least
+    twice as wide as the ghost layer.
+
+    After the boundaries have changed, the local box is recomputed and particle migration is requested from the
+    Communicator, which then happens as part of the next communication step.
+
+    \ingroup updaters
+*/
+class LoadBalancer : public Updater
+    {
+    public:
+        //! Constructor
+        LoadBalancer(boost::shared_ptr<SystemDefinition> sysdef,
+                     boost::shared_ptr<DomainDecomposition> decomposition);
+
+        //! Destructor
+        virtual ~LoadBalancer();
+
+        //! Set the maximum tolerated imbalance
+        /*! \param tolerance Boundaries along a direction are only adjusted if the maximum number of particles in a
+                slab exceeds the average by more than this factor
+        */
+        void setTolerance(Scalar tolerance)
+            {
+            m_tolerance = tolerance;
+            }
+
+        //! Enable or disable balancing along a direction
+        /*! \param dir Direction (0: x, 1: y, 2: z)
+            \param enable True if the boundaries along \a dir may be adjusted
+        */
+        void enableDirection(unsigned int dir, bool enable)
+            {
+            assert(dir < 3);
+            m_enable[dir] = enable;
+            }
+
+        //! Get the current imbalance
+        Scalar getImbalance();
+
+        //! Take one timestep forward
+        virtual void update(unsigned int timestep);
+
+        //! Returns a list of log quantities this updater calculates
+        virtual std::vector< std::string > getProvidedLogQuantities();
+
+        //! Calculates the requested log value and returns it
+        virtual Scalar getLogValue(const std::string& quantity, unsigned int timestep);
+
+    private:
+        boost::shared_ptr<DomainDecomposition> m_decomposition; //!< The domain decomposition to adjust
+        Scalar m_tolerance;             //!< Maximum tolerated ratio of maximum to average number of particles
+        bool m_enable[3];               //!< True if balancing is enabled along x, y and z
+        unsigned int m_n_bins_per_slab; //!< Number of histogram bins per slab of domains
+
+        //! Histogram the particles along a direction
+        void countParticles(unsigned int dir, std::vector<unsigned int>& n_bin);
+
+        //! Compute new domain boundaries along one direction
+        bool adjustBoundaries(unsigned int dir, const std::vector<unsigned int>& n_bin,
+                              std::vector<Scalar>& cum_frac);
+    };
+
+//! Exports the LoadBalancer class to python
+void export_LoadBalancer();
+
+#endif // __LOADBALANCER_H__
+#endif // ENABLE_MPI
@@ -203,7 +203,6 @@ void BondTablePotential::computeForces(unsigned int timestep)
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::overwrite);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
@@ -222,29 +221,18 @@ void BondTablePotential::computeForces(unsigned int timestep)
     ArrayHandle<Scalar2> h_tables(m_tables, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_params(m_params, access_location::host, access_mode::read);
 
+    // access the bond table, with the members already resolved to particle indices
+    ArrayHandle<BondData::members_t> h_bonds(m_bond_data->getIndexTable(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_type(m_bond_data->getIndexTableTypes(), access_location::host, access_mode::read);
+
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
     for (unsigned int i = 0; i < size; i++)
         {
-        // lookup the tag of each of the particles participating in the bond
-        const BondData::members_t bond = m_bond_data->getMembersByIndex(i);
-        assert(bond.tag[0] < m_pdata->getN());
-        assert(bond.tag[1] < m_pdata->getN());
-
-        // transform a and b into indicies into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-        assert(idx_a <= m_pdata->getMaximumTag());
-        assert(idx_b <= m_pdata->getMaximumTag());
-
-        // throw an error if this bond is incomplete
-        if (idx_a == NOT_LOCAL || idx_b == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "bond.table: bond " <<
-                bond.tag[0] << " " << bond.tag[1] << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
+        // the particle indices of the bond members (MEM TRANSFER: 2 ints)
+        const BondData::members_t& bond = h_bonds.data[i];
+        unsigned int idx_a = bond.idx[0];
+        unsigned int idx_b = bond.idx[1];
         assert(idx_a <= m_pdata->getN() + m_pdata->getNGhosts());
         assert(idx_b <= m_pdata->getN() + m_pdata->getNGhosts());
 
@@ -257,7 +245,7 @@ void BondTablePotential::computeForces(unsigned int timestep)
         dx = box.minImage(dx);
 
         // access needed parameters
-        unsigned int type = m_bond_data->getTypeByIndex(i);
+        unsigned int type = h_type.data[i];
         Scalar4 params = h_params.data[type];
         Scalar rmin = params.x;
         Scalar rmax = params.y;
@@ -226,7 +226,6 @@ void CGCMMAngleForceCompute::computeForces(unsigned int timestep)
 
     assert(m_pdata);
     // access the particle data arrays
-    ArrayHandle< unsigned int > h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle< Scalar4 > h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
@@ -241,7 +240,6 @@ void CGCMMAngleForceCompute::computeForces(unsigned int timestep)
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
-    assert(h_rtag.data);
 
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
@@ -252,30 +250,20 @@ void CGCMMAngleForceCompute::computeForces(unsigned int timestep)
 
     Scalar eac;
     Scalar vac[6];
+
+    // access the angle table, with the members already resolved to particle indices
+    ArrayHandle<AngleData::members_t> h_angles(m_CGCMMAngle_data->getIndexTable(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_type(m_CGCMMAngle_data->getIndexTableTypes(), access_location::host, access_mode::read);
+
     // for each of the angles
     const unsigned int size = (unsigned int)m_CGCMMAngle_data->getN();
     for (unsigned int i = 0; i < size; i++)
         {
-        // lookup the tag of each of the particles participating in the angle
-        const AngleData::members_t& angle = m_CGCMMAngle_data->getMembersByIndex(i);
-        assert(angle.tag[0] <= m_pdata->getMaximumTag());
-        assert(angle.tag[1] <= m_pdata->getMaximumTag());
-        assert(angle.tag[1] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indicies into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[angle.tag[0]];
-        unsigned int idx_b = h_rtag.data[angle.tag[1]];
-        unsigned int idx_c = h_rtag.data[angle.tag[2]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "angle.harmonic: angle " <<
-                angle.tag[0] << " " << angle.tag[1] << " " << angle.tag[2] << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in angle calculation");
-            }
-
+        // the particle indices of the angle members (MEM TRANSFER: 3 ints)
+        const AngleData::members_t& angle = h_angles.data[i];
+        unsigned int idx_a = angle.idx[0];
+        unsigned int idx_b = angle.idx[1];
+        unsigned int idx_c = angle.idx[2];
         assert(idx_a < m_pdata->getN()+m_pdata->getNGhosts());
         assert(idx_b < m_pdata->getN()+m_pdata->getNGhosts());
         assert(idx_c < m_pdata->getN()+m_pdata->getNGhosts());
@@ -331,7 +319,7 @@ void CGCMMAngleForceCompute::computeForces(unsigned int timestep)
         for (int k = 0; k < 6; k++)
             vac[k] = Scalar(0.0);
 
-        unsigned int angle_type = m_CGCMMAngle_data->getTypeByIndex(i);
+        unsigned int angle_type = h_type.data[i];
         if (rac < m_rcut[angle_type])
             {
             const unsigned int cg_type = m_cg_type[angle_type];
@@ -274,7 +274,8 @@ void CGCMMForceCompute::computeForces(unsigned int timestep)
     // access the neighbor list
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
-    Index2D nli = m_nlist->getNListIndexer();
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+    const unsigned int nlist_stride = m_nlist->getNListStride();
 
     // access the particle data
     ArrayHandle< Scalar4 > h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -314,13 +315,14 @@ void CGCMMForceCompute::computeForces(unsigned int timestep)
 
         // loop over all of the neighbors of this particle
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        const unsigned int head_i = h_head_list.data[i];
         for (unsigned int j = 0; j < size; j++)
             {
             // increment our calculation counter
             n_calc++;
 
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int k = h_nlist.data[nli(i, j)];
+            unsigned int k = h_nlist.data[head_i + j*nlist_stride];
             // sanity check
             assert(k < m_pdata->getN());
 
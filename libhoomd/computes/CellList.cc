@@ -59,6 +59,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellList.h"
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace boost;
 using namespace boost::python;
 using namespace std;
@@ -467,6 +471,13 @@ void CellList::initializeCellAdj()
         m_prof->pop();
     }
 
+/*! The particles are binned in two passes so that several threads can fill the cell list without atomic operations.
+    Each thread owns a contiguous range of particles. In the first pass, every thread computes the bin of each of its
+    particles and counts how many of them fall into each cell. An exclusive prefix sum over the thread counts of each
+    cell then gives every thread its starting offset within the cell, and the second pass writes the particles to
+    their slots. Because the ranges are ordered by particle index, the resulting cell list is identical to a serial
+    build, independent of the number of threads.
+*/
 void CellList::computeCellList()
     {
     if (m_prof)
@@ -492,27 +503,50 @@ void CellList::computeCellList()
     Index3D ci = m_cell_indexer;
     Index2D cli = m_cell_list_indexer;
 
-    // clear the bin sizes to 0
-    memset(h_cell_size.data, 0, sizeof(unsigned int) * m_cell_indexer.getNumElements());
-
     Scalar3 ghost_width = getGhostWidth();
 
     // get periodic flags
     uchar3 periodic = box.getPeriodic();
 
     // for each particle
-    unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
+    unsigned int n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
+    unsigned int n_local = m_pdata->getN();
+    unsigned int n_cells = ci.getNumElements();
+
+    // allocate the scratch space for the bin of every particle and the per-thread cell counts
+    unsigned int n_threads = m_exec_conf->n_cpu;
+    if (m_bin_idx.size() < n_tot_particles)
+        m_bin_idx.resize(n_tot_particles);
+    if (m_thread_cell_count.size() < n_threads*n_cells)
+        m_thread_cell_count.resize(n_threads*n_cells);
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+    unsigned int tid = 0;
+    #ifdef ENABLE_OPENMP
+    tid = omp_get_thread_num();
+    #endif
+
+    // contiguous range of particles handled by this thread
+    unsigned int n_start = (unsigned int)((unsigned long long)tid*n_tot_particles/n_threads);
+    unsigned int n_end = (unsigned int)((unsigned long long)(tid+1)*n_tot_particles/n_threads);
+
+    unsigned int *cell_count = &m_thread_cell_count[tid*n_cells];
+    memset(cell_count, 0, sizeof(unsigned int)*n_cells);
+    uint3 thread_conditions = make_uint3(0,0,0);
 
-    for (unsigned int n = 0; n < n_tot_particles; n++)
+    // first pass: find the bin each particle belongs in and count the members of each cell
+    for (unsigned int n = n_start; n < n_end; n++)
         {
+        m_bin_idx[n] = NOT_BINNED;
+
         Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
         if (isnan(p.x) || isnan(p.y) || isnan(p.z))
             {
-            conditions.y = n+1;
+            thread_conditions.y = n+1;
             continue;
             }
 
-
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(p,ghost_width);
         int ib = (int)(f.x * m_dim.x);
@@ -525,8 +559,8 @@ void CellList::computeCellList()
             (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)) )
             {
             // if a ghost particle is out of bounds, silently ignore it
-            if (n < m_pdata->getN())
-                conditions.z = n+1;
+            if (n < n_local)
+                thread_conditions.z = n+1;
             continue;
             }
 
@@ -539,20 +573,48 @@ void CellList::computeCellList()
             kb = 0;
 
         // sanity check
-        assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=m_pdata->getN());
-
-        // record its bin
-        unsigned int bin = ci(ib, jb, kb);
+        assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z)) || n>=n_local);
 
         // all particles should be in a valid cell
         if (ib >= (int)m_dim.x || jb >= (int)m_dim.y || kb >= (int)m_dim.z)
             {
             // but ghost particles that are out of range should not produce an error
-            if (n < m_pdata->getN())
-                conditions.z = n+1;
+            if (n < n_local)
+                thread_conditions.z = n+1;
             continue;
             }
 
+        // record its bin
+        unsigned int bin = ci(ib, jb, kb);
+        m_bin_idx[n] = bin;
+        cell_count[bin]++;
+        }
+
+    #pragma omp barrier
+
+    // turn the per-thread counts into per-thread starting offsets in each cell and total the cell sizes
+    #pragma omp for schedule(static)
+    for (int bin = 0; bin < (int)n_cells; bin++)
+        {
+        unsigned int offset = 0;
+        for (unsigned int t = 0; t < n_threads; t++)
+            {
+            unsigned int count = m_thread_cell_count[t*n_cells+bin];
+            m_thread_cell_count[t*n_cells+bin] = offset;
+            offset += count;
+            }
+        h_cell_size.data[bin] = offset;
+        }
+
+    // (implicit barrier at the end of the omp for)
+
+    // second pass: write the particles into their slots
+    for (unsigned int n = n_start; n < n_end; n++)
+        {
+        unsigned int bin = m_bin_idx[n];
+        if (bin == NOT_BINNED)
+            continue;
+
         // setup the flag value to store
         Scalar flag;
         if (m_flag_charge)
@@ -563,7 +625,7 @@ void CellList::computeCellList()
             flag = __int_as_scalar(n);
 
         // store the bin entries
-        unsigned int offset = h_cell_size.data[bin];
+        unsigned int offset = cell_count[bin]++;
 
         if (offset < m_Nmax)
             {
@@ -588,12 +650,18 @@ void CellList::computeCellList()
             }
         else
             {
-            conditions.x = max(conditions.x, offset+1);
+            thread_conditions.x = max(thread_conditions.x, offset+1);
             }
+        }
 
-        // increment the cell occupancy counter
-        h_cell_size.data[bin]++;
+    // combine the conditions of all threads
+    #pragma omp critical
+        {
+        conditions.x = max(conditions.x, thread_conditions.x);
+        conditions.y = max(conditions.y, thread_conditions.y);
+        conditions.z = max(conditions.z, thread_conditions.z);
         }
+    } // end omp parallel
 
     // write out conditions
     m_conditions.resetFlags(conditions);
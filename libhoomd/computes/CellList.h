@@ -51,6 +51,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/shared_ptr.hpp>
 #include <boost/signals2.hpp>
+#include <vector>
 #include "GPUArray.h"
 #include "GPUFlags.h"
 
@@ -372,6 +373,12 @@ class CellList : public Compute
         GPUArray<Scalar4> m_orientation;     //!< Cell list with orientation
         GPUArray<unsigned int> m_idx;        //!< Cell list with index
         GPUFlags<uint3> m_conditions;        //!< Condition flags set during the computeCellList() call
+
+        std::vector<unsigned int> m_bin_idx;            //!< Scratch space: cell of each particle (CPU build)
+        std::vector<unsigned int> m_thread_cell_count;  //!< Scratch space: per-thread cell counts/offsets (CPU build)
+
+        //! Marks a particle in m_bin_idx that is not placed in any cell
+        static const unsigned int NOT_BINNED = 0xffffffff;
         boost::signals2::connection m_sort_connection;        //!< Connection to the ParticleData sort signal
         boost::signals2::connection m_boxchange_connection;   //!< Connection to the ParticleData box size change signal
 
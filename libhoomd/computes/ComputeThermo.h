@@ -137,7 +137,7 @@ class ComputeThermo : public Compute
             {
             // return NaN if the flags are not valid
             PDataFlags flags = m_pdata->getFlags();
-            if (flags[pdata_flag::isotropic_virial])
+            if (flags[pdata_flag::isotropic_virial] && isVirialValid())
                 {
                 // return the pressure
                 #ifdef ENABLE_MPI
@@ -197,7 +197,7 @@ class ComputeThermo : public Compute
             // return tensor of NaN's if flags are not valid
             PDataFlags flags = m_pdata->getFlags();
             PressureTensor p;
-            if (flags[pdata_flag::pressure_tensor])
+            if (flags[pdata_flag::pressure_tensor] && isVirialValid())
                 {
                 #ifdef ENABLE_MPI
                 if (!m_properties_reduced) reduceProperties();
@@ -249,6 +249,15 @@ class ComputeThermo : public Compute
         //! Does the actual computation
         virtual void computeProperties();
 
+        //! Test if the virial of the group is known
+        /*! In reduced virial mode (ParticleData::setReducedVirial()), part of the virial is only available summed over all
+            particles, so the pressure of a subset of the particles can not be computed.
+        */
+        bool isVirialValid()
+            {
+            return !m_pdata->getReducedVirial() || m_group->getNumMembersGlobal() == m_pdata->getNGlobal();
+            }
+
         #ifdef ENABLE_MPI
         bool m_properties_reduced;      //!< True if properties have been reduced across MPI
 
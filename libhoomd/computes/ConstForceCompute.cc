@@ -76,6 +76,9 @@ ConstForceCompute::ConstForceCompute(boost::shared_ptr<SystemDefinition> sysdef,
     {
     m_exec_conf->msg->notice(5) << "Constructing ConstForceCompute" << endl;
 
+    // the forces are set once and kept in m_force
+    m_accumulate_supported = false;
+
     setForce(fx,fy,fz);
     }
 
@@ -91,6 +94,9 @@ ConstForceCompute::ConstForceCompute(boost::shared_ptr<SystemDefinition> sysdef,
     {
     m_exec_conf->msg->notice(5) << "Constructing ConstForceCompute" << endl;
 
+    // the forces are set once and kept in m_force
+    m_accumulate_supported = false;
+
     setGroupForce(group,fx,fy,fz);
     }
 
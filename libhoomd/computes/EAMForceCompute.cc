@@ -64,6 +64,10 @@ using namespace boost::python;
 #include "EAMForceCompute.h"
 #include <stdexcept>
 
+#ifdef ENABLE_MPI
+#include "Communicator.h"
+#endif
+
 /*! \file EAMForceCompute.cc
     \brief Defines the EAMForceCompute class
 */
@@ -87,6 +91,10 @@ EAMForceCompute::EAMForceCompute(boost::shared_ptr<SystemDefinition> sysdef, cha
     assert(m_pdata);
 
     loadFile(filename, type_of_file);
+
+    GPUArray<Scalar> atom_derivative_embedding(m_pdata->getMaxN(), m_exec_conf);
+    m_atom_derivative_embedding.swap(atom_derivative_embedding);
+
     // initialize the number of types value
     m_ntypes = m_pdata->getNTypes();
     assert(m_ntypes > 0);
@@ -335,7 +343,8 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     assert(m_nlist);
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
-    Index2D nli = m_nlist->getNListIndexer();
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+    const unsigned int nlist_stride = m_nlist->getNListStride();
 
     // access the particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -361,84 +370,103 @@ void EAMForceCompute::computeForces(unsigned int timestep)
     // tally up the number of forces calculated
     int64_t n_calc = 0;
 
+    // in MPI simulations, the neighbors may be ghost particles
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_ghosts = m_pdata->getNGhosts();
+    if (m_atom_derivative_embedding.getNumElements() < N + n_ghosts)
+        m_atom_derivative_embedding.resize(m_pdata->getMaxN());
 
-    // for each particle
-    vector<Scalar> atomElectronDensity;
-    atomElectronDensity.resize(m_pdata->getN());
-    vector<Scalar> atomDerivativeEmbeddingFunction;
-    atomDerivativeEmbeddingFunction.resize(m_pdata->getN());
-    vector<Scalar> atomEmbeddingFunction;
-    atomEmbeddingFunction.resize(m_pdata->getN());
     unsigned int ntypes = m_pdata->getNTypes();
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-
-        // sanity check
-        assert(typei < m_pdata->getNTypes());
 
-        // loop over all of the neighbors of this particle
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
-
-        for (unsigned int j = 0; j < size; j++)
+        {
+        // the electron densities are only computed for the local particles
+        vector<Scalar> atomElectronDensity;
+        atomElectronDensity.resize(N);
+        ArrayHandle<Scalar> h_atom_derivative_embedding(m_atom_derivative_embedding, access_location::host,
+            access_mode::overwrite);
+
+        // for each particle
+        for (unsigned int i = 0; i < N; i++)
             {
-            // increment our calculation counter
-            n_calc++;
+            // access the particle's position and type (MEM TRANSFER: 4 scalars)
+            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
 
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int k = h_nlist.data[nli(i, j)];
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(typei < m_pdata->getNTypes());
 
-            // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+            // loop over all of the neighbors of this particle
+            const unsigned int size = (unsigned int)h_n_neigh.data[i];
+            const unsigned int head_i = h_head_list.data[i];
 
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
-            // sanity check
-            assert(typej < m_pdata->getNTypes());
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // start computing the force
-            // calculate r squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);;
-            // only compute the force if the particles are closer than the cuttoff (FLOPS: 1)
-            if (rsq < r_cut_sq)
+            for (unsigned int j = 0; j < size; j++)
                 {
-                 Scalar position_scalar = sqrt(rsq) * rdr;
-                 Scalar position = position_scalar;
-                 unsigned int r_index = (unsigned int)position;
-                 r_index = min(r_index,nr);
-                 position -= r_index;
-                 atomElectronDensity[i] += electronDensity[r_index + nr * (typei * ntypes + typej)] + derivativeElectronDensity[r_index + nr * (typei * ntypes + typej)] * position * dr;
-                 if(third_law)
+                // increment our calculation counter
+                n_calc++;
+
+                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+                unsigned int k = h_nlist.data[head_i + j*nlist_stride];
+                // sanity check
+                assert(k < N + n_ghosts);
+
+                // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                Scalar3 dx = pi - pk;
+
+                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar
+                unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // sanity check
+                assert(typej < m_pdata->getNTypes());
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+
+                // start computing the force
+                // calculate r squared (FLOPS: 5)
+                Scalar rsq = dot(dx, dx);;
+                // only compute the force if the particles are closer than the cuttoff (FLOPS: 1)
+                if (rsq < r_cut_sq)
                     {
-                    atomElectronDensity[k] += electronDensity[r_index + nr * (typej * ntypes + typei)]
-                        + derivativeElectronDensity[r_index + nr * (typej * ntypes + typei)] * position * dr;
+                     Scalar position_scalar = sqrt(rsq) * rdr;
+                     Scalar position = position_scalar;
+                     unsigned int r_index = (unsigned int)position;
+                     r_index = min(r_index,nr);
+                     position -= r_index;
+                     atomElectronDensity[i] += electronDensity[r_index + nr * (typei * ntypes + typej)] + derivativeElectronDensity[r_index + nr * (typei * ntypes + typej)] * position * dr;
+                     // the density of a ghost particle is computed by its owner
+                     if(third_law && k < N)
+                        {
+                        atomElectronDensity[k] += electronDensity[r_index + nr * (typej * ntypes + typei)]
+                            + derivativeElectronDensity[r_index + nr * (typej * ntypes + typei)] * position * dr;
+                        }
                     }
                 }
             }
-        }
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
 
-        Scalar position = atomElectronDensity[i] * rdrho;
-        unsigned int r_index = (unsigned int)position;
-        r_index = min(r_index,nrho);
-        position -= (Scalar)r_index;
-        atomDerivativeEmbeddingFunction[i] = derivativeEmbeddingFunction[r_index + typei * nrho];
+            Scalar position = atomElectronDensity[i] * rdrho;
+            unsigned int r_index = (unsigned int)position;
+            r_index = min(r_index,nrho);
+            position -= (Scalar)r_index;
+            h_atom_derivative_embedding.data[i] = derivativeEmbeddingFunction[r_index + typei * nrho];
 
-        h_force.data[i].w += embeddingFunction[r_index + typei * nrho] + derivativeEmbeddingFunction[r_index + typei * nrho] * position * drho;
+            h_force.data[i].w += embeddingFunction[r_index + typei * nrho] + derivativeEmbeddingFunction[r_index + typei * nrho] * position * drho;
+            }
         }
 
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+#ifdef ENABLE_MPI
+    // the ghost particles need the derivatives of their embedding function for the forces
+    if (m_comm)
+        m_comm->updateGhostValues(m_atom_derivative_embedding);
+#endif
+
+    ArrayHandle<Scalar> h_atom_derivative_embedding(m_atom_derivative_embedding, access_location::host,
+        access_mode::read);
+
+    for (unsigned int i = 0; i < N; i++)
         {
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -457,15 +485,16 @@ void EAMForceCompute::computeForces(unsigned int timestep)
 
         // loop over all of the neighbors of this particle
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        const unsigned int head_i = h_head_list.data[i];
         for (unsigned int j = 0; j < size; j++)
             {
             // increment our calculation counter
             n_calc++;
 
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int k = h_nlist.data[nli(i, j)];
+            unsigned int k = h_nlist.data[head_i + j*nlist_stride];
             // sanity check
-            assert(k < m_pdata->getN());
+            assert(k < N + n_ghosts);
 
             // calculate dr (MEM TRANSFER: 3 scalars / FLOPS: 3)
             Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
@@ -496,23 +525,29 @@ void EAMForceCompute::computeForces(unsigned int timestep)
             Scalar derivativePhi = (pairPotential[r_index + shift].y - pair_eng) * inverseR;
             Scalar derivativeRhoI = derivativeElectronDensity[r_index + typei * nr];
             Scalar derivativeRhoJ = derivativeElectronDensity[r_index + typej * nr];
-            Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ +
-                atomDerivativeEmbeddingFunction[k] * derivativeRhoI + derivativePhi;
+            Scalar fullDerivativePhi = h_atom_derivative_embedding.data[i] * derivativeRhoJ +
+                h_atom_derivative_embedding.data[k] * derivativeRhoI + derivativePhi;
             Scalar pairForce = - fullDerivativePhi * inverseR;
+
+            // with a half neighbor list, a pair with a ghost particle is evaluated on both ranks,
+            // each of which counts half of its energy and virial
+            Scalar pair_weight = (third_law && k >= N) ? Scalar(0.5) : Scalar(1.0);
+
             // are the virial and potential energy correctly calculated
             // with respect to double counting?
-            viriali[0] += dx.x*dx.x * pairForce;
-            viriali[1] += dx.x*dx.y * pairForce;
-            viriali[2] += dx.x*dx.z * pairForce;
-            viriali[3] += dx.y*dx.y * pairForce;
-            viriali[4] += dx.y*dx.z * pairForce;
-            viriali[5] += dx.z*dx.z * pairForce;
+            viriali[0] += dx.x*dx.x * pairForce * pair_weight;
+            viriali[1] += dx.x*dx.y * pairForce * pair_weight;
+            viriali[2] += dx.x*dx.z * pairForce * pair_weight;
+            viriali[3] += dx.y*dx.y * pairForce * pair_weight;
+            viriali[4] += dx.y*dx.z * pairForce * pair_weight;
+            viriali[5] += dx.z*dx.z * pairForce * pair_weight;
             fxi += dx.x * pairForce;
             fyi += dx.y * pairForce;
             fzi += dx.z * pairForce;
-            pei += pair_eng;
+            pei += pair_eng * pair_weight;
 
-            if (third_law)
+            // only add the force to local particles, the owner of a ghost computes its force
+            if (third_law && k < N)
                 {
                 h_force.data[k].x -= dx.x * pairForce;
                 h_force.data[k].y -= dx.y * pairForce;
@@ -78,6 +78,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     Forces can be computed directly by calling compute() and then retrieved with a call to acquire(), but
     a more typical usage will be to add the force compute to NVEUpdater or NVTUpdater.
 
+    In MPI simulations, the electron densities and the derivatives of the embedding function are computed for the
+    local particles. The derivatives are then sent to the ghost particles with Communicator::updateGhostValues(),
+    before the forces are computed.
+
     \ingroup computes
 */
 class EAMForceCompute : public ForceCompute
@@ -129,6 +133,8 @@ class EAMForceCompute : public ForceCompute
         vector<Scalar> derivativePairPotential;        //!< array Z'(r)
         vector<Scalar> derivativeEmbeddingFunction;    //!< array F'(rho)
 
+        GPUArray<Scalar> m_atom_derivative_embedding;  //!< F'(rho) of every local and ghost particle
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
@@ -78,7 +78,10 @@ using namespace boost;
     \post \c force and \c virial GPUarrays are initialized
     \post All forces are initialized to 0
 */
-ForceCompute::ForceCompute(boost::shared_ptr<SystemDefinition> sysdef) : Compute(sysdef), m_particles_sorted(false)
+ForceCompute::ForceCompute(boost::shared_ptr<SystemDefinition> sysdef)
+    : Compute(sysdef), m_particles_sorted(false), m_accumulate(false), m_accumulate_supported(true),
+      m_per_force_requested(false), m_has_accumulated(false), m_accumulated_tstep(0), m_virial_reduced(false),
+      m_partial_pitch(0)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
@@ -102,7 +105,10 @@ ForceCompute::ForceCompute(boost::shared_ptr<SystemDefinition> sysdef) : Compute
 
     // reset external virial
     for (unsigned int i = 0; i < 6; ++i)
+        {
         m_external_virial[i] = Scalar(0.0);
+        m_virial_total[i] = Scalar(0.0);
+        }
 
     }
 
@@ -110,6 +116,10 @@ ForceCompute::ForceCompute(boost::shared_ptr<SystemDefinition> sysdef) : Compute
  */
 void ForceCompute::reallocate()
     {
+    // in accumulate mode, the forces are computed into arrays owned by the caller
+    if (m_accumulate)
+        return;
+
     m_force.resize(m_pdata->getMaxN());
     m_virial.resize(m_pdata->getMaxN(),6);
     m_torque.resize(m_pdata->getMaxN());
@@ -118,6 +128,188 @@ void ForceCompute::reallocate()
     m_virial_pitch = m_virial.getPitch();
     }
 
+/*! \param enable Set to true to compute the forces in accumulate mode
+
+    In accumulate mode, the force compute does not keep its own per-particle force, virial and torque arrays. The
+    Integrator instead calls computeInto() with the arrays it sums the net force in, which saves both the memory of
+    the per-force arrays and the bandwidth of summing them. The arrays are allocated again, and accumulate mode is left
+    for good, as soon as per-force data is requested (i.e. by the Logger through compute() and calcEnergySum(), or by
+    the per-particle accessors used by the python force_data proxy). Later calls to setAccumulate(true) are ignored.
+
+    Computes that keep state in m_force between steps (such as ConstForceCompute) do not support accumulate mode.
+*/
+void ForceCompute::setAccumulate(bool enable)
+    {
+    if (enable == m_accumulate)
+        return;
+
+    if (enable)
+        {
+        if (!m_accumulate_supported || m_per_force_requested)
+            return;
+
+        m_exec_conf->msg->notice(6) << "ForceCompute: releasing per-force arrays in accumulate mode" << endl;
+        m_accumulate = true;
+
+        // release the per-force arrays
+        GPUArray<Scalar4> force;
+        GPUArray<Scalar> virial;
+        GPUArray<Scalar4> torque;
+        m_force.swap(force);
+        m_virial.swap(virial);
+        m_torque.swap(torque);
+        m_virial_pitch = 0;
+        }
+    else
+        {
+        m_accumulate = false;
+
+        unsigned int max_num_particles = m_pdata->getMaxN();
+        GPUArray<Scalar4>  force(max_num_particles,exec_conf);
+        GPUArray<Scalar>   virial(max_num_particles,6,exec_conf);
+        GPUArray<Scalar4>  torque(max_num_particles,exec_conf);
+        m_force.swap(force);
+        m_virial.swap(virial);
+        m_torque.swap(torque);
+        m_virial_pitch = m_virial.getPitch();
+        }
+    }
+
+/*! Called by all accessors of per-force data. If the forces are computed in accumulate mode, the per-force arrays
+    are allocated and the forces of the last computed time step are recomputed into them.
+*/
+void ForceCompute::requestPerForceData()
+    {
+    if (!m_accumulate)
+        return;
+
+    m_per_force_requested = true;
+    setAccumulate(false);
+
+    if (m_has_accumulated)
+        computeForces(m_accumulated_tstep);
+    }
+
+/*! \param timestep Current time step
+    \param force Force array to compute into
+    \param virial Virial array to compute into
+    \param torque Torque array to compute into
+
+    The arrays are swapped with the (empty) per-force arrays while computeForces() runs, so every force compute
+    supports this without modification. Like compute() into the per-force arrays, the result overwrites the contents
+    of the arrays. Callers must pass arrays that are zeroed and sized for the current maximum number of particles.
+
+    \pre The force compute is in accumulate mode
+*/
+void ForceCompute::computeInto(unsigned int timestep,
+                               const GPUArray<Scalar4>& force,
+                               const GPUArray<Scalar>& virial,
+                               const GPUArray<Scalar4>& torque)
+    {
+    assert(m_accumulate);
+    assert(force.getNumElements() >= m_pdata->getMaxN());
+
+    force.swap(m_force);
+    virial.swap(m_virial);
+    torque.swap(m_torque);
+    m_virial_pitch = m_virial.getPitch();
+
+    computeForces(timestep);
+
+    force.swap(m_force);
+    virial.swap(m_virial);
+    torque.swap(m_torque);
+    m_virial_pitch = 0;
+
+    m_has_accumulated = true;
+    m_accumulated_tstep = timestep;
+    m_particles_sorted = false;
+    }
+
+/*! \param n_threads Number of threads that will accumulate forces
+    \param include_ghosts If true, the slices also hold the ghost particles (for computes that accumulate forces on
+           ghosts, which are returned to their owners by Communicator::reduceGhostForces())
+
+    Computes that apply Newton's third law on several threads cannot write the force on a neighbor directly, since
+    another thread may update the same particle. Instead, thread \a t accumulates into its own slice of
+    m_force_partial and m_virial_partial, starting at t*m_partial_pitch (forces) and 6*t*m_partial_pitch (virials,
+    stored with a pitch of m_partial_pitch). Each thread is responsible for zeroing its own slice.
+
+    \post The partial arrays hold a slice of m_pdata->getN() particles (plus the ghosts, if requested) for each
+           thread. They only ever grow.
+*/
+void ForceCompute::allocateThreadPartial(unsigned int n_threads, bool include_ghosts)
+    {
+    m_partial_pitch = m_pdata->getN();
+    if (include_ghosts)
+        m_partial_pitch += m_pdata->getNGhosts();
+
+    unsigned int size = n_threads*m_partial_pitch;
+    if (m_force_partial.size() < size)
+        m_force_partial.resize(size);
+    if (m_virial_partial.size() < 6*size)
+        m_virial_partial.resize(6*size);
+    }
+
+/*! \param h_force Force array to write (indexed by particle)
+    \param h_virial Virial array to write (pitch m_virial_pitch)
+    \param n_threads Number of threads that accumulated into the partial arrays
+    \param compute_virial Set to true to also sum the virial
+
+    The per-thread contributions are always summed in thread order, so the result does not depend on how the
+    reduction itself is scheduled and is reproducible for a given number of threads.
+
+    \pre allocateThreadPartial() has been called with \a n_threads and all slices have been filled
+*/
+void ForceCompute::reduceThreadPartial(Scalar4 *h_force, Scalar *h_virial, unsigned int n_threads, bool compute_virial)
+    {
+    const unsigned int pitch = m_partial_pitch;
+
+    #pragma omp parallel for schedule(static) num_threads(n_threads)
+    for (int i = 0; i < (int)pitch; i++)
+        {
+        Scalar4 f = make_scalar4(0,0,0,0);
+        for (unsigned int t = 0; t < n_threads; t++)
+            {
+            const Scalar4& f_t = m_force_partial[t*pitch+i];
+            f.x += f_t.x;
+            f.y += f_t.y;
+            f.z += f_t.z;
+            f.w += f_t.w;
+            }
+        h_force[i] = f;
+
+        if (compute_virial)
+            {
+            for (unsigned int l = 0; l < 6; l++)
+                {
+                Scalar v = Scalar(0.0);
+                for (unsigned int t = 0; t < n_threads; t++)
+                    v += m_virial_partial[(6*t+l)*pitch+i];
+                h_virial[l*m_virial_pitch+i] = v;
+                }
+            }
+        }
+    }
+
+/*! \param n_threads Number of threads that summed up their virial
+
+    In reduced virial mode (ParticleData::getReducedVirial()), thread \a t sums the virial of its particles into
+    m_virial_total_partial[6*t] to m_virial_total_partial[6*t+5]. The thread totals are added to m_virial_total in
+    thread order, so the result is reproducible for a given number of threads.
+*/
+void ForceCompute::reduceThreadVirialTotal(unsigned int n_threads)
+    {
+    assert(m_virial_total_partial.size() >= 6*n_threads);
+    for (unsigned int k = 0; k < 6; k++)
+        {
+        double v = 0.0;
+        for (unsigned int t = 0; t < n_threads; t++)
+            v += m_virial_total_partial[6*t+k];
+        m_virial_total[k] += Scalar(v);
+        }
+    }
+
 /*! Frees allocated memory
 */
 ForceCompute::~ForceCompute()
@@ -130,6 +322,8 @@ ForceCompute::~ForceCompute()
 */
 Scalar ForceCompute::calcEnergySum()
     {
+    requestPerForceData();
+
     ArrayHandle<Scalar4> h_force(m_force,access_location::host,access_mode::read);
     // always perform the sum in double precision for better accuracy
     // this is cheating and is really just a temporary hack to get logging up and running
@@ -159,6 +353,14 @@ Scalar ForceCompute::calcEnergySum()
 
 void ForceCompute::compute(unsigned int timestep)
     {
+    // the forces computed into the caller's arrays are not available in accumulate mode, compute them again
+    if (m_accumulate)
+        {
+        m_per_force_requested = true;
+        setAccumulate(false);
+        m_particles_sorted = true;
+        }
+
     // skip if we shouldn't compute this step
     if (!m_particles_sorted && !shouldCompute(timestep))
         return;
@@ -176,6 +378,8 @@ void ForceCompute::compute(unsigned int timestep)
 double ForceCompute::benchmark(unsigned int num_iters)
     {
     ClockSource t;
+    requestPerForceData();
+
     // warm up run
     computeForces(0);
 
@@ -207,6 +411,7 @@ double ForceCompute::benchmark(unsigned int num_iters)
  */
 Scalar4 ForceCompute::getTorque(unsigned int tag)
     {
+    requestPerForceData();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar4 result = make_scalar4(0.0,0.0,0.0,0.0);
@@ -230,6 +435,7 @@ Scalar4 ForceCompute::getTorque(unsigned int tag)
  */
 Scalar3 ForceCompute::getForce(unsigned int tag)
     {
+    requestPerForceData();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar3 result = make_scalar3(0.0,0.0,0.0);
@@ -254,6 +460,7 @@ Scalar3 ForceCompute::getForce(unsigned int tag)
  */
 Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
     {
+    requestPerForceData();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
@@ -277,6 +484,7 @@ Scalar ForceCompute::getVirial(unsigned int tag, unsigned int component)
  */
 Scalar ForceCompute::getEnergy(unsigned int tag)
     {
+    requestPerForceData();
     unsigned int i = m_pdata->getRTag(tag);
     bool found = (i < m_pdata->getN());
     Scalar result = Scalar(0.0);
@@ -320,6 +528,8 @@ void export_ForceCompute()
     .def("getTorque", &ForceCompute::getTorque)
     .def("getVirial", &ForceCompute::getVirial)
     .def("getEnergy", &ForceCompute::getEnergy)
+    .def("setAccumulate", &ForceCompute::setAccumulate)
+    .def("isAccumulating", &ForceCompute::isAccumulating)
     ;
     }
 
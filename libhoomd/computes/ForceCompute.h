@@ -56,6 +56,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/shared_ptr.hpp>
 #include <boost/signals2.hpp>
+#include <vector>
 
 #include "Compute.h"
 #include "Index1D.h"
@@ -114,6 +115,12 @@ class ForceCompute : public Compute
          * and can be used to overlap computation with communication
          */
         virtual void preCompute(unsigned int timestep) { }
+
+        //! Pre-compute the forces on particles that do not interact with ghosts
+        /*! This method is called in MPI simulations while the ghost particles are being updated, in time steps
+         * without particle migration. The forces on the remaining particles are added by the next call to compute().
+         */
+        virtual void preComputeInterior(unsigned int timestep) { }
         #endif
 
         //! Computes the forces
@@ -140,21 +147,39 @@ class ForceCompute : public Compute
         //! Get the array of computed forces
         GPUArray<Scalar4>& getForceArray()
             {
+            requestPerForceData();
             return m_force;
             }
 
         //! Get the array of computed virials
         GPUArray<Scalar>& getVirialArray()
             {
+            requestPerForceData();
             return m_virial;
             }
 
         //! Get the array of computed torques
         GPUArray<Scalar4>& getTorqueArray()
             {
+            requestPerForceData();
             return m_torque;
             }
 
+        //! Enable or disable accumulate mode
+        void setAccumulate(bool enable);
+
+        //! Test if the force is computed in accumulate mode
+        bool isAccumulating() const
+            {
+            return m_accumulate;
+            }
+
+        //! Compute the forces into arrays owned by the caller
+        void computeInto(unsigned int timestep,
+                         const GPUArray<Scalar4>& force,
+                         const GPUArray<Scalar>& virial,
+                         const GPUArray<Scalar4>& torque);
+
         //! Get the contribution to the external virial
         Scalar getExternalVirial(unsigned int dir)
             {
@@ -162,6 +187,19 @@ class ForceCompute : public Compute
             return m_external_virial[dir];
             }
 
+        //! Test if the virial of the last computation was only summed over all particles
+        bool isVirialReduced() const
+            {
+            return m_virial_reduced;
+            }
+
+        //! Get the virial summed over all local particles when isVirialReduced() is true
+        Scalar getVirialTotal(unsigned int dir)
+            {
+            assert(dir<6);
+            return m_virial_total[dir];
+            }
+
         #ifdef ENABLE_MPI
         //! Get requested ghost communication flags
         virtual CommFlags getRequestedCommFlags(unsigned int timestep)
@@ -190,6 +228,9 @@ class ForceCompute : public Compute
         //! Reallocate internal arrays
         void reallocate();
 
+        //! Allocate the per-force arrays and leave accumulate mode
+        void requestPerForceData();
+
         Scalar m_deltaT;  //!< timestep size (required for some types of non-conservative forces)
 
         GPUArray<Scalar4> m_force;            //!< m_force.x,m_force.y,m_force.z are the x,y,z components of the force, m_force.u is the PE
@@ -207,6 +248,29 @@ class ForceCompute : public Compute
 
         Scalar m_external_virial[6]; //!< Stores external contribution to virial
 
+        bool m_virial_reduced;          //!< True if the last computation only summed the virial into m_virial_total
+        Scalar m_virial_total[6];       //!< Virial summed over all local particles in reduced virial mode
+        std::vector<double> m_virial_total_partial; //!< Per-thread virial totals for multithreaded CPU computes
+
+        bool m_accumulate;              //!< True if the forces are only computed into arrays passed to computeInto()
+        bool m_accumulate_supported;    //!< False for computes that keep state in m_force between steps
+        bool m_per_force_requested;     //!< True once per-force data has been requested in accumulate mode
+        bool m_has_accumulated;         //!< True if computeInto() has been called
+        unsigned int m_accumulated_tstep;   //!< Time step of the last call to computeInto()
+
+        std::vector<Scalar4> m_force_partial;   //!< Per-thread force/energy accumulators for multithreaded CPU computes
+        std::vector<Scalar> m_virial_partial;   //!< Per-thread virial accumulators for multithreaded CPU computes
+        unsigned int m_partial_pitch;           //!< Number of particles in each thread's slice of the partial arrays
+
+        //! Allocate per-thread force and virial accumulators
+        void allocateThreadPartial(unsigned int n_threads, bool include_ghosts=false);
+
+        //! Sum the per-thread accumulators into the force and virial arrays
+        void reduceThreadPartial(Scalar4 *h_force, Scalar *h_virial, unsigned int n_threads, bool compute_virial);
+
+        //! Add the per-thread virial totals to m_virial_total
+        void reduceThreadVirialTotal(unsigned int n_threads);
+
         //! Connection to the signal notifying when particles are resorted
         boost::signals2::connection m_sort_connection;
 
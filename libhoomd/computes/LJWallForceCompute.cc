@@ -65,6 +65,8 @@ using namespace boost::python;
 #include "LJWallForceCompute.h"
 #include "WallData.h"
 #include <stdexcept>
+#include <algorithm>
+#include <float.h>
 
 using namespace std;
 
@@ -182,21 +184,95 @@ Scalar LJWallForceCompute::getLogValue(const std::string& quantity, unsigned int
         }
     }
 
+/*! The minimum image of the vector from a wall to a particle points from a periodic image of the wall plane to the
+    particle. A wall can therefore only act on particles within the cutoff of one of its images. The signed distances
+    of the local box corners to the wall bound those of the local particles, and are compared against every image
+    of the wall plane that the minimum image convention can reach. Walls that no image brings within the cutoff are
+    left out of m_active_walls.
+*/
+void LJWallForceCompute::findActiveWalls()
+    {
+    boost::shared_ptr<WallData> wall_data = m_sysdef->getWallData();
+    unsigned int numWalls = wall_data->getNumWalls();
+
+    m_active_walls.clear();
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    const BoxDim& box = m_pdata->getBox();
+
+    // particles may leave the local box by less than the skin width before they are migrated
+    Scalar margin(0.0);
+#ifdef ENABLE_MPI
+    if (m_comm)
+        margin = m_comm->getRBuff();
+#endif
+
+    uchar3 periodic = global_box.getPeriodic();
+    Scalar3 npd = global_box.getNearestPlaneDistance();
+    bool is_2d = (m_sysdef->getNDimensions() == 2);
+
+    for (unsigned int cur_wall_idx = 0; cur_wall_idx < numWalls; cur_wall_idx++)
+        {
+        const Wall& cur_wall = wall_data->getWall(cur_wall_idx);
+        Scalar3 normal = make_scalar3(cur_wall.normal_x, cur_wall.normal_y, cur_wall.normal_z);
+        Scalar3 origin = make_scalar3(cur_wall.origin_x, cur_wall.origin_y, cur_wall.origin_z);
+
+        // range of signed distances of the local box from the wall plane
+        Scalar dist_min(FLT_MAX);
+        Scalar dist_max(-FLT_MAX);
+        for (unsigned int corner = 0; corner < 8; corner++)
+            {
+            Scalar3 f = make_scalar3(corner & 1, (corner >> 1) & 1, (corner >> 2) & 1);
+            Scalar dist = dot(normal, box.makeCoordinates(f) - origin);
+            dist_min = std::min(dist_min, dist);
+            dist_max = std::max(dist_max, dist);
+            }
+        dist_min -= margin;
+        dist_max += margin;
+
+        // number of images the minimum image convention can shift the distance vector by, in each direction
+        Scalar dist_abs = std::max(fabs(dist_min), fabs(dist_max));
+        int nx = periodic.x ? int(ceil(dist_abs/npd.x)) : 0;
+        int ny = periodic.y ? int(ceil(dist_abs/npd.y)) : 0;
+        int nz = (periodic.z && !is_2d) ? int(ceil(dist_abs/npd.z)) : 0;
+
+        // offsets of the wall images along the normal
+        Scalar shift_x = dot(normal, global_box.getLatticeVector(0));
+        Scalar shift_y = dot(normal, global_box.getLatticeVector(1));
+        Scalar shift_z = dot(normal, global_box.getLatticeVector(2));
+
+        bool active = false;
+        for (int i = -nx; i <= nx && !active; i++)
+            for (int j = -ny; j <= ny && !active; j++)
+                for (int k = -nz; k <= nz && !active; k++)
+                    {
+                    Scalar shift = Scalar(i)*shift_x + Scalar(j)*shift_y + Scalar(k)*shift_z;
+                    active = (dist_min - shift < m_r_cut) && (dist_max - shift > -m_r_cut);
+                    }
+
+        if (active)
+            m_active_walls.push_back(cur_wall_idx);
+        }
+    }
+
 void LJWallForceCompute::computeForces(unsigned int timestep)
     {
     // start the profile for this compute
     if (m_prof) m_prof->push("LJ wall");
 
+    // only evaluate the walls near the local box
+    findActiveWalls();
+
     // get numparticle var for easier access
     unsigned int numParticles = m_pdata->getN();
     boost::shared_ptr<WallData> wall_data = m_sysdef->getWallData();
-    unsigned int numWalls = wall_data->getNumWalls();
+    unsigned int numWalls = (unsigned int)m_active_walls.size();
 
     // precalculate r_cut squqred
     Scalar r_cut_sq = m_r_cut * m_r_cut;
 
     // precalculate box lengths for use in the periodic imaging
-    BoxDim box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
 
     // access the particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -234,7 +310,7 @@ void LJWallForceCompute::computeForces(unsigned int timestep)
         // the sum of the forces from each wall is the resulting force
         for (unsigned int cur_wall_idx = 0; cur_wall_idx < numWalls; cur_wall_idx++)
             {
-            const Wall& cur_wall = wall_data->getWall(cur_wall_idx);
+            const Wall& cur_wall = wall_data->getWall(m_active_walls[cur_wall_idx]);
 
             // calculate distance from point to plane
             // http://mathworld.wolfram.com/Point-PlaneDistance.html
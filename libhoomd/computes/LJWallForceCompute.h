@@ -58,6 +58,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 #include "ForceCompute.h"
 
@@ -65,7 +66,9 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define __LJWallForceCompute__
 
 //! Computes an LJ-type force between each particle and each wall in the simulation
-/*!
+/*! Only walls that come within the cutoff of the local box, including their periodic images, are evaluated.
+    With domain decomposition, each rank thus only loops over the walls near its own domain.
+
     \ingroup computes
 */
 class LJWallForceCompute :  public ForceCompute
@@ -95,10 +98,14 @@ class LJWallForceCompute :  public ForceCompute
         //! Computes forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Finds the walls that can interact with particles in the local box
+        void findActiveWalls();
+
         Scalar m_r_cut;         //!< Cuttoff distance beyond which the force is set to 0
 
         Scalar * __restrict__ m_lj1;    //!< Parameter for computing forces (m_ntypes by m_ntypes array)
         Scalar * __restrict__ m_lj2;    //!< Parameter for computing forces (m_ntypes by m_ntypes array)
+        std::vector<unsigned int> m_active_walls;   //!< Indices of the walls within the cutoff of the local box
 
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange();
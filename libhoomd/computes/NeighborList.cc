@@ -68,6 +68,7 @@ using namespace boost::python;
 
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
 
 using namespace boost;
 using namespace std;
@@ -86,7 +87,7 @@ using namespace std;
 */
 NeighborList::NeighborList(boost::shared_ptr<SystemDefinition> sysdef, Scalar r_cut, Scalar r_buff)
     : Compute(sysdef), m_r_cut(r_cut), m_r_buff(r_buff), m_d_max(1.0), m_filter_body(false), m_filter_diameter(false),
-      m_storage_mode(half), m_updates(0), m_forced_updates(0), m_dangerous_updates(0),
+      m_storage_mode(half), m_compact(false), m_typpair_idx(m_pdata->getNTypes()), m_updates(0), m_forced_updates(0), m_dangerous_updates(0),
       m_force_update(true), m_dist_check(true), m_has_been_updated_once(false), m_want_exclusions(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing Neighborlist" << endl;
@@ -112,11 +113,25 @@ NeighborList::NeighborList(boost::shared_ptr<SystemDefinition> sysdef, Scalar r_
     m_Nmax = 0;
     m_exclusions_set = false;
 
+    #ifdef ENABLE_MPI
+    m_n_interior = 0;
+    m_interior_list_valid = false;
+    #endif
+
 
     // initialize box length at last update
     m_last_L = m_pdata->getGlobalBox().getNearestPlaneDistance();
     m_last_L_local = m_pdata->getBox().getNearestPlaneDistance();
 
+    // allocate the per type pair cutoffs, every pair starts out with the maximum cutoff
+    GPUArray<Scalar> r_cut_pair(m_typpair_idx.getNumElements(), exec_conf);
+    m_r_cut_pair.swap(r_cut_pair);
+        {
+        ArrayHandle<Scalar> h_r_cut_pair(m_r_cut_pair, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < m_typpair_idx.getNumElements(); i++)
+            h_r_cut_pair.data[i] = m_r_cut;
+        }
+
     // allocate conditions flags
     GPUFlags<unsigned int> conditions(exec_conf);
     m_conditions.swap(conditions);
@@ -125,6 +140,10 @@ NeighborList::NeighborList(boost::shared_ptr<SystemDefinition> sysdef, Scalar r_
     GPUArray<unsigned int> n_neigh(m_pdata->getMaxN(), exec_conf);
     m_n_neigh.swap(n_neigh);
 
+    // allocate the head list
+    GPUArray<unsigned int> head_list(m_pdata->getMaxN(), exec_conf);
+    m_head_list.swap(head_list);
+
     // allocate neighbor list
     allocateNlist();
 
@@ -156,6 +175,7 @@ NeighborList::NeighborList(boost::shared_ptr<SystemDefinition> sysdef, Scalar r_
 
     m_max_particle_num_change_connection = m_pdata->connectMaxParticleNumberChange(bind(&NeighborList::reallocate, this));
     m_global_particle_num_change_connection = m_pdata->connectGlobalParticleNumberChange(bind(&NeighborList::slotGlobalParticleNumberChange, this));
+    m_num_type_change_connection = m_pdata->connectNumTypesChange(bind(&NeighborList::slotNumTypesChange, this));
 
     // allocate m_update_periods tracking info
     m_update_periods.resize(100);
@@ -173,8 +193,14 @@ void NeighborList::reallocate()
     m_ex_list_idx.resize(m_pdata->getMaxN(), ex_list_height );
     m_ex_list_indexer = Index2D(m_ex_list_idx.getPitch(), ex_list_height);
 
-    m_nlist.resize(m_pdata->getMaxN(), m_Nmax+1);
-    m_nlist_indexer = Index2D(m_nlist.getPitch(), m_Nmax);
+    m_head_list.resize(m_pdata->getMaxN());
+    // the compact list is resized when it is built
+    if (!m_compact)
+        {
+        m_nlist.resize(m_pdata->getMaxN(), m_Nmax+1);
+        m_nlist_indexer = Index2D(m_nlist.getPitch(), m_Nmax);
+        resetHeadList();
+        }
 
     m_n_neigh.resize(m_pdata->getMaxN());
 
@@ -199,6 +225,7 @@ NeighborList::~NeighborList()
     m_sort_connection.disconnect();
     m_max_particle_num_change_connection.disconnect();
     m_global_particle_num_change_connection.disconnect();
+    m_num_type_change_connection.disconnect();
 #ifdef ENABLE_MPI
     if (m_migrate_request_connection.connected())
         m_migrate_request_connection.disconnect();
@@ -243,11 +270,18 @@ void NeighborList::compute(unsigned int timestep)
                 }
             } while (overflowed);
 
+        if (m_compact)
+            packCompactNlist();
+
         if (m_exclusions_set)
             filterNlist();
 
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+
+        #ifdef ENABLE_MPI
+        m_interior_list_valid = false;
+        #endif
         }
 
     if (m_prof) m_prof->pop();
@@ -277,7 +311,11 @@ double NeighborList::benchmark(unsigned int num_iters)
     // benchmark
     uint64_t start_time = t.getTime();
     for (unsigned int i = 0; i < num_iters; i++)
+        {
         buildNlist(0);
+        if (m_compact)
+            packCompactNlist();
+        }
 
 #ifdef ENABLE_CUDA
     if (exec_conf->isCUDAEnabled())
@@ -312,6 +350,13 @@ void NeighborList::setRCut(Scalar r_cut, Scalar r_buff)
         throw runtime_error("Error changing NeighborList parameters");
         }
 
+    // the per type pair cutoffs are reset to the new maximum
+        {
+        ArrayHandle<Scalar> h_r_cut_pair(m_r_cut_pair, access_location::host, access_mode::overwrite);
+        for (unsigned int i = 0; i < m_typpair_idx.getNumElements(); i++)
+            h_r_cut_pair.data[i] = m_r_cut;
+        }
+
 #ifdef ENABLE_MPI
     if (m_comm)
         {
@@ -325,6 +370,105 @@ void NeighborList::setRCut(Scalar r_cut, Scalar r_buff)
     forceUpdate();
     }
 
+/*! \param compact Set to true to store the neighbor list compactly
+
+    When switching to the compact layout, the 2D neighbor list matrix is released and the compact list is allocated on
+    the next build. Compact storage is not available on the GPU, a warning is issued and the default layout is kept.
+*/
+void NeighborList::setCompactStorage(bool compact)
+    {
+    if (compact && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->warning() << "nlist: Compact storage is not supported on the GPU, ignoring" << endl;
+        return;
+        }
+
+    if (compact == m_compact)
+        return;
+
+    m_compact = compact;
+    if (m_compact)
+        {
+        GPUArray<unsigned int> nlist;
+        m_nlist.swap(nlist);
+        }
+    else
+        {
+        allocateNlist();
+        }
+
+    forceUpdate();
+    }
+
+/*! \param typ1 First type index in the pair
+    \param typ2 Second type index in the pair
+    \param r_cut Cuttoff radius to set for this type pair
+    \note When setting the value for (\a typ1, \a typ2), the value for (\a typ2, \a typ1) is automatically set.
+    \note \a r_cut must not be larger than the maximum cutoff set with setRCut(). The neighbor list is not
+          immediately updated, the new cuttoff will take effect when compute is called for the next timestep.
+*/
+void NeighborList::setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut)
+    {
+    if (typ1 >= m_pdata->getNTypes() || typ2 >= m_pdata->getNTypes())
+        {
+        m_exec_conf->msg->error() << "nlist: Trying to set r_cut for a non existant type! "
+                                  << typ1 << "," << typ2 << endl;
+        throw runtime_error("Error changing NeighborList parameters");
+        }
+
+    if (r_cut < 0.0)
+        {
+        m_exec_conf->msg->error() << "nlist: Requested cuttoff radius is less than zero" << endl;
+        throw runtime_error("Error changing NeighborList parameters");
+        }
+
+    if (r_cut > m_r_cut)
+        {
+        m_exec_conf->msg->error() << "nlist: Requested cuttoff radius for type pair " << typ1 << "," << typ2
+                                  << " is larger than the maximum cuttoff " << m_r_cut << endl;
+        throw runtime_error("Error changing NeighborList parameters");
+        }
+
+    ArrayHandle<Scalar> h_r_cut_pair(m_r_cut_pair, access_location::host, access_mode::readwrite);
+    h_r_cut_pair.data[m_typpair_idx(typ1, typ2)] = r_cut;
+    h_r_cut_pair.data[m_typpair_idx(typ2, typ1)] = r_cut;
+
+    forceUpdate();
+    }
+
+/*! \param typ1 First type index in the pair
+    \param typ2 Second type index in the pair
+    \returns The cuttoff radius of the type pair
+*/
+Scalar NeighborList::getRCutPair(unsigned int typ1, unsigned int typ2)
+    {
+    if (typ1 >= m_pdata->getNTypes() || typ2 >= m_pdata->getNTypes())
+        {
+        m_exec_conf->msg->error() << "nlist: Trying to get r_cut for a non existant type! "
+                                  << typ1 << "," << typ2 << endl;
+        throw runtime_error("Error getting NeighborList parameters");
+        }
+
+    ArrayHandle<Scalar> h_r_cut_pair(m_r_cut_pair, access_location::host, access_mode::read);
+    return h_r_cut_pair.data[m_typpair_idx(typ1, typ2)];
+    }
+
+/*! The type pair arrays are reallocated for the new number of types and every pair is reset to the maximum cutoff.
+*/
+void NeighborList::slotNumTypesChange()
+    {
+    m_typpair_idx = Index2D(m_pdata->getNTypes());
+
+    GPUArray<Scalar> r_cut_pair(m_typpair_idx.getNumElements(), exec_conf);
+    m_r_cut_pair.swap(r_cut_pair);
+
+    ArrayHandle<Scalar> h_r_cut_pair(m_r_cut_pair, access_location::host, access_mode::overwrite);
+    for (unsigned int i = 0; i < m_typpair_idx.getNumElements(); i++)
+        h_r_cut_pair.data[i] = m_r_cut;
+
+    forceUpdate();
+    }
+
 /*! \returns an estimate of the number of neighbors per particle
     This mean-field estimate may be very bad dending on how clustered particles are.
     Derived classes can override this method to provide better estimates.
@@ -1049,7 +1193,7 @@ unsigned int NeighborList::getSmallestRebuild()
 
 /*! Loops through the particles and finds all of the particles \c j who's distance is less than
     \param timestep Current time step of the simulation
-    \c r_cut \c + \c r_buff from particle \c i, includes either i < j or all neighbors depending
+    \c r_cut(typei,typej) \c + \c r_buff from particle \c i, includes either i < j or all neighbors depending
     on the mode set by setStorageMode()
 */
 void NeighborList::buildNlist(unsigned int timestep)
@@ -1074,12 +1218,14 @@ void NeighborList::buildNlist(unsigned int timestep)
     const BoxDim& box = m_pdata->getBox();
     Scalar3 nearest_plane_distance = box.getNearestPlaneDistance();
 
-    // start by creating a temporary copy of r_cut sqaured
-    Scalar rmax = m_r_cut + m_r_buff;
+    // every type pair includes neighbors up to its own cutoff plus the buffer
+    Scalar r_list_extra = m_r_buff;
     // add d_max - 1.0, if diameter filtering is not already taking care of it
     if (!m_filter_diameter)
-        rmax += m_d_max - Scalar(1.0);
-    Scalar rmaxsq = rmax*rmax;
+        r_list_extra += m_d_max - Scalar(1.0);
+    Scalar rmax = m_r_cut + r_list_extra;
+
+    ArrayHandle<Scalar> h_r_cut_pair(m_r_cut_pair, access_location::host, access_mode::read);
 
     if ((box.getPeriodic().x && nearest_plane_distance.x <= rmax * 2.0) ||
         (box.getPeriodic().y && nearest_plane_distance.y <= rmax * 2.0) ||
@@ -1089,25 +1235,39 @@ void NeighborList::buildNlist(unsigned int timestep)
         throw runtime_error("Error updating neighborlist bins");
         }
 
+    unsigned int conditions = 0;
+
+    // the compact list is collected in a single row, it is packed by compute()
+    if (m_compact)
+        {
+        m_thread_nlist.resize(1);
+        m_thread_nlist[0].clear();
+        }
+
     // access the nlist data
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::readwrite);
 
-    unsigned int conditions = 0;
-
-    // start by clearing the entire list
-    memset(h_n_neigh.data, 0, sizeof(unsigned int)*m_pdata->getN());
-
-    // now we can loop over all particles in n^2 fashion and build the list
+    // now we can loop over all particles in n^2 fashion and build the list, each particle fills its own row
     for (int i = 0; i < (int)m_pdata->getN(); i++)
         {
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         Scalar di = h_diameter.data[i];
         unsigned int bodyi = h_body.data[i];
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        unsigned int cur_n_neigh = 0;
 
-        // for each other particle with i < j, including ghost particles
-        for (unsigned int j = i + 1; j < m_pdata->getN() + m_pdata->getNGhosts(); j++)
+        if (m_compact)
+            h_head_list.data[i] = m_thread_nlist[0].size();
+
+        // for each other particle (only those with i < j in half mode), including ghost particles
+        unsigned int j_start = (m_storage_mode == full) ? 0 : i + 1;
+        for (unsigned int j = j_start; j < m_pdata->getN() + m_pdata->getNGhosts(); j++)
             {
+            if (j == (unsigned int)i)
+                continue;
+
             // calculate dr
             Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
             Scalar3 dx = pj - pi;
@@ -1118,6 +1278,10 @@ void NeighborList::buildNlist(unsigned int timestep)
             if (m_filter_body && bodyi != NO_BODY)
                 excluded = (bodyi == h_body.data[j]);
 
+            // list radius of this type pair
+            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+            Scalar rlist = h_r_cut_pair.data[m_typpair_idx(typei, typej)] + r_list_extra;
+
             Scalar sqshift = Scalar(0.0);
             if (m_filter_diameter)
                 {
@@ -1125,44 +1289,25 @@ void NeighborList::buildNlist(unsigned int timestep)
                 Scalar delta = (di + h_diameter.data[j]) * Scalar(0.5) - Scalar(1.0);
                 // r^2 < (r_max + delta)^2
                 // r^2 < r_maxsq + delta^2 + 2*r_max*delta
-                sqshift = (delta + Scalar(2.0) * rmax) * delta;
+                sqshift = (delta + Scalar(2.0) * rlist) * delta;
                 }
 
-            // now compare rsq to rmaxsq and add to the list if it meets the criteria
+            // now compare rsq to rlistsq and add to the list if it meets the criteria
             Scalar rsq = dot(dx, dx);
-            if (rsq <= (rmaxsq + sqshift) && !excluded)
+            if (rsq <= (rlist*rlist + sqshift) && !excluded)
                 {
-                if (m_storage_mode == full)
-                    {
-                    unsigned int posi = h_n_neigh.data[i];
-                    if (posi < m_Nmax)
-                        h_nlist.data[m_nlist_indexer(i, posi)] = j;
-                    else
-                        conditions = max(conditions, h_n_neigh.data[i]+1);
-
-                    h_n_neigh.data[i]++;
-
-                    unsigned int posj = h_n_neigh.data[j];
-                    if (posj < m_Nmax)
-                        h_nlist.data[m_nlist_indexer(j, posj)] = i;
-                    else
-                        conditions = max(conditions, h_n_neigh.data[j]+1);
-
-                    h_n_neigh.data[j]++;
-                    }
+                if (m_compact)
+                    m_thread_nlist[0].push_back(j);
+                else if (cur_n_neigh < m_Nmax)
+                    h_nlist.data[m_nlist_indexer(i, cur_n_neigh)] = j;
                 else
-                    {
-                    unsigned int pos = h_n_neigh.data[i];
-
-                    if (pos < m_Nmax)
-                        h_nlist.data[m_nlist_indexer(i, pos)] = j;
-                    else
-                        conditions = max(conditions, h_n_neigh.data[i]+1);
+                    conditions = max(conditions, cur_n_neigh+1);
 
-                    h_n_neigh.data[i]++;
-                    }
+                cur_n_neigh++;
                 }
             }
+
+        h_n_neigh.data[i] = cur_n_neigh;
         }
 
     // write out conditions
@@ -1224,18 +1369,22 @@ void NeighborList::filterNlist()
     ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    const unsigned int nlist_stride = getNListStride();
 
-    // for each particle's neighbor list
-    for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
+    // for each particle's neighbor list (each row is filtered independently)
+    #pragma omp parallel for schedule(static) num_threads(m_exec_conf->n_cpu)
+    for (int idx = 0; idx < (int)m_pdata->getN(); idx++)
         {
         unsigned int n_neigh = h_n_neigh.data[idx];
         unsigned int n_ex = h_n_ex_idx.data[idx];
         unsigned int new_n_neigh = 0;
+        const unsigned int head_idx = h_head_list.data[idx];
 
         // loop over the list, regenerating it as we go
         for (unsigned int cur_neigh_idx = 0; cur_neigh_idx < n_neigh; cur_neigh_idx++)
             {
-            unsigned int cur_neigh = h_nlist.data[m_nlist_indexer(idx, cur_neigh_idx)];
+            unsigned int cur_neigh = h_nlist.data[head_idx + cur_neigh_idx*nlist_stride];
 
             // test if excluded
             bool excluded = false;
@@ -1252,7 +1401,7 @@ void NeighborList::filterNlist()
             // add it back to the list if it is not excluded
             if (!excluded)
                 {
-                h_nlist.data[m_nlist_indexer(idx, new_n_neigh)] = cur_neigh;
+                h_nlist.data[head_idx + new_n_neigh*nlist_stride] = cur_neigh;
                 new_n_neigh++;
                 }
             }
@@ -1278,6 +1427,65 @@ void NeighborList::allocateNlist()
 
     // update the indexer
     m_nlist_indexer = Index2D(m_nlist.getPitch(), m_Nmax);
+
+    resetHeadList();
+    }
+
+/*! In the default layout, the neighbors of particle \a i start at element \a i of the matrix.
+*/
+void NeighborList::resetHeadList()
+    {
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::overwrite);
+    for (unsigned int i = 0; i < m_head_list.getNumElements(); i++)
+        h_head_list.data[i] = i;
+    }
+
+/*! The neighbors of the particles handled by thread \a t are in m_thread_nlist[t], and the head list holds the index
+    of the first neighbor of each particle within the rows of its thread. Thread \a t must have handled the
+    contiguous range of particles <code>[t*N/n_threads, (t+1)*N/n_threads)</code>, where \a n_threads is the size of
+    m_thread_nlist. The rows are concatenated in thread order, which gives the same list for any number of threads.
+
+    This is called by compute() after buildNlist() when compact storage is enabled.
+    The compact list is grown as needed, leaving some room so that small fluctuations in the number of neighbors do
+    not trigger a reallocation on every build.
+*/
+void NeighborList::packCompactNlist()
+    {
+    unsigned int N = m_pdata->getN();
+    unsigned int n_threads = m_thread_nlist.size();
+
+    // find where the rows of each thread start in the compact list
+    std::vector<unsigned int> thread_base(n_threads);
+    unsigned int n_total = 0;
+    for (unsigned int t = 0; t < n_threads; t++)
+        {
+        thread_base[t] = n_total;
+        n_total += m_thread_nlist[t].size();
+        }
+
+    if (n_total > m_nlist.getNumElements())
+        {
+        unsigned int n_alloc = n_total + n_total/8;
+        m_exec_conf->msg->notice(6) << "nlist: (Re-)Allocating compact list of " << n_alloc << endl;
+
+        GPUArray<unsigned int> nlist(n_alloc, exec_conf);
+        m_nlist.swap(nlist);
+        }
+
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::readwrite);
+
+    #pragma omp parallel for schedule(static) num_threads(n_threads)
+    for (int t = 0; t < (int)n_threads; t++)
+        {
+        unsigned int n_start = (unsigned int)((unsigned long long)t*N/n_threads);
+        unsigned int n_end = (unsigned int)((unsigned long long)(t+1)*N/n_threads);
+        for (unsigned int i = n_start; i < n_end; i++)
+            h_head_list.data[i] += thread_base[t];
+
+        if (m_thread_nlist[t].size() > 0)
+            memcpy(h_nlist.data + thread_base[t], &m_thread_nlist[t][0], sizeof(unsigned int)*m_thread_nlist[t].size());
+        }
     }
 
 unsigned int NeighborList::readConditions()
@@ -1359,6 +1567,52 @@ bool NeighborList::peekUpdate(unsigned int timestep)
 
     return result;
     }
+
+/*! Ghost particles are stored after the local particles, so a particle is in the interior if all of its neighbors
+    have an index smaller than the number of local particles.
+ */
+void NeighborList::buildInteriorList()
+    {
+    const unsigned int N = m_pdata->getN();
+
+    if (m_interior_list.getNumElements() < N)
+        {
+        GPUArray<unsigned int> interior_list(N, exec_conf);
+        m_interior_list.swap(interior_list);
+        }
+
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_interior_list(m_interior_list, access_location::host, access_mode::overwrite);
+    const unsigned int nlist_stride = getNListStride();
+
+    // interior particles are filled in from the front, boundary particles from the back
+    unsigned int n_interior = 0;
+    unsigned int n_boundary = 0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const unsigned int head_i = h_head_list.data[i];
+        bool interior = true;
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            if (h_nlist.data[head_i + k*nlist_stride] >= N)
+                {
+                interior = false;
+                break;
+                }
+
+        if (interior)
+            h_interior_list.data[n_interior++] = i;
+        else
+            h_interior_list.data[N - 1 - n_boundary++] = i;
+        }
+
+    // restore the ascending order of the boundary particles
+    std::reverse(h_interior_list.data + n_interior, h_interior_list.data + N);
+
+    m_n_interior = n_interior;
+    m_interior_list_valid = true;
+    }
 #endif
 
 void export_NeighborList()
@@ -1371,8 +1625,11 @@ void export_NeighborList()
     scope in_nlist = class_<NeighborList, boost::shared_ptr<NeighborList>, bases<Compute>, boost::noncopyable >
                      ("NeighborList", init< boost::shared_ptr<SystemDefinition>, Scalar, Scalar >())
                      .def("setRCut", &NeighborList::setRCut)
+                     .def("setRCutPair", &NeighborList::setRCutPair)
+                     .def("getRCutPair", &NeighborList::getRCutPair)
                      .def("setEvery", &NeighborList::setEvery)
                      .def("setStorageMode", &NeighborList::setStorageMode)
+                     .def("setCompactStorage", &NeighborList::setCompactStorage)
                      .def("addExclusion", &NeighborList::addExclusion)
                      .def("clearExclusions", &NeighborList::clearExclusions)
                      .def("countExclusions", &NeighborList::countExclusions)
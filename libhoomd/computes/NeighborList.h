@@ -103,14 +103,42 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
     \a jf includes flags in the highest bits. The format and use of these flags are yet to be determined.
 
+    <b>Compact storage:</b>
+
+    The 2D matrix is sized for the particle with the most neighbors, so a single dense cluster inflates the memory
+    needed for every particle. setCompactStorage() switches to a compact (CSR like) layout where the neighbors of each
+    particle are stored contiguously, one particle after the other, and the list is only as large as the total number
+    of neighbors. The start of each particle's neighbors is stored in the head list (getHeadList()). Consumers that
+    want to support both layouts access the list through the head list and getNListStride():
+
+     - <code>jf = nlist[head_list[i] + n*nlist_stride]</code>
+
+    In the default layout, <code>head_list[i] = i</code> and the stride is the pitch of the matrix, so this is
+    identical to using the indexer. In the compact layout the stride is 1 and getNListIndexer() must not be used.
+    The compact layout is only available on the CPU. With compact storage, buildNlist() does not write to \a m_nlist.
+    Each thread instead appends the neighbors of a contiguous range of particles to its own row of \a m_thread_nlist,
+    and stores the offset within that row in the head list. compute() then concatenates the rows with
+    packCompactNlist(), which needs no overflow handling.
+
     \b Filtering:
 
     By default, a neighbor list includes all particles within a single cutoff distance r_cut. Various filters can be
     applied to remove unwanted neighbors from the list.
+     - setRCutPair() sets an individual r_cut value for a pair of particle types
      - setFilterBody() prevents two particles of the same body from being neighbors
-     - setFilterRcutType() enables individual r_cut values for each pair of particle types
      - setFilterDiameter() enables slj type diameter filtering (TODO: need to specify exactly what this does)
 
+    <b>Per type pair cutoffs:</b>
+
+    The cutoff passed to the constructor or setRCut() is the maximum cutoff of any type pair. It sets the size of the
+    cell list and the ghost layer. setRCutPair() may lower the cutoff for an individual type pair (typ1, typ2), and
+    only neighbors within <code>r_cut(typ1,typ2) + r_buff</code> are stored for that pair. In mixtures where only one
+    pair is long ranged, this keeps the short ranged pairs from carrying the long cutoff and greatly reduces the size
+    of the list. The per pair cutoffs are stored in \a m_r_cut_pair, indexed by \a m_typpair_idx just like the
+    parameters of PotentialPair. setRCut() resets every type pair to the new maximum cutoff. Derived classes that do
+    not check the per pair cutoffs (currently the GPU implementations) still build a correct list using the maximum
+    cutoff, it is just longer than it needs to be.
+
     \b Algorithms:
 
     This base class supplys a dumb O(N^2) algorithm for generating this list. It is very
@@ -173,6 +201,9 @@ class NeighborList : public Compute
         //! Change the cuttoff radius
         virtual void setRCut(Scalar r_cut, Scalar r_buff);
 
+        //! Change the cuttoff radius for a single type pair
+        virtual void setRCutPair(unsigned int typ1, unsigned int typ2, Scalar r_cut);
+
         //! Change how many timesteps before checking to see if the list should be rebuilt
         /*! \param every Number of time steps to wait before beignning to check if particles have moved a sufficient distance
                    to require a neighbor list upate.
@@ -199,6 +230,9 @@ class NeighborList : public Compute
             forceUpdate();
             }
 
+        //! Enable/disable compact storage
+        void setCompactStorage(bool compact);
+
         // @}
         //! \name Get properties
         // @{
@@ -209,6 +243,35 @@ class NeighborList : public Compute
             return m_storage_mode;
             }
 
+        //! Test if compact storage is enabled
+        bool getCompactStorage()
+            {
+            return m_compact;
+            }
+
+        //! Get the width of the buffer around the cutoff
+        Scalar getRBuff()
+            {
+            return m_r_buff;
+            }
+
+        //! Get the cuttoff radius of a single type pair
+        Scalar getRCutPair(unsigned int typ1, unsigned int typ2);
+
+        //! Get the per type pair cutoff array
+        /*! \note The array is indexed with getTypePairIndexer()
+        */
+        const GPUArray<Scalar>& getRCutPairArray()
+            {
+            return m_r_cut_pair;
+            }
+
+        //! Get the type pair indexer
+        const Index2D& getTypePairIndexer()
+            {
+            return m_typpair_idx;
+            }
+
         // @}
         //! \name Statistics
         // @{
@@ -259,6 +322,20 @@ class NeighborList : public Compute
             return m_nlist_indexer;
             }
 
+        //! Get the index of the first neighbor of each particle in the neighbor list
+        const GPUArray<unsigned int>& getHeadList()
+            {
+            return m_head_list;
+            }
+
+        //! Get the distance between two consecutive neighbors of a particle in the neighbor list
+        /*! \note Like the indexer, the stride may change after every call to compute()
+        */
+        unsigned int getNListStride()
+            {
+            return m_compact ? 1 : m_nlist_indexer.getW();
+            }
+
         const Index2D& getExListIndexer()
             {
             return m_ex_list_indexer;
@@ -398,6 +475,38 @@ class NeighborList : public Compute
         /*! \param timestep The current timestep
          */
         bool peekUpdate(unsigned int timestep);
+
+        //! Test if the list has been checked in this time step and is not going to be rebuilt
+        /*! \param timestep The current timestep
+
+            In MPI simulations, the rebuild check is performed before the ghost particles are updated. A list that is
+            current can be used before the ghost update has completed, for all particles that do not have any ghost
+            neighbors (see getInteriorList()).
+         */
+        bool isCurrent(unsigned int timestep)
+            {
+            return m_has_been_updated_once && m_last_checked_tstep == timestep && !m_last_check_result
+                && !m_force_update;
+            }
+
+        //! Get the local particle indices, ordered such that particles without ghost neighbors come first
+        /*! The first getNInterior() entries are the interior particles, the remaining ones are the particles
+            that have at least one ghost particle as a neighbor. Within both groups, the indices are sorted.
+         */
+        const GPUArray<unsigned int>& getInteriorList()
+            {
+            if (!m_interior_list_valid)
+                buildInteriorList();
+            return m_interior_list;
+            }
+
+        //! Get the number of local particles without ghost neighbors
+        unsigned int getNInterior()
+            {
+            if (!m_interior_list_valid)
+                buildInteriorList();
+            return m_n_interior;
+            }
 #endif
 
         //! Return true if the neighbor list has been updated this time step
@@ -417,10 +526,16 @@ class NeighborList : public Compute
         bool m_filter_body;         //!< Set to true if particles in the same body are to be filtered
         bool m_filter_diameter;     //!< Set to true if particles are to be filtered by diameter (slj style)
         storageMode m_storage_mode; //!< The storage mode
+        bool m_compact;             //!< True if the neighbor list is stored compactly
+
+        Index2D m_typpair_idx;               //!< Indexer for accessing the per type pair arrays
+        GPUArray<Scalar> m_r_cut_pair;       //!< Cuttoff radius of each type pair (at most m_r_cut)
 
         Index2D m_nlist_indexer;             //!< Indexer for accessing the neighbor list
         GPUArray<unsigned int> m_nlist;      //!< Neighbor list data
         GPUArray<unsigned int> m_n_neigh;    //!< Number of neighbors for each particle
+        GPUArray<unsigned int> m_head_list;  //!< Index of the first neighbor of each particle in m_nlist
+        std::vector< std::vector<unsigned int> > m_thread_nlist; //!< Neighbors found by each thread (compact storage)
         GPUArray<Scalar4> m_last_pos;        //!< coordinates of last updated particle positions
         Scalar3 m_last_L;                    //!< Box lengths at last update
         Scalar3 m_last_L_local;              //!< Local Box lengths at last update
@@ -438,9 +553,17 @@ class NeighborList : public Compute
         boost::signals2::connection m_sort_connection;   //!< Connection to the ParticleData sort signal
         boost::signals2::connection m_max_particle_num_change_connection; //!< Connection to max particle number change signal
         boost::signals2::connection m_global_particle_num_change_connection; //!< Connection to global particle number change signal
+        boost::signals2::connection m_num_type_change_connection; //!< Connection to the number of types change signal
         #ifdef ENABLE_MPI
         boost::signals2::connection m_migrate_request_connection; //!< Connection to trigger particle migration
         boost::signals2::connection m_comm_flags_request;         //!< Connection to request ghost particle fields
+
+        GPUArray<unsigned int> m_interior_list; //!< Local particles, those without ghost neighbors first
+        unsigned int m_n_interior;              //!< Number of local particles without ghost neighbors
+        bool m_interior_list_valid;             //!< True if m_interior_list is current
+
+        //! Sort the local particles into those with and without ghost neighbors
+        void buildInteriorList();
         #endif
 
         //! Return true if we are supposed to do a distance check in this time step
@@ -461,12 +584,17 @@ class NeighborList : public Compute
         //! Filter the neighbor list of excluded particles
         virtual void filterNlist();
 
+        //! Copy the per thread neighbors into the compact neighbor list
+        void packCompactNlist();
+
         #ifdef ENABLE_MPI
         CommFlags getRequestedCommFlags(unsigned int timestep)
             {
             // exclusions require ghost particle tags
             CommFlags flags(0);
             if (m_exclusions_set) flags[comm_flag::tag] = 1;
+            // body filtering requires ghost particle body ids
+            if (m_filter_body) flags[comm_flag::body] = 1;
             return flags;
             }
         #endif
@@ -496,6 +624,9 @@ class NeighborList : public Compute
         //! Allocate the nlist array
         void allocateNlist();
 
+        //! Reset the head list to the default layout
+        void resetHeadList();
+
         //! Check the status of the conditions
         bool checkConditions();
 
@@ -508,6 +639,9 @@ class NeighborList : public Compute
         //! Grow the exclusions list memory capacity by one row
         void growExclusionList();
 
+        //! Reallocate the per type pair cutoffs and reset them to the maximum cutoff
+        void slotNumTypesChange();
+
         //! Method to be called when the global particle number changes
         void slotGlobalParticleNumberChange()
             {
@@ -62,6 +62,10 @@ using namespace boost::python;
 #include "Communicator.h"
 #endif
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 NeighborListBinned::NeighborListBinned(boost::shared_ptr<SystemDefinition> sysdef,
                                        Scalar r_cut,
                                        Scalar r_buff,
@@ -120,12 +124,14 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
     const BoxDim& box = m_pdata->getBox();
     Scalar3 nearest_plane_distance = box.getNearestPlaneDistance();
 
-    // start by creating a temporary copy of r_cut sqaured
-    Scalar rmax = m_r_cut + m_r_buff;
+    // every type pair includes neighbors up to its own cutoff plus the buffer
+    Scalar r_list_extra = m_r_buff;
     // add d_max - 1.0, if diameter filtering is not already taking care of it
     if (!m_filter_diameter)
-        rmax += m_d_max - Scalar(1.0);
-    Scalar rmaxsq = rmax*rmax;
+        r_list_extra += m_d_max - Scalar(1.0);
+    Scalar rmax = m_r_cut + r_list_extra;
+
+    ArrayHandle<Scalar> h_r_cut_pair(m_r_cut_pair, access_location::host, access_mode::read);
 
     if ((box.getPeriodic().x && nearest_plane_distance.x <= rmax * 2.0) ||
         (box.getPeriodic().y && nearest_plane_distance.y <= rmax * 2.0) ||
@@ -142,6 +148,7 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
 
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::readwrite);
 
     unsigned int conditions = 0;
 
@@ -156,13 +163,42 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
-    for (int i = 0; i < (int)nparticles; i++)
+    // every particle writes only its own row of the neighbor list, so the particles can be split among threads
+    #pragma omp parallel num_threads(m_exec_conf->n_cpu)
+    {
+    unsigned int tid = 0;
+    unsigned int n_threads = 1;
+    #ifdef ENABLE_OPENMP
+    tid = omp_get_thread_num();
+    n_threads = omp_get_num_threads();
+    #endif
+
+    unsigned int thread_conditions = 0;
+
+    // with compact storage, each thread collects the neighbors of its particles in its own row
+    if (m_compact)
+        {
+        #pragma omp single
+        m_thread_nlist.resize(n_threads);
+
+        m_thread_nlist[tid].clear();
+        }
+
+    // contiguous range of particles handled by this thread (packCompactNlist() relies on this order)
+    unsigned int n_start = (unsigned int)((unsigned long long)tid*nparticles/n_threads);
+    unsigned int n_end = (unsigned int)((unsigned long long)(tid+1)*nparticles/n_threads);
+
+    for (int i = (int)n_start; i < (int)n_end; i++)
         {
         unsigned int cur_n_neigh = 0;
 
+        if (m_compact)
+            h_head_list.data[i] = m_thread_nlist[tid].size();
+
         Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         unsigned int bodyi = h_body.data[i];
         Scalar di = h_diameter.data[i];
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
 
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(my_pos,ghost_width);
@@ -204,6 +240,10 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
                 if (m_filter_body && bodyi != NO_BODY)
                     excluded = excluded | (bodyi == h_body.data[cur_neigh]);
 
+                // list radius of this type pair
+                unsigned int typej = __scalar_as_int(h_pos.data[cur_neigh].w);
+                Scalar rlist = h_r_cut_pair.data[m_typpair_idx(typei, typej)] + r_list_extra;
+
                 Scalar sqshift = Scalar(0.0);
                 if (m_filter_diameter)
                     {
@@ -211,20 +251,22 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
                     Scalar delta = (di + h_diameter.data[cur_neigh]) * Scalar(0.5) - Scalar(1.0);
                     // r^2 < (r_max + delta)^2
                     // r^2 < r_maxsq + delta^2 + 2*r_max*delta
-                    sqshift = (delta + Scalar(2.0) * rmax) * delta;
+                    sqshift = (delta + Scalar(2.0) * rlist) * delta;
                     }
 
                 Scalar dr_sq = dot(dx,dx);
 
-                if (dr_sq <= (rmaxsq + sqshift) && !excluded)
+                if (dr_sq <= (rlist*rlist + sqshift) && !excluded)
                     {
                     if (m_storage_mode == full || i < (int)cur_neigh)
                         {
                         // local neighbor
-                        if (cur_n_neigh < m_nlist_indexer.getH())
+                        if (m_compact)
+                            m_thread_nlist[tid].push_back(cur_neigh);
+                        else if (cur_n_neigh < m_nlist_indexer.getH())
                             h_nlist.data[m_nlist_indexer(i, cur_n_neigh)] = cur_neigh;
                         else
-                            conditions = max(conditions, cur_n_neigh+1);
+                            thread_conditions = max(thread_conditions, cur_n_neigh+1);
 
                         cur_n_neigh++;
                         }
@@ -235,6 +277,11 @@ void NeighborListBinned::buildNlist(unsigned int timestep)
         h_n_neigh.data[i] = cur_n_neigh;
         }
 
+    // combine the overflow conditions of all threads
+    #pragma omp critical
+    conditions = max(conditions, thread_conditions);
+    } // end omp parallel
+
     // write out conditions
     m_conditions.resetFlags(conditions);
 
@@ -66,6 +66,12 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! Efficient neighbor list build on the CPU
 /*! Implements the O(N) neighbor list build on the CPU using a cell list.
 
+    The cell width is set by the maximum cutoff, and each candidate neighbor is checked against the list radius of its
+    own type pair (see NeighborList::setRCutPair()).
+
+    The loop over particles is split among ExecutionConfiguration::n_cpu threads. Each particle only writes its own
+    row of the neighbor list, so the result is the same for any number of threads.
+
     \ingroup computes
 */
 class NeighborListBinned : public NeighborList
@@ -63,6 +63,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <sstream>
 #include <stdexcept>
 #include <math.h>
+#include <algorithm>
 
 using namespace boost;
 using namespace boost::python;
@@ -86,8 +87,7 @@ const Scalar cpu_sinc_coeff[] = {Scalar(1.0), Scalar(-1.0/6.0), Scalar(1.0/120.0
 PPPMForceCompute::PPPMForceCompute(boost::shared_ptr<SystemDefinition> sysdef,
                                    boost::shared_ptr<NeighborList> nlist,
                                    boost::shared_ptr<ParticleGroup> group)
-    : ForceCompute(sysdef), m_params_set(false), m_nlist(nlist), m_group(group),
-      fft_in(NULL), fft_ex(NULL), fft_ey(NULL), fft_ez(NULL)
+    : ForceCompute(sysdef), m_params_set(false), m_nlist(nlist), m_group(group), m_half_spectrum(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing PPPMForceCompute" << endl;
 
@@ -96,20 +96,31 @@ PPPMForceCompute::PPPMForceCompute(boost::shared_ptr<SystemDefinition> sysdef,
 
     m_box_changed = false;
     m_boxchange_connection = m_pdata->connectBoxChange(bind(&PPPMForceCompute::slotBoxChanged, this));
+
+    m_n_local = make_uint3(0,0,0);
+    m_mesh_offset = make_uint3(0,0,0);
+    m_n_ghost = make_uint3(0,0,0);
+    m_grid_dim = make_uint3(0,0,0);
+    m_n_kspace = make_uint3(0,0,0);
+
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        m_fft_1d_forward[dir] = NULL;
+        m_fft_1d_inverse[dir] = NULL;
+#ifdef ENABLE_MPI
+        m_row_comm[dir] = MPI_COMM_NULL;
+#endif
+        }
     }
 
 PPPMForceCompute::~PPPMForceCompute()
     {
     m_exec_conf->msg->notice(5) << "Destroying PPPMForceCompute" << endl;
 
-    if (fft_in)
-        free(fft_in);
-    if (fft_ex)
-        free(fft_ex);
-    if (fft_ey)
-        free(fft_ey);
-    if (fft_ez)
-        free(fft_ez);
+    freeFFTPlans();
+#ifdef ENABLE_MPI
+    freeRowComms();
+#endif
 
     m_boxchange_connection.disconnect();
     }
@@ -132,7 +143,6 @@ void PPPMForceCompute::setParams(int Nx, int Ny, int Nz, int order, Scalar kappa
     m_order = order;
     m_kappa = kappa;
     m_rcut = rcut;
-    first_run = 0;
 
     if(!(m_Nx == 2)&& !(m_Nx == 4)&& !(m_Nx == 8)&& !(m_Nx == 16)&& !(m_Nx == 32)&& !(m_Nx == 64)&& !(m_Nx == 128)&& !(m_Nx == 256)&& !(m_Nx == 512)&& !(m_Nx == 1024))
         {
@@ -157,30 +167,17 @@ void PPPMForceCompute::setParams(int Nx, int Ny, int Nz, int order, Scalar kappa
         throw std::runtime_error("Error initializing PPPMForceCompute");
         }
 
-    GPUArray<CUFFTCOMPLEX> n_rho_real_space(Nx*Ny*Nz, exec_conf);
-    m_rho_real_space.swap(n_rho_real_space);
-    GPUArray<Scalar> n_green_hat(Nx*Ny*Nz, exec_conf);
-    m_green_hat.swap(n_green_hat);
-
-    GPUArray<Scalar> n_vg(6*Nx*Ny*Nz, exec_conf);
-    m_vg.swap(n_vg);
-
-
-    GPUArray<Scalar3> n_kvec(Nx*Ny*Nz, exec_conf);
-    m_kvec.swap(n_kvec);
-    GPUArray<CUFFTCOMPLEX> n_Ex(Nx*Ny*Nz, exec_conf);
-    m_Ex.swap(n_Ex);
-    GPUArray<CUFFTCOMPLEX> n_Ey(Nx*Ny*Nz, exec_conf);
-    m_Ey.swap(n_Ey);
-    GPUArray<CUFFTCOMPLEX> n_Ez(Nx*Ny*Nz, exec_conf);
-    m_Ez.swap(n_Ez);
     GPUArray<Scalar> n_gf_b(order, exec_conf);
     m_gf_b.swap(n_gf_b);
     GPUArray<Scalar> n_rho_coeff(order*(2*order+1), exec_conf);
     m_rho_coeff.swap(n_rho_coeff);
     GPUArray<Scalar3> n_field(Nx*Ny*Nz, exec_conf);
     m_field.swap(n_field);
-    const BoxDim& box = m_pdata->getBox();
+
+    // allocate the (local) mesh
+    setupMesh();
+
+    const BoxDim& box = m_pdata->getGlobalBox();
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     // get system charge
@@ -190,6 +187,13 @@ void PPPMForceCompute::setParams(int Nx, int Ny, int Nz, int order, Scalar kappa
         m_q += h_charge.data[i];
         m_q2 += h_charge.data[i]*h_charge.data[i];
         }
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &m_q, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &m_q2, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_exec_conf->getMPICommunicator());
+        }
+#endif
     if(fabs(m_q) > 0.0)
         m_exec_conf->msg->warning() << "charge.pppm: system in not neutral, the net charge is " << m_q << endl;
 
@@ -198,18 +202,21 @@ void PPPMForceCompute::setParams(int Nx, int Ny, int Nz, int order, Scalar kappa
     Scalar hx =  L.x/(Scalar)Nx;
     Scalar hy =  L.y/(Scalar)Ny;
     Scalar hz =  L.z/(Scalar)Nz;
-    Scalar lprx = PPPMForceCompute::rms(hx, L.x, (int)m_pdata->getN());
-    Scalar lpry = PPPMForceCompute::rms(hy, L.y, (int)m_pdata->getN());
-    Scalar lprz = PPPMForceCompute::rms(hz, L.z, (int)m_pdata->getN());
+    Scalar lprx = PPPMForceCompute::rms(hx, L.x, (int)m_pdata->getNGlobal());
+    Scalar lpry = PPPMForceCompute::rms(hy, L.y, (int)m_pdata->getNGlobal());
+    Scalar lprz = PPPMForceCompute::rms(hz, L.z, (int)m_pdata->getNGlobal());
     Scalar lpr = sqrt(lprx*lprx + lpry*lpry + lprz*lprz) / sqrt(3.0);
-    Scalar spr = 2.0*m_q2*exp(-m_kappa*m_kappa*m_rcut*m_rcut) / sqrt((int)m_pdata->getN()*m_rcut*L.x*L.y*L.z);
+    Scalar spr = 2.0*m_q2*exp(-m_kappa*m_kappa*m_rcut*m_rcut) / sqrt((int)m_pdata->getNGlobal()*m_rcut*L.x*L.y*L.z);
 
     double RMS_error = MAX(lpr,spr);
-    if(RMS_error > 0.1) {
-        printf("!!!!!!!\n!!!!!!!\n!!!!!!!\nWARNING RMS error of %g is probably too high %f %f\n!!!!!!!\n!!!!!!!\n!!!!!!!\n", RMS_error, lpr, spr);
-        }
-    else{
-        printf("Notice: PPPM RMS error: %g\n", RMS_error);
+    if (m_exec_conf->getRank() == 0)
+        {
+        if(RMS_error > 0.1) {
+            printf("!!!!!!!\n!!!!!!!\n!!!!!!!\nWARNING RMS error of %g is probably too high %f %f\n!!!!!!!\n!!!!!!!\n!!!!!!!\n", RMS_error, lpr, spr);
+            }
+        else{
+            printf("Notice: PPPM RMS error: %g\n", RMS_error);
+            }
         }
 
     PPPMForceCompute::compute_rho_coeff();
@@ -221,6 +228,156 @@ void PPPMForceCompute::setParams(int Nx, int Ny, int Nz, int order, Scalar kappa
     m_energy_virial_factor = 0.5 * L.x * L.y * L.z * scale * scale;
     }
 
+/*! Determines the block of the global mesh owned by this rank and the width of the ghost layer around it, and
+    allocates all arrays defined on the local mesh. Without domain decomposition, the local block is the full mesh.
+*/
+void PPPMForceCompute::setupMesh()
+    {
+    m_n_local = make_uint3(m_Nx, m_Ny, m_Nz);
+    m_mesh_offset = make_uint3(0,0,0);
+    m_n_ghost = make_uint3(0,0,0);
+
+#ifdef ENABLE_MPI
+    boost::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        const Index3D& di = decomposition->getDomainIndexer();
+        uint3 grid_pos = decomposition->getGridPos();
+
+        // split the mesh along the domain boundaries, which need not be spaced uniformly
+        int n_global[3] = {m_Nx, m_Ny, m_Nz};
+        for (unsigned int dir = 0; dir < 3; dir++)
+            {
+            const std::vector<Scalar>& cum_frac = decomposition->getCumulativeFractions(dir);
+            m_mesh_bounds[dir].resize(cum_frac.size());
+            for (unsigned int i = 0; i < cum_frac.size(); i++)
+                m_mesh_bounds[dir][i] = (unsigned int)(cum_frac[i]*Scalar(n_global[dir]) + Scalar(0.5));
+            }
+        m_mesh_offset.x = m_mesh_bounds[0][grid_pos.x];
+        m_mesh_offset.y = m_mesh_bounds[1][grid_pos.y];
+        m_mesh_offset.z = m_mesh_bounds[2][grid_pos.z];
+        m_n_local.x = m_mesh_bounds[0][grid_pos.x+1] - m_mesh_offset.x;
+        m_n_local.y = m_mesh_bounds[1][grid_pos.y+1] - m_mesh_offset.y;
+        m_n_local.z = m_mesh_bounds[2][grid_pos.z+1] - m_mesh_offset.z;
+
+        // the ghost layer has to hold the assignment stencil of particles up to r_buff/2 outside the local box,
+        // plus one mesh point for the rounding of the block boundaries. Directions that are not decomposed
+        // span the global mesh and are wrapped periodically instead
+        Scalar3 plane_dist = m_pdata->getGlobalBox().getNearestPlaneDistance();
+        Scalar r_skin = Scalar(0.5)*m_nlist->getRBuff();
+        if (di.getW() > 1)
+            m_n_ghost.x = m_order/2 + 2 + (unsigned int)ceil(r_skin/plane_dist.x*(Scalar)m_Nx);
+        if (di.getH() > 1)
+            m_n_ghost.y = m_order/2 + 2 + (unsigned int)ceil(r_skin/plane_dist.y*(Scalar)m_Ny);
+        if (di.getD() > 1)
+            m_n_ghost.z = m_order/2 + 2 + (unsigned int)ceil(r_skin/plane_dist.z*(Scalar)m_Nz);
+
+        // ghost cells are only exchanged with the direct neighbors
+        int too_thin = (m_n_local.x < m_n_ghost.x || m_n_local.y < m_n_ghost.y || m_n_local.z < m_n_ghost.z);
+        MPI_Allreduce(MPI_IN_PLACE, &too_thin, 1, MPI_INT, MPI_MAX, m_exec_conf->getMPICommunicator());
+        if (too_thin)
+            {
+            m_exec_conf->msg->error() << "charge.pppm: The local mesh (" << m_n_local.x << "x" << m_n_local.y
+                                      << "x" << m_n_local.z << ") is thinner than the ghost layer ("
+                                      << m_n_ghost.x << "x" << m_n_ghost.y << "x" << m_n_ghost.z << ")." << endl
+                                      << "Use more mesh points or fewer processors." << endl;
+            throw std::runtime_error("Error initializing PPPMForceCompute");
+            }
+
+        // set up the communicators for the FFT transposes, ranks are ordered by their position in the row
+        freeRowComms();
+        MPI_Comm comm = m_exec_conf->getMPICommunicator();
+        MPI_Comm_split(comm, grid_pos.y + di.getH()*grid_pos.z, grid_pos.x, &m_row_comm[0]);
+        MPI_Comm_split(comm, grid_pos.x + di.getW()*grid_pos.z, grid_pos.y, &m_row_comm[1]);
+        MPI_Comm_split(comm, grid_pos.x + di.getW()*grid_pos.y, grid_pos.z, &m_row_comm[2]);
+
+        // the pencil transposes operate on the full spectrum
+        m_half_spectrum = false;
+        }
+#endif
+
+    freeFFTPlans();
+    int dim[3] = {m_Nx, m_Ny, m_Nz};
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        m_fft_1d_forward[dir] = kiss_fft_alloc(dim[dir], 0, NULL, NULL);
+        m_fft_1d_inverse[dir] = kiss_fft_alloc(dim[dir], 1, NULL, NULL);
+        }
+
+    // the spectrum is stored for the same block of wave vectors as the local mesh, but only for k_z >= 0
+    // when using real-to-complex transforms
+    m_n_kspace = m_n_local;
+    if (m_half_spectrum)
+        m_n_kspace.z = m_Nz/2 + 1;
+
+    m_grid_dim = make_uint3(m_n_local.x + 2*m_n_ghost.x,
+                            m_n_local.y + 2*m_n_ghost.y,
+                            m_n_local.z + 2*m_n_ghost.z);
+
+    unsigned int n_kspace = m_n_kspace.x*m_n_kspace.y*m_n_kspace.z;
+    unsigned int n_grid = m_grid_dim.x*m_grid_dim.y*m_grid_dim.z;
+
+    GPUArray<CUFFTCOMPLEX> n_rho_real_space(n_kspace, exec_conf);
+    m_rho_real_space.swap(n_rho_real_space);
+    GPUArray<Scalar> n_green_hat(n_kspace, exec_conf);
+    m_green_hat.swap(n_green_hat);
+
+    GPUArray<Scalar> n_vg(6*n_kspace, exec_conf);
+    m_vg.swap(n_vg);
+
+    GPUArray<Scalar3> n_kvec(n_kspace, exec_conf);
+    m_kvec.swap(n_kvec);
+    GPUArray<CUFFTCOMPLEX> n_Ex(n_kspace, exec_conf);
+    m_Ex.swap(n_Ex);
+    GPUArray<CUFFTCOMPLEX> n_Ey(n_kspace, exec_conf);
+    m_Ey.swap(n_Ey);
+    GPUArray<CUFFTCOMPLEX> n_Ez(n_kspace, exec_conf);
+    m_Ez.swap(n_Ez);
+
+    GPUArray<Scalar> n_rho_grid(n_grid, exec_conf);
+    m_rho_grid.swap(n_rho_grid);
+    GPUArray<Scalar> n_field_grid(3*n_grid, exec_conf);
+    m_field_grid.swap(n_field_grid);
+    }
+
+/*! \param idx Global index of the mesh point closest to a particle, converted to the index on the local mesh
+    \returns false if the assignment stencil around \a idx does not fit into the local mesh
+*/
+bool PPPMForceCompute::getLocalMeshIndex(int3& idx)
+    {
+    int nlower = -(m_order-1)/2;
+    int nupper = m_order/2;
+
+    int *i[3] = {&idx.x, &idx.y, &idx.z};
+    int n_global[3] = {m_Nx, m_Ny, m_Nz};
+    int n_local[3] = {(int)m_n_local.x, (int)m_n_local.y, (int)m_n_local.z};
+    int offset[3] = {(int)m_mesh_offset.x, (int)m_mesh_offset.y, (int)m_mesh_offset.z};
+    int n_ghost[3] = {(int)m_n_ghost.x, (int)m_n_ghost.y, (int)m_n_ghost.z};
+
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        // directions without ghost cells span the global mesh and are wrapped around when assigning
+        if (n_ghost[dir] == 0)
+            continue;
+
+        int j = *i[dir] - offset[dir];
+
+        // the particle may have been wrapped across the global boundary since it was last migrated
+        if (j < -n_ghost[dir])
+            j += n_global[dir];
+        else if (j >= n_local[dir] + n_ghost[dir])
+            j -= n_global[dir];
+
+        j += n_ghost[dir];
+        if (j + nlower < 0 || j + nupper >= n_local[dir] + 2*n_ghost[dir])
+            return false;
+
+        *i[dir] = j;
+        }
+
+    return true;
+    }
+
 std::vector< std::string > PPPMForceCompute::getProvidedLogQuantities()
     {
     vector<string> list;
@@ -263,27 +420,18 @@ void PPPMForceCompute::computeForces(unsigned int timestep)
 
     // start the profile for this compute
     if (m_prof) m_prof->push("PPPM force");
-    int dim[3];
-    dim[0] = m_Nx;
-    dim[1] = m_Ny;
-    dim[2] = m_Nz;
-
-    if(first_run == 0)
-        {
-        first_run = 1;
-        fft_in = (kiss_fft_cpx *)malloc(m_Nx*m_Ny*m_Nz*sizeof(kiss_fft_cpx));
-        fft_ex = (kiss_fft_cpx *)malloc(m_Nx*m_Ny*m_Nz*sizeof(kiss_fft_cpx));
-        fft_ey = (kiss_fft_cpx *)malloc(m_Nx*m_Ny*m_Nz*sizeof(kiss_fft_cpx));
-        fft_ez = (kiss_fft_cpx *)malloc(m_Nx*m_Ny*m_Nz*sizeof(kiss_fft_cpx));
-
-        fft_forward = kiss_fftnd_alloc(dim, 3, 0, NULL, NULL);
-        fft_inverse = kiss_fftnd_alloc(dim, 3, 1, NULL, NULL);
-        }
 
     if(m_box_changed)
         {
-        const BoxDim& box = m_pdata->getBox();
+        const BoxDim& box = m_pdata->getGlobalBox();
         Scalar3 L = box.getL();
+
+#ifdef ENABLE_MPI
+        // the width of the ghost layer depends on the box
+        if (m_pdata->getDomainDecomposition())
+            setupMesh();
+#endif
+
         PPPMForceCompute::reset_kvec_green_hat_cpu();
         Scalar scale = Scalar(1.0)/((Scalar)(m_Nx * m_Ny * m_Nz));
         m_energy_virial_factor = 0.5 * L.x * L.y * L.z * scale * scale;
@@ -291,64 +439,9 @@ void PPPMForceCompute::computeForces(unsigned int timestep)
         }
 
     PPPMForceCompute::assign_charges_to_grid();
-
-//FFTs go next
-
-        { // scoping array handles
-        ArrayHandle<CUFFTCOMPLEX> h_rho_real_space(m_rho_real_space, access_location::host, access_mode::readwrite);
-        for(int i = 0; i < m_Nx * m_Ny * m_Nz ; i++) {
-            fft_in[i].r = (Scalar) h_rho_real_space.data[i].x;
-            fft_in[i].i = (Scalar)0.0;
-            }
-
-        kiss_fftnd(fft_forward, &fft_in[0], &fft_in[0]);
-
-        for(int i = 0; i < m_Nx * m_Ny * m_Nz ; i++) {
-            h_rho_real_space.data[i].x = fft_in[i].r;
-            h_rho_real_space.data[i].y = fft_in[i].i;
-
-            }
-        }
-
+    PPPMForceCompute::forwardFFT();
     PPPMForceCompute::combined_green_e();
-
-//More FFTs
-
-        { // scoping array handles
-        ArrayHandle<CUFFTCOMPLEX> h_Ex(m_Ex, access_location::host, access_mode::readwrite);
-        ArrayHandle<CUFFTCOMPLEX> h_Ey(m_Ey, access_location::host, access_mode::readwrite);
-        ArrayHandle<CUFFTCOMPLEX> h_Ez(m_Ez, access_location::host, access_mode::readwrite);
-
-        for(int i = 0; i < m_Nx * m_Ny * m_Nz ; i++)
-            {
-            fft_ex[i].r = (Scalar) h_Ex.data[i].x;
-            fft_ex[i].i = (Scalar) h_Ex.data[i].y;
-
-            fft_ey[i].r = (Scalar) h_Ey.data[i].x;
-            fft_ey[i].i = (Scalar) h_Ey.data[i].y;
-
-            fft_ez[i].r = (Scalar) h_Ez.data[i].x;
-            fft_ez[i].i = (Scalar) h_Ez.data[i].y;
-            }
-
-
-        kiss_fftnd(fft_inverse, &fft_ex[0], &fft_ex[0]);
-        kiss_fftnd(fft_inverse, &fft_ey[0], &fft_ey[0]);
-        kiss_fftnd(fft_inverse, &fft_ez[0], &fft_ez[0]);
-
-        for(int i = 0; i < m_Nx * m_Ny * m_Nz ; i++)
-            {
-            h_Ex.data[i].x = fft_ex[i].r;
-            h_Ex.data[i].y = fft_ex[i].i;
-
-            h_Ey.data[i].x = fft_ey[i].r;
-            h_Ey.data[i].y = fft_ey[i].i;
-
-            h_Ez.data[i].x = fft_ez[i].r;
-            h_Ez.data[i].y = fft_ez[i].i;
-            }
-        }
-
+    PPPMForceCompute::inverseFFT();
     PPPMForceCompute::calculate_forces();
 
     // If there are exclusions, correct for the long-range part of the potential
@@ -511,10 +604,37 @@ inline Scalar sinc(Scalar x)
     return sinc;
     }
 
+//! Wave number of the mesh point \a i along a direction with \a n mesh points
+inline int wave_number(int i, int n)
+    {
+    return i > n/2 ? i - n : i;
+    }
+
+//! Computes the virial coefficients of a mode with wave vector \a kvec
+inline void compute_vg(const Scalar3& kvec, Scalar kappa, Scalar *vg)
+    {
+    Scalar sqk = dot(kvec, kvec);
+    if (sqk == 0.0)
+        {
+        for (unsigned int c = 0; c < 6; c++)
+            vg[c] = Scalar(0.0);
+        }
+    else
+        {
+        Scalar vterm = -2.0 * (1.0/sqk + 0.25/(kappa*kappa));
+        vg[0] =  1.0 + vterm*kvec.x*kvec.x;
+        vg[1] =        vterm*kvec.x*kvec.y;
+        vg[2] =        vterm*kvec.x*kvec.z;
+        vg[3] =  1.0 + vterm*kvec.y*kvec.y;
+        vg[4] =        vterm*kvec.y*kvec.z;
+        vg[5] =  1.0 + vterm*kvec.z*kvec.z;
+        }
+    }
+
 void PPPMForceCompute::reset_kvec_green_hat_cpu()
     {
     ArrayHandle<Scalar3> h_kvec(m_kvec, access_location::host, access_mode::readwrite);
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
     Scalar3 L = box.getL();
 
     // compute reciprocal lattice vectors
@@ -527,52 +647,55 @@ void PPPMForceCompute::reset_kvec_green_hat_cpu()
     Scalar3 b2 = Scalar(2.0*M_PI)*make_scalar3(a3.y*a1.z-a3.z*a1.y, a3.z*a1.x-a3.x*a1.z, a3.x*a1.y-a3.y*a1.x)/V_box;
     Scalar3 b3 = Scalar(2.0*M_PI)*make_scalar3(a1.y*a2.z-a1.z*a2.y, a1.z*a2.x-a1.x*a2.z, a1.x*a2.y-a1.y*a2.x)/V_box;
 
-    // Set up the k-vectors
+    // only the wave vectors in the local block of the spectrum are needed
+    int nx_local = m_n_kspace.x;
+    int ny_local = m_n_kspace.y;
+    int nz_local = m_n_kspace.z;
+
+    // Set up the k-vectors. The field is real on the mesh, so only the antisymmetric part of k contributes to it.
+    // This part vanishes along directions where the wave number is the Nyquist frequency (N/2 for even N), which
+    // makes the spectrum of the field exactly Hermitian
     int ix, iy, iz, kper, lper, mper, k, l, m;
-    for (ix = 0; ix < m_Nx; ix++) {
+    for (int ix_local = 0; ix_local < nx_local; ix_local++) {
+        ix = ix_local + m_mesh_offset.x;
         Scalar3 j;
-        j.x = ix > m_Nx/2 ? ix - m_Nx : ix;
-        for (iy = 0; iy < m_Ny; iy++) {
-            j.y = iy > m_Ny/2 ? iy - m_Ny : iy;
-            for (iz = 0; iz < m_Nz; iz++) {
-                j.z = iz > m_Nz/2 ? iz - m_Nz : iz;
-                h_kvec.data[iz + m_Nz * (iy + m_Ny * ix)] =  j.x*b1+j.y*b2+j.z*b3;
+        j.x = (2*ix == m_Nx) ? 0 : wave_number(ix, m_Nx);
+        for (int iy_local = 0; iy_local < ny_local; iy_local++) {
+            iy = iy_local + m_mesh_offset.y;
+            j.y = (2*iy == m_Ny) ? 0 : wave_number(iy, m_Ny);
+            for (int iz_local = 0; iz_local < nz_local; iz_local++) {
+                iz = iz_local + m_mesh_offset.z;
+                j.z = (2*iz == m_Nz) ? 0 : wave_number(iz, m_Nz);
+                h_kvec.data[iz_local + nz_local * (iy_local + ny_local * ix_local)] =  j.x*b1+j.y*b2+j.z*b3;
                 }
             }
         }
 
     // Set up constants for virial calculation
     ArrayHandle<Scalar> h_vg(m_vg, access_location::host, access_mode::readwrite);;
-    for(int x = 0; x < m_Nx; x++)
+    for(int x = 0; x < nx_local; x++)
         {
-        for(int y = 0; y < m_Ny; y++)
+        ix = x + m_mesh_offset.x;
+        for(int y = 0; y < ny_local; y++)
             {
-            for(int z = 0; z < m_Nz; z++)
+            iy = y + m_mesh_offset.y;
+            for(int z = 0; z < nz_local; z++)
                 {
-                Scalar3 kvec = h_kvec.data[z + m_Nz * (y + m_Ny * x)];
-                Scalar sqk =  kvec.x*kvec.x;
-                sqk += kvec.y*kvec.y;
-                sqk += kvec.z*kvec.z;
+                iz = z + m_mesh_offset.z;
+                int grid_point = z + nz_local * (y + ny_local * x);
+                Scalar3 kvec = wave_number(ix, m_Nx)*b1 + wave_number(iy, m_Ny)*b2 + wave_number(iz, m_Nz)*b3;
+                compute_vg(kvec, m_kappa, &h_vg.data[6*grid_point]);
 
-                int grid_point = z + m_Nz * (y + m_Ny * x);
-                if (sqk == 0.0)
-                    {
-                    h_vg.data[0 + 6*grid_point] = Scalar(0.0);
-                    h_vg.data[1 + 6*grid_point] = Scalar(0.0);
-                    h_vg.data[2 + 6*grid_point] = Scalar(0.0);
-                    h_vg.data[3 + 6*grid_point] = Scalar(0.0);
-                    h_vg.data[4 + 6*grid_point] = Scalar(0.0);
-                    h_vg.data[5 + 6*grid_point] = Scalar(0.0);
-                    }
-                else
+                // in the half spectrum, the modes with 0 < k_z < Nz/2 also account for their -k partners
+                if (m_half_spectrum && iz > 0 && 2*iz < m_Nz)
                     {
-                    Scalar vterm = -2.0 * (1.0/sqk + 0.25/(m_kappa*m_kappa));
-                    h_vg.data[0 + 6*grid_point] =  1.0 + vterm*kvec.x*kvec.x;
-                    h_vg.data[1 + 6*grid_point] =        vterm*kvec.x*kvec.y;
-                    h_vg.data[2 + 6*grid_point] =        vterm*kvec.x*kvec.z;
-                    h_vg.data[3 + 6*grid_point] =  1.0 + vterm*kvec.y*kvec.y;
-                    h_vg.data[4 + 6*grid_point] =        vterm*kvec.y*kvec.z;
-                    h_vg.data[5 + 6*grid_point] =  1.0 + vterm*kvec.z*kvec.z;
+                    Scalar3 kvec_partner = wave_number((m_Nx-ix) % m_Nx, m_Nx)*b1
+                                           + wave_number((m_Ny-iy) % m_Ny, m_Ny)*b2
+                                           + wave_number(m_Nz-iz, m_Nz)*b3;
+                    Scalar vg_partner[6];
+                    compute_vg(kvec_partner, m_kappa, vg_partner);
+                    for (unsigned int c = 0; c < 6; c++)
+                        h_vg.data[c + 6*grid_point] += vg_partner[c];
                     }
                 }
             }
@@ -612,17 +735,20 @@ void PPPMForceCompute::reset_kvec_green_hat_cpu()
     Scalar3 kvec,kn, kn1, kn2, kn3;
     Scalar arg_gauss, gauss;
 
-    for (m = 0; m < m_Nz; m++) {
+    for (int m_local = 0; m_local < nz_local; m_local++) {
+        m = m_local + m_mesh_offset.z;
         mper = m - m_Nz*(2*m/m_Nz);
         snz = sin(0.5*kH.z*mper);
         snz2 = snz*snz;
 
-        for (l = 0; l < m_Ny; l++) {
+        for (int l_local = 0; l_local < ny_local; l_local++) {
+            l = l_local + m_mesh_offset.y;
             lper = l - m_Ny*(2*l/m_Ny);
             sny = sin(0.5*kH.y*lper);
             sny2 = sny*sny;
 
-            for (k = 0; k < m_Nx; k++) {
+            for (int k_local = 0; k_local < nx_local; k_local++) {
+                k = k_local + m_mesh_offset.x;
                 kper = k - m_Nx*(2*k/m_Nx);
                 snx = sin(0.5*kH.x*kper);
                 snx2 = snx*snx;
@@ -663,8 +789,8 @@ void PPPMForceCompute::reset_kvec_green_hat_cpu()
                                 }
                             }
                         }
-                    h_green_hat.data[m + m_Nz * (l + m_Ny * k)] = numerator*sum1/denominator;
-                    } else h_green_hat.data[m + m_Nz * (l + m_Ny * k)] = 0.0;
+                    h_green_hat.data[m_local + nz_local * (l_local + ny_local * k_local)] = numerator*sum1/denominator;
+                    } else h_green_hat.data[m_local + nz_local * (l_local + ny_local * k_local)] = 0.0;
                 }
             }
         }
@@ -673,15 +799,19 @@ void PPPMForceCompute::reset_kvec_green_hat_cpu()
 void PPPMForceCompute::assign_charges_to_grid()
     {
 
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
-    ArrayHandle<CUFFTCOMPLEX> h_rho_real_space(m_rho_real_space, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_rho_grid(m_rho_grid, access_location::host, access_mode::overwrite);
 
-    memset(h_rho_real_space.data, 0, sizeof(CUFFTCOMPLEX)*m_Nx*m_Ny*m_Nz);
+    // charges are assigned to the local mesh including ghost cells
+    int grid_x = m_grid_dim.x;
+    int grid_y = m_grid_dim.y;
+    int grid_z = m_grid_dim.z;
+    memset(h_rho_grid.data, 0, sizeof(Scalar)*grid_x*grid_y*grid_z);
 
     Scalar V_cell = box.getVolume()/(Scalar)(m_Nx*m_Ny*m_Nz);
 
@@ -724,6 +854,16 @@ void PPPMForceCompute::assign_charges_to_grid()
         dy = shiftone+(Scalar)nyi-pos_frac.y;
         dz = shiftone+(Scalar)nzi-pos_frac.z;
 
+        int3 idx = make_int3(nxi, nyi, nzi);
+        if (!getLocalMeshIndex(idx))
+            {
+            m_exec_conf->msg->error() << "charge.pppm: Particle " << i << " is too far outside the local domain" << endl;
+            throw std::runtime_error("Error computing PPPM forces");
+            }
+        nxi = idx.x;
+        nyi = idx.y;
+        nzi = idx.z;
+
         int n,m,l,k;
         Scalar result;
         int mult_fact = 2*m_order+1;
@@ -731,8 +871,8 @@ void PPPMForceCompute::assign_charges_to_grid()
         x0 = qi / V_cell;
         for (n = nlower; n <= nupper; n++) {
             mx = n+nxi;
-            if(mx >= m_Nx) mx -= m_Nx;
-            if(mx < 0)  mx += m_Nx;
+            if(mx >= grid_x) mx -= grid_x;
+            if(mx < 0)  mx += grid_x;
             result = Scalar(0.0);
             for (k = m_order-1; k >= 0; k--) {
                 result = h_rho_coeff.data[n-nlower + k*mult_fact] + result * dx;
@@ -740,8 +880,8 @@ void PPPMForceCompute::assign_charges_to_grid()
             y0 = x0*result;
             for (m = nlower; m <= nupper; m++) {
                 my = m+nyi;
-                if(my >= m_Ny) my -= m_Ny;
-                if(my < 0)  my += m_Ny;
+                if(my >= grid_y) my -= grid_y;
+                if(my < 0)  my += grid_y;
                 result = Scalar(0.0);
                 for (k = m_order-1; k >= 0; k--) {
                     result = h_rho_coeff.data[m-nlower + k*mult_fact] + result * dy;
@@ -749,32 +889,224 @@ void PPPMForceCompute::assign_charges_to_grid()
                 z0 = y0*result;
                 for (l = nlower; l <= nupper; l++) {
                     mz = l+nzi;
-                    if(mz >= m_Nz) mz -= m_Nz;
-                    if(mz < 0)  mz += m_Nz;
+                    if(mz >= grid_z) mz -= grid_z;
+                    if(mz < 0)  mz += grid_z;
                     result = Scalar(0.0);
                     for (k = m_order-1; k >= 0; k--) {
                         result = h_rho_coeff.data[l-nlower + k*mult_fact] + result * dz;
                         }
-                    h_rho_real_space.data[mz + m_Nz * (my + m_Ny * mx)].x += z0*result;
+                    h_rho_grid.data[mz + grid_z * (my + grid_y * mx)] += z0*result;
                     }
                 }
             }
         }
 
+#ifdef ENABLE_MPI
+    // add the charge assigned to ghost cells to the ranks that own them
+    if (m_pdata->getDomainDecomposition())
+        reduceGhostCells(h_rho_grid.data, 1);
+#endif
     }
 
+/*! \param cfg Forward 1D FFT plan of length \a n
+    \param n Length of the mesh lines
+    \param a First real mesh line
+    \param b Second real mesh line, may be NULL
+    \param A Output, the n/2+1 lowest Fourier coefficients of \a a
+    \param B Output, the n/2+1 lowest Fourier coefficients of \a b (ignored if \a b is NULL)
+    \param buf Scratch space for 2*n complex numbers
+
+    Both real lines are transformed with a single complex FFT of c = a + i b. Their spectra are separated using
+    the Hermitian symmetry of the transform of a real sequence.
+*/
+inline void realLinesToHalfSpectrum(kiss_fft_cfg cfg, unsigned int n, const Scalar *a, const Scalar *b,
+                                    kiss_fft_cpx *A, kiss_fft_cpx *B, kiss_fft_cpx *buf)
+    {
+    kiss_fft_cpx *c = buf;
+    kiss_fft_cpx *C = buf + n;
+    for (unsigned int k = 0; k < n; k++)
+        {
+        c[k].r = a[k];
+        c[k].i = b ? b[k] : Scalar(0.0);
+        }
+
+    kiss_fft(cfg, c, C);
+
+    for (unsigned int k = 0; k <= n/2; k++)
+        {
+        kiss_fft_cpx Ck = C[k];
+        kiss_fft_cpx Cm = C[(n-k) % n];
+        A[k].r = Scalar(0.5)*(Ck.r + Cm.r);
+        A[k].i = Scalar(0.5)*(Ck.i - Cm.i);
+        if (b)
+            {
+            B[k].r = Scalar(0.5)*(Ck.i + Cm.i);
+            B[k].i = Scalar(0.5)*(Cm.r - Ck.r);
+            }
+        }
+    }
+
+/*! \param cfg Inverse 1D FFT plan of length \a n
+    \param n Length of the mesh lines
+    \param A The n/2+1 lowest Fourier coefficients of the first line
+    \param B The n/2+1 lowest Fourier coefficients of the second line, may be NULL
+    \param a Output, first real mesh line
+    \param b Output, second real mesh line (ignored if \a B is NULL)
+    \param stride Distance between the elements of \a a and \a b
+    \param buf Scratch space for 2*n complex numbers
+
+    The inverse of realLinesToHalfSpectrum(). The full spectrum of c = a + i b is reconstructed from the half spectra
+    of \a a and \a b and transformed with a single complex FFT. Only the real parts of the k = 0 and k = n/2 (for
+    even n) coefficients contribute, as for the real part of a complex transform.
+*/
+inline void halfSpectrumToRealLines(kiss_fft_cfg cfg, unsigned int n, const kiss_fft_cpx *A, const kiss_fft_cpx *B,
+                                    Scalar *a, Scalar *b, unsigned int stride, kiss_fft_cpx *buf)
+    {
+    kiss_fft_cpx *C = buf;
+    kiss_fft_cpx *c = buf + n;
+    for (unsigned int k = 0; k <= n/2; k++)
+        {
+        kiss_fft_cpx Ak = A[k];
+        kiss_fft_cpx Bk;
+        if (B)
+            Bk = B[k];
+        else
+            Bk.r = Bk.i = Scalar(0.0);
+        if (k == 0 || 2*k == n)
+            {
+            Ak.i = Scalar(0.0);
+            Bk.i = Scalar(0.0);
+            }
+
+        C[k].r = Ak.r - Bk.i;
+        C[k].i = Ak.i + Bk.r;
+        if (k > 0 && 2*k < n)
+            {
+            C[n-k].r = Ak.r + Bk.i;
+            C[n-k].i = Bk.r - Ak.i;
+            }
+        }
+
+    kiss_fft(cfg, C, c);
+
+    for (unsigned int k = 0; k < n; k++)
+        {
+        a[k*stride] = c[k].r;
+        if (B)
+            b[k*stride] = c[k].i;
+        }
+    }
+
+/*! \param data Half spectrum (in memory order z, y, x), transformed in place
+    \param inverse True if the inverse FFT is to be performed
+
+    Performs the complex 1D FFTs along y and x of all lines of the half spectrum, in the order y, x for the forward
+    and x, y for the inverse transform.
+*/
+void PPPMForceCompute::transformHalfSpectrumXY(kiss_fft_cpx *data, bool inverse)
+    {
+    unsigned int nz = m_n_kspace.z;
+    unsigned int n[2] = {(unsigned int)m_Ny, (unsigned int)m_Nx};
+    unsigned int stride[2] = {nz, nz*m_Ny};
+    unsigned int n_outer[2] = {(unsigned int)m_Nx, 1};
+    unsigned int outer_stride[2] = {nz*m_Ny, 0};
+    unsigned int n_inner[2] = {nz, nz*m_Ny};
+
+    m_fft_line_buf.resize(std::max(m_Nx, m_Ny));
+    kiss_fft_cpx *line_out = &m_fft_line_buf[0];
+
+    for (unsigned int pass = 0; pass < 2; pass++)
+        {
+        // y is transformed first in the forward direction, and last in the inverse direction
+        unsigned int d = inverse ? 1 - pass : pass;
+        kiss_fft_cfg cfg = inverse ? m_fft_1d_inverse[1-d] : m_fft_1d_forward[1-d];
+
+        for (unsigned int o = 0; o < n_outer[d]; o++)
+            for (unsigned int i = 0; i < n_inner[d]; i++)
+                {
+                kiss_fft_cpx *line = data + o*outer_stride[d] + i;
+                kiss_fft_stride(cfg, line, line_out, stride[d]);
+                for (unsigned int k = 0; k < n[d]; k++)
+                    line[k*stride[d]] = line_out[k];
+                }
+        }
+    }
+
+/*! The charge density on the local mesh is transformed into m_rho_real_space. In the serial case, the transform
+    is real-to-complex and only the half spectrum is computed. With domain decomposition, the interior of the local
+    mesh is copied into m_rho_real_space and transformed in place across all ranks.
+*/
+void PPPMForceCompute::forwardFFT()
+    {
+    ArrayHandle<Scalar> h_rho_grid(m_rho_grid, access_location::host, access_mode::read);
+    ArrayHandle<CUFFTCOMPLEX> h_rho_real_space(m_rho_real_space, access_location::host, access_mode::overwrite);
+
+    // CUFFTCOMPLEX and kiss_fft_cpx are both a pair of Scalars
+    kiss_fft_cpx *rho_hat = (kiss_fft_cpx *)h_rho_real_space.data;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        int grid_y = m_grid_dim.y;
+        int grid_z = m_grid_dim.z;
+        int nx_local = m_n_local.x;
+        int ny_local = m_n_local.y;
+        int nz_local = m_n_local.z;
+        for (int x = 0; x < nx_local; x++)
+            for (int y = 0; y < ny_local; y++)
+                for (int z = 0; z < nz_local; z++)
+                    {
+                    int grid_idx = (z + m_n_ghost.z) + grid_z * ((y + m_n_ghost.y) + grid_y * (x + m_n_ghost.x));
+                    kiss_fft_cpx& rho = rho_hat[z + nz_local * (y + ny_local * x)];
+                    rho.r = h_rho_grid.data[grid_idx];
+                    rho.i = Scalar(0.0);
+                    }
+
+        distributedFFT(rho_hat, false);
+        return;
+        }
+#endif
+
+    if (m_prof) m_prof->push("FFT");
+
+    // without ghost cells, the padded mesh is the global mesh. Transform pairs of lines along z
+    unsigned int n_lines = m_Nx*m_Ny;
+    unsigned int nz = m_n_kspace.z;
+    m_fft_line_buf.resize(2*m_Nz);
+    for (unsigned int l = 0; l < n_lines; l += 2)
+        {
+        bool pair = (l + 1 < n_lines);
+        realLinesToHalfSpectrum(m_fft_1d_forward[2],
+                                m_Nz,
+                                h_rho_grid.data + l*m_Nz,
+                                pair ? h_rho_grid.data + (l+1)*m_Nz : NULL,
+                                rho_hat + l*nz,
+                                pair ? rho_hat + (l+1)*nz : NULL,
+                                &m_fft_line_buf[0]);
+        }
+
+    transformHalfSpectrumXY(rho_hat, false);
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! The Green's function multiply and the gradient are applied in a single pass over the local block of the
+    spectrum. For the full spectrum (domain decomposition), the x and y components are combined into m_Ex as
+    Ex + i Ey, since both are real on the mesh.
+*/
 void PPPMForceCompute::combined_green_e()
     {
 
-    ArrayHandle<Scalar3> h_kvec(m_kvec, access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar> h_green_hat(m_green_hat, access_location::host, access_mode::readwrite);
-    ArrayHandle<CUFFTCOMPLEX> h_Ex(m_Ex, access_location::host, access_mode::readwrite);
-    ArrayHandle<CUFFTCOMPLEX> h_Ey(m_Ey, access_location::host, access_mode::readwrite);
-    ArrayHandle<CUFFTCOMPLEX> h_Ez(m_Ez, access_location::host, access_mode::readwrite);
-    ArrayHandle<CUFFTCOMPLEX> h_rho_real_space(m_rho_real_space, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar3> h_kvec(m_kvec, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_green_hat(m_green_hat, access_location::host, access_mode::read);
+    ArrayHandle<CUFFTCOMPLEX> h_Ex(m_Ex, access_location::host, access_mode::overwrite);
+    ArrayHandle<CUFFTCOMPLEX> h_Ey(m_Ey, access_location::host, access_mode::overwrite);
+    ArrayHandle<CUFFTCOMPLEX> h_Ez(m_Ez, access_location::host, access_mode::overwrite);
+    ArrayHandle<CUFFTCOMPLEX> h_rho_real_space(m_rho_real_space, access_location::host, access_mode::read);
 
     unsigned int NNN = m_Nx*m_Ny*m_Nz;
-    for(unsigned int i = 0; i < NNN; i++)
+    unsigned int n_kspace = m_n_kspace.x*m_n_kspace.y*m_n_kspace.z;
+    for(unsigned int i = 0; i < n_kspace; i++)
         {
 
         CUFFTCOMPLEX rho_local = h_rho_real_space.data[i];
@@ -782,20 +1114,102 @@ void PPPMForceCompute::combined_green_e()
         rho_local.x *= scale_times_green;
         rho_local.y *= scale_times_green;
 
-        h_Ex.data[i].x = h_kvec.data[i].x * rho_local.y;
-        h_Ex.data[i].y = -h_kvec.data[i].x * rho_local.x;
+        Scalar3 kvec = h_kvec.data[i];
+        if (m_half_spectrum)
+            {
+            h_Ex.data[i].x = kvec.x * rho_local.y;
+            h_Ex.data[i].y = -kvec.x * rho_local.x;
 
-        h_Ey.data[i].x = h_kvec.data[i].y * rho_local.y;
-        h_Ey.data[i].y = -h_kvec.data[i].y * rho_local.x;
+            h_Ey.data[i].x = kvec.y * rho_local.y;
+            h_Ey.data[i].y = -kvec.y * rho_local.x;
+            }
+        else
+            {
+            h_Ex.data[i].x = (kvec.x * rho_local.y) + (kvec.y * rho_local.x);
+            h_Ex.data[i].y = (-kvec.x * rho_local.x) + (kvec.y * rho_local.y);
+            }
 
-        h_Ez.data[i].x = h_kvec.data[i].z * rho_local.y;
-        h_Ez.data[i].y = -h_kvec.data[i].z * rho_local.x;
+        h_Ez.data[i].x = kvec.z * rho_local.y;
+        h_Ez.data[i].y = -kvec.z * rho_local.x;
         }
     }
 
+/*! The electric field is transformed back into the interior of m_field_grid. In the serial case, the z component
+    lines are transformed in pairs and the x and y components of every line together, with complex-to-real
+    transforms of the half spectrum. With domain decomposition, the transforms of Ex + i Ey and Ez are done across
+    all ranks.
+*/
+void PPPMForceCompute::inverseFFT()
+    {
+    ArrayHandle<CUFFTCOMPLEX> h_Ex(m_Ex, access_location::host, access_mode::readwrite);
+    ArrayHandle<CUFFTCOMPLEX> h_Ey(m_Ey, access_location::host, access_mode::readwrite);
+    ArrayHandle<CUFFTCOMPLEX> h_Ez(m_Ez, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_field_grid(m_field_grid, access_location::host, access_mode::overwrite);
+
+    kiss_fft_cpx *e_x = (kiss_fft_cpx *)h_Ex.data;
+    kiss_fft_cpx *e_y = (kiss_fft_cpx *)h_Ey.data;
+    kiss_fft_cpx *e_z = (kiss_fft_cpx *)h_Ez.data;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        distributedFFT(e_x, true);
+        distributedFFT(e_z, true);
+
+        int grid_y = m_grid_dim.y;
+        int grid_z = m_grid_dim.z;
+        int nx_local = m_n_local.x;
+        int ny_local = m_n_local.y;
+        int nz_local = m_n_local.z;
+        for (int x = 0; x < nx_local; x++)
+            for (int y = 0; y < ny_local; y++)
+                for (int z = 0; z < nz_local; z++)
+                    {
+                    int grid_idx = (z + m_n_ghost.z) + grid_z * ((y + m_n_ghost.y) + grid_y * (x + m_n_ghost.x));
+                    int local_idx = z + nz_local * (y + ny_local * x);
+                    h_field_grid.data[3*grid_idx + 0] = e_x[local_idx].r;
+                    h_field_grid.data[3*grid_idx + 1] = e_x[local_idx].i;
+                    h_field_grid.data[3*grid_idx + 2] = e_z[local_idx].r;
+                    }
+        return;
+        }
+#endif
+
+    if (m_prof) m_prof->push("FFT");
+
+    transformHalfSpectrumXY(e_x, true);
+    transformHalfSpectrumXY(e_y, true);
+    transformHalfSpectrumXY(e_z, true);
+
+    unsigned int n_lines = m_Nx*m_Ny;
+    unsigned int nz = m_n_kspace.z;
+    m_fft_line_buf.resize(2*m_Nz);
+    for (unsigned int l = 0; l < n_lines; l++)
+        {
+        Scalar *field = h_field_grid.data + 3*l*m_Nz;
+        halfSpectrumToRealLines(m_fft_1d_inverse[2], m_Nz, e_x + l*nz, e_y + l*nz, field, field + 1, 3,
+                                &m_fft_line_buf[0]);
+        }
+    for (unsigned int l = 0; l < n_lines; l += 2)
+        {
+        bool pair = (l + 1 < n_lines);
+        Scalar *field = h_field_grid.data + 3*l*m_Nz + 2;
+        halfSpectrumToRealLines(m_fft_1d_inverse[2],
+                                m_Nz,
+                                e_z + l*nz,
+                                pair ? e_z + (l+1)*nz : NULL,
+                                field,
+                                pair ? field + 3*m_Nz : NULL,
+                                3,
+                                &m_fft_line_buf[0]);
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
 void PPPMForceCompute::calculate_forces()
     {
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
@@ -812,9 +1226,17 @@ void PPPMForceCompute::calculate_forces()
     memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
 
     ArrayHandle<Scalar> h_rho_coeff(m_rho_coeff, access_location::host, access_mode::read);
-    ArrayHandle<CUFFTCOMPLEX> h_Ex(m_Ex, access_location::host, access_mode::readwrite);
-    ArrayHandle<CUFFTCOMPLEX> h_Ey(m_Ey, access_location::host, access_mode::readwrite);
-    ArrayHandle<CUFFTCOMPLEX> h_Ez(m_Ez, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_field_grid(m_field_grid, access_location::host, access_mode::readwrite);
+
+    int grid_x = m_grid_dim.x;
+    int grid_y = m_grid_dim.y;
+    int grid_z = m_grid_dim.z;
+
+#ifdef ENABLE_MPI
+    // get the field in the ghost cells from the ranks that own them
+    if (m_pdata->getDomainDecomposition())
+        fillGhostCells(h_field_grid.data, 3);
+#endif
 
     for(int i = 0; i < (int)m_pdata->getN(); i++)
         {
@@ -855,13 +1277,23 @@ void PPPMForceCompute::calculate_forces()
         dy = shiftone+(Scalar)nyi-pos_frac.y;
         dz = shiftone+(Scalar)nzi-pos_frac.z;
 
+        int3 idx = make_int3(nxi, nyi, nzi);
+        if (!getLocalMeshIndex(idx))
+            {
+            m_exec_conf->msg->error() << "charge.pppm: Particle " << i << " is too far outside the local domain" << endl;
+            throw std::runtime_error("Error computing PPPM forces");
+            }
+        nxi = idx.x;
+        nyi = idx.y;
+        nzi = idx.z;
+
         int n,m,l,k;
         Scalar result;
         int mult_fact = 2*m_order+1;
         for (n = nlower; n <= nupper; n++) {
             mx = n+nxi;
-            if(mx >= m_Nx) mx -= m_Nx;
-            if(mx < 0)  mx += m_Nx;
+            if(mx >= grid_x) mx -= grid_x;
+            if(mx < 0)  mx += grid_x;
             result = Scalar(0.0);
             for (k = m_order-1; k >= 0; k--) {
                 result = h_rho_coeff.data[n-nlower + k*mult_fact] + result * dx;
@@ -869,8 +1301,8 @@ void PPPMForceCompute::calculate_forces()
             x0 = result;
             for (m = nlower; m <= nupper; m++) {
                 my = m+nyi;
-                if(my >= m_Ny) my -= m_Ny;
-                if(my < 0)  my += m_Ny;
+                if(my >= grid_y) my -= grid_y;
+                if(my < 0)  my += grid_y;
                 result = Scalar(0.0);
                 for (k = m_order-1; k >= 0; k--) {
                     result = h_rho_coeff.data[m-nlower + k*mult_fact] + result * dy;
@@ -878,16 +1310,17 @@ void PPPMForceCompute::calculate_forces()
                 y0 = x0*result;
                 for (l = nlower; l <= nupper; l++) {
                     mz = l+nzi;
-                    if(mz >= m_Nz) mz -= m_Nz;
-                    if(mz < 0)  mz += m_Nz;
+                    if(mz >= grid_z) mz -= grid_z;
+                    if(mz < 0)  mz += grid_z;
                     result = Scalar(0.0);
                     for (k = m_order-1; k >= 0; k--) {
                         result = h_rho_coeff.data[l-nlower + k*mult_fact] + result * dz;
                         }
                     z0 = y0*result;
-                    Scalar local_field_x = h_Ex.data[mz + m_Nz * (my + m_Ny * mx)].x;
-                    Scalar local_field_y = h_Ey.data[mz + m_Nz * (my + m_Ny * mx)].x;
-                    Scalar local_field_z = h_Ez.data[mz + m_Nz * (my + m_Ny * mx)].x;
+                    int grid_idx = mz + grid_z * (my + grid_y * mx);
+                    Scalar local_field_x = h_field_grid.data[3*grid_idx + 0];
+                    Scalar local_field_y = h_field_grid.data[3*grid_idx + 1];
+                    Scalar local_field_z = h_field_grid.data[3*grid_idx + 2];
                     h_force.data[i].x += qi*z0*local_field_x;
                     h_force.data[i].y += qi*z0*local_field_y;
                     h_force.data[i].z += qi*z0*local_field_z;
@@ -913,7 +1346,7 @@ void PPPMForceCompute::fix_exclusions_cpu()
     assert(h_force.data);
 
     ArrayHandle< unsigned int > d_group_members(m_group->getIndexArray(), access_location::host, access_mode::read);
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
     ArrayHandle<unsigned int> d_exlist(m_nlist->getExListArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> d_n_ex(m_nlist->getNExArray(), access_location::host, access_mode::read);
     Index2D nex = m_nlist->getExListIndexer();
@@ -982,12 +1415,12 @@ void PPPMForceCompute::fix_exclusions_cpu()
 
 /*! Computes the additional energy and virial contributed by PPPM
     \note The additional terms are simply added onto particle 0 so that they will be accounted for by
-    ComputeThermo
+    ComputeThermo. In MPI simulations, they are added onto the particle with tag 0.
 */
 void PPPMForceCompute::fix_thermo_quantities()
     {
     // access data arrays
-    BoxDim box = m_pdata->getBox();
+    BoxDim box = m_pdata->getGlobalBox();
     Scalar3 L = box.getL();
 
     ArrayHandle<CUFFTCOMPLEX> d_rho_real_space(m_rho_real_space, access_location::host, access_mode::readwrite);
@@ -1000,10 +1433,12 @@ void PPPMForceCompute::fix_thermo_quantities()
 
 
     // compute the correction
-    for (int i = 0; i < m_Nx*m_Ny*m_Nz; i++)
+    int n_kspace = m_n_kspace.x*m_n_kspace.y*m_n_kspace.z;
+    for (int i = 0; i < n_kspace; i++)
         {
         Scalar energy = d_green_hat.data[i]*(d_rho_real_space.data[i].x*d_rho_real_space.data[i].x +
                                              d_rho_real_space.data[i].y*d_rho_real_space.data[i].y);
+
         Scalar pressure = energy*(d_vg.data[0+6*i] + d_vg.data[3+6*i] + d_vg.data[5+6*i]);
         v_xx += d_vg.data[0+6*i]*energy;
         v_xy += d_vg.data[1+6*i]*energy;
@@ -1013,8 +1448,40 @@ void PPPMForceCompute::fix_thermo_quantities()
         v_zz += d_vg.data[5+6*i]*energy;
         pppm_virial_energy.x += pressure;
         pppm_virial_energy.y += energy;
+
+        // in the half spectrum, the modes with 0 < k_z < Nz/2 stand for their -k partners as well. Their virial
+        // coefficients already include those of the partners
+        if (m_half_spectrum)
+            {
+            int kz = i % m_n_kspace.z;
+            if (kz > 0 && 2*kz < m_Nz)
+                pppm_virial_energy.y += energy;
+            }
         }
 
+    unsigned int idx = 0;
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        // sum up the contributions of all mesh blocks
+        Scalar sums[8] = {v_xx, v_xy, v_xz, v_yy, v_yz, v_zz, pppm_virial_energy.x, pppm_virial_energy.y};
+        MPI_Allreduce(MPI_IN_PLACE, sums, 8, MPI_HOOMD_SCALAR, MPI_SUM, m_exec_conf->getMPICommunicator());
+        v_xx = sums[0];
+        v_xy = sums[1];
+        v_xz = sums[2];
+        v_yy = sums[3];
+        v_yz = sums[4];
+        v_zz = sums[5];
+        pppm_virial_energy.x = sums[6];
+        pppm_virial_energy.y = sums[7];
+
+        // only the rank owning the particle with tag 0 applies the correction
+        idx = m_pdata->getRTag(0);
+        if (idx >= m_pdata->getN())
+            return;
+        }
+#endif
+
     pppm_virial_energy.x *= m_energy_virial_factor/ (Scalar(3.0) * L.x * L.y * L.z);
     pppm_virial_energy.y *= m_energy_virial_factor;
     pppm_virial_energy.y -= m_q2 * m_kappa / Scalar(1.772453850905516027298168);
@@ -1023,17 +1490,298 @@ void PPPMForceCompute::fix_thermo_quantities()
     // apply the correction to particle 0
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar> h_virial(m_virial,access_location::host, access_mode::readwrite);
-    h_force.data[0].w += pppm_virial_energy.y;
+    h_force.data[idx].w += pppm_virial_energy.y;
 
 
     // Compute full virial tensor
     unsigned int virial_pitch = m_virial.getPitch();
-    h_virial.data[0*virial_pitch+0] += v_xx*m_energy_virial_factor;
-    h_virial.data[1*virial_pitch+0] += v_xy*m_energy_virial_factor;
-    h_virial.data[2*virial_pitch+0] += v_xz*m_energy_virial_factor;
-    h_virial.data[3*virial_pitch+0] += v_yy*m_energy_virial_factor;
-    h_virial.data[4*virial_pitch+0] += v_yz*m_energy_virial_factor;
-    h_virial.data[5*virial_pitch+0] += v_zz*m_energy_virial_factor;
+    h_virial.data[0*virial_pitch+idx] += v_xx*m_energy_virial_factor;
+    h_virial.data[1*virial_pitch+idx] += v_xy*m_energy_virial_factor;
+    h_virial.data[2*virial_pitch+idx] += v_xz*m_energy_virial_factor;
+    h_virial.data[3*virial_pitch+idx] += v_yy*m_energy_virial_factor;
+    h_virial.data[4*virial_pitch+idx] += v_yz*m_energy_virial_factor;
+    h_virial.data[5*virial_pitch+idx] += v_zz*m_energy_virial_factor;
+    }
+
+#ifdef ENABLE_MPI
+//! Index of the k-th mesh point along direction \a dir on the \a l-th mesh line of a block with dimensions \a n
+/*! The mesh lines along a direction are numbered in the memory order of the two other directions.
+*/
+inline unsigned int getLineElement(const unsigned int *n, unsigned int dir, unsigned int l, unsigned int k)
+    {
+    if (dir == 0)
+        return l + n[1]*n[2]*k;
+    else if (dir == 1)
+        return (l % n[2]) + n[2]*(k + n[1]*(l / n[2]));
+    else
+        return k + n[2]*l;
+    }
+
+/*! \param data Local block of the mesh (in memory order z, y, x), transformed in place
+    \param inverse True if the inverse FFT is to be performed
+
+    For every direction, the ranks in a row of the processor grid distribute the mesh lines of their blocks (which
+    have the same extent perpendicular to the row) evenly among themselves, so that after an MPI_Alltoallv every rank holds a set of complete lines
+    along the global mesh. These are transformed with 1D FFTs, and sent back to the ranks owning the block. Like
+    kiss_fft, the transforms are not normalized.
+*/
+void PPPMForceCompute::distributedFFT(kiss_fft_cpx *data, bool inverse)
+    {
+    if (m_prof) m_prof->push("FFT");
+
+    unsigned int n_local[3] = {m_n_local.x, m_n_local.y, m_n_local.z};
+    unsigned int n_global[3] = {(unsigned int)m_Nx, (unsigned int)m_Ny, (unsigned int)m_Nz};
+    unsigned int n_points = n_local[0]*n_local[1]*n_local[2];
+
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        int n_ranks, my_rank;
+        MPI_Comm_size(m_row_comm[dir], &n_ranks);
+        MPI_Comm_rank(m_row_comm[dir], &my_rank);
+
+        kiss_fft_cfg cfg = inverse ? m_fft_1d_inverse[dir] : m_fft_1d_forward[dir];
+        unsigned int n_lines = n_points/n_local[dir];
+        unsigned int line_length = n_global[dir];
+
+        // the lines this rank transforms
+        unsigned int my_first_line = (unsigned int)my_rank*n_lines/n_ranks;
+        unsigned int my_n_lines = (unsigned int)(my_rank+1)*n_lines/n_ranks - my_first_line;
+
+        std::vector<int> send_counts(n_ranks);
+        std::vector<int> send_displs(n_ranks);
+        std::vector<int> recv_counts(n_ranks);
+        std::vector<int> recv_displs(n_ranks);
+
+        // pack the segments of the lines that are transformed by the other ranks
+        m_fft_send_buf.resize(n_points);
+        m_fft_recv_buf.resize(my_n_lines*line_length);
+        unsigned int send_offset = 0;
+        unsigned int recv_offset = 0;
+        for (int r = 0; r < n_ranks; r++)
+            {
+            unsigned int first_line = (unsigned int)r*n_lines/n_ranks;
+            unsigned int last_line = (unsigned int)(r+1)*n_lines/n_ranks;
+
+            // number of mesh points owned by rank r along this direction
+            unsigned int n_r = m_mesh_bounds[dir][r+1] - m_mesh_bounds[dir][r];
+
+            send_counts[r] = (last_line - first_line)*n_local[dir]*sizeof(kiss_fft_cpx);
+            send_displs[r] = send_offset*sizeof(kiss_fft_cpx);
+            recv_counts[r] = my_n_lines*n_r*sizeof(kiss_fft_cpx);
+            recv_displs[r] = recv_offset*sizeof(kiss_fft_cpx);
+
+            for (unsigned int l = first_line; l < last_line; l++)
+                for (unsigned int k = 0; k < n_local[dir]; k++)
+                    m_fft_send_buf[send_offset++] = data[getLineElement(n_local, dir, l, k)];
+
+            recv_offset += my_n_lines*n_r;
+            }
+
+        MPI_Alltoallv(&m_fft_send_buf.front(), &send_counts.front(), &send_displs.front(), MPI_BYTE,
+                      &m_fft_recv_buf.front(), &recv_counts.front(), &recv_displs.front(), MPI_BYTE,
+                      m_row_comm[dir]);
+
+        // assemble and transform the complete lines
+        m_fft_line_buf.resize(2*line_length);
+        kiss_fft_cpx *line_in = &m_fft_line_buf[0];
+        kiss_fft_cpx *line_out = &m_fft_line_buf[line_length];
+        for (unsigned int l = 0; l < my_n_lines; l++)
+            {
+            for (int r = 0; r < n_ranks; r++)
+                {
+                unsigned int offset_r = m_mesh_bounds[dir][r];
+                unsigned int n_r = m_mesh_bounds[dir][r+1] - offset_r;
+                kiss_fft_cpx *segment = &m_fft_recv_buf[recv_displs[r]/sizeof(kiss_fft_cpx) + l*n_r];
+                for (unsigned int k = 0; k < n_r; k++)
+                    line_in[offset_r + k] = segment[k];
+                }
+
+            kiss_fft(cfg, line_in, line_out);
+
+            for (int r = 0; r < n_ranks; r++)
+                {
+                unsigned int offset_r = m_mesh_bounds[dir][r];
+                unsigned int n_r = m_mesh_bounds[dir][r+1] - offset_r;
+                kiss_fft_cpx *segment = &m_fft_recv_buf[recv_displs[r]/sizeof(kiss_fft_cpx) + l*n_r];
+                for (unsigned int k = 0; k < n_r; k++)
+                    segment[k] = line_out[offset_r + k];
+                }
+            }
+
+        // send the transformed segments back to their owners
+        MPI_Alltoallv(&m_fft_recv_buf.front(), &recv_counts.front(), &recv_displs.front(), MPI_BYTE,
+                      &m_fft_send_buf.front(), &send_counts.front(), &send_displs.front(), MPI_BYTE,
+                      m_row_comm[dir]);
+
+        send_offset = 0;
+        for (int r = 0; r < n_ranks; r++)
+            {
+            unsigned int first_line = (unsigned int)r*n_lines/n_ranks;
+            unsigned int last_line = (unsigned int)(r+1)*n_lines/n_ranks;
+            for (unsigned int l = first_line; l < last_line; l++)
+                for (unsigned int k = 0; k < n_local[dir]; k++)
+                    data[getLineElement(n_local, dir, l, k)] = m_fft_send_buf[send_offset++];
+            }
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+/*! \param data Local mesh including ghost cells, with \a n_comp values per mesh point
+    \param n_comp Number of values per mesh point
+*/
+void PPPMForceCompute::reduceGhostCells(Scalar *data, unsigned int n_comp)
+    {
+    exchangeGhostCells(data, n_comp, true);
+    }
+
+/*! \param data Local mesh including ghost cells, with \a n_comp values per mesh point
+    \param n_comp Number of values per mesh point
+*/
+void PPPMForceCompute::fillGhostCells(Scalar *data, unsigned int n_comp)
+    {
+    exchangeGhostCells(data, n_comp, false);
+    }
+
+/*! \param data Local mesh including ghost cells, with \a n_comp values per mesh point
+    \param n_comp Number of values per mesh point
+    \param reduce If true, the ghost cells are added to the ranks owning them, otherwise they are filled
+
+    The exchange is performed one direction at a time with the two neighbors along that direction. Cells at the edges
+    and corners of the ghost layer are forwarded along the subsequent directions by including the ghost cells of
+    the previous directions in the exchanged slabs. This requires filling in the order x, y, z and reducing in the
+    order z, y, x.
+*/
+void PPPMForceCompute::exchangeGhostCells(Scalar *data, unsigned int n_comp, bool reduce)
+    {
+    boost::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    MPI_Comm comm = m_exec_conf->getMPICommunicator();
+
+    unsigned int grid_dim[3] = {m_grid_dim.x, m_grid_dim.y, m_grid_dim.z};
+    unsigned int n_local[3] = {m_n_local.x, m_n_local.y, m_n_local.z};
+    unsigned int n_ghost[3] = {m_n_ghost.x, m_n_ghost.y, m_n_ghost.z};
+
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        unsigned int dir = reduce ? 2 - i : i;
+        if (n_ghost[dir] == 0)
+            continue;
+
+        // the slabs include the ghost cells along the directions handled before when filling
+        unsigned int lo[3], hi[3];
+        for (unsigned int other = 0; other < 3; other++)
+            {
+            if (other < dir)
+                {
+                lo[other] = 0;
+                hi[other] = grid_dim[other];
+                }
+            else
+                {
+                lo[other] = n_ghost[other];
+                hi[other] = n_ghost[other] + n_local[other];
+                }
+            }
+
+        // first plane of the slabs that are sent to the lower [0] and upper [1] neighbor, and of those received
+        // from the lower [0] and upper [1] neighbor
+        unsigned int send_plane[2], recv_plane[2];
+        if (reduce)
+            {
+            send_plane[0] = 0;
+            send_plane[1] = n_local[dir] + n_ghost[dir];
+            recv_plane[0] = n_ghost[dir];
+            recv_plane[1] = n_local[dir];
+            }
+        else
+            {
+            send_plane[0] = n_ghost[dir];
+            send_plane[1] = n_local[dir];
+            recv_plane[0] = 0;
+            recv_plane[1] = n_local[dir] + n_ghost[dir];
+            }
+
+        unsigned int neighbor[2] = {decomposition->getNeighborRank(2*dir+1), decomposition->getNeighborRank(2*dir)};
+
+        unsigned int n_slab = n_comp;
+        for (unsigned int other = 0; other < 3; other++)
+            n_slab *= (other == dir) ? n_ghost[dir] : hi[other] - lo[other];
+
+        m_ghost_send_buf.resize(2*n_slab);
+        m_ghost_recv_buf.resize(2*n_slab);
+
+        // pack the slabs
+        for (unsigned int side = 0; side < 2; side++)
+            {
+            lo[dir] = send_plane[side];
+            hi[dir] = send_plane[side] + n_ghost[dir];
+            Scalar *buf = &m_ghost_send_buf[side*n_slab];
+            for (unsigned int x = lo[0]; x < hi[0]; x++)
+                for (unsigned int y = lo[1]; y < hi[1]; y++)
+                    for (unsigned int z = lo[2]; z < hi[2]; z++)
+                        for (unsigned int c = 0; c < n_comp; c++)
+                            *buf++ = data[n_comp*(z + grid_dim[2]*(y + grid_dim[1]*x)) + c];
+            }
+
+        // the slab sent to the lower neighbor is received from the upper neighbor and vice versa
+        MPI_Request reqs[4];
+        MPI_Status status[4];
+        for (unsigned int side = 0; side < 2; side++)
+            {
+            MPI_Isend(&m_ghost_send_buf[side*n_slab], n_slab, MPI_HOOMD_SCALAR, neighbor[side], side, comm,
+                      &reqs[side]);
+            MPI_Irecv(&m_ghost_recv_buf[side*n_slab], n_slab, MPI_HOOMD_SCALAR, neighbor[side], 1-side, comm,
+                      &reqs[2+side]);
+            }
+        MPI_Waitall(4, reqs, status);
+
+        // unpack the slabs
+        for (unsigned int side = 0; side < 2; side++)
+            {
+            lo[dir] = recv_plane[side];
+            hi[dir] = recv_plane[side] + n_ghost[dir];
+            Scalar *buf = &m_ghost_recv_buf[side*n_slab];
+            for (unsigned int x = lo[0]; x < hi[0]; x++)
+                for (unsigned int y = lo[1]; y < hi[1]; y++)
+                    for (unsigned int z = lo[2]; z < hi[2]; z++)
+                        for (unsigned int c = 0; c < n_comp; c++)
+                            {
+                            Scalar& val = data[n_comp*(z + grid_dim[2]*(y + grid_dim[1]*x)) + c];
+                            if (reduce)
+                                val += *buf++;
+                            else
+                                val = *buf++;
+                            }
+            }
+        }
+    }
+
+void PPPMForceCompute::freeRowComms()
+    {
+    // the compute may be destroyed after MPI has been shut down
+    int finalized;
+    MPI_Finalized(&finalized);
+
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        if (m_row_comm[dir] != MPI_COMM_NULL && !finalized)
+            MPI_Comm_free(&m_row_comm[dir]);
+        m_row_comm[dir] = MPI_COMM_NULL;
+        }
+    }
+#endif
+
+void PPPMForceCompute::freeFFTPlans()
+    {
+    for (unsigned int dir = 0; dir < 3; dir++)
+        {
+        if (m_fft_1d_forward[dir])
+            free(m_fft_1d_forward[dir]);
+        if (m_fft_1d_inverse[dir])
+            free(m_fft_1d_inverse[dir]);
+        m_fft_1d_forward[dir] = NULL;
+        m_fft_1d_inverse[dir] = NULL;
+        }
     }
 
 void export_PPPMForceCompute()
@@ -85,7 +85,11 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define kiss_fft_scalar Scalar
 #endif
 #include "HOOMDMath.h"
-#include "kiss_fftnd.h"
+#include "kiss_fft.h"
+
+#ifdef ENABLE_MPI
+#include "DomainDecomposition.h"
+#endif
 
 
 // MAX gives the larger of two values
@@ -103,6 +107,36 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! Computes the long ranged part of the electrostatic forces on each particle
 /*! PPPM forces are computed on every particle in the simulation.
 
+    <b>Domain decomposition</b>
+
+    In an MPI simulation, every rank owns a contiguous block of the global mesh, obtained by splitting the mesh at
+    the mesh points closest to the domain boundaries of the DomainDecomposition. The block is padded by a layer of
+    ghost cells that is wide enough to hold the assignment stencil of any local particle, including those that have
+    moved outside the local box by up to half the neighbor list buffer since the last particle migration.
+
+    Charges are assigned to the padded block, and the ghost cell contributions are then added to the ranks owning
+    those cells (reduceGhostCells()). The 3D FFT is carried out as a sequence of 1D FFTs along x, y and z. Before
+    each 1D pass, the ranks in a row of the processor grid along that direction exchange data with MPI_Alltoallv so
+    that every rank holds complete mesh lines (pencils), and the data is transposed back afterwards
+    (distributedFFT()). Because the transformed data comes back in the original block layout, the Green's function
+    and k vectors are only computed for the local block. After the inverse transforms, the electric field is copied
+    into the padded block and the ghost cells are filled from the neighboring ranks (fillGhostCells()), so the
+    forces can be interpolated locally.
+
+    Without MPI, the local block is the full mesh and there are no ghost cells.
+
+    <b>Real-to-complex transforms</b>
+
+    Since the charge density and the electric field are real, the serial CPU path only stores the half of the
+    spectrum with k_z >= 0 (Nz/2+1 points along z), the other half follows from Hermitian symmetry. The transforms
+    along z are done as real-to-complex (forward) or complex-to-real (inverse) transforms, where two real mesh lines
+    are packed into the real and imaginary parts of a single complex FFT of length Nz (forwardFFT() and inverseFFT()).
+    The transforms along x and y are complex FFTs on the half spectrum. This halves the FFT work and the size of all
+    arrays defined in k-space. Green's function, k vectors and virial coefficients are computed for the half
+    spectrum only, and the energy and virial sums count every mode with 0 < k_z < Nz/2 twice.
+
+    With domain decomposition, the full spectrum is kept so that the pencil transposes can split every direction
+    evenly. The inverse transforms of Ex and Ey are combined into a single complex transform of Ex + i Ey.
 */
 class PPPMForceCompute : public ForceCompute
     {
@@ -144,6 +178,10 @@ class PPPMForceCompute : public ForceCompute
         void assign_charges_to_grid();
         //! multiply Green's function by charge density to get electric field
         void combined_green_e();
+        //! Transform the charge density on the mesh to k-space
+        void forwardFFT();
+        //! Transform the electric field back to the mesh
+        void inverseFFT();
         //! Do the final force calculation
         void calculate_forces();
         //! fix the force due to excluded particles
@@ -151,6 +189,12 @@ class PPPMForceCompute : public ForceCompute
         //! fix the energy and virial thermodynamic quantities
         virtual void fix_thermo_quantities();
 
+        //! Set up the local mesh and allocate the mesh arrays
+        void setupMesh();
+
+        //! Convert the global index of a mesh point to the index on the local mesh
+        bool getLocalMeshIndex(int3& idx);
+
     protected:
         GPUArray<Scalar>m_vg;                    //!< Virial coefficient
         Scalar m_thermo_data[7];                 //!< PPPM contribution to energy and virial
@@ -185,13 +229,48 @@ class PPPMForceCompute : public ForceCompute
         boost::signals2::connection m_boxchange_connection;   //!< Connection to the ParticleData box size change signal
         boost::shared_ptr<NeighborList> m_nlist; //!< The neighborlist to use for the computation
         boost::shared_ptr<ParticleGroup> m_group;//!< Group to compute properties for
-        kiss_fft_cpx *fft_in;                    //!< For FFTs on CPU rho_real_space
-        kiss_fft_cpx *fft_ex;                    //!< For FFTs on CPU E-field x component
-        kiss_fft_cpx *fft_ey;                    //!< For FFTs on CPU E-field y component
-        kiss_fft_cpx *fft_ez;                    //!< For FFTs on CPU E-field z component
-        kiss_fftnd_cfg fft_forward;              //!< Forward FFT on CPU
-        kiss_fftnd_cfg fft_inverse;              //!< Inverse FFT on CPU
-        int first_run;                           //!< flag for allocating arrays
+
+        uint3 m_n_local;                         //!< Number of mesh points owned by this rank along each direction
+        uint3 m_mesh_offset;                     //!< Global index of the first local mesh point
+        uint3 m_n_ghost;                         //!< Number of ghost cells on either side along each direction
+        uint3 m_grid_dim;                        //!< Dimensions of the local mesh including ghost cells
+        GPUArray<Scalar> m_rho_grid;             //!< Charge density on the local mesh including ghost cells
+        GPUArray<Scalar> m_field_grid;           //!< Electric field (x,y,z interleaved) on the local mesh including ghost cells
+        bool m_half_spectrum;                    //!< True if only the k_z >= 0 half of the spectrum is stored
+        uint3 m_n_kspace;                        //!< Dimensions of the local block of the spectrum
+        kiss_fft_cfg m_fft_1d_forward[3];        //!< 1D forward FFTs along the global mesh directions
+        kiss_fft_cfg m_fft_1d_inverse[3];        //!< 1D inverse FFTs along the global mesh directions
+        std::vector<kiss_fft_cpx> m_fft_line_buf;  //!< Complete mesh lines for the 1D FFTs
+
+        //! Complex FFTs along x and y of the half spectrum
+        void transformHalfSpectrumXY(kiss_fft_cpx *data, bool inverse);
+
+        //! Free the 1D FFT plans
+        void freeFFTPlans();
+
+#ifdef ENABLE_MPI
+        MPI_Comm m_row_comm[3];                  //!< Communicators of the ranks in a row of the processor grid along x, y and z
+        std::vector<unsigned int> m_mesh_bounds[3]; //!< Global mesh indices of the domain boundaries along x, y and z
+        std::vector<kiss_fft_cpx> m_fft_send_buf;  //!< Send buffer for the FFT transposes
+        std::vector<kiss_fft_cpx> m_fft_recv_buf;  //!< Receive buffer for the FFT transposes
+        std::vector<Scalar> m_ghost_send_buf;      //!< Send buffer for the ghost cell exchange
+        std::vector<Scalar> m_ghost_recv_buf;      //!< Receive buffer for the ghost cell exchange
+
+        //! Perform a 3D FFT of the local mesh block across all ranks
+        void distributedFFT(kiss_fft_cpx *data, bool inverse);
+
+        //! Add the ghost cell contributions of the padded mesh to the ranks owning those cells
+        void reduceGhostCells(Scalar *data, unsigned int n_comp);
+
+        //! Fill the ghost cells of the padded mesh with the values from the ranks owning those cells
+        void fillGhostCells(Scalar *data, unsigned int n_comp);
+
+        //! Helper function to exchange ghost cells along all directions
+        void exchangeGhostCells(Scalar *data, unsigned int n_comp, bool reduce);
+
+        //! Free the row communicators
+        void freeRowComms();
+#endif
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
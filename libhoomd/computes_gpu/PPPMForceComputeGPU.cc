@@ -88,6 +88,9 @@ PPPMForceComputeGPU::PPPMForceComputeGPU(boost::shared_ptr<SystemDefinition> sys
         m_exec_conf->msg->error() << "Creating a PPMForceComputeGPU with no GPU in the execution configuration" << endl;
         throw std::runtime_error("Error initializing PPMForceComputeGPU");
         }
+
+    // cuFFT operates on the full complex spectrum
+    m_half_spectrum = false;
     CHECK_CUDA_ERROR();
     }
 
@@ -62,6 +62,9 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /*! To keep the argument count down to gpu_integrator_sum_accel, up to 6 force/virial array pairs are packed up in this
     struct for addition to the net force/virial in a single kernel call. If there is not a multiple of 5 forces to sum,
     set some of the pointers to NULL and they will be ignored.
+
+    The force and torque of each array are multiplied by the matching scale factor before they are added (see
+    Integrator::setForcePeriod()). Energies and virials are added unscaled.
 */
 struct gpu_force_list
     {
@@ -70,7 +73,8 @@ struct gpu_force_list
         : f0(NULL), f1(NULL), f2(NULL), f3(NULL), f4(NULL), f5(NULL),
           t0(NULL), t1(NULL), t2(NULL), t3(NULL), t4(NULL), t5(NULL),
           v0(NULL), v1(NULL), v2(NULL), v3(NULL), v4(NULL), v5(NULL),
-          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0)
+          vpitch0(0), vpitch1(0), vpitch2(0), vpitch3(0), vpitch4(0), vpitch5(0),
+          s0(1.0), s1(1.0), s2(1.0), s3(1.0), s4(1.0), s5(1.0)
           {
           }
 
@@ -101,6 +105,13 @@ struct gpu_force_list
     unsigned int vpitch3; //!< Pitch of virial array 3
     unsigned int vpitch4; //!< Pitch of virial array 4
     unsigned int vpitch5; //!< Pitch of virial array 5
+
+    Scalar s0; //!< Scale factor for force and torque 0
+    Scalar s1; //!< Scale factor for force and torque 1
+    Scalar s2; //!< Scale factor for force and torque 2
+    Scalar s3; //!< Scale factor for force and torque 3
+    Scalar s4; //!< Scale factor for force and torque 4
+    Scalar s5; //!< Scale factor for force and torque 5
  };
 
 //! Driver for gpu_integrator_sum_net_force_kernel()
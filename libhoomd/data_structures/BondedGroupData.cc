@@ -81,7 +81,7 @@ template<unsigned int group_size, typename Group, const char *name>
 BondedGroupData<group_size, Group, name>::BondedGroupData(
     boost::shared_ptr<ParticleData> pdata,
     unsigned int n_group_types)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_nglobal(0), m_groups_dirty(true), m_idx_table_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name<< "s, n=" << group_size << ") "
         << endl;
@@ -127,7 +127,7 @@ template<unsigned int group_size, typename Group, const char *name>
 BondedGroupData<group_size, Group, name>::BondedGroupData(
     boost::shared_ptr<ParticleData> pdata,
     const Snapshot& snapshot)
-    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_nglobal(0), m_groups_dirty(true)
+    : m_exec_conf(pdata->getExecConf()), m_pdata(pdata), m_nglobal(0), m_groups_dirty(true), m_idx_table_dirty(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondedGroupData (" << name << ") " << endl;
 
@@ -201,6 +201,13 @@ void BondedGroupData<group_size, Group, name>::initialize()
     GPUVector<unsigned int> n_groups(m_exec_conf);
     m_n_groups.swap(n_groups);
 
+    // Lookup table for the CPU
+    GPUVector<members_t> idx_table(m_exec_conf);
+    m_idx_table.swap(idx_table);
+
+    GPUVector<unsigned int> idx_table_type(m_exec_conf);
+    m_idx_table_type.swap(idx_table_type);
+
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -402,6 +409,7 @@ unsigned int BondedGroupData<group_size, Group, name>::addBondedGroup(Group g)
 
     // set flag to rebuild GPU table
     m_groups_dirty = true;
+    m_idx_table_dirty = true;
 
     // notifiy observers
     m_group_num_change_signal();
@@ -607,6 +615,7 @@ void BondedGroupData<group_size, Group, name>::removeBondedGroup(unsigned int ta
 
     // set flag to trigger rebuild of GPU table
     m_groups_dirty = true;
+    m_idx_table_dirty = true;
 
     // notifiy observers
     m_group_num_change_signal();
@@ -767,6 +776,76 @@ void BondedGroupData<group_size, Group, name>::rebuildGPUTable()
         }
     }
 
+/*! The CPU force computes loop over the table once per group instead of looking up the members by tag for every
+    group. The groups are bucketed by the lowest index of their members with a counting sort, so the table keeps the
+    particle access pattern of the last particle sort.
+ */
+template<unsigned int group_size, typename Group, const char *name>
+void BondedGroupData<group_size, Group, name>::rebuildIndexTable()
+    {
+    if (m_prof) m_prof->push("update " + std::string(name) + " index table");
+
+    unsigned int n_groups = getN();
+    unsigned int n_ptl = m_pdata->getN()+m_pdata->getNGhosts();
+
+    m_idx_table.resize(n_groups);
+    m_idx_table_type.resize(n_groups);
+
+    ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_group_type(m_group_type, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<members_t> h_idx_table(m_idx_table, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_idx_table_type(m_idx_table_type, access_location::host, access_mode::overwrite);
+
+    // resolve the member tags and count the groups per lowest member index
+    std::vector<members_t> groups_idx(n_groups);
+    std::vector<unsigned int> first_idx(n_groups);
+    std::vector<unsigned int> offset(n_ptl+1, 0);
+    for (unsigned int cur_group = 0; cur_group < n_groups; cur_group++)
+        {
+        members_t g = h_groups.data[cur_group];
+        members_t h;
+        unsigned int min_idx = n_ptl;
+        for (unsigned int i = 0; i < group_size; ++i)
+            {
+            unsigned int idx = h_rtag.data[g.tag[i]];
+
+            if (idx >= n_ptl)
+                {
+                // incomplete group
+                std::ostringstream oss;
+                oss << name << ".*: " << name << " ";
+                for (unsigned int k = 0; k < group_size; ++k)
+                    oss << g.tag[k] << ((k != group_size - 1) ? ", " : " ");
+                oss << "incomplete!" << std::endl;
+                m_exec_conf->msg->error() << oss.str();
+                throw std::runtime_error("Error building group index table.");
+                }
+
+            h.idx[i] = idx;
+            if (idx < min_idx)
+                min_idx = idx;
+            }
+
+        groups_idx[cur_group] = h;
+        first_idx[cur_group] = min_idx;
+        offset[min_idx+1]++;
+        }
+
+    for (unsigned int i = 0; i < n_ptl; i++)
+        offset[i+1] += offset[i];
+
+    // place the groups, keeping their relative order within each bucket
+    for (unsigned int cur_group = 0; cur_group < n_groups; cur_group++)
+        {
+        unsigned int pos = offset[first_idx[cur_group]]++;
+        h_idx_table.data[pos] = groups_idx[cur_group];
+        h_idx_table_type.data[pos] = h_group_type.data[cur_group];
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
 #ifdef ENABLE_CUDA
 template<unsigned int group_size, typename Group, const char *name>
 void BondedGroupData<group_size, Group, name>::rebuildGPUTableGPU()
@@ -868,92 +947,78 @@ void BondedGroupData<group_size, Group, name>::takeSnapshot(Snapshot& snapshot)
     // allocate memory in snapshot
     snapshot.resize(getNGlobal());
 
-    std::map<unsigned int, unsigned int> rtag_map;
-
-    for (unsigned int group_idx = 0; group_idx < getN(); group_idx++)
-        {
-        unsigned int tag = m_group_tag[group_idx];
-        assert(m_group_rtag[tag] == group_idx);
-
-        rtag_map.insert(std::pair<unsigned int,unsigned int>(tag, group_idx));
-        }
-
     #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
         // gather local data
-        std::vector<unsigned int> types; // Group types
-        std::vector<members_t> members;  // Group members
+        std::vector<unsigned int> tags(getN());  // Group tags
+        std::vector<unsigned int> types(getN()); // Group types
+        std::vector<members_t> members(getN());  // Group members
 
         for (unsigned int group_idx  = 0; group_idx < getN(); ++group_idx)
             {
-            types.push_back(m_group_type[group_idx]);
-            members.push_back(m_groups[group_idx]);
+            tags[group_idx] = m_group_tag[group_idx];
+            types[group_idx] = m_group_type[group_idx];
+            members[group_idx] = m_groups[group_idx];
             }
 
-        std::vector< std::vector<unsigned int> > types_proc;     // Group types of every processor
-        std::vector< std::vector<members_t> > members_proc;      // Group members of every processor
+        std::vector<unsigned int> tags_proc;     // Group tags of all processors, in rank order
+        std::vector<unsigned int> types_proc;    // Group types of all processors
+        std::vector<members_t> members_proc;     // Group members of all processors
 
-        std::vector< std::map<unsigned int, unsigned int> > rtag_map_proc; // List of reverse-lookup maps
-
-        unsigned int size = m_exec_conf->getNRanks();
-
-        // resize arrays to accumulate group data of all ranks
-        types_proc.resize(size);
-        members_proc.resize(size);
-        rtag_map_proc.resize(size);
-
-        // gather all processors' data
-        gather_v(types, types_proc, 0, m_exec_conf->getMPICommunicator());
-        gather_v(members, members_proc, 0, m_exec_conf->getMPICommunicator());
-        gather_v(rtag_map, rtag_map_proc, 0, m_exec_conf->getMPICommunicator());
+        // gather all processors' data, without serialization
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        gather_pod_v(tags, tags_proc, 0, mpi_comm);
+        gather_pod_v(types, types_proc, 0, mpi_comm);
+        gather_pod_v(members, members_proc, 0, mpi_comm);
 
         if (m_exec_conf->getRank() == 0)
             {
-            assert(rtag_map_proc.size() == size);
+            // look-up table from the active tags to their position in the snapshot
+            std::vector<unsigned int> tag_snap_idx(m_tag_set.empty() ? 0 : *m_tag_set.rbegin()+1, GROUP_NOT_LOCAL);
+            unsigned int n_active = 0;
+            std::set<unsigned int>::iterator active_tag_it;
+            for (active_tag_it = m_tag_set.begin(); active_tag_it != m_tag_set.end(); ++active_tag_it)
+                tag_snap_idx[*active_tag_it] = n_active++;
 
-            // create single map of all group ranks and indices
             // groups present on more than one processor will count as one group
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> > rank_rtag_map;
-            std::map<unsigned int, unsigned int>::iterator it;
-            for (unsigned int irank = 0; irank < size; ++irank)
-                for (it = rtag_map_proc[irank].begin(); it != rtag_map_proc[irank].end(); ++it)
-                    rank_rtag_map.insert(std::make_pair(it->first, std::make_pair(irank, it->second)));
-
-            // add groups to snapshot
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> >::iterator rank_rtag_it;
+            std::vector<bool> found(getNGlobal(), false);
+            for (unsigned int i = 0; i < tags_proc.size(); ++i)
+                {
+                unsigned int group_tag = tags_proc[i];
+                assert(group_tag < tag_snap_idx.size());
+                unsigned int snap_id = tag_snap_idx[group_tag];
+                assert(snap_id != GROUP_NOT_LOCAL);
+
+                snapshot.type_id[snap_id] = types_proc[i];
+                snapshot.groups[snap_id] = members_proc[i];
+                found[snap_id] = true;
+                }
 
-            // index in snapshot
             unsigned int snap_id = 0;
-
-            // loop through active tags
-            std::set<unsigned int>::iterator active_tag_it;
-            for (active_tag_it = m_tag_set.begin(); active_tag_it != m_tag_set.end(); ++active_tag_it)
-                {
-                unsigned int group_tag = *active_tag_it;
-                rank_rtag_it = rank_rtag_map.find(group_tag);
-                if (rank_rtag_it == rank_rtag_map.end())
+            for (active_tag_it = m_tag_set.begin(); active_tag_it != m_tag_set.end(); ++active_tag_it, ++snap_id)
+                if (! found[snap_id])
                     {
                     m_exec_conf->msg->error()
-                        << endl << "Could not find " << name << " " << group_tag << " on any processor. "
+                        << endl << "Could not find " << name << " " << *active_tag_it << " on any processor. "
                         << endl << endl;
                     throw std::runtime_error("Error gathering "+std::string(name)+"s");
                     }
-
-                // rank contains the processor rank on which the particle was found
-                std::pair<unsigned int, unsigned int> rank_idx = rank_rtag_it->second;
-                unsigned int rank = rank_idx.first;
-                unsigned int idx = rank_idx.second;
-
-                snapshot.type_id[snap_id] = types_proc[rank][idx];
-                snapshot.groups[snap_id] = members_proc[rank][idx];
-                snap_id++;
-                }
             }
         }
     else
     #endif
         {
+        std::map<unsigned int, unsigned int> rtag_map;
+
+        for (unsigned int group_idx = 0; group_idx < getN(); group_idx++)
+            {
+            unsigned int tag = m_group_tag[group_idx];
+            assert(m_group_rtag[tag] == group_idx);
+
+            rtag_map.insert(std::pair<unsigned int,unsigned int>(tag, group_idx));
+            }
+
         assert(getN() == getNGlobal());
         std::map<unsigned int, unsigned int>::iterator rtag_it;
         // index in snapshot
@@ -1103,6 +1168,7 @@ void BondedGroupData<group_size, Group, name>::moveParticleGroups(unsigned int t
     // notify observers
     m_group_num_change_signal();
     m_groups_dirty = true;
+    m_idx_table_dirty = true;
     }
 #endif
 
@@ -480,6 +480,39 @@ class BondedGroupData : boost::noncopyable
             return m_n_groups;
             }
 
+        /*
+         * CPU group table
+         */
+
+        //! Return the bonded groups with their members resolved to particle indices
+        /*! Each entry lists the particle indices of the members of one group (in member order). The entries are sorted
+            by the lowest member index, so that a loop over the table accesses the particle data in memory order.
+         */
+        const GPUArray<members_t>& getIndexTable()
+            {
+            // rebuild lookup table if necessary
+            if (m_idx_table_dirty)
+                {
+                rebuildIndexTable();
+                m_idx_table_dirty = false;
+                }
+
+            return m_idx_table;
+            }
+
+        //! Return the types of the groups in the index table
+        const GPUArray<unsigned int>& getIndexTableTypes()
+            {
+            // rebuild lookup table if necessary
+            if (m_idx_table_dirty)
+                {
+                rebuildIndexTable();
+                m_idx_table_dirty = false;
+                }
+
+            return m_idx_table_type;
+            }
+
         /*
          * add/remove groups globally
          */
@@ -515,6 +548,7 @@ class BondedGroupData : boost::noncopyable
         void setDirty()
             {
             m_groups_dirty = true;
+            m_idx_table_dirty = true;
             }
 
     protected:
@@ -538,6 +572,8 @@ class BondedGroupData : boost::noncopyable
         GPUVector<unsigned int> m_gpu_pos_table;     //!< Position of particle idx in group table
         Index2D m_gpu_table_indexer;                 //!< Indexer for GPU table
         GPUVector<unsigned int> m_n_groups;          //!< Number of entries in lookup table per particle
+        GPUVector<members_t> m_idx_table;            //!< Groups by particle index for access on the CPU
+        GPUVector<unsigned int> m_idx_table_type;    //!< Types of the groups in the CPU table
         std::vector<std::string> m_type_mapping;     //!< Mapping of types of bonded groups
 
         #ifdef ENABLE_MPI
@@ -559,6 +595,7 @@ class BondedGroupData : boost::noncopyable
 
     private:
         bool m_groups_dirty;                         //!< Is it necessary to rebuild the lookup-by-index table?
+        bool m_idx_table_dirty;                      //!< Is it necessary to rebuild the CPU index table?
         boost::signals2::connection m_sort_connection;   //!< Connection to the resort signal from ParticleData
 
         #ifdef ENABLE_MPI
@@ -573,6 +610,9 @@ class BondedGroupData : boost::noncopyable
         //! Helper function to rebuild lookup by index table
         void rebuildGPUTable();
 
+        //! Helper function to rebuild the CPU index table
+        void rebuildIndexTable();
+
         #ifdef ENABLE_CUDA
         //! Helper function to rebuild lookup by index table on the GPU
         void rebuildGPUTableGPU();
@@ -64,6 +64,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "HOOMDMPI.h"
 #endif
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 #include <boost/python.hpp>
 using namespace boost::python;
 
@@ -686,13 +690,51 @@ void ExecutionConfiguration::setupStats()
 
     if (exec_mode == CPU)
         {
+        #ifdef ENABLE_OPENMP
+        // use as many threads as OpenMP provides (controlled by OMP_NUM_THREADS)
+        n_cpu = omp_get_max_threads();
+        #endif
+
         ostringstream s;
 
-        s << "HOOMD-blue is running on the CPU" << endl;
+        s << "HOOMD-blue is running on the CPU";
+        if (n_cpu > 1)
+            s << " with " << n_cpu << " threads";
+        s << endl;
         msg->collectiveNoticeStr(1,s.str());
         }
     }
 
+/*! \param n_threads Number of CPU threads to use
+
+    Overrides the number of threads chosen at initialization. GPU runs always use a single CPU thread, and builds
+    without OpenMP support can only run with one.
+*/
+void ExecutionConfiguration::setNumThreads(unsigned int n_threads)
+    {
+    if (n_threads == 0)
+        {
+        msg->error() << "The number of CPU threads must be at least 1" << endl;
+        throw runtime_error("Error setting the number of threads");
+        }
+
+    if (exec_mode != CPU)
+        {
+        msg->warning() << "Multithreaded execution is only available on the CPU, ignoring request for "
+                       << n_threads << " threads" << endl;
+        return;
+        }
+
+    #ifdef ENABLE_OPENMP
+    n_cpu = n_threads;
+    omp_set_num_threads(n_cpu);
+    msg->notice(4) << "Using " << n_cpu << " CPU threads" << endl;
+    #else
+    if (n_threads > 1)
+        msg->warning() << "This hoomd was built without OpenMP support, running on a single CPU thread" << endl;
+    #endif
+    }
+
 #ifdef ENABLE_MPI
 unsigned int ExecutionConfiguration::getNRanks() const
     {
@@ -709,6 +751,7 @@ void export_ExecutionConfiguration()
                          .def("isCUDAEnabled", &ExecutionConfiguration::isCUDAEnabled)
                          .def("setCUDAErrorChecking", &ExecutionConfiguration::setCUDAErrorChecking)
                          .def("getGPUName", &ExecutionConfiguration::getGPUName)
+                         .def("setNumThreads", &ExecutionConfiguration::setNumThreads)
                          .def_readonly("n_cpu", &ExecutionConfiguration::n_cpu)
                          .def_readonly("msg", &ExecutionConfiguration::msg)
 #ifdef ENABLE_CUDA
@@ -135,7 +135,7 @@ struct ExecutionConfiguration : boost::noncopyable
     static int guessLocalRank();
 
     executionMode exec_mode;    //!< Execution mode specified in the constructor
-    unsigned int n_cpu;         //!< Number of CPUS hoomd is executing on
+    unsigned int n_cpu;         //!< Number of CPU threads hoomd is executing on
     bool m_cuda_error_checking;                //!< Set to true if GPU error checking is enabled
     boost::shared_ptr<Messenger> msg;          //!< Messenger for use in printing messages to the screen / log file
 
@@ -161,6 +161,9 @@ struct ExecutionConfiguration : boost::noncopyable
         m_cuda_error_checking = cuda_error_checking;
         }
 
+    //! Set the number of CPU threads to use
+    void setNumThreads(unsigned int n_threads);
+
     //! Get the name of the executing GPU (or the empty string)
     std::string getGPUName() const;
 #ifdef ENABLE_CUDA
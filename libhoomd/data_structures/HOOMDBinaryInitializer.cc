@@ -59,19 +59,24 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include "HOOMDBinaryInitializer.h"
+#include "HOOMDTrajectoryReader.h"
 #include "SnapshotSystemData.h"
+#include "SystemDefinition.h"
 
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
 #include <sstream>
 #include <algorithm>
+#include <cstring>
 
 using namespace std;
 
 #include <boost/python.hpp>
 #include <boost/iostreams/device/file.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
 #ifdef ENABLE_ZLIB
 #include <boost/iostreams/filter/gzip.hpp>
 #endif
@@ -82,18 +87,28 @@ using namespace boost::iostreams;
 
 /*! \param ExecutionConfiguration
     \param fname File name with the data to load
+    \param frame Index of the frame to read if \a fname is a trajectory file (negative values count from the end)
     The file will be read and parsed fully during the constructor call.
 */
 HOOMDBinaryInitializer::HOOMDBinaryInitializer(boost::shared_ptr<const ExecutionConfiguration> exec_conf,
-                                               const std::string &fname)
+                                               const std::string &fname,
+                                               int frame)
     : m_exec_conf(exec_conf),
-      m_timestep(0)
+      m_timestep(0),
+      m_tail_offset(0),
+      m_frame(frame)
     {
-    // execute only on rank zero
-    if (m_exec_conf->getRank()) return;
-
     // initialize member variables
     m_num_dimensions = 3;
+
+    // execute only on rank zero, except that every rank maps an aligned file to read its own particles
+    if (m_exec_conf->getRank())
+        {
+        if (isAlignedFile(fname))
+            mapAlignedFile(fname);
+        return;
+        }
+
     // read in the file
     readFile(fname);
     }
@@ -122,15 +137,35 @@ boost::shared_ptr<SnapshotSystemData> HOOMDBinaryInitializer::getSnapshot() cons
     // execute only on rank zero
     if (m_exec_conf->getRank()) return snapshot;
 
-    // init dimensions
-    snapshot->dimensions = m_num_dimensions;
+    // a trajectory frame is already stored as a snapshot
+    if (m_traj_snapshot)
+        return boost::shared_ptr<SnapshotSystemData>(new SnapshotSystemData(*m_traj_snapshot));
 
-    // init box
-    snapshot->global_box = m_box;
+    fillSnapshot(*snapshot);
 
     // init particle data snapshot
     SnapshotParticleData& pdata = snapshot->particle_data;
 
+    if (m_mapped_file.is_open())
+        {
+        // copy the arrays straight out of the mapped file
+        const ParticleDataView& view = m_particle_view;
+        pdata.size = view.size;
+        pdata.pos.assign(view.pos, view.pos + view.size);
+        pdata.vel.assign(view.vel, view.vel + view.size);
+        pdata.accel.assign(view.accel, view.accel + view.size);
+        pdata.type.assign(view.type, view.type + view.size);
+        pdata.mass.assign(view.mass, view.mass + view.size);
+        pdata.charge.assign(view.charge, view.charge + view.size);
+        pdata.diameter.assign(view.diameter, view.diameter + view.size);
+        pdata.image.assign(view.image, view.image + view.size);
+        pdata.body.assign(view.body, view.body + view.size);
+        pdata.orientation.assign(view.orientation, view.orientation + view.size);
+        pdata.inertia_tensor.resize(view.size);
+        pdata.type_mapping = view.type_mapping;
+        return snapshot;
+        }
+
     // resize snapshot
     pdata.resize(m_x_array.size());
 
@@ -152,10 +187,24 @@ boost::shared_ptr<SnapshotSystemData> HOOMDBinaryInitializer::getSnapshot() cons
 
     pdata.type_mapping = m_type_mapping;
 
+    return snapshot;
+    }
+
+/*! \param snapshot Snapshot to fill with the box, dimensions, bonded groups, walls, integrator variables and rigid
+    bodies read from the file
+*/
+void HOOMDBinaryInitializer::fillSnapshot(SnapshotSystemData& snapshot) const
+    {
+    // init dimensions
+    snapshot.dimensions = m_num_dimensions;
+
+    // init box
+    snapshot.global_box = m_box;
+
     /*
      * Initialize bond data
      */
-    BondData::Snapshot& bdata = snapshot->bond_data;
+    BondData::Snapshot& bdata = snapshot.bond_data;
 
     // allocate memory in snapshot
     bdata.resize(m_bonds.size());
@@ -172,7 +221,7 @@ boost::shared_ptr<SnapshotSystemData> HOOMDBinaryInitializer::getSnapshot() cons
     /*
      * Initialize angle data
      */
-    AngleData::Snapshot& adata = snapshot->angle_data;
+    AngleData::Snapshot& adata = snapshot.angle_data;
 
     // allocate memory in snapshot
     adata.resize(m_angles.size());
@@ -189,7 +238,7 @@ boost::shared_ptr<SnapshotSystemData> HOOMDBinaryInitializer::getSnapshot() cons
     /*
      * Initialize dihedral data
      */
-    DihedralData::Snapshot& ddata = snapshot->dihedral_data;
+    DihedralData::Snapshot& ddata = snapshot.dihedral_data;
 
     // allocate memory
     ddata.resize(m_dihedrals.size());
@@ -206,7 +255,7 @@ boost::shared_ptr<SnapshotSystemData> HOOMDBinaryInitializer::getSnapshot() cons
     /*
      * Initialize improper data
      */
-    ImproperData::Snapshot& idata = snapshot->improper_data;
+    ImproperData::Snapshot& idata = snapshot.improper_data;
 
     // allocate memory
     idata.resize(m_impropers.size());
@@ -223,17 +272,17 @@ boost::shared_ptr<SnapshotSystemData> HOOMDBinaryInitializer::getSnapshot() cons
     /*
      * Initialize walls
      */
-    snapshot->wall_data = m_walls;
+    snapshot.wall_data = m_walls;
 
     /*
      * Initialize integrator data
      */
-    snapshot->integrator_data = m_integrator_variables;
+    snapshot.integrator_data = m_integrator_variables;
 
     /*
      * Initalize rigid body data
      */
-    SnapshotRigidData& rdata = snapshot->rigid_data;
+    SnapshotRigidData& rdata = snapshot.rigid_data;
 
     unsigned int n_bodies = m_com.size();
     rdata.resize(n_bodies);
@@ -245,8 +294,28 @@ boost::shared_ptr<SnapshotSystemData> HOOMDBinaryInitializer::getSnapshot() cons
         rdata.angmom[body] = make_scalar3(m_angmom[body].x, m_angmom[body].y, m_angmom[body].z);
         rdata.body_image[body] = m_body_image[body];
         }
+    }
 
-    return snapshot;
+/*! \param exec_conf Execution configuration to run on
+    \param decomposition (optional) The domain decomposition layout
+    \returns A new SystemDefinition initialized with the contents of the file
+
+    For aligned files, the ParticleData is initialized directly from the memory-mapped file. Otherwise, this is
+    equivalent to constructing a SystemDefinition from getSnapshot().
+*/
+boost::shared_ptr<SystemDefinition> HOOMDBinaryInitializer::createSystemDefinition(
+    boost::shared_ptr<ExecutionConfiguration> exec_conf,
+    boost::shared_ptr<DomainDecomposition> decomposition) const
+    {
+    if (!m_mapped_file.is_open())
+        return boost::shared_ptr<SystemDefinition>(new SystemDefinition(getSnapshot(), exec_conf, decomposition));
+
+    // the particle data is taken from the mapped file, everything else from the snapshot
+    boost::shared_ptr<SnapshotSystemData> snapshot(new SnapshotSystemData());
+    if (m_exec_conf->getRank() == 0)
+        fillSnapshot(*snapshot);
+
+    return boost::shared_ptr<SystemDefinition>(new SystemDefinition(snapshot, m_particle_view, exec_conf, decomposition));
     }
 
 //! Helper function to read a string from the file
@@ -276,6 +345,18 @@ static string read_string(istream &f)
 */
 void HOOMDBinaryInitializer::readFile(const string &fname)
     {
+    if (HOOMDTrajectoryReader::isTrajectoryFile(fname))
+        {
+        readTrajectoryFrame(fname);
+        return;
+        }
+
+    if (isAlignedFile(fname))
+        {
+        readAlignedFile(fname);
+        return;
+        }
+
     // check to see if the file has a .gz extension or not and enable decompression if it is
     bool enable_decompression = false;
     string ext = fname.substr(fname.size()-3, fname.size());
@@ -395,6 +476,48 @@ void HOOMDBinaryInitializer::readFile(const string &fname)
         m_type_mapping[i] = read_string(f);
     f.read((char*)&(m_type_array[0]), np*sizeof(unsigned int));
 
+    readTail(f);
+
+    // check for required items in the file
+    if (m_x_array.size() == 0)
+        {
+        m_exec_conf->msg->error() << endl << "No particles found in binary file" << endl << endl;
+        throw runtime_error("Error extracting data from hoomd_binary file");
+        }
+
+    // notify the user of what we have accomplished
+    m_exec_conf->msg->notice(2) << "--- hoomd_binary file read summary" << endl;
+    m_exec_conf->msg->notice(2) << m_x_array.size() << " positions at timestep " << m_timestep << endl;
+    if (m_ix_array.size() > 0)
+        m_exec_conf->msg->notice(2) << m_ix_array.size() << " images" << endl;
+    if (m_vx_array.size() > 0)
+        m_exec_conf->msg->notice(2) << m_vx_array.size() << " velocities" << endl;
+    if (m_mass_array.size() > 0)
+        m_exec_conf->msg->notice(2) << m_mass_array.size() << " masses" << endl;
+    if (m_diameter_array.size() > 0)
+        m_exec_conf->msg->notice(2) << m_diameter_array.size() << " diameters" << endl;
+    if (m_charge_array.size() > 0)
+        m_exec_conf->msg->notice(2) << m_charge_array.size() << " charges" << endl;
+    m_exec_conf->msg->notice(2) << m_type_mapping.size() <<  " particle types" << endl;
+    if (m_integrator_variables.size() > 0)
+        m_exec_conf->msg->notice(2) << m_integrator_variables.size() << " integrator states" << endl;
+    if (m_bonds.size() > 0)
+        m_exec_conf->msg->notice(2) << m_bonds.size() << " bonds" << endl;
+    if (m_angles.size() > 0)
+        m_exec_conf->msg->notice(2) << m_angles.size() << " angles" << endl;
+    if (m_dihedrals.size() > 0)
+        m_exec_conf->msg->notice(2) << m_dihedrals.size() << " dihedrals" << endl;
+    if (m_impropers.size() > 0)
+        m_exec_conf->msg->notice(2) << m_impropers.size() << " impropers" << endl;
+    if (m_walls.size() > 0)
+        m_exec_conf->msg->notice(2) << m_walls.size() << " walls" << endl;
+    }
+
+/*! \param f Stream positioned after the particle types of a hoomd_bin file
+    \post The integrator variables, bonded groups, walls and rigid bodies are read from \a f
+*/
+void HOOMDBinaryInitializer::readTail(istream &f)
+    {
     //parse integrator states
     {
     std::vector<IntegratorVariables> v;
@@ -420,7 +543,7 @@ void HOOMDBinaryInitializer::readFile(const string &fname)
 
     //parse bonds
     {
-    ntypes = 0;
+    unsigned int ntypes = 0;
     f.read((char*)&ntypes, sizeof(unsigned int));
     m_bond_type_mapping.resize(ntypes);
     for (unsigned int i = 0; i < ntypes; i++)
@@ -444,7 +567,7 @@ void HOOMDBinaryInitializer::readFile(const string &fname)
 
     //parse angles
     {
-    ntypes = 0;
+    unsigned int ntypes = 0;
     f.read((char*)&ntypes, sizeof(unsigned int));
     m_angle_type_mapping.resize(ntypes);
     for (unsigned int i = 0; i < ntypes; i++)
@@ -469,7 +592,7 @@ void HOOMDBinaryInitializer::readFile(const string &fname)
 
     //parse dihedrals
     {
-    ntypes = 0;
+    unsigned int ntypes = 0;
     f.read((char*)&ntypes, sizeof(unsigned int));
     m_dihedral_type_mapping.resize(ntypes);
     for (unsigned int i = 0; i < ntypes; i++)
@@ -495,7 +618,7 @@ void HOOMDBinaryInitializer::readFile(const string &fname)
 
     //parse impropers
     {
-    ntypes = 0;
+    unsigned int ntypes = 0;
     f.read((char*)&ntypes, sizeof(unsigned int));
     m_improper_type_mapping.resize(ntypes);
     for (unsigned int i = 0; i < ntypes; i++)
@@ -571,9 +694,151 @@ void HOOMDBinaryInitializer::readFile(const string &fname)
         }
 
     }
+    }
 
-    // check for required items in the file
-    if (m_x_array.size() == 0)
+/*! \param fname File to test
+    \returns true if \a fname is a hoomd_bin file in the aligned format
+*/
+bool HOOMDBinaryInitializer::isAlignedFile(const std::string &fname)
+    {
+    ifstream f(fname.c_str(), ios::in | ios::binary);
+    unsigned int file_magic = 0;
+    int file_version = 0;
+    f.read((char*)&file_magic, sizeof(unsigned int));
+    f.read((char*)&file_version, sizeof(int));
+    return f.good() && file_magic == (unsigned int)hoomd_bin_aligned::magic
+                    && file_version == (int)hoomd_bin_aligned::version;
+    }
+
+//! Helper function to read a value from the header of a mapped file
+template<class T>
+static T read_value(const char *data, size_t &offset)
+    {
+    T value;
+    memcpy(&value, data + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+    }
+
+/*! \param fname File name of the aligned hoomd_bin file to map
+    \post The file is mapped, the header is read, and m_particle_view points to the particle arrays in the file
+*/
+void HOOMDBinaryInitializer::mapAlignedFile(const string &fname)
+    {
+    try
+        {
+        m_mapped_file.open(fname);
+        }
+    catch (std::exception const & ex)
+        {
+        m_exec_conf->msg->error() << endl << "Error mapping " << fname << ": " << ex.what() << endl << endl;
+        throw runtime_error("Error reading binary file");
+        }
+
+    const char *data = m_mapped_file.data();
+    size_t size = m_mapped_file.size();
+
+    size_t header_size = 8*sizeof(unsigned int) + 6*sizeof(Scalar)
+                         + (hoomd_bin_field::num_fields + 2)*sizeof(uint64_t);
+    if (size < 8*sizeof(unsigned int))
+        {
+        m_exec_conf->msg->error() << endl << fname << " is truncated" << endl << endl;
+        throw runtime_error("Error reading binary file");
+        }
+
+    // read the header
+    size_t offset = 2*sizeof(unsigned int);
+    m_timestep = read_value<unsigned int>(data, offset);
+    m_num_dimensions = read_value<unsigned int>(data, offset);
+    unsigned int scalar_size = read_value<unsigned int>(data, offset);
+    unsigned int np = read_value<unsigned int>(data, offset);
+    unsigned int num_fields = read_value<unsigned int>(data, offset);
+    offset += sizeof(unsigned int);
+
+    if (scalar_size != sizeof(Scalar))
+        {
+        m_exec_conf->msg->error() << endl << fname << " was written by a build of hoomd with a different "
+                                  << "floating point precision" << endl << endl;
+        throw runtime_error("Error reading binary file");
+        }
+
+    if (num_fields != hoomd_bin_field::num_fields || size < header_size)
+        {
+        m_exec_conf->msg->error() << endl << fname << " has an invalid header" << endl << endl;
+        throw runtime_error("Error reading binary file");
+        }
+
+    Scalar Lx = read_value<Scalar>(data, offset);
+    Scalar Ly = read_value<Scalar>(data, offset);
+    Scalar Lz = read_value<Scalar>(data, offset);
+    Scalar xy = read_value<Scalar>(data, offset);
+    Scalar xz = read_value<Scalar>(data, offset);
+    Scalar yz = read_value<Scalar>(data, offset);
+    m_box = BoxDim(Lx,Ly,Lz);
+    m_box.setTiltFactors(xy,xz,yz);
+
+    uint64_t field_offset[hoomd_bin_field::num_fields];
+    for (unsigned int i = 0; i < hoomd_bin_field::num_fields; i++)
+        field_offset[i] = read_value<uint64_t>(data, offset);
+    m_tail_offset = read_value<uint64_t>(data, offset);
+    uint64_t file_size = read_value<uint64_t>(data, offset);
+
+    // a file that was not written completely is detected by its size
+    if (file_size != size || m_tail_offset > size)
+        {
+        m_exec_conf->msg->error() << endl << fname << " is truncated" << endl << endl;
+        throw runtime_error("Error reading binary file");
+        }
+
+    for (unsigned int i = 0; i < hoomd_bin_field::num_fields; i++)
+        {
+        if (field_offset[i] % hoomd_bin_aligned::alignment != 0
+            || field_offset[i] + uint64_t(np)*hoomd_bin_field::getElementSize(i) > size)
+            {
+            m_exec_conf->msg->error() << endl << fname << " has an invalid header" << endl << endl;
+            throw runtime_error("Error reading binary file");
+            }
+        }
+
+    // the particle arrays are used in place
+    m_particle_view.size = np;
+    m_particle_view.pos = (const Scalar3 *)(data + field_offset[hoomd_bin_field::position]);
+    m_particle_view.vel = (const Scalar3 *)(data + field_offset[hoomd_bin_field::velocity]);
+    m_particle_view.accel = (const Scalar3 *)(data + field_offset[hoomd_bin_field::acceleration]);
+    m_particle_view.type = (const unsigned int *)(data + field_offset[hoomd_bin_field::type]);
+    m_particle_view.mass = (const Scalar *)(data + field_offset[hoomd_bin_field::mass]);
+    m_particle_view.charge = (const Scalar *)(data + field_offset[hoomd_bin_field::charge]);
+    m_particle_view.diameter = (const Scalar *)(data + field_offset[hoomd_bin_field::diameter]);
+    m_particle_view.image = (const int3 *)(data + field_offset[hoomd_bin_field::image]);
+    m_particle_view.body = (const unsigned int *)(data + field_offset[hoomd_bin_field::body]);
+    m_particle_view.orientation = (const Scalar4 *)(data + field_offset[hoomd_bin_field::orientation]);
+    }
+
+/*! \param fname File name of the aligned hoomd_bin file to read
+*/
+void HOOMDBinaryInitializer::readAlignedFile(const string &fname)
+    {
+    m_exec_conf->msg->notice(2) << "Mapping " << fname << "..." << endl;
+    mapAlignedFile(fname);
+
+    // parse the tail, starting with the particle types
+    stream<array_source> f(m_mapped_file.data() + m_tail_offset, m_mapped_file.size() - m_tail_offset);
+
+    unsigned int ntypes = 0;
+    f.read((char*)&ntypes, sizeof(unsigned int));
+    m_particle_view.type_mapping.resize(ntypes);
+    for (unsigned int i = 0; i < ntypes; i++)
+        m_particle_view.type_mapping[i] = read_string(f);
+
+    readTail(f);
+
+    if (f.fail())
+        {
+        m_exec_conf->msg->error() << endl << fname << " is truncated" << endl << endl;
+        throw runtime_error("Error reading binary file");
+        }
+
+    if (m_particle_view.size == 0)
         {
         m_exec_conf->msg->error() << endl << "No particles found in binary file" << endl << endl;
         throw runtime_error("Error extracting data from hoomd_binary file");
@@ -581,18 +846,8 @@ void HOOMDBinaryInitializer::readFile(const string &fname)
 
     // notify the user of what we have accomplished
     m_exec_conf->msg->notice(2) << "--- hoomd_binary file read summary" << endl;
-    m_exec_conf->msg->notice(2) << m_x_array.size() << " positions at timestep " << m_timestep << endl;
-    if (m_ix_array.size() > 0)
-        m_exec_conf->msg->notice(2) << m_ix_array.size() << " images" << endl;
-    if (m_vx_array.size() > 0)
-        m_exec_conf->msg->notice(2) << m_vx_array.size() << " velocities" << endl;
-    if (m_mass_array.size() > 0)
-        m_exec_conf->msg->notice(2) << m_mass_array.size() << " masses" << endl;
-    if (m_diameter_array.size() > 0)
-        m_exec_conf->msg->notice(2) << m_diameter_array.size() << " diameters" << endl;
-    if (m_charge_array.size() > 0)
-        m_exec_conf->msg->notice(2) << m_charge_array.size() << " charges" << endl;
-    m_exec_conf->msg->notice(2) << m_type_mapping.size() <<  " particle types" << endl;
+    m_exec_conf->msg->notice(2) << m_particle_view.size << " particles at timestep " << m_timestep << endl;
+    m_exec_conf->msg->notice(2) << m_particle_view.type_mapping.size() <<  " particle types" << endl;
     if (m_integrator_variables.size() > 0)
         m_exec_conf->msg->notice(2) << m_integrator_variables.size() << " integrator states" << endl;
     if (m_bonds.size() > 0)
@@ -605,16 +860,52 @@ void HOOMDBinaryInitializer::readFile(const string &fname)
         m_exec_conf->msg->notice(2) << m_impropers.size() << " impropers" << endl;
     if (m_walls.size() > 0)
         m_exec_conf->msg->notice(2) << m_walls.size() << " walls" << endl;
+    if (m_com.size() > 0)
+        m_exec_conf->msg->notice(2) << m_com.size() << " rigid bodies" << endl;
+    }
+
+/*! \param fname File name of the trajectory file to read
+*/
+void HOOMDBinaryInitializer::readTrajectoryFrame(const string &fname)
+    {
+    m_exec_conf->msg->notice(2) << "Reading " << fname << "..." << endl;
+    HOOMDTrajectoryReader reader(m_exec_conf, fname);
+
+    int n_frames = reader.getNumFrames();
+    int frame = m_frame < 0 ? n_frames + m_frame : m_frame;
+    if (frame < 0 || frame >= n_frames)
+        {
+        m_exec_conf->msg->error() << "init.read_bin: frame " << m_frame << " is out of range, " << fname
+                                  << " has " << n_frames << " frames" << endl;
+        throw runtime_error("Error reading binary file");
+        }
+
+    m_traj_snapshot = reader.readFrame(frame);
+    m_timestep = reader.getTimeStep(frame);
+    m_num_dimensions = m_traj_snapshot->dimensions;
+
+    m_exec_conf->msg->notice(2) << "Read frame " << frame << " (time step " << m_timestep << ") with "
+                                << m_traj_snapshot->particle_data.size << " particles" << endl;
+    }
+
+//! Helper function to create a SystemDefinition without domain decomposition from python
+static boost::shared_ptr<SystemDefinition> create_system_definition_nodecomp(const HOOMDBinaryInitializer& init,
+    boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    return init.createSystemDefinition(exec_conf);
     }
 
 void export_HOOMDBinaryInitializer()
     {
     class_< HOOMDBinaryInitializer >("HOOMDBinaryInitializer",
-        init<boost::shared_ptr<const ExecutionConfiguration>, const string&>())
+        init<boost::shared_ptr<const ExecutionConfiguration>, const string&, boost::python::optional<int> >())
         // virtual methods from ParticleDataInitializer are inherited
         .def("getSnapshot", &HOOMDBinaryInitializer::getSnapshot)
         .def("getTimeStep", &HOOMDBinaryInitializer::getTimeStep)
         .def("setTimeStep", &HOOMDBinaryInitializer::setTimeStep)
+        .def("getBox", &HOOMDBinaryInitializer::getBox)
+        .def("createSystemDefinition", &HOOMDBinaryInitializer::createSystemDefinition)
+        .def("createSystemDefinition", &create_system_definition_nodecomp)
         ;
     }
 
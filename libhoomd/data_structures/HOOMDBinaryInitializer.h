@@ -70,6 +70,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+using boost::uint64_t;
 
 #ifndef __HOOMD_BINARY_INITIALIZER_H__
 #define __HOOMD_BINARY_INITIALIZER_H__
@@ -77,6 +81,91 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 //! Forward definition of SnapshotSystemData
 struct SnapshotSystemData;
 
+//! Forward definition of SystemDefinition
+class SystemDefinition;
+
+/*! \page page_bin_aligned_format Aligned hoomd_bin file format
+
+    Version 4 of the hoomd_bin format stores the same data as version 3, but is never compressed and places every
+    per-particle array at an offset that is a multiple of hoomd_bin_aligned::alignment bytes. It can therefore be
+    memory-mapped and the arrays used in place. It is written by HOOMDBinaryDumpWriter when aligned output is
+    enabled, and read by HOOMDBinaryInitializer. All values are stored in the native byte order.
+
+    The file starts with a header:
+     - the magic number hoomd_bin_aligned::magic, the version (4), the time step, the number of dimensions,
+       sizeof(Scalar), the number of particles N, the number of per-particle arrays (hoomd_bin_field::num_fields)
+       and one reserved word (all 32-bit)
+     - Lx, Ly, Lz, xy, xz, yz of the global box (Scalar)
+     - the file offset of every per-particle array, the file offset of the tail and the total size of the
+       file (64-bit)
+
+    The per-particle arrays follow, in tag order and in the order of hoomd_bin_field. Each array stores N values of
+    the type used for the same field in SnapshotParticleData (Scalar3 for hoomd_bin_field::position, ...).
+
+    The tail holds the particle type names (the number of types followed by the names, as in version 3), followed
+    by everything that version 3 stores after the particle types: integrator variables, bonds, angles, dihedrals,
+    impropers, walls and rigid bodies.
+*/
+
+//! Constants describing the aligned hoomd_bin file layout
+/*! See \ref page_bin_aligned_format
+*/
+struct hoomd_bin_aligned
+    {
+    enum Enum
+        {
+        magic = 0x444d4f48,     //!< Magic number at the start of the file (same as all hoomd_bin versions)
+        version = 4,            //!< Version of the aligned file format
+        alignment = 64          //!< Alignment of the per-particle arrays in bytes
+        };
+    };
+
+//! Per-particle arrays in an aligned hoomd_bin file
+/*! See \ref page_bin_aligned_format
+*/
+struct hoomd_bin_field
+    {
+    enum Enum
+        {
+        position = 0,   //!< Particle positions (Scalar3)
+        velocity,       //!< Particle velocities (Scalar3)
+        acceleration,   //!< Particle accelerations (Scalar3)
+        type,           //!< Particle types (unsigned int)
+        mass,           //!< Particle masses (Scalar)
+        charge,         //!< Particle charges (Scalar)
+        diameter,       //!< Particle diameters (Scalar)
+        image,          //!< Particle images (int3)
+        body,           //!< Body ids (unsigned int)
+        orientation,    //!< Particle orientations (Scalar4)
+        num_fields      //!< Number of per-particle arrays
+        };
+
+    //! Get the size of one element of a per-particle array in bytes
+    static unsigned int getElementSize(unsigned int field)
+        {
+        switch (field)
+            {
+            case position:
+            case velocity:
+            case acceleration:
+                return sizeof(Scalar3);
+            case type:
+            case body:
+                return sizeof(unsigned int);
+            case mass:
+            case charge:
+            case diameter:
+                return sizeof(Scalar);
+            case image:
+                return sizeof(int3);
+            case orientation:
+                return sizeof(Scalar4);
+            default:
+                return 0;
+            }
+        }
+    };
+
 //! Initializes particle data from a Hoomd input file
 /*! The input XML file format is identical to the output XML file format that HOOMDDumpWriter writes.
     For more information on the XML file format design see \ref page_dev_info. Although, HOOMD's
@@ -92,6 +181,14 @@ struct SnapshotSystemData;
     of them. Adding a new node to the file format parser is as simple as adding a new node parser function
     (like parsePositionNode()) and adding it to the map in the constructor.
 
+    Files in the aligned format (\ref page_bin_aligned_format) are memory-mapped instead of read. The particle
+    data is not copied at all until createSystemDefinition() initializes the ParticleData directly from the mapped
+    file. In MPI runs, every rank maps the file and copies only the particles in its own domain. The file must
+    therefore be accessible from all ranks.
+
+    If \a fname is a HOOMD trajectory file written by HOOMDTrajectoryWriter, the frame with index \a frame is read
+    with HOOMDTrajectoryReader instead. Negative values of \a frame count from the end of the file.
+
     \ingroup data_structs
 */
 class HOOMDBinaryInitializer
@@ -99,7 +196,8 @@ class HOOMDBinaryInitializer
     public:
         //! Loads in the file and parses the data
         HOOMDBinaryInitializer(boost::shared_ptr<const ExecutionConfiguration> exec_conf,
-                               const std::string &fname);
+                               const std::string &fname,
+                               int frame=-1);
 
         //! Returns the timestep of the simulation
         virtual unsigned int getTimeStep() const;
@@ -110,10 +208,38 @@ class HOOMDBinaryInitializer
         //! initializes a snapshot with the particle data
         virtual boost::shared_ptr<SnapshotSystemData> getSnapshot() const;
 
+        //! Returns the global simulation box
+        BoxDim getBox() const
+            {
+            return m_box;
+            }
+
+        //! Initialize a system with the data read from the file
+        boost::shared_ptr<SystemDefinition> createSystemDefinition(boost::shared_ptr<ExecutionConfiguration> exec_conf,
+            boost::shared_ptr<DomainDecomposition> decomposition=boost::shared_ptr<DomainDecomposition>()) const;
+
+        //! Test if a file is in the aligned hoomd_bin format
+        static bool isAlignedFile(const std::string &fname);
+
     private:
         //! Helper function to read the input file
         void readFile(const std::string &fname);
 
+        //! Helper function to fill a snapshot with everything but the particle data
+        void fillSnapshot(SnapshotSystemData& snapshot) const;
+
+        //! Helper function to read everything that follows the particle data in a hoomd_bin file
+        void readTail(std::istream &f);
+
+        //! Helper function to memory-map a file in the aligned format
+        void mapAlignedFile(const std::string &fname);
+
+        //! Helper function to read a file in the aligned format
+        void readAlignedFile(const std::string &fname);
+
+        //! Helper function to read a frame of a trajectory file
+        void readTrajectoryFrame(const std::string &fname);
+
         boost::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
 
         BoxDim m_box;   //!< Simulation box read from the file
@@ -164,6 +290,13 @@ class HOOMDBinaryInitializer
         std::vector< Scalar4 > m_vel;                    //!< n_bodies length 1D array of body velocities
         std::vector< Scalar4 > m_angmom;                 //!< n_bodies length 1D array of angular momenta in the space frame
         std::vector< int3 > m_body_image;                //!< n_bodies length 1D array of the body image
+
+        boost::iostreams::mapped_file_source m_mapped_file; //!< Mapping of an aligned file (if any)
+        ParticleDataView m_particle_view;                //!< Particle arrays in the mapped file
+        uint64_t m_tail_offset;                          //!< Offset of the tail in the mapped file
+
+        int m_frame;                                     //!< Frame to read from a trajectory file
+        boost::shared_ptr<SnapshotSystemData> m_traj_snapshot; //!< Frame read from a trajectory file (if any)
     };
 
 //! Exports HOOMDBinaryInitializer to python
@@ -67,15 +67,345 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdexcept>
 #include <sstream>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
 
 using namespace std;
 
 #include <boost/python.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 
 using namespace boost::python;
 
 using namespace boost;
 
+/*! \param p Pointer into the text
+    \param end End of the text
+    \param str Null terminated string to look for
+    \returns true if the text at \a p starts with \a str
+*/
+static bool starts_with(const char *p, const char *end, const char *str)
+    {
+    size_t len = strlen(str);
+    return (size_t)(end - p) >= len && strncmp(p, str, len) == 0;
+    }
+
+//! Locates the elements of a memory mapped hoomd_xml file
+/*! This is a minimal, non-validating XML scanner. It understands elements, attributes, comments, processing
+    instructions, CDATA sections and document type declarations, which covers everything found in hoomd_xml
+    files. No text is copied: each HOOMDInitializer::xml_node records the range of characters between its
+    start and end tags, so the cost of scanning a file is a single pass over it with memchr().
+
+    Errors in the structure of the file are reported with their line and column.
+*/
+class xml_scanner
+    {
+    public:
+        //! Constructor
+        /*! \param begin First character of the file
+            \param end One past the last character of the file
+            \param fname File name (for error messages)
+            \param msg Messenger to report errors to
+        */
+        xml_scanner(const char *begin, const char *end, const string& fname, boost::shared_ptr<Messenger> msg)
+            : m_begin(begin), m_end(end), m_fname(fname), m_msg(msg)
+            {
+            }
+
+        //! Scan the root element of the file
+        /*! \param root Node to fill out
+            \returns false if the file does not contain any element
+        */
+        bool scanRoot(HOOMDInitializer::xml_node& root)
+            {
+            const char *p = m_begin;
+
+            // skip a UTF-8 byte order mark
+            if (starts_with(p, m_end, "\xEF\xBB\xBF"))
+                p += 3;
+
+            while (true)
+                {
+                p = skipSpace(p);
+                if (p == m_end || *p != '<')
+                    return false;
+
+                if (p + 1 < m_end && (p[1] == '?' || p[1] == '!'))
+                    p = skipMarkup(p);
+                else
+                    {
+                    scanElement(p, root);
+                    return true;
+                    }
+                }
+            }
+
+    private:
+        const char *m_begin;            //!< First character of the file
+        const char *m_end;              //!< One past the last character of the file
+        const string& m_fname;          //!< File name
+        boost::shared_ptr<Messenger> m_msg; //!< Messenger for reporting errors
+
+        //! Report an error at the given location and throw
+        void error(const char *p, const string& message)
+            {
+            unsigned int line = 1;
+            const char *line_start = m_begin;
+            for (const char *c = m_begin; c < p; c++)
+                {
+                if (*c == '\n')
+                    {
+                    line++;
+                    line_start = c + 1;
+                    }
+                }
+
+            m_msg->error() << endl << message << " in file " << m_fname << " at line " << line
+                           << " col " << (p - line_start) + 1 << endl << endl;
+            throw runtime_error("Error reading xml file");
+            }
+
+        //! Skip white space
+        const char *skipSpace(const char *p)
+            {
+            while (p < m_end && isspace((unsigned char)*p))
+                p++;
+            return p;
+            }
+
+        //! Find a string and return a pointer past it
+        const char *skipPast(const char *p, const char *str)
+            {
+            size_t len = strlen(str);
+            const char *found = std::search(p, m_end, str, str + len);
+            if (found == m_end)
+                error(p, string("Unterminated markup, expected ") + str);
+            return found + len;
+            }
+
+        //! Skip a comment, processing instruction, CDATA section or document type declaration starting at p
+        const char *skipMarkup(const char *p)
+            {
+            if (starts_with(p, m_end, "<!--"))
+                return skipPast(p + 4, "-->");
+            if (starts_with(p, m_end, "<![CDATA["))
+                return skipPast(p + 9, "]]>");
+            if (starts_with(p, m_end, "<?"))
+                return skipPast(p + 2, "?>");
+
+            // document type declaration, possibly with an internal subset in []
+            const char *q = p + 2;
+            while (q < m_end && *q != '>' && *q != '[')
+                q++;
+            if (q < m_end && *q == '[')
+                return skipPast(q, "]>");
+            return skipPast(q, ">");
+            }
+
+        //! Read an element or attribute name
+        const char *scanName(const char *p, string& name)
+            {
+            const char *start = p;
+            while (p < m_end && !isspace((unsigned char)*p) && *p != '/' && *p != '>' && *p != '=')
+                p++;
+            if (p == start)
+                error(start, "Expected a name");
+            name.assign(start, p);
+            return p;
+            }
+
+        //! Scan the element starting at p
+        /*! \param p Pointer to the '<' that opens the element
+            \param node Node to fill out
+            \returns Pointer past the end of the element
+        */
+        const char *scanElement(const char *p, HOOMDInitializer::xml_node& node)
+            {
+            const char *start = p;
+            p = scanName(p + 1, node.name);
+            transform(node.name.begin(), node.name.end(), node.name.begin(), ::tolower);
+
+            // attributes
+            while (true)
+                {
+                p = skipSpace(p);
+                if (p == m_end)
+                    error(start, "Unterminated <" + node.name + "> tag");
+
+                if (*p == '/')
+                    {
+                    if (p + 1 == m_end || p[1] != '>')
+                        error(p, "Expected /> in <" + node.name + "> tag");
+                    node.content_begin = node.content_end = p + 2;
+                    return p + 2;
+                    }
+
+                if (*p == '>')
+                    break;
+
+                string attr_name;
+                p = skipSpace(scanName(p, attr_name));
+                if (p == m_end || *p != '=')
+                    error(p, "Expected = after attribute " + attr_name);
+                p = skipSpace(p + 1);
+                if (p == m_end || (*p != '"' && *p != '\''))
+                    error(p, "Expected a quoted value for attribute " + attr_name);
+
+                const char *value_end = (const char *)memchr(p + 1, *p, m_end - p - 1);
+                if (value_end == NULL)
+                    error(p, "Unterminated value of attribute " + attr_name);
+                node.attributes[attr_name] = string(p + 1, value_end);
+                p = value_end + 1;
+                }
+
+            // content, up to the matching end tag
+            node.content_begin = ++p;
+            while (true)
+                {
+                const char *q = (const char *)memchr(p, '<', m_end - p);
+                if (q == NULL)
+                    error(start, "Missing end tag for <" + node.name + ">");
+
+                if (q + 1 < m_end && q[1] == '/')
+                    {
+                    string end_name;
+                    p = skipSpace(scanName(q + 2, end_name));
+                    transform(end_name.begin(), end_name.end(), end_name.begin(), ::tolower);
+                    if (end_name != node.name)
+                        error(q, "End tag </" + end_name + "> does not match <" + node.name + ">");
+                    if (p == m_end || *p != '>')
+                        error(p, "Expected > in </" + end_name + "> tag");
+                    node.content_end = q;
+                    return p + 1;
+                    }
+                else if (q + 1 < m_end && (q[1] == '!' || q[1] == '?'))
+                    p = skipMarkup(q);
+                else
+                    {
+                    node.children.push_back(HOOMDInitializer::xml_node());
+                    p = scanElement(q, node.children.back());
+                    }
+                }
+            }
+    };
+
+//! Reads white space separated values from the text content of an xml_node
+/*! xml_text_parser follows the semantics of reading from an istringstream with operator>>, which the node parsers
+    were originally written against: values are read one at a time and good() turns false on the first value that
+    cannot be read. Numbers are converted in place with strtod() and friends, without copying the text. Comments
+    embedded in the text are skipped.
+*/
+class xml_text_parser
+    {
+    public:
+        //! Constructor
+        /*! \param node Node to read the content of
+        */
+        xml_text_parser(const HOOMDInitializer::xml_node& node)
+            : m_cur(node.content_begin), m_end(node.content_end), m_good(true)
+            {
+            }
+
+        //! Test if all values so far have been read successfully
+        bool good() const
+            {
+            return m_good;
+            }
+
+        //! Read a Scalar
+        xml_text_parser& operator>>(Scalar& value)
+            {
+            if (!nextToken())
+                return *this;
+
+            char *end;
+            #ifdef SINGLE_PRECISION
+            value = strtof(m_cur, &end);
+            #else
+            value = strtod(m_cur, &end);
+            #endif
+            return advance(end);
+            }
+
+        //! Read an int
+        xml_text_parser& operator>>(int& value)
+            {
+            if (!nextToken())
+                return *this;
+
+            char *end;
+            value = (int)strtol(m_cur, &end, 10);
+            return advance(end);
+            }
+
+        //! Read an unsigned int
+        xml_text_parser& operator>>(unsigned int& value)
+            {
+            if (!nextToken())
+                return *this;
+
+            char *end;
+            value = (unsigned int)strtoul(m_cur, &end, 10);
+            return advance(end);
+            }
+
+        //! Read a white space delimited string
+        xml_text_parser& operator>>(string& value)
+            {
+            if (!nextToken())
+                return *this;
+
+            const char *start = m_cur;
+            while (m_cur < m_end && !isspace((unsigned char)*m_cur) && *m_cur != '<')
+                m_cur++;
+            value.assign(start, m_cur);
+            return *this;
+            }
+
+    private:
+        const char *m_cur;  //!< Current position in the text
+        const char *m_end;  //!< End of the text (always followed by a '<')
+        bool m_good;        //!< false once a value could not be read
+
+        //! Move to the start of the next value
+        /*! \returns true if there is a value to read
+        */
+        bool nextToken()
+            {
+            while (m_good)
+                {
+                while (m_cur < m_end && isspace((unsigned char)*m_cur))
+                    m_cur++;
+
+                if (m_cur < m_end && starts_with(m_cur, m_end, "<!--"))
+                    {
+                    const char *stop = "-->";
+                    const char *found = std::search(m_cur + 4, m_end, stop, stop + 3);
+                    m_cur = (found == m_end) ? m_end : found + 3;
+                    }
+                else if (m_cur == m_end || *m_cur == '<')
+                    m_good = false;
+                else
+                    return true;
+                }
+            return false;
+            }
+
+        //! Finish reading a number that ends at \a end
+        /*! The text is always terminated by the '<' of the end tag, so the conversion functions never read past
+            m_end.
+        */
+        xml_text_parser& advance(char *end)
+            {
+            if (end == m_cur)
+                m_good = false;
+            else
+                m_cur = end;
+            return *this;
+            }
+    };
+
 /*! \param fname File name with the data to load
     The file will be read and parsed fully during the constructor call.
 */
@@ -93,23 +423,23 @@ HOOMDInitializer::HOOMDInitializer(boost::shared_ptr<const ExecutionConfiguratio
     m_box_read = false;
     m_num_dimensions = 3;
 
-    // initialize the parser map
+    // initialize the parser maps
     m_parser_map["box"] = bind(&HOOMDInitializer::parseBoxNode, this, _1);
-    m_parser_map["position"] = bind(&HOOMDInitializer::parsePositionNode, this, _1);
-    m_parser_map["image"] = bind(&HOOMDInitializer::parseImageNode, this, _1);
-    m_parser_map["velocity"] = bind(&HOOMDInitializer::parseVelocityNode, this, _1);
-    m_parser_map["mass"] = bind(&HOOMDInitializer::parseMassNode, this, _1);
-    m_parser_map["diameter"] = bind(&HOOMDInitializer::parseDiameterNode, this, _1);
-    m_parser_map["type"] = bind(&HOOMDInitializer::parseTypeNode, this, _1);
-    m_parser_map["body"] = bind(&HOOMDInitializer::parseBodyNode, this, _1);
-    m_parser_map["bond"] = bind(&HOOMDInitializer::parseBondNode, this, _1);
-    m_parser_map["angle"] = bind(&HOOMDInitializer::parseAngleNode, this, _1);
-    m_parser_map["dihedral"] = bind(&HOOMDInitializer::parseDihedralNode, this, _1);
-    m_parser_map["improper"] = bind(&HOOMDInitializer::parseImproperNode, this, _1);
-    m_parser_map["charge"] = bind(&HOOMDInitializer::parseChargeNode, this, _1);
     m_parser_map["wall"] = bind(&HOOMDInitializer::parseWallNode, this, _1);
-    m_parser_map["orientation"] = bind(&HOOMDInitializer::parseOrientationNode, this, _1);
-    m_parser_map["moment_inertia"] = bind(&HOOMDInitializer::parseMomentInertiaNode, this, _1);
+    m_text_parser_map["position"] = bind(&HOOMDInitializer::parsePositionNode, this, _1);
+    m_text_parser_map["image"] = bind(&HOOMDInitializer::parseImageNode, this, _1);
+    m_text_parser_map["velocity"] = bind(&HOOMDInitializer::parseVelocityNode, this, _1);
+    m_text_parser_map["mass"] = bind(&HOOMDInitializer::parseMassNode, this, _1);
+    m_text_parser_map["diameter"] = bind(&HOOMDInitializer::parseDiameterNode, this, _1);
+    m_text_parser_map["type"] = bind(&HOOMDInitializer::parseTypeNode, this, _1);
+    m_text_parser_map["body"] = bind(&HOOMDInitializer::parseBodyNode, this, _1);
+    m_text_parser_map["bond"] = bind(&HOOMDInitializer::parseBondNode, this, _1);
+    m_text_parser_map["angle"] = bind(&HOOMDInitializer::parseAngleNode, this, _1);
+    m_text_parser_map["dihedral"] = bind(&HOOMDInitializer::parseDihedralNode, this, _1);
+    m_text_parser_map["improper"] = bind(&HOOMDInitializer::parseImproperNode, this, _1);
+    m_text_parser_map["charge"] = bind(&HOOMDInitializer::parseChargeNode, this, _1);
+    m_text_parser_map["orientation"] = bind(&HOOMDInitializer::parseOrientationNode, this, _1);
+    m_text_parser_map["moment_inertia"] = bind(&HOOMDInitializer::parseMomentInertiaNode, this, _1);
 
     // read in the file
     readFile(fname);
@@ -314,34 +644,49 @@ boost::shared_ptr<SnapshotSystemData> HOOMDInitializer::getSnapshot() const
     \post Internal data arrays and members are filled out from which futre calls
     like getSnapshot() will use to intialize the ParticleData
 
-    This function implements the main parser loop. It reads in XML nodes from the
-    file one by one and passes them of to parsers registered in \c m_parser_map.
+    This function implements the main parser loop. The file is memory mapped and the element structure
+    is located with xml_scanner. The child nodes of the configuration are then passed off to parsers
+    registered in \c m_parser_map (serially, in the order they appear) and \c m_text_parser_map. Text
+    sections are grouped by name, and each group is parsed on its own OpenMP thread. Repeated nodes of
+    the same name append to the same arrays, so they are parsed in file order within their group.
 */
 void HOOMDInitializer::readFile(const string &fname)
     {
-    // Create a Root Node and a child node
-    XMLNode root_node;
-
-    // Open the file and read the root element "hoomd_xml"
     m_exec_conf->msg->notice(2) << "Reading " << fname << "..." << endl;
-    XMLResults results;
-    root_node = XMLNode::parseFile(fname.c_str(),"hoomd_xml", &results);
 
-    // handle errors
-    if (results.error != eXMLErrorNone)
+    // Map the file into memory. Empty files cannot be mapped, they are left to fail the root node check.
+    boost::iostreams::mapped_file_source file;
         {
-        // create message
-        if (results.error==eXMLErrorFirstTagNotFound)
+        ifstream f(fname.c_str(), ios::in | ios::binary | ios::ate);
+        if (!f.good())
             {
-            m_exec_conf->msg->error() << endl << "Root node of " << fname << " is not <hoomd_xml>" << endl << endl;
+            m_exec_conf->msg->error() << endl << "Unable to open " << fname << endl << endl;
             throw runtime_error("Error reading xml file");
             }
 
-        ostringstream error_message;
-        error_message << XMLNode::getError(results.error) << " in file "
-        << fname << " at line " << results.nLine << " col "
-        << results.nColumn;
-        m_exec_conf->msg->error() << endl << error_message.str() << endl << endl;
+        if (f.tellg() > 0)
+            {
+            try
+                {
+                file.open(fname);
+                }
+            catch (std::exception const & ex)
+                {
+                m_exec_conf->msg->error() << endl << "Error mapping " << fname << ": " << ex.what() << endl << endl;
+                throw runtime_error("Error reading xml file");
+                }
+            }
+        }
+
+    const char *data = file.is_open() ? file.data() : NULL;
+    size_t size = file.is_open() ? file.size() : 0;
+
+    // Locate the root element "hoomd_xml"
+    xml_node root_node;
+    xml_scanner scanner(data, data + size, fname, m_exec_conf->msg);
+    if (!scanner.scanRoot(root_node) || root_node.name != string("hoomd_xml"))
+        {
+        m_exec_conf->msg->error() << endl << "Root node of " << fname << " is not <hoomd_xml>" << endl << endl;
         throw runtime_error("Error reading xml file");
         }
 
@@ -379,9 +724,19 @@ void HOOMDInitializer::readFile(const string &fname)
              << "hoomd_xml file with version not in the range 1.0-1.5  specified,"
              << " I don't know how to read this. Continuing anyways." << endl << endl;
 
-    // the file was parsed successfully by the XML reader. Extract the information now
+    // the file was scanned successfully. Extract the information now
     // start by checking the number of configurations in the file
-    int num_configurations = root_node.nChildNode("configuration");
+    const xml_node *configuration_node = NULL;
+    int num_configurations = 0;
+    for (unsigned int cur_node = 0; cur_node < root_node.children.size(); cur_node++)
+        {
+        if (root_node.children[cur_node].name == string("configuration"))
+            {
+            configuration_node = &root_node.children[cur_node];
+            num_configurations++;
+            }
+        }
+
     if (num_configurations == 0)
         {
         m_exec_conf->msg->error() << endl << "No <configuration> specified in the XML file" << endl << endl;
@@ -393,36 +748,79 @@ void HOOMDInitializer::readFile(const string &fname)
         throw runtime_error("Error reading xml file");
         }
 
-    // extract the only configuration node
-    XMLNode configuration_node = root_node.getChildNode("configuration");
     // extract the time step
-    if (configuration_node.isAttributeSet("time_step"))
+    if (configuration_node->isAttributeSet("time_step"))
         {
-        m_timestep = atoi(configuration_node.getAttribute("time_step"));
+        m_timestep = atoi(configuration_node->getAttribute("time_step").c_str());
         }
 
     // extract the number of dimensions, or default to 3
-    if (configuration_node.isAttributeSet("dimensions"))
+    if (configuration_node->isAttributeSet("dimensions"))
         {
-        m_num_dimensions = atoi(configuration_node.getAttribute("dimensions"));
+        m_num_dimensions = atoi(configuration_node->getAttribute("dimensions").c_str());
         }
     else
         m_num_dimensions = 3;
 
-    // loop through all child nodes of the configuration
-    for (int cur_node=0; cur_node < configuration_node.nChildNode(); cur_node++)
+    // loop through all child nodes of the configuration and call the appropriate node parser, if it exists.
+    // Text sections are only collected here and parsed below
+    std::vector< boost::function< void (const xml_node&) > > section_parsers;
+    std::vector< std::vector<const xml_node *> > sections;
+    std::map< std::string, unsigned int > section_idx;
+    for (unsigned int cur_node = 0; cur_node < configuration_node->children.size(); cur_node++)
         {
-        // extract the name and call the appropriate node parser, if it exists
-        XMLNode node = configuration_node.getChildNode(cur_node);
-        string name = node.getName();
-        transform(name.begin(), name.end(), name.begin(), ::tolower);
+        const xml_node& node = configuration_node->children[cur_node];
 
-        std::map< std::string, boost::function< void (const XMLNode&) > >::iterator parser;
-        parser = m_parser_map.find(name);
+        std::map< std::string, boost::function< void (const xml_node&) > >::iterator parser;
+        parser = m_parser_map.find(node.name);
         if (parser != m_parser_map.end())
+            {
             parser->second(node);
+            continue;
+            }
+
+        parser = m_text_parser_map.find(node.name);
+        if (parser != m_text_parser_map.end())
+            {
+            std::map< std::string, unsigned int >::iterator idx = section_idx.find(node.name);
+            if (idx == section_idx.end())
+                {
+                idx = section_idx.insert(std::make_pair(node.name, (unsigned int)sections.size())).first;
+                section_parsers.push_back(parser->second);
+                sections.push_back(std::vector<const xml_node *>());
+                }
+            sections[idx->second].push_back(&node);
+            }
         else
-            m_exec_conf->msg->notice(2) << "Parser for node <" << name << "> not defined, ignoring" << endl;
+            m_exec_conf->msg->notice(2) << "Parser for node <" << node.name << "> not defined, ignoring" << endl;
+        }
+
+    // parse the text sections, each fills its own arrays so they can run concurrently
+    bool parse_failed = false;
+    string parse_error;
+
+    #pragma omp parallel for schedule(dynamic) num_threads(m_exec_conf->n_cpu)
+    for (int cur_section = 0; cur_section < (int)sections.size(); cur_section++)
+        {
+        try
+            {
+            for (unsigned int j = 0; j < sections[cur_section].size(); j++)
+                section_parsers[cur_section](*sections[cur_section][j]);
+            }
+        catch (std::exception const & ex)
+            {
+            #pragma omp critical
+                {
+                parse_failed = true;
+                parse_error = ex.what();
+                }
+            }
+        }
+
+    if (parse_failed)
+        {
+        m_exec_conf->msg->error() << endl << "Error parsing " << fname << ": " << parse_error << endl << endl;
+        throw runtime_error("Error reading xml file");
         }
 
     // check for required items in the file
@@ -532,15 +930,13 @@ void HOOMDInitializer::readFile(const string &fname)
         m_exec_conf->msg->notice(2) << m_moment_inertia.size() << " moments of inertia" << endl;
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the information in the attributes of the \b box node
 */
-void HOOMDInitializer::parseBoxNode(const XMLNode &node)
+void HOOMDInitializer::parseBoxNode(const xml_node& node)
     {
     // first, verify that this is the box node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("box"));
+    assert(node.name == string("box"));
 
     // temporary values for extracting attributes as Scalars
     Scalar Lx,Ly,Lz;
@@ -604,24 +1000,17 @@ void HOOMDInitializer::parseBoxNode(const XMLNode &node)
     m_box_read = true;
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b position node and fills out m_pos_array. The number
     of particles in the array is determined dynamically.
 */
-void HOOMDInitializer::parsePositionNode(const XMLNode &node)
+void HOOMDInitializer::parsePositionNode(const xml_node& node)
     {
     // check that this is actually a position node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("position"));
+    assert(node.name == string("position"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         Scalar x,y,z;
@@ -631,23 +1020,16 @@ void HOOMDInitializer::parsePositionNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b image node and fills out m_pos_array. The number
     of particles in the array is determined dynamically.
 */
-void HOOMDInitializer::parseImageNode(const XMLNode& node)
+void HOOMDInitializer::parseImageNode(const xml_node& node)
     {
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("image"));
+    assert(node.name == string("image"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         int x,y,z;
@@ -657,24 +1039,17 @@ void HOOMDInitializer::parseImageNode(const XMLNode& node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b velocity node and fills out m_vel_array. The number
     of particles in the array is determined dynamically.
 */
-void HOOMDInitializer::parseVelocityNode(const XMLNode &node)
+void HOOMDInitializer::parseVelocityNode(const xml_node& node)
     {
     // check that this is actually a velocity node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("velocity"));
+    assert(node.name == string("velocity"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         Scalar x,y,z;
@@ -684,24 +1059,17 @@ void HOOMDInitializer::parseVelocityNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b mass node and fills out m_mass_array. The number
     of particles in the array is determined dynamically.
 */
-void HOOMDInitializer::parseMassNode(const XMLNode &node)
+void HOOMDInitializer::parseMassNode(const xml_node& node)
     {
     // check that this is actually a velocity node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("mass"));
+    assert(node.name == string("mass"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         Scalar mass;
@@ -711,24 +1079,17 @@ void HOOMDInitializer::parseMassNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b diameter node and fills out m_diameter_array. The number
     of particles in the array is determined dynamically.
 */
-void HOOMDInitializer::parseDiameterNode(const XMLNode &node)
+void HOOMDInitializer::parseDiameterNode(const xml_node& node)
     {
     // check that this is actually a velocity node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("diameter"));
+    assert(node.name == string("diameter"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         Scalar diameter;
@@ -738,24 +1099,17 @@ void HOOMDInitializer::parseDiameterNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b type node and fills out m_type_array. The number
     of particles in the array is determined dynamically.
 */
-void HOOMDInitializer::parseTypeNode(const XMLNode &node)
+void HOOMDInitializer::parseTypeNode(const xml_node& node)
     {
     // check that this is actually a type node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("type"));
+    assert(node.name == string("type"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         // dynamically determine the particle types
@@ -766,24 +1120,17 @@ void HOOMDInitializer::parseTypeNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b body node and fills out m_body_array. The number
     of particles in the array is determined dynamically.
 */
-void HOOMDInitializer::parseBodyNode(const XMLNode &node)
+void HOOMDInitializer::parseBodyNode(const xml_node& node)
     {
     // check that this is actually a type node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("body"));
+    assert(node.name == string("body"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         // handle -1 as NO_BODY
@@ -800,24 +1147,17 @@ void HOOMDInitializer::parseBodyNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b bond node and fills out m_bonds. The number
     of bonds in the array is determined dynamically.
 */
-void HOOMDInitializer::parseBondNode(const XMLNode &node)
+void HOOMDInitializer::parseBondNode(const xml_node& node)
     {
     // check that this is actually a bond node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("bond"));
+    assert(node.name == string("bond"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         string type_name;
@@ -833,20 +1173,13 @@ void HOOMDInitializer::parseBondNode(const XMLNode &node)
         }
     }
 
-void HOOMDInitializer::parseAngleNode(const XMLNode &node)
+void HOOMDInitializer::parseAngleNode(const xml_node& node)
     {
     // check that this is actually a angle node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("angle"));
+    assert(node.name == string("angle"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         string type_name;
@@ -862,24 +1195,17 @@ void HOOMDInitializer::parseAngleNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b dihedral node and fills out m_dihedrals. The number
     of dihedrals in the array is determined dynamically.
 */
-void HOOMDInitializer::parseDihedralNode(const XMLNode &node)
+void HOOMDInitializer::parseDihedralNode(const xml_node& node)
     {
     // check that this is actually a dihedral node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("dihedral"));
+    assert(node.name == string("dihedral"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         string type_name;
@@ -895,24 +1221,17 @@ void HOOMDInitializer::parseDihedralNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b dihedral node and fills out m_dihedrals. The number
     of dihedrals in the array is determined dynamically.
 */
-void HOOMDInitializer::parseImproperNode(const XMLNode &node)
+void HOOMDInitializer::parseImproperNode(const xml_node& node)
     {
     // check that this is actually a improper node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("improper"));
+    assert(node.name == string("improper"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         string type_name;
@@ -928,24 +1247,17 @@ void HOOMDInitializer::parseImproperNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b charge node and fills out m_charge_array. The number
     of particles in the array is determined dynamically.
 */
-void HOOMDInitializer::parseChargeNode(const XMLNode &node)
+void HOOMDInitializer::parseChargeNode(const xml_node& node)
     {
     // check that this is actually a charge node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("charge"));
+    assert(node.name == string("charge"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         Scalar charge;
@@ -955,24 +1267,22 @@ void HOOMDInitializer::parseChargeNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b wall node and fills out m_walls. The number
     of walls is dtermined dynamically.
 */
-void HOOMDInitializer::parseWallNode(const XMLNode& node)
+void HOOMDInitializer::parseWallNode(const xml_node& node)
     {
     // check that this is actually a wall node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("wall"));
+    assert(node.name == string("wall"));
 
-    for (int cur_node=0; cur_node < node.nChildNode(); cur_node++)
+    for (unsigned int cur_node=0; cur_node < node.children.size(); cur_node++)
         {
         // check to make sure this is a node type we understand
-        XMLNode child_node = node.getChildNode(cur_node);
-        if (string(child_node.getName()) != string("coord"))
+        const xml_node& child_node = node.children[cur_node];
+        if (child_node.name != string("coord"))
             {
-            m_exec_conf->msg->notice(2) << "Ignoring <" << child_node.getName() << "> node in <wall> node";
+            m_exec_conf->msg->notice(2) << "Ignoring <" << child_node.name << "> node in <wall> node";
             }
         else
             {
@@ -983,66 +1293,59 @@ void HOOMDInitializer::parseWallNode(const XMLNode& node)
                 m_exec_conf->msg->error() << endl << "ox not set in <coord> node" << endl << endl;
                 throw runtime_error("Error extracting data from hoomd_xml file");
                 }
-            ox = (Scalar)atof(child_node.getAttribute("ox"));
+            ox = (Scalar)atof(child_node.getAttribute("ox").c_str());
 
             if (!child_node.isAttributeSet("oy"))
                 {
                 m_exec_conf->msg->error() << endl << "oy not set in <coord> node" << endl << endl;
                 throw runtime_error("Error extracting data from hoomd_xml file");
                 }
-            oy = (Scalar)atof(child_node.getAttribute("oy"));
+            oy = (Scalar)atof(child_node.getAttribute("oy").c_str());
 
             if (!child_node.isAttributeSet("oz"))
                 {
                 m_exec_conf->msg->error() << endl << "oz not set in <coord> node" << endl << endl;
                 throw runtime_error("Error extracting data from hoomd_xml file");
                 }
-            oz = (Scalar)atof(child_node.getAttribute("oz"));
+            oz = (Scalar)atof(child_node.getAttribute("oz").c_str());
 
             if (!child_node.isAttributeSet("nx"))
                 {
                 m_exec_conf->msg->error() << endl << "nx not set in <coord> node" << endl << endl;
                 throw runtime_error("Error extracting data from hoomd_xml file");
                 }
-            nx = (Scalar)atof(child_node.getAttribute("nx"));
+            nx = (Scalar)atof(child_node.getAttribute("nx").c_str());
 
             if (!child_node.isAttributeSet("ny"))
                 {
                 m_exec_conf->msg->error() << endl << "ny not set in <coord> node" << endl << endl;
                 throw runtime_error("Error extracting data from hoomd_xml file");
                 }
-            ny = (Scalar)atof(child_node.getAttribute("ny"));
+            ny = (Scalar)atof(child_node.getAttribute("ny").c_str());
 
             if (!child_node.isAttributeSet("nz"))
                 {
                 m_exec_conf->msg->error() << endl << "nz not set in <coord> node" << endl << endl;
                 throw runtime_error("Error extracting data from hoomd_xml file");
                 }
-            nz = (Scalar)atof(child_node.getAttribute("nz"));
+            nz = (Scalar)atof(child_node.getAttribute("nz").c_str());
 
             m_walls.push_back(Wall(ox,oy,oz,nx,ny,nz));
             }
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b orientation node and fills out m_orientation. The number
     of particles in the array is determined dynamically.
 */
-void HOOMDInitializer::parseOrientationNode(const XMLNode &node)
+void HOOMDInitializer::parseOrientationNode(const xml_node& node)
     {
     // check that this is actually a charge node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("orientation"));
+    assert(node.name == string("orientation"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         Scalar ox, oy, oz, ow;
@@ -1052,24 +1355,17 @@ void HOOMDInitializer::parseOrientationNode(const XMLNode &node)
         }
     }
 
-/*! \param node XMLNode passed from the top level parser in readFile
+/*! \param node xml_node passed from the top level parser in readFile
     This function extracts all of the data in a \b moment_inertia node and fills out m_moment_inertia. The number
     of particles in the array is determined dynamically.
 */
-void HOOMDInitializer::parseMomentInertiaNode(const XMLNode &node)
+void HOOMDInitializer::parseMomentInertiaNode(const xml_node& node)
     {
     // check that this is actually a charge node
-    string name = node.getName();
-    transform(name.begin(), name.end(), name.begin(), ::tolower);
-    assert(name == string("moment_inertia"));
+    assert(node.name == string("moment_inertia"));
 
     // extract the data from the node
-    string all_text;
-    for (int i = 0; i < node.nText(); i++)
-        all_text += string(node.getText(i)) + string("\n");
-
-    istringstream parser;
-    parser.str(all_text);
+    xml_text_parser parser(node);
     while (parser.good())
         {
         InertiaTensor I;
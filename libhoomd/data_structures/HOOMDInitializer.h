@@ -60,8 +60,6 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ParticleData.h"
 #include "BondedGroupData.h"
 #include "WallData.h"
-#include "xmlParser.h"
-#include "BondedGroupData.h"
 
 #include <string>
 #include <vector>
@@ -86,11 +84,21 @@ struct SnapshotSystemData;
     and parses it into internal data structures. The initializer is then ready to be passed
     to ParticleData which will then make the needed calls to copy the data into its representation.
 
+    The file is not loaded into an XML document tree. Instead, it is memory mapped and scanned once to
+    locate the elements (see xml_node), which record only their name, attributes and the range of
+    characters holding their content. The node parsers then convert the text of each node directly into
+    the data arrays, so the memory needed to read a file is little more than the size of the data itself.
+
     HOOMD's XML file format and this class are designed to be very extensible. Parsers for inidividual
-    XML nodes are written in separate functions and stored by name in the map \c m_parser_map. As the
-    main parser loops through, it reads in xml nodes and fires of parsers from this map to parse each
-    of them. Adding a new node to the file format parser is as simple as adding a new node parser function
-    (like parsePositionNode()) and adding it to the map in the constructor.
+    XML nodes are written in separate functions and stored by name in the maps \c m_parser_map and
+    \c m_text_parser_map. As the main parser loops through, it reads in xml nodes and fires of parsers from
+    these maps to parse each of them. Adding a new node to the file format parser is as simple as adding a new
+    node parser function (like parsePositionNode()) and adding it to one of the maps in the constructor.
+
+    Parsers in \c m_text_parser_map only read the text content of their node, never throw, and fill
+    members that no other parser touches. Distinct sections of the file (i.e. \<position\> and
+    \<velocity\>) are therefore parsed concurrently when OpenMP is enabled. Parsers that check attributes
+    or child nodes and may report errors go in \c m_parser_map and are run serially.
 
     \ingroup data_structs
 */
@@ -151,6 +159,42 @@ class HOOMDInitializer
             int z;  //!< z-component
             };
 
+        //! Element of a hoomd_xml file located by the scanner in readFile()
+        /*! Only the element structure is stored. The content is referenced as a range of characters in the
+            mapped file, and is only valid while readFile() is running.
+        */
+        struct xml_node
+            {
+            std::string name;                               //!< Element name (converted to lower case)
+            std::map<std::string, std::string> attributes;  //!< Attribute values by name
+            std::vector<xml_node> children;                 //!< Child elements
+            const char *content_begin;                      //!< First character of the element content
+            const char *content_end;                        //!< One past the last character of the element content
+
+            //! Default constructor
+            xml_node() : content_begin(NULL), content_end(NULL)
+                {
+                }
+
+            //! Test if an attribute is set
+            bool isAttributeSet(const std::string& attr) const
+                {
+                return attributes.find(attr) != attributes.end();
+                }
+
+            //! Get the value of an attribute
+            /*! \param attr Name of the attribute
+                \returns The value of the attribute, or an empty string if it is not set
+            */
+            std::string getAttribute(const std::string& attr) const
+                {
+                std::map<std::string, std::string>::const_iterator i = attributes.find(attr);
+                if (i == attributes.end())
+                    return std::string();
+                return i->second;
+                }
+            };
+
         //! Access the read particle positions
         const std::vector< vec >& getPos() { return m_pos_array; }
 
@@ -161,37 +205,37 @@ class HOOMDInitializer
         //! Helper function to read the input file
         void readFile(const std::string &fname);
         //! Helper function to parse the box node
-        void parseBoxNode(const XMLNode& node);
+        void parseBoxNode(const xml_node& node);
         //! Helper function to parse the position node
-        void parsePositionNode(const XMLNode& node);
+        void parsePositionNode(const xml_node& node);
         //! Helper function to parse the image node
-        void parseImageNode(const XMLNode& node);
+        void parseImageNode(const xml_node& node);
         //! Helper function to parse the velocity node
-        void parseVelocityNode(const XMLNode& node);
+        void parseVelocityNode(const xml_node& node);
         //! Helper function to parse the mass node
-        void parseMassNode(const XMLNode& node);
+        void parseMassNode(const xml_node& node);
         //! Helper function to parse diameter node
-        void parseDiameterNode(const XMLNode& node);
+        void parseDiameterNode(const xml_node& node);
         //! Helper function to parse the type node
-        void parseTypeNode(const XMLNode& node);
+        void parseTypeNode(const xml_node& node);
         //! Helper function to parse the body node
-        void parseBodyNode(const XMLNode& node);
+        void parseBodyNode(const xml_node& node);
         //! Helper function to parse the bonds node
-        void parseBondNode(const XMLNode& node);
+        void parseBondNode(const xml_node& node);
         //! Helper function to parse the angle node
-        void parseAngleNode(const XMLNode& node);
+        void parseAngleNode(const xml_node& node);
         //! Helper function to parse the dihedral node
-        void parseDihedralNode(const XMLNode& node);
+        void parseDihedralNode(const xml_node& node);
         //! Helper function to parse the improper node
-        void parseImproperNode(const XMLNode& node);
+        void parseImproperNode(const xml_node& node);
         //! Parse charge node
-        void parseChargeNode(const XMLNode& node);
+        void parseChargeNode(const xml_node& node);
         //! Parse wall node
-        void parseWallNode(const XMLNode& node);
+        void parseWallNode(const xml_node& node);
         //! Parse orientation node
-        void parseOrientationNode(const XMLNode& node);
+        void parseOrientationNode(const xml_node& node);
         //! Parse moment inertia node
-        void parseMomentInertiaNode(const XMLNode& node);
+        void parseMomentInertiaNode(const xml_node& node);
 
         //! Helper function for identifying the particle type id
         unsigned int getTypeId(const std::string& name);
@@ -204,7 +248,8 @@ class HOOMDInitializer
         //! Helper function for identifying the improper type id
         unsigned int getImproperTypeId(const std::string& name);
 
-        std::map< std::string, boost::function< void (const XMLNode&) > > m_parser_map; //!< Map for dispatching parsers based on node type
+        std::map< std::string, boost::function< void (const xml_node&) > > m_parser_map; //!< Map for dispatching parsers based on node type
+        std::map< std::string, boost::function< void (const xml_node&) > > m_text_parser_map; //!< Map for dispatching parsers of text-only sections
 
         BoxDim m_box;   //!< Simulation box read from the file
         bool m_box_read;    //!< Stores the box we read in
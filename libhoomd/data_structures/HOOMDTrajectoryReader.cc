@@ -0,0 +1,520 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file HOOMDTrajectoryReader.cc
+    \brief Defines the HOOMDTrajectoryReader class
+*/
+
+#ifdef WIN32
+#pragma warning( push )
+#pragma warning( disable : 4244 )
+#endif
+
+#include "HOOMDTrajectoryReader.h"
+
+#include <stdexcept>
+#include <sstream>
+#include <string.h>
+
+#include <boost/python.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/copy.hpp>
+#ifdef ENABLE_ZLIB
+#include <boost/iostreams/filter/zlib.hpp>
+#endif
+
+using namespace std;
+using namespace boost::python;
+using namespace boost::iostreams;
+
+//! Helper class to unpack values from the data of a block
+class BlockParser
+    {
+    public:
+        //! Constructor
+        /*! \param data Data of the block
+            \param name Name of the block for error messages
+        */
+        BlockParser(const std::string& data, const char *name)
+            : m_data(data), m_name(name), m_pos(0)
+            {
+            }
+
+        //! Read a single value
+        template<class T> T read()
+            {
+            T val;
+            copy(&val, 1);
+            return val;
+            }
+
+        //! Read n values into a vector
+        template<class T> void read(std::vector<T>& v, unsigned int n)
+            {
+            v.resize(n);
+            if (n)
+                copy(&v[0], n);
+            }
+
+        //! Read a string
+        std::string readString()
+            {
+            unsigned int len = read<unsigned int>();
+            check(len);
+            std::string str = m_data.substr(m_pos, len);
+            m_pos += len;
+            return str;
+            }
+
+        //! Read a list of type names
+        void readNames(std::vector<std::string>& names)
+            {
+            unsigned int n = read<unsigned int>();
+            names.resize(n);
+            for (unsigned int i = 0; i < n; i++)
+                names[i] = readString();
+            }
+
+        //! Verify that all data was consumed
+        void finish()
+            {
+            if (m_pos != m_data.size())
+                throw runtime_error(string("Unexpected size of the ") + m_name + " block");
+            }
+
+    private:
+        const std::string& m_data;  //!< Data of the block
+        const char *m_name;         //!< Name of the block
+        size_t m_pos;               //!< Current read position
+
+        //! Check that \a nbytes can be read
+        void check(size_t nbytes)
+            {
+            if (m_pos + nbytes > m_data.size())
+                throw runtime_error(string("Unexpected end of the ") + m_name + " block");
+            }
+
+        //! Copy n values out of the data
+        template<class T> void copy(T *dest, unsigned int n)
+            {
+            size_t nbytes = sizeof(T)*size_t(n);
+            check(nbytes);
+            memcpy((void *)dest, m_data.data() + m_pos, nbytes);
+            m_pos += nbytes;
+            }
+    };
+
+//! Helper function to read a bonded group block into a snapshot
+template<class Snapshot>
+static void read_group_block(const std::string& data, const char *name, Snapshot& snap)
+    {
+    BlockParser p(data, name);
+    p.readNames(snap.type_mapping);
+    unsigned int n = p.read<unsigned int>();
+    p.read(snap.type_id, n);
+    p.read(snap.groups, n);
+    p.finish();
+    }
+
+//! Helper function to read a per-particle block
+template<class T>
+static void read_particle_block(const std::string& data, const char *name, std::vector<T>& v, unsigned int N)
+    {
+    BlockParser p(data, name);
+    p.read(v, N);
+    p.finish();
+    }
+
+/*! \param exec_conf Execution configuration
+    \param fname File name of the trajectory to read
+*/
+HOOMDTrajectoryReader::HOOMDTrajectoryReader(boost::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                             const std::string &fname)
+    : m_exec_conf(exec_conf), m_fname(fname)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing HOOMDTrajectoryReader: " << fname << endl;
+
+    m_file.open(fname.c_str(), ios::in | ios::binary);
+    if (!m_file.good())
+        {
+        m_exec_conf->msg->error() << "HOOMDTrajectoryReader: Unable to open file " << fname << endl;
+        throw runtime_error("Error reading trajectory file");
+        }
+
+    // check the file header
+    unsigned int header[4];
+    m_file.read((char *)header, sizeof(header));
+    if (!m_file.good() || header[0] != traj_format::file_magic)
+        corrupt("not a HOOMD trajectory file");
+    if (header[1] != traj_format::version)
+        {
+        m_exec_conf->msg->error() << "HOOMDTrajectoryReader: " << fname << " has an unsupported version "
+                                  << header[1] << endl;
+        throw runtime_error("Error reading trajectory file");
+        }
+    if (header[2] != sizeof(Scalar))
+        {
+        m_exec_conf->msg->error() << "HOOMDTrajectoryReader: " << fname << " was written with a different "
+                                  << "floating point precision than this build of hoomd uses" << endl;
+        throw runtime_error("Error reading trajectory file");
+        }
+
+    m_file.seekg(0, ios::end);
+    uint64_t file_size = m_file.tellg();
+
+    if (!readIndex(file_size))
+        {
+        m_exec_conf->msg->warning() << "HOOMDTrajectoryReader: the frame index of " << fname
+                                    << " is missing, scanning the file" << endl;
+        scanFrames(file_size);
+        }
+
+    m_exec_conf->msg->notice(2) << fname << ": " << getNumFrames() << " frames" << endl;
+    }
+
+/*! \param file_size Size of the file in bytes
+    \returns true if a valid index was found
+*/
+bool HOOMDTrajectoryReader::readIndex(uint64_t file_size)
+    {
+    if (file_size < uint64_t(traj_format::file_header_size + traj_format::trailer_size))
+        return false;
+
+    uint64_t index_offset;
+    unsigned int trailer[2];
+    m_file.seekg(file_size - traj_format::trailer_size);
+    m_file.read((char *)&index_offset, sizeof(uint64_t));
+    m_file.read((char *)trailer, sizeof(trailer));
+    if (!m_file.good() || trailer[1] != traj_format::index_magic)
+        {
+        m_file.clear();
+        return false;
+        }
+
+    unsigned int n_frames = trailer[0];
+    if (index_offset + uint64_t(n_frames)*sizeof(uint64_t) + traj_format::trailer_size != file_size)
+        return false;
+
+    m_frame_offsets.resize(n_frames);
+    m_file.seekg(index_offset);
+    if (n_frames)
+        m_file.read((char *)&m_frame_offsets[0], n_frames*sizeof(uint64_t));
+    if (!m_file.good())
+        {
+        m_file.clear();
+        m_frame_offsets.clear();
+        return false;
+        }
+
+    return true;
+    }
+
+/*! \param file_size Size of the file in bytes
+
+    Only complete frames are added to the index. A partially written frame at the end of the file is ignored.
+*/
+void HOOMDTrajectoryReader::scanFrames(uint64_t file_size)
+    {
+    m_frame_offsets.clear();
+
+    uint64_t offset = traj_format::file_header_size;
+    while (offset + traj_format::frame_header_size <= file_size)
+        {
+        unsigned int header[4];
+        uint64_t frame_size;
+        m_file.seekg(offset);
+        m_file.read((char *)header, sizeof(header));
+        m_file.read((char *)&frame_size, sizeof(uint64_t));
+
+        if (!m_file.good() || header[0] != traj_format::frame_magic || offset + frame_size > file_size)
+            break;
+
+        m_frame_offsets.push_back(offset);
+        offset += frame_size;
+        }
+
+    m_file.clear();
+    }
+
+/*! \param frame Index of the frame
+    \returns The time step at which the frame was written
+*/
+unsigned int HOOMDTrajectoryReader::getTimeStep(unsigned int frame)
+    {
+    if (frame >= getNumFrames())
+        {
+        m_exec_conf->msg->error() << "HOOMDTrajectoryReader: frame " << frame << " is out of range, " << m_fname
+                                  << " has " << getNumFrames() << " frames" << endl;
+        throw runtime_error("Error reading trajectory file");
+        }
+
+    unsigned int header[2];
+    m_file.seekg(m_frame_offsets[frame]);
+    m_file.read((char *)header, sizeof(header));
+    if (!m_file.good() || header[0] != traj_format::frame_magic)
+        corrupt("invalid frame header");
+
+    return header[1];
+    }
+
+/*! \param frame Index of the frame
+    \returns A snapshot of the system as stored in the frame
+
+    Only the blocks listed in the directory of the frame are read, the cost of this call does not depend on the
+    number of frames in the file.
+*/
+boost::shared_ptr<SnapshotSystemData> HOOMDTrajectoryReader::readFrame(unsigned int frame)
+    {
+    if (frame >= getNumFrames())
+        {
+        m_exec_conf->msg->error() << "HOOMDTrajectoryReader: frame " << frame << " is out of range, " << m_fname
+                                  << " has " << getNumFrames() << " frames" << endl;
+        throw runtime_error("Error reading trajectory file");
+        }
+
+    // read the frame header and the block directory
+    unsigned int header[4];
+    m_file.seekg(m_frame_offsets[frame]);
+    m_file.read((char *)header, sizeof(header));
+    if (!m_file.good() || header[0] != traj_format::frame_magic)
+        corrupt("invalid frame header");
+
+    unsigned int N = header[2];
+    unsigned int n_entries = header[3];
+
+    std::vector<unsigned int> ids(n_entries);
+    std::vector<uint64_t> offsets(n_entries);
+    m_file.seekg(m_frame_offsets[frame] + traj_format::frame_header_size);
+    for (unsigned int i = 0; i < n_entries; i++)
+        {
+        unsigned int entry[2];
+        m_file.read((char *)entry, sizeof(entry));
+        m_file.read((char *)&offsets[i], sizeof(uint64_t));
+        ids[i] = entry[0];
+        }
+    if (!m_file.good())
+        corrupt("invalid block directory");
+
+    boost::shared_ptr<SnapshotSystemData> snapshot(new SnapshotSystemData());
+    SnapshotParticleData& pdata = snapshot->particle_data;
+    pdata.resize(N);
+    snapshot->has_rigid_data = false;
+    snapshot->has_wall_data = false;
+    snapshot->has_integrator_data = false;
+
+    try
+        {
+        for (unsigned int i = 0; i < n_entries; i++)
+            {
+            std::string data;
+            readBlock(offsets[i], ids[i], data);
+
+            switch (ids[i])
+                {
+                case traj_block::box:
+                    {
+                    BlockParser p(data, "box");
+                    snapshot->dimensions = p.read<unsigned int>();
+                    Scalar3 L;
+                    L.x = p.read<Scalar>();
+                    L.y = p.read<Scalar>();
+                    L.z = p.read<Scalar>();
+                    Scalar xy = p.read<Scalar>();
+                    Scalar xz = p.read<Scalar>();
+                    Scalar yz = p.read<Scalar>();
+                    p.finish();
+                    snapshot->global_box = BoxDim(L);
+                    snapshot->global_box.setTiltFactors(xy, xz, yz);
+                    break;
+                    }
+                case traj_block::position:
+                    read_particle_block(data, "position", pdata.pos, N);
+                    break;
+                case traj_block::velocity:
+                    read_particle_block(data, "velocity", pdata.vel, N);
+                    break;
+                case traj_block::image:
+                    read_particle_block(data, "image", pdata.image, N);
+                    break;
+                case traj_block::orientation:
+                    read_particle_block(data, "orientation", pdata.orientation, N);
+                    break;
+                case traj_block::type_names:
+                    {
+                    BlockParser p(data, "type_names");
+                    p.readNames(pdata.type_mapping);
+                    p.finish();
+                    break;
+                    }
+                case traj_block::type:
+                    read_particle_block(data, "type", pdata.type, N);
+                    break;
+                case traj_block::mass:
+                    read_particle_block(data, "mass", pdata.mass, N);
+                    break;
+                case traj_block::charge:
+                    read_particle_block(data, "charge", pdata.charge, N);
+                    break;
+                case traj_block::diameter:
+                    read_particle_block(data, "diameter", pdata.diameter, N);
+                    break;
+                case traj_block::body:
+                    read_particle_block(data, "body", pdata.body, N);
+                    break;
+                case traj_block::bond:
+                    read_group_block(data, "bond", snapshot->bond_data);
+                    break;
+                case traj_block::angle:
+                    read_group_block(data, "angle", snapshot->angle_data);
+                    break;
+                case traj_block::dihedral:
+                    read_group_block(data, "dihedral", snapshot->dihedral_data);
+                    break;
+                case traj_block::improper:
+                    read_group_block(data, "improper", snapshot->improper_data);
+                    break;
+                default:
+                    // blocks added by later versions of the format are skipped
+                    m_exec_conf->msg->notice(5) << "HOOMDTrajectoryReader: skipping unknown block " << ids[i]
+                                                << endl;
+                    break;
+                }
+            }
+        }
+    catch (std::runtime_error const & ex)
+        {
+        corrupt(ex.what());
+        }
+
+    return snapshot;
+    }
+
+/*! \param offset File offset of the block header
+    \param id Expected block id
+    \param data Output: the (decompressed) data of the block
+*/
+void HOOMDTrajectoryReader::readBlock(uint64_t offset, unsigned int id, std::string& data)
+    {
+    unsigned int header[2];
+    uint64_t sizes[2];
+    m_file.seekg(offset);
+    m_file.read((char *)header, sizeof(header));
+    m_file.read((char *)sizes, sizeof(sizes));
+    if (!m_file.good() || header[0] != id)
+        throw runtime_error("invalid block header");
+
+    uint64_t raw_size = sizes[0];
+    uint64_t stored_size = sizes[1];
+
+    std::string stored(stored_size, '\0');
+    if (stored_size)
+        m_file.read(&stored[0], stored_size);
+    if (!m_file.good())
+        throw runtime_error("unexpected end of file");
+
+    if (header[1] & traj_format::block_compressed)
+        {
+        #ifdef ENABLE_ZLIB
+        data.clear();
+        data.reserve(raw_size);
+        filtering_istream in;
+        in.push(zlib_decompressor());
+        in.push(array_source(stored.data(), stored.size()));
+        boost::iostreams::copy(in, boost::iostreams::back_inserter(data));
+        #else
+        m_exec_conf->msg->error() << "HOOMDTrajectoryReader: " << m_fname << " contains compressed data, but ZLIB "
+                                  << "was not enabled in this build of hoomd" << endl;
+        throw runtime_error("Error reading trajectory file");
+        #endif
+        }
+    else
+        data.swap(stored);
+
+    if (data.size() != raw_size)
+        throw runtime_error("invalid block size");
+    }
+
+/*! \param what Description of the problem
+*/
+void HOOMDTrajectoryReader::corrupt(const std::string& what)
+    {
+    m_exec_conf->msg->error() << "HOOMDTrajectoryReader: " << m_fname << " is corrupt: " << what << endl;
+    throw runtime_error("Error reading trajectory file");
+    }
+
+/*! \param fname Name of the file to test
+    \returns true if the file starts with the magic number of a HOOMD trajectory file
+*/
+bool HOOMDTrajectoryReader::isTrajectoryFile(const std::string &fname)
+    {
+    ifstream f(fname.c_str(), ios::in | ios::binary);
+    unsigned int magic = 0;
+    f.read((char *)&magic, sizeof(unsigned int));
+    return f.good() && magic == traj_format::file_magic;
+    }
+
+void export_HOOMDTrajectoryReader()
+    {
+    class_<HOOMDTrajectoryReader, boost::shared_ptr<HOOMDTrajectoryReader>, boost::noncopyable>
+        ("HOOMDTrajectoryReader", init<boost::shared_ptr<const ExecutionConfiguration>, const string&>())
+        .def("getNumFrames", &HOOMDTrajectoryReader::getNumFrames)
+        .def("getTimeStep", &HOOMDTrajectoryReader::getTimeStep)
+        .def("readFrame", &HOOMDTrajectoryReader::readFrame)
+        .def("isTrajectoryFile", &HOOMDTrajectoryReader::isTrajectoryFile)
+        .staticmethod("isTrajectoryFile")
+        ;
+    }
+
+#ifdef WIN32
+#pragma warning( pop )
+#endif
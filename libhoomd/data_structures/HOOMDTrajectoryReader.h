@@ -0,0 +1,225 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+// Maintainer: joaander
+
+/*! \file HOOMDTrajectoryReader.h
+    \brief Declares the HOOMDTrajectoryReader class and the layout of HOOMD trajectory files
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ExecutionConfiguration.h"
+#include "SnapshotSystemData.h"
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/utility.hpp>
+#include <boost/cstdint.hpp>
+
+using boost::uint64_t;
+
+#ifndef __HOOMD_TRAJECTORY_READER_H__
+#define __HOOMD_TRAJECTORY_READER_H__
+
+/*! \page page_traj_format HOOMD trajectory file format
+
+    A HOOMD trajectory file stores any number of frames of a simulation. It is written by HOOMDTrajectoryWriter
+    and read by HOOMDTrajectoryReader. All values are stored in the native byte order, and floating point values
+    are stored as Scalar. The precision of Scalar is recorded in the file header.
+
+    The file is made up of the following parts:
+     - <b>file header</b> (16 bytes): magic number traj_format::file_magic, format version, sizeof(Scalar), and
+       one reserved word
+     - <b>frames</b>, one after the other
+     - <b>frame index</b>: the file offset of every frame (one 64-bit integer per frame)
+     - <b>trailer</b> (16 bytes): the file offset of the frame index, the number of frames, and the magic number
+       traj_format::index_magic
+
+    The index and the trailer are rewritten after every frame. A reader can therefore locate any frame with two
+    reads from the end of the file. If the trailer is missing, e.g. because a job was killed while writing, the
+    index is rebuilt by walking over the frames from the start of the file.
+
+    Every frame starts with a header (24 bytes): traj_format::frame_magic, the time step, the number of particles,
+    the number of entries in the block directory, and the total size of the frame in bytes. The header is followed
+    by the block directory, which holds one entry (16 bytes) per block: the block id (traj_block::Enum), one
+    reserved word and the file offset of the block.
+
+    Data blocks (box, positions, ...) are written in every frame. Blocks with data that rarely changes (types,
+    masses, topology, ...) are only written when their contents change. The directory entries of the other frames
+    point back to the block in the frame where the data was last written. Reading a frame therefore never
+    requires reading any other frame.
+
+    Every block starts with a header (24 bytes): the block id, flags (traj_format::block_compressed), the size of
+    the data in bytes and the size of the data as stored in the file. The data follows the header, and is zlib
+    compressed if the block_compressed flag is set. Per particle arrays are stored in tag order. The contents of
+    the blocks are:
+     - traj_block::box: the number of dimensions (uint), followed by Lx, Ly, Lz, xy, xz, yz (Scalar)
+     - traj_block::position, traj_block::velocity: N Scalar3 values
+     - traj_block::image: N int3 values
+     - traj_block::orientation: N Scalar4 values
+     - traj_block::type, traj_block::body: N uints
+     - traj_block::mass, traj_block::charge, traj_block::diameter: N Scalar values
+     - traj_block::type_names: the number of particle types (uint), followed by the names. Strings are stored as
+       their length (uint) followed by the characters.
+     - traj_block::bond, traj_block::angle, traj_block::dihedral, traj_block::improper: the number of types and the
+       type names (as for type_names), followed by the number of groups (uint), the type id of every group (uint)
+       and the tags of the members of every group (uint)
+*/
+
+//! Constants describing the HOOMD trajectory file layout
+/*! See \ref page_traj_format
+*/
+struct traj_format
+    {
+    enum Enum
+        {
+        file_magic = 0x4a525448,        //!< Magic number at the start of the file ("HTRJ")
+        frame_magic = 0x454d5246,       //!< Magic number at the start of each frame ("FRME")
+        index_magic = 0x58444948,       //!< Magic number at the end of the trailer ("HIDX")
+        version = 1,                    //!< Version of the file format
+        block_compressed = 1,           //!< Block flag: the data is zlib compressed
+        file_header_size = 16,          //!< Size of the file header in bytes
+        frame_header_size = 24,         //!< Size of the frame header in bytes
+        dir_entry_size = 16,            //!< Size of one block directory entry in bytes
+        block_header_size = 24,         //!< Size of the block header in bytes
+        trailer_size = 16               //!< Size of the trailer in bytes
+        };
+    };
+
+//! Block ids in a HOOMD trajectory file
+/*! See \ref page_traj_format
+*/
+struct traj_block
+    {
+    enum Enum
+        {
+        box = 0,        //!< Simulation box and dimensions
+        position,       //!< Particle positions
+        velocity,       //!< Particle velocities
+        image,          //!< Particle images
+        orientation,    //!< Particle orientations
+        type_names,     //!< Names of the particle types
+        type,           //!< Particle types
+        mass,           //!< Particle masses
+        charge,         //!< Particle charges
+        diameter,       //!< Particle diameters
+        body,           //!< Rigid body ids of the particles
+        bond,           //!< Bonds
+        angle,          //!< Angles
+        dihedral,       //!< Dihedrals
+        improper,       //!< Impropers
+        num_blocks      //!< Number of block ids
+        };
+    };
+
+//! Reads frames from a HOOMD trajectory file
+/*! On construction, the frame index of the file is loaded (see \ref page_traj_format). Any frame can then be read
+    with readFrame() at a cost that does not depend on the position of the frame in the file.
+
+    Blocks that are missing from a frame are left at their default values in the returned snapshot (e.g. zero
+    velocities if the velocities were not written).
+
+    \ingroup data_structs
+*/
+class HOOMDTrajectoryReader : boost::noncopyable
+    {
+    public:
+        //! Open the file and load the frame index
+        HOOMDTrajectoryReader(boost::shared_ptr<const ExecutionConfiguration> exec_conf, const std::string &fname);
+
+        //! Get the number of frames in the file
+        unsigned int getNumFrames() const
+            {
+            return (unsigned int)m_frame_offsets.size();
+            }
+
+        //! Get the file offsets of all frames
+        const std::vector<uint64_t>& getFrameOffsets() const
+            {
+            return m_frame_offsets;
+            }
+
+        //! Get the time step of a frame
+        unsigned int getTimeStep(unsigned int frame);
+
+        //! Read a frame
+        boost::shared_ptr<SnapshotSystemData> readFrame(unsigned int frame);
+
+        //! Test if a file is a HOOMD trajectory file
+        static bool isTrajectoryFile(const std::string &fname);
+
+    private:
+        boost::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+        std::string m_fname;                    //!< Name of the file
+        std::ifstream m_file;                   //!< The open file
+        std::vector<uint64_t> m_frame_offsets;  //!< File offset of every frame
+
+        //! Load the frame index from the end of the file
+        bool readIndex(uint64_t file_size);
+
+        //! Rebuild the frame index by walking over the frames
+        void scanFrames(uint64_t file_size);
+
+        //! Read the data of one block
+        void readBlock(uint64_t offset, unsigned int id, std::string& data);
+
+        //! Throw an error for a corrupt file
+        void corrupt(const std::string& what);
+    };
+
+//! Exports HOOMDTrajectoryReader to python
+void export_HOOMDTrajectoryReader();
+
+#endif
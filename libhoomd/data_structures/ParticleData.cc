@@ -64,6 +64,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdexcept>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 
 using namespace std;
 
@@ -159,6 +160,9 @@ ParticleData::ParticleData(unsigned int N, const BoxDim &global_box, unsigned in
     for (unsigned int i = 0; i < 6; i++)
         m_external_virial[i] = Scalar(0.0);
 
+    // the per-particle virial is stored by default
+    m_reduced_virial = false;
+
     // zero the origin
     m_origin = make_scalar3(0,0,0);
     m_o_image = make_int3(0,0,0);
@@ -208,7 +212,7 @@ ParticleData::ParticleData(const SnapshotParticleData& snapshot,
     setGlobalBox(global_box);
 
     // it is an error for particles to be initialized outside of their box
-    if (!inBox(snapshot))
+    if (!inBox(ParticleDataView(snapshot)))
         {
         m_exec_conf->msg->warning() << "Not all particles were found inside the given box" << endl;
         throw runtime_error("Error initializing ParticleData");
@@ -221,6 +225,9 @@ ParticleData::ParticleData(const SnapshotParticleData& snapshot,
     for (unsigned int i = 0; i < 6; i++)
         m_external_virial[i] = Scalar(0.0);
 
+    // the per-particle virial is stored by default
+    m_reduced_virial = false;
+
     // default constructed shared ptr is null as desired
     m_prof = boost::shared_ptr<Profiler>();
 
@@ -238,6 +245,70 @@ ParticleData::ParticleData(const SnapshotParticleData& snapshot,
     }
 
 
+/*! Loads particle data from the view into the internal arrays.
+ * \param view The particle data, accessible on every rank
+ * \param global_box The dimensions of the global simulation box
+ * \param exec_conf The execution configuration
+ * \param decomposition (optional) Domain decomposition layout
+ */
+ParticleData::ParticleData(const ParticleDataView& view,
+                           const BoxDim& global_box,
+                           boost::shared_ptr<ExecutionConfiguration> exec_conf,
+                           boost::shared_ptr<DomainDecomposition> decomposition
+                          )
+    : m_exec_conf(exec_conf),
+      m_nparticles(0),
+      m_nghosts(0),
+      m_max_nparticles(0),
+      m_nglobal(0),
+      m_resize_factor(9./8.)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ParticleData" << endl;
+
+    // allocate reverse-lookup tag list
+    GPUVector< unsigned int> rtag(view.size, m_exec_conf);
+    m_rtag.swap(rtag);
+
+    // initialize number of particles
+    setNGlobal(view.size);
+
+    #ifdef ENABLE_MPI
+    // Set up domain decomposition information
+    if (decomposition) setDomainDecomposition(decomposition);
+    #endif
+
+    // initialize box dimensions on all procesors
+    setGlobalBox(global_box);
+
+    // it is an error for particles to be initialized outside of their box
+    if (!inBox(view))
+        {
+        m_exec_conf->msg->warning() << "Not all particles were found inside the given box" << endl;
+        throw runtime_error("Error initializing ParticleData");
+        }
+
+    // initialize particle data with the contents of the view
+    initializeFromView(view);
+
+    // reset external virial
+    for (unsigned int i = 0; i < 6; i++)
+        m_external_virial[i] = Scalar(0.0);
+
+    // the per-particle virial is stored by default
+    m_reduced_virial = false;
+
+    // default constructed shared ptr is null as desired
+    m_prof = boost::shared_ptr<Profiler>();
+
+    #ifdef ENABLE_CUDA
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        // create a ModernGPU context
+        m_mgpu_context = mgpu::CreateCudaDeviceAttachStream(0);
+        }
+    #endif
+    }
+
 ParticleData::~ParticleData()
     {
     m_exec_conf->msg->notice(5) << "Destroying ParticleData" << endl;
@@ -670,7 +741,7 @@ void ParticleData::reallocate(unsigned int max_n)
 
 /*! \return true If and only if all particles are in the simulation box
 */
-bool ParticleData::inBox(const SnapshotParticleData &snap)
+bool ParticleData::inBox(const ParticleDataView& snap)
     {
     bool in_box = true;
     if (m_exec_conf->getRank() == 0)
@@ -705,6 +776,73 @@ bool ParticleData::inBox(const SnapshotParticleData &snap)
     return in_box;
     }
 
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle, wrapped back into the box on output if it lies on the upper boundary
+    \param img Image of the particle, updated when the particle is wrapped
+    \param tag Tag of the particle (for error messages)
+    \param cart_ranks Host array of the ranks of the domains (DomainDecomposition::getCartRanks())
+    \returns The rank of the domain that the particle is placed into
+*/
+unsigned int ParticleData::placeParticle(Scalar3& pos, int3& img, unsigned int tag, const unsigned int *cart_ranks)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+
+    Scalar3 f = m_global_box.makeFraction(pos);
+    int i= f.x * ((Scalar)di.getW());
+    int j= f.y * ((Scalar)di.getH());
+    int k= f.z * ((Scalar)di.getD());
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0,0,0);
+    if (i == (int) di.getW())
+        {
+        i = 0;
+        flags.x = 1;
+        }
+
+    if (j == (int) di.getH())
+        {
+        j = 0;
+        flags.y = 1;
+        }
+
+    if (k == (int) di.getD())
+        {
+        k = 0;
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    BoxDim global_box = m_global_box;
+    uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    unsigned int rank = (i < 0 || j < 0 || k < 0 || i >= (int)di.getW() || j >= (int)di.getH() || k >= (int)di.getD())
+                        ? n_ranks : cart_ranks[di(i,j,k)];
+
+    if (rank >= n_ranks)
+        {
+        m_exec_conf->msg->error() << "init.*: Particle " << tag << " out of bounds." << std::endl;
+        m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
+        m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
+        Scalar3 lo = m_global_box.getLo();
+        Scalar3 hi = m_global_box.getHi();
+        m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
+        m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
+
+        throw std::runtime_error("Error initializing from snapshot.");
+        }
+
+    return rank;
+    }
+#endif
+
 //! Initialize from a snapshot
 /*! \param snapshot the initial particle data
 
@@ -786,68 +924,17 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData& snapshot)
                 throw std::runtime_error("Error initializing ParticleData");
                 }
 
-            const Index3D& di = m_decomposition->getDomainIndexer();
-            unsigned int n_ranks = m_exec_conf->getNRanks();
             ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
 
-            BoxDim global_box = m_global_box;
-
             // loop over particles in snapshot, place them into domains
             for (std::vector<Scalar3>::const_iterator it=snapshot.pos.begin(); it != snapshot.pos.end(); it++)
                 {
-                // determine domain the particle is placed into
-                Scalar3 pos = *it;
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i= f.x * ((Scalar)di.getW());
-                int j= f.y * ((Scalar)di.getH());
-                int k= f.z * ((Scalar)di.getD());
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0,0,0);
-                if (i == (int) di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
-
-                if (j == (int) di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
-
-                if (k == (int) di.getD())
-                    {
-                    k = 0;
-                    flags.z = 1;
-                    }
-
                 unsigned int tag = it - snapshot.pos.begin();
+                Scalar3 pos = *it;
                 int3 img = snapshot.image[tag];
 
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x,flags.y,flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
-
-                unsigned int rank = h_cart_ranks.data[di(i,j,k)];
-
-                if (rank >= n_ranks)
-                    {
-                    m_exec_conf->msg->error() << "init.*: Particle " << tag << " out of bounds." << std::endl;
-                    m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
-                    m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box.getLo();
-                    Scalar3 hi = m_global_box.getHi();
-                    m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z << ")" << std::endl;
-                    m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z << ")" << std::endl;
-
-                    throw std::runtime_error("Error initializing from snapshot.");
-                    }
+                // determine domain the particle is placed into
+                unsigned int rank = placeParticle(pos, img, tag, h_cart_ranks.data);
 
                 // fill up per-processor data structures
                 pos_proc[rank].push_back(pos);
@@ -1040,6 +1127,170 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData& snapshot)
     m_num_types_signal();
     }
 
+/*! \param view the initial particle data
+
+    \post the particle data arrays are initialized from the view, in index order
+
+    Unlike initializeFromSnapshot(), the particle arrays of \a view must be accessible on every rank. In parallel
+    simulations, every rank places all particles into domains and copies only those in its own domain, so that no
+    particle data is communicated. The type mapping is taken from rank 0.
+
+    \pre In parallel simulations, the local box size must be set before a call to initializeFromView().
+ */
+void ParticleData::initializeFromView(const ParticleDataView& view)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing from view" << std::endl;
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    // check the input for errors
+    if (m_exec_conf->getRank() == 0 && view.type_mapping.size() == 0)
+        {
+        m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    // clear set of active tags
+    m_tag_set.clear();
+
+    // clear reservoir of recycled tags
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+
+    // global number of particles
+    unsigned int nglobal = view.size;
+
+    // local particles, in the order they are stored
+    std::vector<unsigned int> tags;
+    std::vector<Scalar3> pos;
+    std::vector<int3> image;
+
+    m_type_mapping = view.type_mapping;
+
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        bcast(m_type_mapping, 0, m_exec_conf->getMPICommunicator());
+
+        unsigned int my_rank = m_exec_conf->getRank();
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(), access_location::host, access_mode::read);
+
+        // every rank places all particles into domains, and keeps its own
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            {
+            Scalar3 p = view.pos[tag];
+            int3 img = view.image[tag];
+            if (placeParticle(p, img, tag, h_cart_ranks.data) == my_rank)
+                {
+                tags.push_back(tag);
+                pos.push_back(p);
+                image.push_back(img);
+                }
+            }
+        }
+    else
+#endif
+        {
+        tags.resize(nglobal);
+        for (unsigned int tag = 0; tag < nglobal; tag++)
+            tags[tag] = tag;
+        pos.assign(view.pos, view.pos + nglobal);
+        image.assign(view.image, view.image + nglobal);
+        }
+
+    m_nparticles = tags.size();
+
+    // allocate array for reverse lookup tags
+    GPUVector< unsigned int> rtag(nglobal, m_exec_conf);
+    m_rtag.swap(rtag);
+
+    // update list of active tags
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        {
+        m_tag_set.insert(tag);
+        }
+
+    // we have to allocate even if the number of particles on a processor
+    // is zero, so that the arrays can be resized later
+    if (m_nparticles == 0)
+        allocate(1);
+    else
+        allocate(m_nparticles);
+
+    // Load particle data
+    ArrayHandle< Scalar4 > h_pos(m_pos, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar4 > h_vel(m_vel, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar3 > h_accel(m_accel, access_location::host, access_mode::overwrite);
+    ArrayHandle< int3 > h_image(m_image, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar > h_charge(m_charge, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar > h_diameter(m_diameter, access_location::host, access_mode::overwrite);
+    ArrayHandle< unsigned int > h_body(m_body, access_location::host, access_mode::overwrite);
+    ArrayHandle< Scalar4 > h_orientation(m_orientation, access_location::host, access_mode::overwrite);
+    ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::overwrite);
+    #ifdef ENABLE_MPI
+    ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+    #endif
+    ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::overwrite);
+
+    for (unsigned int tag = 0; tag < nglobal; tag++)
+        h_rtag.data[tag] = NOT_LOCAL;
+
+    for (unsigned int idx = 0; idx < m_nparticles; idx++)
+        {
+        unsigned int tag = tags[idx];
+        h_pos.data[idx] = make_scalar4(pos[idx].x, pos[idx].y, pos[idx].z, __int_as_scalar(view.type[tag]));
+        h_vel.data[idx] = make_scalar4(view.vel[tag].x, view.vel[tag].y, view.vel[tag].z, view.mass[tag]);
+        h_accel.data[idx] = view.accel[tag];
+        h_charge.data[idx] = view.charge[tag];
+        h_diameter.data[idx] = view.diameter[tag];
+        h_image.data[idx] = image[idx];
+        h_tag.data[idx] = tag;
+        h_rtag.data[tag] = idx;
+        h_body.data[idx] = view.body[tag];
+        h_orientation.data[idx] = view.orientation[tag];
+        if (view.inertia_tensor)
+            m_inertia_tensor[idx] = view.inertia_tensor[tag];
+
+        #ifdef ENABLE_MPI
+        h_comm_flag.data[idx] = 0; // initialize with zero
+        #endif
+        }
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal();
+    }
+
+#ifdef ENABLE_MPI
+//! Gather a per-particle quantity on the root processor and store it in snapshot order
+/*! \param values Values of the local particles
+    \param snap_values Output, on the root processor the values of all particles in snapshot order
+    \param snap_idx On the root processor, the snapshot index of every gathered particle in rank order
+    \param root Rank of the root processor
+    \param mpi_comm MPI communicator
+*/
+template<typename T>
+static void gather_snapshot_values(const std::vector<T>& values, std::vector<T>& snap_values,
+    const std::vector<unsigned int>& snap_idx, unsigned int root, const MPI_Comm mpi_comm)
+    {
+    std::vector<T> values_proc;
+    gather_pod_v(values, values_proc, root, mpi_comm);
+
+    for (unsigned int i = 0; i < values_proc.size(); i++)
+        snap_values[snap_idx[i]] = values_proc[i];
+    }
+#endif
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
 
@@ -1065,139 +1316,111 @@ void ParticleData::takeSnapshot(SnapshotParticleData &snapshot)
 #ifdef ENABLE_MPI
     if (m_decomposition)
         {
-        // gather a global snapshot
-        std::vector<Scalar3> pos(m_nparticles);
-        std::vector<Scalar3> vel(m_nparticles);
-        std::vector<Scalar3> accel(m_nparticles);
-        std::vector<unsigned int> type(m_nparticles);
-        std::vector<Scalar> mass(m_nparticles);
-        std::vector<Scalar> charge(m_nparticles);
-        std::vector<Scalar> diameter(m_nparticles);
-        std::vector<int3> image(m_nparticles);
-        std::vector<unsigned int> body(m_nparticles);
-        std::vector<Scalar4> orientation(m_nparticles);
-        std::vector<unsigned int> tag(m_nparticles);
-        std::map<unsigned int, unsigned int> rtag_map;
-        for (unsigned int idx = 0; idx < m_nparticles; idx++)
-            {
-            pos[idx] = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
-            vel[idx] = make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z);
-            accel[idx] = h_accel.data[idx];
-            type[idx] = __scalar_as_int(h_pos.data[idx].w);
-            mass[idx] = h_vel.data[idx].w;
-            charge[idx] = h_charge.data[idx];
-            diameter[idx] = h_diameter.data[idx];
-            image[idx] = h_image.data[idx];
-            image[idx].x -= m_o_image.x;
-            image[idx].y -= m_o_image.y;
-            image[idx].z -= m_o_image.z;
-            body[idx] = h_body.data[idx];
-            orientation[idx] = h_orientation.data[idx];
-
-            // insert reverse lookup global tag -> idx
-            rtag_map.insert(std::pair<unsigned int, unsigned int>(h_tag.data[idx], idx));
-            }
-
-        std::vector< std::vector<Scalar3> > pos_proc;              // Position array of every processor
-        std::vector< std::vector<Scalar3> > vel_proc;              // Velocities array of every processor
-        std::vector< std::vector<Scalar3> > accel_proc;            // Accelerations array of every processor
-        std::vector< std::vector<unsigned int> > type_proc;        // Particle types array of every processor
-        std::vector< std::vector<Scalar > > mass_proc;             // Particle masses array of every processor
-        std::vector< std::vector<Scalar > > charge_proc;           // Particle charges array of every processor
-        std::vector< std::vector<Scalar > > diameter_proc;         // Particle diameters array of every processor
-        std::vector< std::vector<int3 > > image_proc;              // Particle images array of every processor
-        std::vector< std::vector<unsigned int > > body_proc;       // Body ids of every processor
-        std::vector< std::vector<Scalar4 > > orientation_proc;     // Orientations of every processor
-
-        std::vector< std::map<unsigned int, unsigned int> > rtag_map_proc; // List of reverse-lookup maps
-
         const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
-        unsigned int size = m_exec_conf->getNRanks();
-        unsigned int rank = m_exec_conf->getRank();
+        unsigned int root = 0;
 
-        // resize to number of ranks in communicator
-        pos_proc.resize(size);
-        vel_proc.resize(size);
-        accel_proc.resize(size);
-        type_proc.resize(size);
-        mass_proc.resize(size);
-        charge_proc.resize(size);
-        diameter_proc.resize(size);
-        image_proc.resize(size);
-        body_proc.resize(size);
-        orientation_proc.resize(size);
-        rtag_map_proc.resize(size);
+        // gather the tags first, they determine the position of every particle in the snapshot
+        std::vector<unsigned int> tag(h_tag.data, h_tag.data + m_nparticles);
+        std::vector<unsigned int> tag_proc;
+        gather_pod_v(tag, tag_proc, root, mpi_comm);
 
-        unsigned int root = 0;
+        // snapshot index of every gathered particle, in rank order
+        std::vector<unsigned int> snap_idx;
 
-        // collect all particle data on the root processor
-        gather_v(pos, pos_proc, root,mpi_comm);
-        gather_v(vel, vel_proc, root, mpi_comm);
-        gather_v(accel, accel_proc, root, mpi_comm);
-        gather_v(type, type_proc, root, mpi_comm);
-        gather_v(mass, mass_proc, root, mpi_comm);
-        gather_v(charge, charge_proc, root, mpi_comm);
-        gather_v(diameter, diameter_proc, root, mpi_comm);
-        gather_v(image, image_proc, root, mpi_comm);
-        gather_v(body, body_proc, root, mpi_comm);
-        gather_v(orientation, orientation_proc, root, mpi_comm);
-
-        // gather the reverse-lookup maps
-        gather_v(rtag_map, rtag_map_proc, root, mpi_comm);
-
-        if (rank == root)
+        if (m_exec_conf->getRank() == root)
             {
-            unsigned int n_ranks = m_exec_conf->getNRanks();
-            assert(rtag_map_proc.size() == n_ranks);
-
-            // create single map of all particle ranks and indices
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> > rank_rtag_map;
-            std::map<unsigned int, unsigned int>::iterator it;
-            for (unsigned int irank = 0; irank < n_ranks; ++irank)
-                for (it = rtag_map_proc[irank].begin(); it != rtag_map_proc[irank].end(); ++it)
-                    rank_rtag_map.insert(std::pair<unsigned int, std::pair<unsigned int, unsigned int> >(
-                        it->first, std::pair<unsigned int, unsigned int>(irank, it->second)));
-
-            // add particles to snapshot
-            assert(m_tag_set.size() == getNGlobal());
-            std::set<unsigned int>::const_iterator tag_set_it = m_tag_set.begin();
-
-            std::map<unsigned int, std::pair<unsigned int, unsigned int> >::iterator rank_rtag_it;
-            for (unsigned int snap_id = 0; snap_id < getNGlobal(); snap_id++)
+            // look-up table from the active tags to their position in the snapshot
+            std::vector<unsigned int> tag_snap_idx(getMaximumTag()+1, NOT_LOCAL);
+            unsigned int n_active = 0;
+            std::set<unsigned int>::const_iterator tag_set_it;
+            for (tag_set_it = m_tag_set.begin(); tag_set_it != m_tag_set.end(); ++tag_set_it)
+                tag_snap_idx[*tag_set_it] = n_active++;
+
+            std::vector<bool> found(getNGlobal(), false);
+            snap_idx.resize(tag_proc.size());
+            for (unsigned int i = 0; i < tag_proc.size(); i++)
                 {
-                unsigned int tag = *tag_set_it;
-                assert(tag <= getMaximumTag());
-                rank_rtag_it = rank_rtag_map.find(tag);
-
-                if (rank_rtag_it == rank_rtag_map.end())
+                unsigned int tag = tag_proc[i];
+                unsigned int snap_id = (tag < tag_snap_idx.size()) ? tag_snap_idx[tag] : NOT_LOCAL;
+                if (snap_id == NOT_LOCAL || found[snap_id])
                     {
                     m_exec_conf->msg->error()
-                        << endl << "Could not find particle " << tag << " on any processor. "
+                        << endl << "Particle " << tag << " is not active or found on more than one processor. "
                         << endl << endl;
                     throw std::runtime_error("Error gathering ParticleData");
                     }
+                found[snap_id] = true;
+                snap_idx[i] = snap_id;
+                }
 
-                // rank contains the processor rank on which the particle was found
-                std::pair<unsigned int, unsigned int> rank_idx = rank_rtag_it->second;
-                unsigned int rank = rank_idx.first;
-                unsigned int idx = rank_idx.second;
-
-                snapshot.pos[snap_id] = pos_proc[rank][idx];
-                snapshot.vel[snap_id] = vel_proc[rank][idx];
-                snapshot.accel[snap_id] = accel_proc[rank][idx];
-                snapshot.type[snap_id] = type_proc[rank][idx];
-                snapshot.mass[snap_id] = mass_proc[rank][idx];
-                snapshot.charge[snap_id] = charge_proc[rank][idx];
-                snapshot.diameter[snap_id] = diameter_proc[rank][idx];
-                snapshot.image[snap_id] = image_proc[rank][idx];
-                snapshot.body[snap_id] = body_proc[rank][idx];
-                snapshot.orientation[snap_id] = orientation_proc[rank][idx];
-
-                // make sure the position stored in the snapshot is within the boundaries
-                m_global_box.wrap(snapshot.pos[snap_id], snapshot.image[snap_id]);
+            if (tag_proc.size() != getNGlobal())
+                {
+                unsigned int missing = std::find(found.begin(), found.end(), false) - found.begin();
+                tag_set_it = m_tag_set.begin();
+                std::advance(tag_set_it, missing);
+                m_exec_conf->msg->error()
+                    << endl << "Could not find particle " << *tag_set_it << " on any processor. "
+                    << endl << endl;
+                throw std::runtime_error("Error gathering ParticleData");
+                }
+            }
+
+        // gather one field after the other, to limit the memory footprint on the root processor
+            {
+            std::vector<Scalar3> pos(m_nparticles);
+            for (unsigned int idx = 0; idx < m_nparticles; idx++)
+                pos[idx] = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - m_origin;
+            gather_snapshot_values(pos, snapshot.pos, snap_idx, root, mpi_comm);
+            }
+
+            {
+            std::vector<unsigned int> type(m_nparticles);
+            for (unsigned int idx = 0; idx < m_nparticles; idx++)
+                type[idx] = __scalar_as_int(h_pos.data[idx].w);
+            gather_snapshot_values(type, snapshot.type, snap_idx, root, mpi_comm);
+            }
+
+            {
+            std::vector<Scalar3> vel(m_nparticles);
+            for (unsigned int idx = 0; idx < m_nparticles; idx++)
+                vel[idx] = make_scalar3(h_vel.data[idx].x, h_vel.data[idx].y, h_vel.data[idx].z);
+            gather_snapshot_values(vel, snapshot.vel, snap_idx, root, mpi_comm);
+            }
+
+            {
+            std::vector<Scalar> mass(m_nparticles);
+            for (unsigned int idx = 0; idx < m_nparticles; idx++)
+                mass[idx] = h_vel.data[idx].w;
+            gather_snapshot_values(mass, snapshot.mass, snap_idx, root, mpi_comm);
+            }
 
-                std::advance(tag_set_it, 1);
+            {
+            std::vector<int3> image(h_image.data, h_image.data + m_nparticles);
+            for (unsigned int idx = 0; idx < m_nparticles; idx++)
+                {
+                image[idx].x -= m_o_image.x;
+                image[idx].y -= m_o_image.y;
+                image[idx].z -= m_o_image.z;
                 }
+            gather_snapshot_values(image, snapshot.image, snap_idx, root, mpi_comm);
+            }
+
+        gather_snapshot_values(std::vector<Scalar3>(h_accel.data, h_accel.data + m_nparticles),
+            snapshot.accel, snap_idx, root, mpi_comm);
+        gather_snapshot_values(std::vector<Scalar>(h_charge.data, h_charge.data + m_nparticles),
+            snapshot.charge, snap_idx, root, mpi_comm);
+        gather_snapshot_values(std::vector<Scalar>(h_diameter.data, h_diameter.data + m_nparticles),
+            snapshot.diameter, snap_idx, root, mpi_comm);
+        gather_snapshot_values(std::vector<unsigned int>(h_body.data, h_body.data + m_nparticles),
+            snapshot.body, snap_idx, root, mpi_comm);
+        gather_snapshot_values(std::vector<Scalar4>(h_orientation.data, h_orientation.data + m_nparticles),
+            snapshot.orientation, snap_idx, root, mpi_comm);
+
+        if (m_exec_conf->getRank() == root)
+            {
+            // make sure the positions stored in the snapshot are within the boundaries
+            for (unsigned int snap_id = 0; snap_id < getNGlobal(); snap_id++)
+                m_global_box.wrap(snapshot.pos[snap_id], snapshot.image[snap_id]);
             }
         }
     else
@@ -2220,6 +2443,26 @@ void export_ParticleData()
     ;
     }
 
+/*! \param snapshot Snapshot to view, must not be resized while the view is in use
+*/
+ParticleDataView::ParticleDataView(const SnapshotParticleData& snapshot)
+    : size(snapshot.size), pos(NULL), vel(NULL), accel(NULL), type(NULL), mass(NULL), charge(NULL), diameter(NULL),
+      image(NULL), body(NULL), orientation(NULL), inertia_tensor(NULL), type_mapping(snapshot.type_mapping)
+    {
+    // leave the pointers of empty arrays NULL
+    if (!snapshot.pos.empty()) pos = &snapshot.pos[0];
+    if (!snapshot.vel.empty()) vel = &snapshot.vel[0];
+    if (!snapshot.accel.empty()) accel = &snapshot.accel[0];
+    if (!snapshot.type.empty()) type = &snapshot.type[0];
+    if (!snapshot.mass.empty()) mass = &snapshot.mass[0];
+    if (!snapshot.charge.empty()) charge = &snapshot.charge[0];
+    if (!snapshot.diameter.empty()) diameter = &snapshot.diameter[0];
+    if (!snapshot.image.empty()) image = &snapshot.image[0];
+    if (!snapshot.body.empty()) body = &snapshot.body[0];
+    if (!snapshot.orientation.empty()) orientation = &snapshot.orientation[0];
+    if (!snapshot.inertia_tensor.empty()) inertia_tensor = &snapshot.inertia_tensor[0];
+    }
+
 //! Constructor for SnapshotParticleData
 SnapshotParticleData::SnapshotParticleData(unsigned int N)
        : size(N)
@@ -255,6 +255,41 @@ struct SnapshotParticleData {
     std::vector<std::string> type_mapping; //!< Mapping between particle type ids and names
     };
 
+//! Read-only view of per-particle arrays stored in global tag order
+/*! A ParticleDataView points to particle data that is laid out like the fields of a SnapshotParticleData, but is
+ * owned by someone else, e.g. a memory-mapped restart file. ParticleData::initializeFromView() copies the particles
+ * straight from the view into its arrays, without an intermediate snapshot.
+ *
+ * All arrays must be set and hold  size elements, except  inertia_tensor, which may be NULL.
+ * \ingroup data_structs
+ */
+struct ParticleDataView
+    {
+    //! Empty view
+    ParticleDataView()
+        : size(0), pos(NULL), vel(NULL), accel(NULL), type(NULL), mass(NULL), charge(NULL), diameter(NULL),
+          image(NULL), body(NULL), orientation(NULL), inertia_tensor(NULL)
+        {
+        }
+
+    //! View of the arrays of a snapshot
+    explicit ParticleDataView(const SnapshotParticleData& snapshot);
+
+    unsigned int size;                  //!< number of particles in the view
+    const Scalar3 *pos;                 //!< positions
+    const Scalar3 *vel;                 //!< velocities
+    const Scalar3 *accel;               //!< accelerations
+    const unsigned int *type;           //!< types
+    const Scalar *mass;                 //!< masses
+    const Scalar *charge;               //!< charges
+    const Scalar *diameter;             //!< diameters
+    const int3 *image;                  //!< images
+    const unsigned int *body;           //!< body ids
+    const Scalar4 *orientation;         //!< orientations
+    const InertiaTensor *inertia_tensor; //!< Moments of inertia (optional)
+    std::vector<std::string> type_mapping; //!< Mapping between particle type ids and names
+    };
+
 //! Structure to store packed particle data
 /* pdata_element is used for compact storage of particle data, mainly for communication.
  */
@@ -322,6 +357,11 @@ struct pdata_element
 
     If these flags are not set, these arrays can still be read but their values may be incorrect.
 
+    When the virial is only needed summed over all particles, the integrator may enable reduced virial mode with
+    setReducedVirial(). Computes that support it then sum up their virial instead of filling the 6 x N per-particle
+    virial array, and the integrator adds the sums to the external virial (getExternalVirial()). The per-particle
+    net_virial then only holds the contributions of the remaining computes.
+
     If any computation is unable to supply the appropriate values (i.e. rigid body virial can not be computed
     until the second step of the simulation), then it should remove the flag to signify that the values are not valid.
     Any analyzer/updater that expects the value to be set should check the flags that are actually set.
@@ -408,6 +448,14 @@ class ParticleData : boost::noncopyable
                         = boost::shared_ptr<DomainDecomposition>()
                      );
 
+        //! Construct using a ParticleDataView
+        ParticleData(const ParticleDataView& view,
+                     const BoxDim& global_box,
+                     boost::shared_ptr<ExecutionConfiguration> exec_conf,
+                     boost::shared_ptr<DomainDecomposition> decomposition
+                        = boost::shared_ptr<DomainDecomposition>()
+                     );
+
         //! Destructor
         virtual ~ParticleData();
 
@@ -845,9 +893,18 @@ class ParticleData : boost::noncopyable
         //! Remove the given flag
         void removeFlag(pdata_flag::Enum flag) { m_flags[flag] = false; }
 
+        //! Set whether the virial is only summed over all particles
+        void setReducedVirial(bool reduced_virial) { m_reduced_virial = reduced_virial; }
+
+        //! Test if the virial is only summed over all particles
+        bool getReducedVirial() const { return m_reduced_virial; }
+
         //! Initialize from a snapshot
         void initializeFromSnapshot(const SnapshotParticleData & snapshot);
 
+        //! Initialize from a view of particle data that every rank can access
+        void initializeFromView(const ParticleDataView& view);
+
         //! Take a snapshot
         void takeSnapshot(SnapshotParticleData &snapshot);
 
@@ -871,6 +928,16 @@ class ParticleData : boost::noncopyable
             m_boxchange_signal();
             }
 
+        //! Recompute the local box after the domain boundaries have been changed
+        /*! The particles are not migrated by this method, this is left to the Communicator.
+         */
+        void updateLocalBox()
+            {
+            assert(m_decomposition);
+            m_box = m_decomposition->calculateLocalBox(m_global_box);
+            m_boxchange_signal();
+            }
+
         //! Returns the domain decomin decomposition information
         boost::shared_ptr<DomainDecomposition> getDomainDecomposition()
             {
@@ -1033,6 +1100,7 @@ class ParticleData : boost::noncopyable
         Scalar m_external_virial[6];                 //!< External potential contribution to the virial
         const float m_resize_factor;                 //!< The numerical factor with which the particle data arrays are resized
         PDataFlags m_flags;                          //!< Flags identifying which optional fields are valid
+        bool m_reduced_virial;                       //!< True if computes may only sum up their virial
 
         Scalar3 m_origin;                            //!< Tracks the position of the origin of the coordinate system
         int3 m_o_image;                              //!< Tracks the origin image
@@ -1055,9 +1123,14 @@ class ParticleData : boost::noncopyable
 
         //! Helper function to check that particles of a snapshot are in the box
         /*! \return true If and only if all particles are in the simulation box
-         * \param Snapshot to check
+         * \param view Particles to check
          */
-        bool inBox(const SnapshotParticleData& snap);
+        bool inBox(const ParticleDataView& view);
+
+        #ifdef ENABLE_MPI
+        //! Helper function to find the rank that owns a particle
+        unsigned int placeParticle(Scalar3& pos, int3& img, unsigned int tag, const unsigned int *cart_ranks);
+        #endif
     };
 
 
@@ -318,6 +318,15 @@ class ParticleGroup
             return m_member_idx;
             }
 
+        //! Direct access to the list of member tags
+        /*! \returns A GPUArray with the tags of all members of the group (on all processors), in ascending order
+            \note The caller \b must \b not write to or change the array.
+        */
+        const GPUArray<unsigned int>& getMemberTags() const
+            {
+            return m_member_tags;
+            }
+
         // @}
         //! \name Analysis methods
         // @{
@@ -98,6 +98,19 @@ RigidBodyGroup::RigidBodyGroup(boost::shared_ptr<SystemDefinition> sysdef, boost
 
     }
 
+    #ifdef ENABLE_MPI
+    // count the members of the group on all ranks
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &particle_count.front(),
+                      m_rdata->getNumBodies(),
+                      MPI_UNSIGNED,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
     // validate that all bodies are completely selected
     // also count up the number of selected bodies
     unsigned int n_selected_bodies = 0;
@@ -67,6 +67,10 @@ using namespace boost::python;
 #include "RigidData.h"
 #include "QuaternionMath.h"
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
 using namespace boost;
 using namespace std;
 
@@ -81,7 +85,7 @@ using namespace std;
     \post All data members in RigidData are completely initialized from the given info in \a particle_data
 */
 RigidData::RigidData(boost::shared_ptr<ParticleData> particle_data)
-    : m_pdata(particle_data), m_n_bodies(0), m_ndof(0)
+    : m_pdata(particle_data), m_n_bodies(0), m_ndof(0), m_nglobal(0)
     {
     // leave arrays initialized to NULL. There are currently 0 bodies and their
     // initialization is delayed because we cannot reasonably determine when that initialization
@@ -94,7 +98,7 @@ RigidData::RigidData(boost::shared_ptr<ParticleData> particle_data)
     m_exec_conf = m_pdata->getExecConf();
 
     // connect to global particle number change signal
-    m_sort_connection = m_pdata->connectGlobalParticleNumberChange(bind(&RigidData::slotGlobalParticleNumberChange, this));
+    m_global_particle_num_connection = m_pdata->connectGlobalParticleNumberChange(bind(&RigidData::slotGlobalParticleNumberChange, this));
     }
 
 RigidData::~RigidData()
@@ -108,6 +112,8 @@ RigidData::~RigidData()
     \pre m_particle_tags has been filled with values
     \pre m_particle_indices has been allocated
     \post m_particle_indices is updated to match the current sorting of the particle data
+
+    Members of a body that are not local to this rank are given the index NO_INDEX.
 */
 void RigidData::recalcIndices()
     {
@@ -124,6 +130,10 @@ void RigidData::recalcIndices()
 
     assert(m_n_bodies == m_body_size.getNumElements());
 
+    // the per-particle arrays follow the size of the particle data
+    if (m_particle_offset.getNumElements() < m_pdata->getMaxN())
+        m_particle_offset.resize(m_pdata->getMaxN());
+
     // get the particle data
     ArrayHandle< unsigned int > h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
 
@@ -153,6 +163,14 @@ void RigidData::recalcIndices()
             // translate the tag to the current index
             unsigned int tag = tags.data[body*tags_pitch + i];
             unsigned int pidx = h_rtag.data[tag];
+
+            // skip members owned by other ranks (ghost particles are updated by the communication)
+            if (pidx >= m_pdata->getN())
+                {
+                indices.data[body*indices_pitch + i] = NO_INDEX;
+                continue;
+                }
+
             indices.data[body*indices_pitch + i] = pidx;
             h_particle_offset.data[pidx] = i;
 
@@ -160,6 +178,8 @@ void RigidData::recalcIndices()
             }
         }
 
+    m_num_particles = ridx;
+
     #ifdef ENABLE_CUDA
     //Sort them so they are ordered
     sort(rigid_particle_indices.data, rigid_particle_indices.data + ridx);
@@ -182,38 +202,102 @@ inline static void mat_multiply(Scalar a[3][3], Scalar b[3][3], Scalar c[3][3])
     c[2][2] = a[2][0] * b[0][2] + a[2][1] * b[1][2] + a[2][2] * b[2][2];
     }
 
+//! Per-particle data needed to set up the rigid bodies
+/*! In multi-processor simulations, these records are gathered from all ranks so that every rank can compute the
+    static data of all bodies.
+*/
+struct rigid_member
+    {
+    unsigned int tag;           //!< Particle tag
+    unsigned int body;          //!< Body the particle belongs to
+    Scalar mass;                //!< Particle mass
+    Scalar3 pos;                //!< Particle position
+    int3 image;                 //!< Particle image
+    Scalar4 orientation;        //!< Particle orientation
+    InertiaTensor inertia;      //!< Particle moment of inertia tensor
+    };
+
+//! Orders body members by particle tag
+static bool compare_rigid_member_tag(const rigid_member& a, const rigid_member& b)
+    {
+    return a.tag < b.tag;
+    }
+
 /*! \pre all data members have been allocated
     \post all data members are initialized with data from the particle data
+
+    In multi-processor simulations, the members of all bodies are gathered on every rank and ordered by tag. Every rank
+    then holds identical copies of the body data, and the bodies are integrated redundantly on all ranks.
 */
 void RigidData::initializeData()
     {
+    BoxDim box = m_pdata->getGlobalBox();
+    m_nglobal = m_pdata->getNGlobal();
 
-    // get the particle data
-    ArrayHandle< unsigned int > h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    // collect the particles that belong to bodies
+    std::vector<rigid_member> members;
 
+    {
+    ArrayHandle< unsigned int > h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle< unsigned int > h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle< Scalar4 > h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle< Scalar4 > h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle< int3 > h_image(m_pdata->getImages(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_p_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
-    BoxDim box = m_pdata->getBox();
+
+    for (unsigned int j = 0; j < m_pdata->getN(); j++)
+        {
+        if (h_body.data[j] == NO_BODY) continue;
+
+        rigid_member m;
+        m.tag = h_tag.data[j];
+        m.body = h_body.data[j];
+        m.mass = h_vel.data[j].w;
+        m.pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+        m.image = h_image.data[j];
+        m.orientation = h_p_orientation.data[j];
+
+        #ifdef ENABLE_MPI
+        // in multi-processor simulations, the inertia tensors are stored by local particle index
+        if (m_pdata->getDomainDecomposition())
+            m.inertia = m_pdata->getInertiaTensor(j);
+        else
+        #endif
+            m.inertia = m_pdata->getInertiaTensor(m.tag);
+
+        members.push_back(m);
+        }
+    }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        std::vector<rigid_member> local_members;
+        local_members.swap(members);
+        all_gather_pod_v(local_members, members, m_exec_conf->getMPICommunicator());
+
+        // order by tag so that the body arrays are laid out identically on all ranks
+        std::sort(members.begin(), members.end(), compare_rigid_member_tag);
+        }
+    #endif
 
     // determine the number of rigid bodies
     unsigned int maxbody = 0;
     unsigned int minbody = NO_BODY;
     bool found_body = false;
-    unsigned int nparticles = m_pdata->getN();
-    for (unsigned int j = 0; j < nparticles; j++)
+    unsigned int nmembers = members.size();
+    for (unsigned int k = 0; k < nmembers; k++)
         {
-        if (h_body.data[j] != NO_BODY)
-            {
-            found_body = true;
-            if (maxbody < h_body.data[j])
-                maxbody = h_body.data[j];
-            if (minbody > h_body.data[j])
-                minbody = h_body.data[j];
-            }
+        found_body = true;
+        if (maxbody < members[k].body)
+            maxbody = members[k].body;
+        if (minbody > members[k].body)
+            minbody = members[k].body;
         }
 
     if (found_body)
         {
-        m_n_bodies = maxbody + 1;   // h_body.data[j] is numbered from 0
+        m_n_bodies = maxbody + 1;   // body indices are numbered from 0
         if (minbody != 0)
             {
             m_exec_conf->msg->error() << "rigid data: Body indices do not start at 0\n";
@@ -247,7 +331,7 @@ void RigidData::initializeData()
     GPUArray<Scalar4> force(m_n_bodies, m_pdata->getExecConf());
     GPUArray<Scalar4> torque(m_n_bodies, m_pdata->getExecConf());
 
-    GPUArray<unsigned int> particle_offset(m_pdata->getN(), m_pdata->getExecConf());
+    GPUArray<unsigned int> particle_offset(m_pdata->getMaxN(), m_pdata->getExecConf());
 
     m_body_dof.swap(body_dof);
     m_body_mass.swap(body_mass);
@@ -275,12 +359,8 @@ void RigidData::initializeData()
     for (unsigned int body = 0; body < m_n_bodies; body++)
         body_size_handle.data[body] = 0;
 
-    for (unsigned int j = 0; j < nparticles; j++)
-        {
-        unsigned int body = h_body.data[j];
-        if (body != NO_BODY)
-            body_size_handle.data[body]++;
-        }
+    for (unsigned int k = 0; k < nmembers; k++)
+        body_size_handle.data[members[k].body]++;
 
     // determine the maximum number of particles in a rigid body
     m_nmax = 0;
@@ -323,30 +403,20 @@ void RigidData::initializeData()
     // stable way by bringing all particles unwrapped coords to being at most slightly outside of the box.
     std::vector<int3> nominal_body_image(m_n_bodies);
 
-    ArrayHandle< int3 > h_image(m_pdata->getImages(), access_location::host, access_mode::read);
-    ArrayHandle< Scalar4 > h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    for (unsigned int j = 0; j < nparticles; j++)
-        {
-        unsigned int body = h_body.data[j];
-        if (body != NO_BODY)
-            nominal_body_image[body] = h_image.data[j];
-        }
+    for (unsigned int k = 0; k < nmembers; k++)
+        nominal_body_image[members[k].body] = members[k].image;
 
     // compute the center of mass for each body by summing up mass * \vec{r} for each particle in the body
-    ArrayHandle< Scalar4 > h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
-    for (unsigned int j = 0; j < m_pdata->getN(); j++)
+    for (unsigned int k = 0; k < nmembers; k++)
         {
-        if (h_body.data[j] == NO_BODY) continue;
-
-        unsigned int body = h_body.data[j];
-        Scalar mass_one = h_vel.data[j].w;
+        unsigned int body = members[k].body;
+        Scalar mass_one = members[k].mass;
         body_mass_handle.data[body] += mass_one;
         // unwrap all particles in a body to the same image
-        int3 shift = make_int3(h_image.data[j].x - nominal_body_image[body].x,
-                               h_image.data[j].y - nominal_body_image[body].y,
-                               h_image.data[j].z - nominal_body_image[body].z);
-        Scalar3 wrapped = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-        Scalar3 unwrapped = box.shift(wrapped, shift);
+        int3 shift = make_int3(members[k].image.x - nominal_body_image[body].x,
+                               members[k].image.y - nominal_body_image[body].y,
+                               members[k].image.z - nominal_body_image[body].z);
+        Scalar3 unwrapped = box.shift(members[k].pos, shift);
 
         com_handle.data[body].x += mass_one * unwrapped.x;
         com_handle.data[body].y += mass_one * unwrapped.y;
@@ -373,23 +443,17 @@ void RigidData::initializeData()
     InertiaTensor pinertia_tensor;
     Scalar rot_mat[3][3], rot_mat_trans[3][3], Ibody[3][3], Ispace[3][3], tmp[3][3];
 
-    ArrayHandle< unsigned int > h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
-
     // determine the inertia tensor then diagonalize it
-    for (unsigned int j = 0; j < m_pdata->getN(); j++)
+    for (unsigned int k = 0; k < nmembers; k++)
         {
-        if (h_body.data[j] == NO_BODY) continue;
-
-        unsigned int body = h_body.data[j];
-        Scalar mass_one = h_vel.data[j].w;
-        unsigned int tag = h_tag.data[j];
+        unsigned int body = members[k].body;
+        Scalar mass_one = members[k].mass;
 
         // unwrap all particles in a body to the same image
-        int3 shift = make_int3(h_image.data[j].x - nominal_body_image[body].x,
-                               h_image.data[j].y - nominal_body_image[body].y,
-                               h_image.data[j].z - nominal_body_image[body].z);
-        Scalar3 wrapped = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-        Scalar3 unwrapped = box.shift(wrapped, shift);
+        int3 shift = make_int3(members[k].image.x - nominal_body_image[body].x,
+                               members[k].image.y - nominal_body_image[body].y,
+                               members[k].image.z - nominal_body_image[body].z);
+        Scalar3 unwrapped = box.shift(members[k].pos, shift);
 
         Scalar dx = unwrapped.x - com_handle.data[body].x;
         Scalar dy = unwrapped.y - com_handle.data[body].y;
@@ -404,8 +468,8 @@ void RigidData::initializeData()
 
         // take into account the partile inertia moments
         // get the original particle orientation and inertia tensor from input
-        porientation = h_p_orientation.data[j];
-        pinertia_tensor = m_pdata->getInertiaTensor(tag);
+        porientation = members[k].orientation;
+        pinertia_tensor = members[k].inertia;
 
         exyzFromQuaternion(porientation, ex, ey, ez);
 
@@ -567,30 +631,25 @@ void RigidData::initializeData()
     //tally up how many particles belong to rigid bodies
     unsigned int rigid_particle_count = 0;
 
-    // determine the particle indices and particle tags
-    for (unsigned int j = 0; j < m_pdata->getN(); j++)
+    // determine the particle tags, the particle indices are set by recalcIndices()
+    for (unsigned int k = 0; k < nmembers; k++)
         {
-        if (h_body.data[j] == NO_BODY) continue;
-
         rigid_particle_count++;
 
         // get the corresponding body
-        unsigned int body = h_body.data[j];
+        unsigned int body = members[k].body;
         // get the current index in the body
         unsigned int current_localidx = local_indices_handle.data[body];
-        // set the particle index to be this value
-        particle_indices_handle.data[body * particle_indices_pitch + current_localidx] = j;
         // set the particle tag to be the tag of this particle
-        particle_tags_handle.data[body * particle_tags_pitch + current_localidx] = h_tag.data[j];
+        particle_tags_handle.data[body * particle_tags_pitch + current_localidx] = members[k].tag;
 
         // determine the particle position in the body frame
         // with ex_space, ey_space and ex_space vectors computed from the diagonalization
         // unwrap all particles in a body to the same image
-        int3 shift = make_int3(h_image.data[j].x - nominal_body_image[body].x,
-                               h_image.data[j].y - nominal_body_image[body].y,
-                               h_image.data[j].z - nominal_body_image[body].z);
-        Scalar3 wrapped = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-        Scalar3 unwrapped = box.shift(wrapped, shift);
+        int3 shift = make_int3(members[k].image.x - nominal_body_image[body].x,
+                               members[k].image.y - nominal_body_image[body].y,
+                               members[k].image.z - nominal_body_image[body].z);
+        Scalar3 unwrapped = box.shift(members[k].pos, shift);
 
         Scalar dx = unwrapped.x - com_handle.data[body].x;
         Scalar dy = unwrapped.y - com_handle.data[body].y;
@@ -609,7 +668,7 @@ void RigidData::initializeData()
         Scalar4 qc;
         quatconj(orientation_handle.data[body], qc);
 
-        porientation = h_p_orientation.data[j];
+        porientation = members[k].orientation;
         quatquat(qc, porientation, h_particle_orientation.data[idx]);
         normalize(h_particle_orientation.data[idx]);
 
@@ -628,10 +687,10 @@ void RigidData::initializeData()
     m_rigid_particle_indices.swap(rigid_particle_indices);
     m_num_particles = rigid_particle_count;
 
-    GPUArray<Scalar4> particle_oldpos(m_pdata->getN(), m_pdata->getExecConf());
+    GPUArray<Scalar4> particle_oldpos(m_pdata->getMaxN(), m_pdata->getExecConf());
     m_particle_oldpos.swap(particle_oldpos);
 
-    GPUArray<Scalar4> particle_oldvel(m_pdata->getN(), m_pdata->getExecConf());
+    GPUArray<Scalar4> particle_oldvel(m_pdata->getMaxN(), m_pdata->getExecConf());
     m_particle_oldvel.swap(particle_oldvel);
 
     // release particle data for later access
@@ -665,7 +724,7 @@ void RigidData::setRV(bool set_x)
 void RigidData::setRVCPU(bool set_x)
     {
     // get box
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
 
     // access to the force
     const GPUArray< Scalar4 >& net_force = m_pdata->getNetForce();
@@ -704,6 +763,11 @@ void RigidData::setRVCPU(bool set_x)
             {
             // get the actual index of particle in the particle arrays
             unsigned int pidx = particle_indices_handle.data[body * indices_pitch + j];
+
+            // skip members owned by other ranks
+            if (pidx == NO_INDEX)
+                continue;
+
             // get the index of particle in the current rigid body in the particle_pos array
             unsigned int localidx = body * particle_pos_pitch + j;
 
@@ -1063,6 +1127,13 @@ void RigidData::setAngMom(unsigned int body, Scalar3 angmom)
 */
 void RigidData::computeVirialCorrectionStart()
     {
+    // the number of local particles changes in multi-processor simulations
+    if (m_particle_oldpos.getNumElements() < m_pdata->getN())
+        {
+        m_particle_oldpos.resize(m_pdata->getMaxN());
+        m_particle_oldvel.resize(m_pdata->getMaxN());
+        }
+
     #ifdef ENABLE_CUDA
         if (m_pdata->getExecConf()->isCUDAEnabled())
             computeVirialCorrectionStartGPU();
@@ -1192,18 +1263,37 @@ void RigidData::computeVirialCorrectionEndGPU(Scalar deltaT)
     }
 #endif
 
-/*! \param snapshot SnapshotRigidData to initialize from
+/*! \param snapshot_in SnapshotRigidData to initialize from
+
+    In multi-processor simulations, the snapshot is only read on rank 0 and broadcast to all ranks.
  */
-void RigidData::initializeFromSnapshot(const SnapshotRigidData& snapshot)
+void RigidData::initializeFromSnapshot(const SnapshotRigidData& snapshot_in)
     {
     // check that all fields in the snapshot have correct length
-    if (m_exec_conf->getRank() == 0 && !snapshot.validate())
+    if (m_exec_conf->getRank() == 0 && !snapshot_in.validate())
         {
         m_exec_conf->msg->error() << "init.*: invalid rigid body snapshot."
                                 << std::endl << std::endl;
         throw std::runtime_error("Error initializing rigid bodies.");
         }
 
+    SnapshotRigidData snapshot;
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        if (m_exec_conf->getRank() == 0)
+            snapshot = snapshot_in;
+
+        bcast(snapshot.com, 0, m_exec_conf->getMPICommunicator());
+        bcast(snapshot.vel, 0, m_exec_conf->getMPICommunicator());
+        bcast(snapshot.angmom, 0, m_exec_conf->getMPICommunicator());
+        bcast(snapshot.body_image, 0, m_exec_conf->getMPICommunicator());
+        bcast(snapshot.size, 0, m_exec_conf->getMPICommunicator());
+        }
+    else
+    #endif
+        snapshot = snapshot_in;
+
     ArrayHandle<Scalar4> h_com(getCOM(), access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar4> h_vel(getVel(), access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar4> h_angmom(getAngMom(), access_location::host, access_mode::overwrite);
@@ -1254,7 +1344,7 @@ void RigidData::takeSnapshot(SnapshotRigidData& snapshot) const
 
 void RigidData::slotGlobalParticleNumberChange()
     {
-    if (m_particle_offset.getNumElements() != 0 && m_pdata->getNGlobal() != m_particle_offset.getNumElements())
+    if (m_n_bodies != 0 && m_pdata->getNGlobal() != m_nglobal)
         {
         throw std::runtime_error("Changing particle number with rigid bodies is unsupported.");
         }
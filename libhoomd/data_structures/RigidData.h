@@ -133,6 +133,11 @@ struct SnapshotRigidData
     be able to process 1 body in each block with one particle in each thread, performing any sums as
     reductions.
 
+    In multi-processor simulations, every rank stores the data of all bodies, including those with members on other
+    ranks. The rigid body integrators sum the forces and torques of the local members over all ranks and then advance
+    every body identically on all ranks, so no body state has to be sent around. Members that are not local to a rank
+    have the index NO_INDEX in the particle index array, and setRV() only updates the local members.
+
     \ingroup data_structs
 */
 class RigidData
@@ -491,6 +496,7 @@ class RigidData
         unsigned int m_n_bodies;                    //!< Number of rigid bodies in the data structure
         unsigned int m_nmax;                        //!< Maximum number of particles in a rigid body
         unsigned int m_ndof;                        //!< Total number degrees of freedom of rigid bodies
+        unsigned int m_nglobal;                     //!< Global number of particles the bodies were initialized with
         GPUArray<unsigned int> m_body_dof;          //!< n_bodies length 1D array of body DOF
         GPUArray<Scalar> m_body_mass;               //!< n_bodies length 1D array of body mass
         GPUArray<Scalar4> m_moment_inertia;         //!< n_bodies length 1D array of moments of inertia in the body frame
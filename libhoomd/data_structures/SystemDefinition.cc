@@ -130,6 +130,38 @@ SystemDefinition::SystemDefinition(boost::shared_ptr<const SnapshotSystemData> s
                  exec_conf,
                  decomposition));
 
+    constructFromSnapshot(snapshot, exec_conf);
+    }
+
+/*! The particles are initialized from \a particles, which must be accessible on every rank (see
+    ParticleData::initializeFromView()). The particle data of \a snapshot is ignored.
+    \param snapshot Snapshot to use for all other data
+    \param particles View of the particle data
+    \param exec_conf Execution configuration to run on
+    \param decomposition (optional) The domain decomposition layout
+*/
+SystemDefinition::SystemDefinition(boost::shared_ptr<const SnapshotSystemData> snapshot,
+                                   const ParticleDataView& particles,
+                                   boost::shared_ptr<ExecutionConfiguration> exec_conf,
+                                   boost::shared_ptr<DomainDecomposition> decomposition)
+    {
+    setNDimensions(snapshot->dimensions);
+
+    m_particle_data = boost::shared_ptr<ParticleData>(new ParticleData(particles,
+                 snapshot->global_box,
+                 exec_conf,
+                 decomposition));
+
+    constructFromSnapshot(snapshot, exec_conf);
+    }
+
+/*! \param snapshot Snapshot to use
+    \param exec_conf Execution configuration to run on
+    \pre m_particle_data is initialized
+*/
+void SystemDefinition::constructFromSnapshot(boost::shared_ptr<const SnapshotSystemData> snapshot,
+                                             boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
     #ifdef ENABLE_MPI
     // in MPI simulations, broadcast dimensionality from rank zero
     if (m_particle_data->getDomainDecomposition())
@@ -138,7 +170,13 @@ SystemDefinition::SystemDefinition(boost::shared_ptr<const SnapshotSystemData> s
 
     m_bond_data = boost::shared_ptr<BondData>(new BondData(m_particle_data, snapshot->bond_data));
 
-    m_wall_data = boost::shared_ptr<WallData>(new WallData(snapshot->wall_data));
+    std::vector<Wall> walls = snapshot->wall_data;
+    #ifdef ENABLE_MPI
+    // the walls are known to every rank, but the snapshot is only valid on rank zero
+    if (m_particle_data->getDomainDecomposition())
+        bcast(walls, 0, exec_conf->getMPICommunicator());
+    #endif
+    m_wall_data = boost::shared_ptr<WallData>(new WallData(walls));
 
     m_rigid_data = boost::shared_ptr<RigidData>(new RigidData(m_particle_data));
 
@@ -149,7 +187,13 @@ SystemDefinition::SystemDefinition(boost::shared_ptr<const SnapshotSystemData> s
 
     // If the initializer is from a binary file, then this reads in the body COM, velocities, angular momenta and body images;
     // otherwise, nothing is done here.
-    if (snapshot->rigid_data.size) m_rigid_data->initializeFromSnapshot(snapshot->rigid_data);
+    unsigned int n_snapshot_bodies = snapshot->rigid_data.size;
+    #ifdef ENABLE_MPI
+    // the snapshot is only valid on rank zero
+    if (m_particle_data->getDomainDecomposition())
+        bcast(n_snapshot_bodies, 0, exec_conf->getMPICommunicator());
+    #endif
+    if (n_snapshot_bodies) m_rigid_data->initializeFromSnapshot(snapshot->rigid_data);
 
     m_angle_data = boost::shared_ptr<AngleData>(new AngleData(m_particle_data, snapshot->angle_data));
 
@@ -305,9 +349,15 @@ void SystemDefinition::initializeFromSnapshot(boost::shared_ptr<SnapshotSystemDa
 
     if (snapshot->has_wall_data)
         {
+        std::vector<Wall> walls = snapshot->wall_data;
+        #ifdef ENABLE_MPI
+        if (m_particle_data->getDomainDecomposition())
+            bcast(walls, 0, exec_conf->getMPICommunicator());
+        #endif
+
         m_wall_data->removeAllWalls();
-        for (unsigned int i = 0; i < snapshot->wall_data.size(); ++i)
-            m_wall_data->addWall(snapshot->wall_data[i]);
+        for (unsigned int i = 0; i < walls.size(); ++i)
+            m_wall_data->addWall(walls[i]);
         }
 
     // it is an error to load variables for more integrators than are
@@ -134,6 +134,12 @@ class SystemDefinition
                          boost::shared_ptr<ExecutionConfiguration> exec_conf=boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration()),
                          boost::shared_ptr<DomainDecomposition> decomposition=boost::shared_ptr<DomainDecomposition>());
 
+        //! Construct from a snapshot, with the particles taken from a view
+        SystemDefinition(boost::shared_ptr<const SnapshotSystemData> snapshot,
+                         const ParticleDataView& particles,
+                         boost::shared_ptr<ExecutionConfiguration> exec_conf,
+                         boost::shared_ptr<DomainDecomposition> decomposition=boost::shared_ptr<DomainDecomposition>());
+
         //! Set the dimensionality of the system
         void setNDimensions(unsigned int);
 
@@ -204,6 +210,10 @@ class SystemDefinition
         void initializeFromSnapshot(boost::shared_ptr<SnapshotSystemData> snapshot);
 
     private:
+        //! Helper function to construct all data structures except the particle data from a snapshot
+        void constructFromSnapshot(boost::shared_ptr<const SnapshotSystemData> snapshot,
+                                   boost::shared_ptr<ExecutionConfiguration> exec_conf);
+
         unsigned int m_n_dimensions;                        //!< Dimensionality of the system
         boost::shared_ptr<ParticleData> m_particle_data;    //!< Particle data for the system
         boost::shared_ptr<BondData> m_bond_data;            //!< Bond data for the system
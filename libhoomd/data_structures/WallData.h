@@ -89,6 +89,20 @@ struct Wall
         normal_z = nz / len;
         }
 
+    #ifdef ENABLE_MPI
+    //! Serialization method
+    template<class Archive>
+    void serialize(Archive & ar, const unsigned int version)
+        {
+        ar & origin_x;
+        ar & origin_y;
+        ar & origin_z;
+        ar & normal_x;
+        ar & normal_y;
+        ar & normal_z;
+        }
+    #endif
+
     Scalar origin_x;    //!< x-component of the origin
     Scalar origin_y;    //!< y-component of the origin
     Scalar origin_z;    //!< z-component of the origin
@@ -199,9 +199,12 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
     assert(m_pdata);
 
+    // access the bond table, with the members already resolved to particle indices
+    ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getIndexTable(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_type(m_bond_data->getIndexTableTypes(), access_location::host, access_mode::read);
+
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
@@ -219,46 +222,35 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     assert(h_diameter.data);
     assert(h_charge.data);
 
-    // Zero data for force calculation
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
-
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getGlobalBox();
 
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
+    // in reduced virial mode, the virial is only summed over all particles and the virial array is left alone
+    bool reduce_virial = compute_virial && this->m_pdata->getReducedVirial();
+    double virial_total[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    // Zero data for force calculation
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    if (!reduce_virial)
+        memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
     Scalar bond_virial[6];
     for (unsigned int i = 0; i< 6; i++)
         bond_virial[i]=Scalar(0.0);
 
-    ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_type(m_bond_data->getTypesArray(), access_location::host, access_mode::read);
-
-    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
-
     // for each of the bonds
     const unsigned int size = (unsigned int)m_bond_data->getN();
     for (unsigned int i = 0; i < size; i++)
         {
-        // lookup the tag of each of the particles participating in the bond
+        // the particle indices of the bond members (MEM TRANSFER: 2 integers)
         const typename BondData::members_t& bond = h_bonds.data[i];
-        assert(bond.tag[0] < m_pdata->getMaximumTag()+1);
-        assert(bond.tag[1] < m_pdata->getMaximumTag()+1);
-
-        // transform a and b into indicies into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-
-        // throw an error if this bond is incomplete
-        if (idx_a >= max_local || idx_b >= max_local)
-            {
-            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
-                bond.tag[0] << " " << bond.tag[1] << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
+        unsigned int idx_a = bond.idx[0];
+        unsigned int idx_b = bond.idx[1];
+        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
 
         // calculate d\vec{r}
         // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
@@ -329,7 +321,10 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
                 h_force.data[idx_b].y += force_divr * dx.y;
                 h_force.data[idx_b].z += force_divr * dx.z;
                 h_force.data[idx_b].w += bond_eng;
-                if (compute_virial)
+                if (reduce_virial)
+                    for (unsigned int i = 0; i < 6; i++)
+                        virial_total[i] += bond_virial[i];
+                else if (compute_virial)
                     for (unsigned int i = 0; i < 6; i++)
                         h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
                 }
@@ -340,7 +335,10 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
                 h_force.data[idx_a].y -= force_divr * dx.y;
                 h_force.data[idx_a].z -= force_divr * dx.z;
                 h_force.data[idx_a].w += bond_eng;
-                if (compute_virial)
+                if (reduce_virial)
+                    for (unsigned int i = 0; i < 6; i++)
+                        virial_total[i] += bond_virial[i];
+                else if (compute_virial)
                     for (unsigned int i = 0; i < 6; i++)
                         h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
                 }
@@ -352,6 +350,10 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
             }
         }
 
+    m_virial_reduced = reduce_virial;
+    for (unsigned int i = 0; i < 6; i++)
+        m_virial_total[i] = Scalar(virial_total[i]);
+
     if (m_prof) m_prof->pop();
     }
 
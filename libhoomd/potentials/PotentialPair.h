@@ -68,6 +68,10 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Communicator.h"
 #endif
 
+#ifdef ENABLE_OPENMP
+#include <omp.h>
+#endif
+
 #ifdef WIN32
 #pragma warning( push )
 #pragma warning( disable : 4103 4244 )
@@ -113,6 +117,36 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     the combination of XPLOR switching + shifted potentials will not be supported to avoid slowing down the calculation
     for everyone.
 
+    <b>Multithreading</b>
+
+    On the CPU, the loop over particles is split among ExecutionConfiguration::n_cpu OpenMP threads with a static
+    schedule. With a full neighbor list, each thread only writes the forces of its own particles. With a half
+    neighbor list, forces on neighbors are accumulated into per-thread partial arrays (see
+    ForceCompute::allocateThreadPartial()) which are summed in thread order afterwards, so results are reproducible
+    for a fixed number of threads.
+
+    <b>Vectorization</b>
+
+    The neighbors of each particle are processed in batches of \a batch_size. For every batch, the neighbor
+    positions and type pair indices are first gathered into small local arrays. The minimum image convention and
+    the evaluator are then applied in two loops without loop carried dependencies, marked with <tt>omp simd</tt> so
+    that the compiler can emit vector code for whatever instruction set it targets. Finally, the results are
+    accumulated into particle i (and particle j with the third law) in the original neighbor order, so that the sums
+    are identical to those of a scalar loop.
+
+    <b>Overlap with ghost communication</b>
+
+    In MPI simulations, the forces on particles that have no ghost neighbors can be computed before the ghost
+    particles have been updated. preComputeInterior() is called by the Communicator while the ghost update is in
+    flight and computes the forces on those interior particles (see NeighborList::getInteriorList()). The following
+    call to compute() then only adds the forces on the remaining particles. If the neighbor list is rebuilt or the
+    particles are sorted in between, all forces are recomputed.
+
+    With a half neighbor list, a pair of a local and a ghost particle is only evaluated on the rank that owns the
+    particle with the lower tag. The force on the ghost particle is accumulated like that on any other neighbor, and
+    sent back to its owner with Communicator::reduceGhostForces() once all forces have been computed. This way, every
+    pair across a domain boundary is evaluated once instead of on both sides.
+
     <b>Implementation details</b>
 
     rcutsq, ronsq, and the params are stored per particle type pair. It wastes a little bit of space, but benchmarks
@@ -171,6 +205,9 @@ class PotentialPair : public ForceCompute
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+
+        //! Compute the forces on particles without ghost neighbors
+        virtual void preComputeInterior(unsigned int timestep);
         #endif
 
     protected:
@@ -183,9 +220,20 @@ class PotentialPair : public ForceCompute
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
 
+        #ifdef ENABLE_MPI
+        bool m_interior_precomputed;                //!< True if the interior forces have been computed
+        unsigned int m_interior_tstep;              //!< Time step of the interior forces
+        bool m_has_computed;                        //!< True if the forces have been computed at least once
+        unsigned int m_computed_tstep;              //!< Time step of the last complete force computation
+        #endif
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
 
+        //! Compute the forces on a list of particles
+        void computeForcesOnParticles(const unsigned int *particle_list, unsigned int first, unsigned int last,
+                                      bool first_pass, bool last_pass);
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -232,6 +280,13 @@ PotentialPair< evaluator >::PotentialPair(boost::shared_ptr<SystemDefinition> sy
     m_prof_name = std::string("Pair ") + evaluator::getName();
     m_log_name = std::string("pair_") + evaluator::getName() + std::string("_energy") + log_suffix;
 
+    #ifdef ENABLE_MPI
+    m_interior_precomputed = false;
+    m_interior_tstep = 0;
+    m_has_computed = false;
+    m_computed_tstep = 0;
+    #endif
+
     // connect to the ParticleData to receive notifications when the maximum number of particles changes
     m_num_type_change_connection = m_pdata->connectNumTypesChange(boost::bind(&PotentialPair<evaluator>::slotNumTypesChange, this));
     }
@@ -352,26 +407,115 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     // start the profile for this compute
     if (m_prof) m_prof->push(m_prof_name);
 
+    const unsigned int N = m_pdata->getN();
+
+    #ifdef ENABLE_MPI
+    // only the particles with ghost neighbors are left if the interior has been computed with the same list
+    bool interior_precomputed = m_interior_precomputed && m_interior_tstep == timestep
+        && !m_nlist->hasBeenUpdated(timestep) && !m_particles_sorted;
+    m_interior_precomputed = false;
+    m_has_computed = true;
+    m_computed_tstep = timestep;
+
+    if (interior_precomputed)
+        {
+        ArrayHandle<unsigned int> h_interior_list(m_nlist->getInteriorList(), access_location::host, access_mode::read);
+        computeForcesOnParticles(h_interior_list.data, m_nlist->getNInterior(), N, false, true);
+        }
+    else
+    #endif
+        computeForcesOnParticles(NULL, 0, N, true, true);
+
+    #ifdef ENABLE_MPI
+    // return the forces on ghost particles to their owners
+    if (m_comm && m_nlist->getStorageMode() == NeighborList::half)
+        {
+        PDataFlags flags = m_pdata->getFlags();
+        bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+        m_comm->reduceGhostForces(m_force, m_virial, compute_virial && !m_pdata->getReducedVirial());
+        }
+    #endif
+
+    if (m_prof) m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+/*! \param timestep Current time step
+
+    The forces are only pre-computed if the neighbor list has already been checked in this time step and is not going
+    to be rebuilt, and if the forces have not been computed already in this time step.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::preComputeInterior(unsigned int timestep)
+    {
+    if (!m_nlist->isCurrent(timestep) || (m_has_computed && m_computed_tstep == timestep))
+        return;
+
+    if (m_prof) m_prof->push(m_prof_name);
+
+    ArrayHandle<unsigned int> h_interior_list(m_nlist->getInteriorList(), access_location::host, access_mode::read);
+    computeForcesOnParticles(h_interior_list.data, 0, m_nlist->getNInterior(), true, false);
+
+    m_interior_precomputed = true;
+    m_interior_tstep = timestep;
+
+    if (m_prof) m_prof->pop();
+    }
+#endif
+
+/*! \param particle_list List of local particle indices, or NULL to process the particles in index order
+    \param first Index of the first entry of \a particle_list to process
+    \param last One past the index of the last entry of \a particle_list to process
+    \param first_pass If true, the force, energy and virial arrays are reset before adding the forces
+    \param last_pass If true, the forces are final after this call (the per-thread partial sums are reduced)
+
+    A force computation may be split into several passes over disjoint lists of particles, which together contain
+    every local particle exactly once.
+*/
+template< class evaluator >
+void PotentialPair< evaluator >::computeForcesOnParticles(const unsigned int *particle_list, unsigned int first,
+    unsigned int last, bool first_pass, bool last_pass)
+    {
     // depending on the neighborlist settings, we can take advantage of newton's third law
     // to reduce computations at the cost of memory access complexity: set that flag now
     bool third_law = m_nlist->getStorageMode() == NeighborList::half;
 
+    // in MPI simulations, forces on ghost particles are returned to their owners after the computation, so
+    // a pair with a ghost particle must only be evaluated on one of the two ranks
+    bool ghost_forces = false;
+    #ifdef ENABLE_MPI
+    ghost_forces = third_law && m_comm;
+    #endif
+
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
-    Index2D nli = m_nlist->getNListIndexer();
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+    const unsigned int nlist_stride = m_nlist->getNListStride();
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
-
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     //force arrays
-    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host,
+        first_pass ? access_mode::overwrite : access_mode::readwrite);
+    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host,
+        first_pass ? access_mode::overwrite : access_mode::readwrite);
 
 
     const BoxDim& box = m_pdata->getGlobalBox();
+    const Scalar3 L = box.getL();
+    const Scalar3 L_inv = make_scalar3(Scalar(1.0)/L.x, Scalar(1.0)/L.y, Scalar(1.0)/L.z);
+    const Scalar tilt_xy = box.getTiltFactorXY();
+    const Scalar tilt_xz = box.getTiltFactorXZ();
+    const Scalar tilt_yz = box.getTiltFactorYZ();
+    const Scalar periodic_x = box.getPeriodic().x ? Scalar(1.0) : Scalar(0.0);
+    const Scalar periodic_y = box.getPeriodic().y ? Scalar(1.0) : Scalar(0.0);
+    const Scalar periodic_z = box.getPeriodic().z ? Scalar(1.0) : Scalar(0.0);
+    const energyShiftMode shift_mode = m_shift_mode;
+
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
@@ -379,13 +523,79 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
+    // in reduced virial mode, the virial is only summed over all particles and the virial array is left alone
+    const bool reduce_virial = compute_virial && this->m_pdata->getReducedVirial();
+    const bool store_virial = compute_virial && !reduce_virial;
+
     // need to start from a zero force, energy and virial
-    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
-    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+    if (first_pass)
+        {
+        memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+        if (!reduce_virial)
+            memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+        m_virial_reduced = reduce_virial;
+        for (unsigned int l = 0; l < 6; l++)
+            m_virial_total[l] = Scalar(0.0);
+        }
+
+    // with a half neighbor list, several threads may add to the same particle j: in that case each thread
+    // accumulates into its own partial arrays, which are summed in a deterministic order at the end
+    const unsigned int N = m_pdata->getN();
+    const unsigned int n_threads = m_exec_conf->n_cpu;
+    const bool use_partial = third_law && n_threads > 1 && N > 0;
+    if (use_partial && first_pass)
+        allocateThreadPartial(n_threads, ghost_forces);
+    if (reduce_virial)
+        m_virial_total_partial.assign(6*n_threads, 0.0);
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+    unsigned int tid = 0;
+    #ifdef ENABLE_OPENMP
+    tid = omp_get_thread_num();
+    #endif
+
+    // select the arrays this thread writes to
+    Scalar4 *force = h_force.data;
+    Scalar *virial = h_virial.data;
+    unsigned int virial_pitch = m_virial_pitch;
+    if (use_partial)
+        {
+        force = &m_force_partial[tid*m_partial_pitch];
+        virial = &m_virial_partial[6*tid*m_partial_pitch];
+        virial_pitch = m_partial_pitch;
+        if (first_pass)
+            {
+            memset((void*)force, 0, sizeof(Scalar4)*m_partial_pitch);
+            if (store_virial)
+                memset((void*)virial, 0, sizeof(Scalar)*6*m_partial_pitch);
+            }
+        }
+
+    // this thread's share of the virial summed over all particles, in reduced virial mode
+    double virial_total[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    // per thread scratch space for one batch of neighbors
+    const unsigned int batch_size = 16;
+    unsigned int b_j[batch_size];
+    unsigned int b_typpair[batch_size];
+    Scalar b_dx[batch_size];
+    Scalar b_dy[batch_size];
+    Scalar b_dz[batch_size];
+    Scalar b_rsq[batch_size];
+    Scalar b_dj[batch_size];
+    Scalar b_qj[batch_size];
+    Scalar b_force_divr[batch_size];
+    Scalar b_pair_eng[batch_size];
+    bool b_evaluated[batch_size];
 
     // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    #pragma omp for schedule(static)
+    for (int k = (int)first; k < (int)last; k++)
         {
+        const unsigned int i = particle_list ? particle_list[k] : (unsigned int)k;
+
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         unsigned int typei = __scalar_as_int(h_pos.data[i].w);
@@ -411,71 +621,109 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
         Scalar virialyzi = 0.0;
         Scalar virialzzi = 0.0;
 
-        // loop over all of the neighbors of this particle
+        // the tag decides which rank evaluates a pair with a ghost particle
+        const unsigned int tagi = ghost_forces ? h_tag.data[i] : 0;
+
+        // loop over all of the neighbors of this particle, one batch at a time
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
-        for (unsigned int k = 0; k < size; k++)
+        const unsigned int head_i = h_head_list.data[i];
+        unsigned int cur_neigh = 0;
+        while (cur_neigh < size)
             {
-            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[nli(i, k)];
-            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
-
-            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 dx = pi - pj;
-
-            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-            assert(typej < m_pdata->getNTypes());
-
-            // access diameter and charge (if needed)
-            Scalar dj = Scalar(0.0);
-            Scalar qj = Scalar(0.0);
-            if (evaluator::needsDiameter())
-                dj = h_diameter.data[j];
-            if (evaluator::needsCharge())
-                qj = h_charge.data[j];
-
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
-            // calculate r_ij squared (FLOPS: 5)
-            Scalar rsq = dot(dx, dx);
-
-            // get parameters for this type pair
-            unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = h_params.data[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
-            Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
-
-            // design specifies that energies are shifted if
-            // 1) shift mode is set to shift
-            // or 2) shift mode is explor and ron > rcut
-            bool energy_shift = false;
-            if (m_shift_mode == shift)
-                energy_shift = true;
-            else if (m_shift_mode == xplor)
+            // gather the neighbors of the next batch (MEM TRANSFER: 6 scalars per neighbor)
+            unsigned int n_batch = 0;
+            for (; cur_neigh < size && n_batch < batch_size; cur_neigh++)
                 {
-                if (ronsq > rcutsq)
-                    energy_shift = true;
+                // access the index of this neighbor
+                unsigned int j = h_nlist.data[head_i + cur_neigh*nlist_stride];
+                assert(j < N + m_pdata->getNGhosts());
+
+                // the owner of the ghost evaluates this pair
+                if (ghost_forces && j >= N && h_tag.data[j] < tagi)
+                    continue;
+
+                unsigned int m = n_batch++;
+                b_j[m] = j;
+
+                // calculate dr_ji (FLOPS: 3)
+                b_dx[m] = pi.x - h_pos.data[j].x;
+                b_dy[m] = pi.y - h_pos.data[j].y;
+                b_dz[m] = pi.z - h_pos.data[j].z;
+
+                // access the type of the neighbor particle
+                unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                assert(typej < m_pdata->getNTypes());
+                b_typpair[m] = m_typpair_idx(typei, typej);
+
+                // access diameter and charge (if needed)
+                if (evaluator::needsDiameter())
+                    b_dj[m] = h_diameter.data[j];
+                if (evaluator::needsCharge())
+                    b_qj[m] = h_charge.data[j];
                 }
 
-            // compute the force and potential energy
-            Scalar force_divr = Scalar(0.0);
-            Scalar pair_eng = Scalar(0.0);
-            evaluator eval(rsq, rcutsq, param);
-            if (evaluator::needsDiameter())
-                eval.setDiameter(di, dj);
-            if (evaluator::needsCharge())
-                eval.setCharge(qi, qj);
-
-            bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+            // apply periodic boundary conditions and calculate r_ij squared (FLOPS: 23)
+            // this is the same as BoxDim::minImage(), written without branches so that it vectorizes
+            #pragma omp simd
+            for (unsigned int m = 0; m < n_batch; m++)
+                {
+                Scalar dx = b_dx[m];
+                Scalar dy = b_dy[m];
+                Scalar dz = b_dz[m];
+
+                Scalar img = periodic_z * floor(dz * L_inv.z + Scalar(0.5));
+                dz -= L.z * img;
+                dy -= L.z * tilt_yz * img;
+                dx -= L.z * tilt_xz * img;
+
+                img = periodic_y * floor(dy * L_inv.y + Scalar(0.5));
+                dy -= L.y * img;
+                dx -= L.y * tilt_xy * img;
+
+                img = periodic_x * floor(dx * L_inv.x + Scalar(0.5));
+                dx -= L.x * img;
+
+                b_dx[m] = dx;
+                b_dy[m] = dy;
+                b_dz[m] = dz;
+                b_rsq[m] = dx*dx + dy*dy + dz*dz;
+                }
 
-            if (evaluated)
+            // compute the force and potential energy of every pair in the batch
+            #pragma omp simd
+            for (unsigned int m = 0; m < n_batch; m++)
                 {
+                // get parameters for this type pair
+                Scalar rsq = b_rsq[m];
+                Scalar rcutsq = h_rcutsq.data[b_typpair[m]];
+                Scalar ronsq = Scalar(0.0);
+                if (shift_mode == xplor)
+                    ronsq = h_ronsq.data[b_typpair[m]];
+
+                // design specifies that energies are shifted if
+                // 1) shift mode is set to shift
+                // or 2) shift mode is explor and ron > rcut
+                bool energy_shift = false;
+                if (shift_mode == shift)
+                    energy_shift = true;
+                else if (shift_mode == xplor)
+                    {
+                    if (ronsq > rcutsq)
+                        energy_shift = true;
+                    }
+
+                Scalar force_divr = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+                evaluator eval(rsq, rcutsq, h_params.data[b_typpair[m]]);
+                if (evaluator::needsDiameter())
+                    eval.setDiameter(di, b_dj[m]);
+                if (evaluator::needsCharge())
+                    eval.setCharge(qi, b_qj[m]);
+
+                bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
                 // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
+                if (evaluated && shift_mode == xplor)
                     {
                     if (rsq >= ronsq && rsq < rcutsq)
                         {
@@ -500,6 +748,21 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
                         }
                     }
 
+                b_evaluated[m] = evaluated;
+                b_force_divr[m] = force_divr;
+                b_pair_eng[m] = pair_eng;
+                }
+
+            // accumulate the results in neighbor order
+            for (unsigned int m = 0; m < n_batch; m++)
+                {
+                if (!b_evaluated[m])
+                    continue;
+
+                Scalar3 dx = make_scalar3(b_dx[m], b_dy[m], b_dz[m]);
+                Scalar force_divr = b_force_divr[m];
+                Scalar pair_eng = b_pair_eng[m];
+
                 Scalar force_div2r = force_divr * Scalar(0.5);
                 // add the force, potential energy and virial to the particle i
                 // (FLOPS: 8)
@@ -516,22 +779,32 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
                     }
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                // only add force to local particles
-                if (third_law && j < m_pdata->getN())
+                // only add force to ghost particles if it is returned to their owners
+                unsigned int j = b_j[m];
+                if (third_law && (j < N || ghost_forces))
                     {
                     unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
-                    if (compute_virial)
+                    force[mem_idx].x -= dx.x*force_divr;
+                    force[mem_idx].y -= dx.y*force_divr;
+                    force[mem_idx].z -= dx.z*force_divr;
+                    force[mem_idx].w += pair_eng * Scalar(0.5);
+                    if (store_virial)
+                        {
+                        virial[0*virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
+                        virial[1*virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
+                        virial[2*virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
+                        virial[3*virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
+                        virial[4*virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
+                        virial[5*virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                        }
+                    else if (reduce_virial)
                         {
-                        h_virial.data[0*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.x;
-                        h_virial.data[1*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.y;
-                        h_virial.data[2*m_virial_pitch+mem_idx] += force_div2r*dx.x*dx.z;
-                        h_virial.data[3*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.y;
-                        h_virial.data[4*m_virial_pitch+mem_idx] += force_div2r*dx.y*dx.z;
-                        h_virial.data[5*m_virial_pitch+mem_idx] += force_div2r*dx.z*dx.z;
+                        virial_total[0] += force_div2r*dx.x*dx.x;
+                        virial_total[1] += force_div2r*dx.x*dx.y;
+                        virial_total[2] += force_div2r*dx.x*dx.z;
+                        virial_total[3] += force_div2r*dx.y*dx.y;
+                        virial_total[4] += force_div2r*dx.y*dx.z;
+                        virial_total[5] += force_div2r*dx.z*dx.z;
                         }
                     }
                 }
@@ -539,22 +812,40 @@ void PotentialPair< evaluator >::computeForces(unsigned int timestep)
 
         // finally, increment the force, potential energy and virial for particle i
         unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
-        if (compute_virial)
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
+        if (store_virial)
+            {
+            virial[0*virial_pitch+mem_idx] += virialxxi;
+            virial[1*virial_pitch+mem_idx] += virialxyi;
+            virial[2*virial_pitch+mem_idx] += virialxzi;
+            virial[3*virial_pitch+mem_idx] += virialyyi;
+            virial[4*virial_pitch+mem_idx] += virialyzi;
+            virial[5*virial_pitch+mem_idx] += virialzzi;
+            }
+        else if (reduce_virial)
             {
-            h_virial.data[0*m_virial_pitch+mem_idx] += virialxxi;
-            h_virial.data[1*m_virial_pitch+mem_idx] += virialxyi;
-            h_virial.data[2*m_virial_pitch+mem_idx] += virialxzi;
-            h_virial.data[3*m_virial_pitch+mem_idx] += virialyyi;
-            h_virial.data[4*m_virial_pitch+mem_idx] += virialyzi;
-            h_virial.data[5*m_virial_pitch+mem_idx] += virialzzi;
+            virial_total[0] += virialxxi;
+            virial_total[1] += virialxyi;
+            virial_total[2] += virialxzi;
+            virial_total[3] += virialyyi;
+            virial_total[4] += virialyzi;
+            virial_total[5] += virialzzi;
             }
         }
 
-    if (m_prof) m_prof->pop();
+    if (reduce_virial)
+        for (unsigned int l = 0; l < 6; l++)
+            m_virial_total_partial[6*tid+l] = virial_total[l];
+    } // end omp parallel
+
+    // sum up the per-thread contributions
+    if (use_partial && last_pass)
+        reduceThreadPartial(h_force.data, h_virial.data, n_threads, store_virial);
+    if (reduce_virial)
+        reduceThreadVirialTotal(n_threads);
     }
 
 #ifdef ENABLE_MPI
@@ -112,6 +112,9 @@ class PotentialPairDPDThermo : public PotentialPair<evaluator>
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
+
+        //! The DPD forces are always computed in a single pass
+        virtual void preComputeInterior(unsigned int timestep) { }
         #endif
 
     protected:
@@ -176,7 +179,8 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(this->m_nlist->getNNeighArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_nlist(this->m_nlist->getNListArray(), access_location::host, access_mode::read);
-    Index2D nli = this->m_nlist->getNListIndexer();
+    ArrayHandle<unsigned int> h_head_list(this->m_nlist->getHeadList(), access_location::host, access_mode::read);
+    const unsigned int nlist_stride = this->m_nlist->getNListStride();
 
     ArrayHandle<Scalar4> h_pos(this->m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_vel(this->m_pdata->getVelocities(), access_location::host, access_mode::read);
@@ -195,8 +199,39 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
     memset((void*)h_force.data,0,sizeof(Scalar4)*this->m_force.getNumElements());
     memset((void*)h_virial.data,0,sizeof(Scalar)*this->m_virial.getNumElements());
 
+    // the temperature is the same for all pairs
+    const Scalar currentTemp = m_T->getValue(timestep);
+
+    // with a half neighbor list on several threads, accumulate into per-thread partial arrays (see PotentialPair)
+    const unsigned int N = this->m_pdata->getN();
+    const unsigned int n_threads = this->m_exec_conf->n_cpu;
+    const bool use_partial = third_law && n_threads > 1 && N > 0;
+    if (use_partial)
+        this->allocateThreadPartial(n_threads);
+
+    #pragma omp parallel num_threads(n_threads)
+    {
+    unsigned int tid = 0;
+    #ifdef ENABLE_OPENMP
+    tid = omp_get_thread_num();
+    #endif
+
+    // select the arrays this thread writes to
+    Scalar4 *force = h_force.data;
+    Scalar *virial = h_virial.data;
+    unsigned int virial_pitch = this->m_virial_pitch;
+    if (use_partial)
+        {
+        force = &this->m_force_partial[tid*this->m_partial_pitch];
+        virial = &this->m_virial_partial[6*tid*this->m_partial_pitch];
+        virial_pitch = this->m_partial_pitch;
+        memset((void*)force, 0, sizeof(Scalar4)*this->m_partial_pitch);
+        memset((void*)virial, 0, sizeof(Scalar)*6*this->m_partial_pitch);
+        }
+
     // for each particle
-    for (int i = 0; i < (int)this->m_pdata->getN(); i++)
+    #pragma omp for schedule(static)
+    for (int i = 0; i < (int)N; i++)
         {
         // access the particle's position, velocity, and type (MEM TRANSFER: 7 scalars)
         Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
@@ -216,11 +251,12 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
 
         // loop over all of the neighbors of this particle
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        const unsigned int head_i = h_head_list.data[i];
         for (unsigned int k = 0; k < size; k++)
             {
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[nli(i, k)];
-            assert(j < this->m_pdata->getN() + this->m_pdata->getNGhosts() );
+            unsigned int j = h_nlist.data[head_i + k*nlist_stride];
+            assert(j < N + this->m_pdata->getNGhosts() );
 
             // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
             Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
@@ -261,8 +297,6 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
             evaluator eval(rsq, rcutsq, param);
 
             // Special Potential Pair DPD Requirements
-            const Scalar currentTemp = m_T->getValue(timestep);
-
             // set seed using global tags
             unsigned int tagi = h_tag.data[i];
             unsigned int tagj = h_tag.data[j];
@@ -293,28 +327,35 @@ void PotentialPairDPDThermo< evaluator >::computeForces(unsigned int timestep)
                     viriali[l] += pair_virial[l];
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10 scalars / FLOPS: 8)
-                if (third_law)
+                // only add force to local particles
+                if (third_law && j < N)
                     {
                     unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x*force_divr;
-                    h_force.data[mem_idx].y -= dx.y*force_divr;
-                    h_force.data[mem_idx].z -= dx.z*force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    force[mem_idx].x -= dx.x*force_divr;
+                    force[mem_idx].y -= dx.y*force_divr;
+                    force[mem_idx].z -= dx.z*force_divr;
+                    force[mem_idx].w += pair_eng * Scalar(0.5);
                     for (unsigned int l = 0; l < 6; l++)
-                        h_virial.data[l * this->m_virial_pitch + mem_idx] += pair_virial[l];
+                        virial[l * virial_pitch + mem_idx] += pair_virial[l];
                     }
                 }
             }
 
         // finally, increment the force, potential energy and virial for particle i
         unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
         for (unsigned int l = 0; l < 6; l++)
-            h_virial.data[l * this->m_virial_pitch + mem_idx] += viriali[l];
+            virial[l * virial_pitch + mem_idx] += viriali[l];
         }
+    } // end omp parallel
+
+    // sum up the per-thread contributions
+    if (use_partial)
+        this->reduceThreadPartial(h_force.data, h_virial.data, n_threads, true);
+
 
     if (this->m_prof) this->m_prof->pop();
     }
@@ -132,6 +132,9 @@ class PotentialPairGPU : public PotentialPair<evaluator>
             m_precompute = false;
             m_has_been_precomputed = true;
             }
+
+        //! The GPU overlaps the force computation with communication in preCompute() instead
+        virtual void preComputeInterior(unsigned int timestep) { }
         #endif
 
     protected:
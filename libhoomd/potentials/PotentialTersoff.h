@@ -332,7 +332,8 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
-    Index2D nli = m_nlist->getNListIndexer();
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+    const unsigned int nlist_stride = m_nlist->getNListStride();
 
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
@@ -364,10 +365,11 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
 
         // loop over all of the neighbors of this particle
         const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        const unsigned int head_i = h_head_list.data[i];
         for (unsigned int j = 0; j < size; j++)
             {
             // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-            unsigned int jj = h_nlist.data[nli(i, j)];
+            unsigned int jj = h_nlist.data[head_i + j*nlist_stride];
             assert(jj < m_pdata->getN());
 
             // access the position and type of particle j
@@ -406,7 +408,7 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                 for (unsigned int k = 0; k < size; k++)
                     {
                     // access the index of neighbor k
-                    unsigned int kk = h_nlist.data[nli(i,k)];
+                    unsigned int kk = h_nlist.data[head_i + k*nlist_stride];
                     assert(kk < m_pdata->getN());
 
                     // access the position and type of neighbor k
@@ -464,7 +466,7 @@ void PotentialTersoff< evaluator >::computeForces(unsigned int timestep)
                 for (unsigned int k = 0; k < size; k++)
                     {
                     // access the index of neighbor k
-                    unsigned int kk = h_nlist.data[nli(i, k)];
+                    unsigned int kk = h_nlist.data[head_i + k*nlist_stride];
                     assert(kk < m_pdata->getN());
 
                     // access the position and type of neighbor k
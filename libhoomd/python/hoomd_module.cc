@@ -68,6 +68,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Initializers.h"
 #include "HOOMDInitializer.h"
 #include "HOOMDBinaryInitializer.h"
+#include "HOOMDTrajectoryReader.h"
 #include "RandomGenerator.h"
 #include "Compute.h"
 #include "CellList.h"
@@ -95,6 +96,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "IMDInterface.h"
 #include "HOOMDDumpWriter.h"
 #include "HOOMDBinaryDumpWriter.h"
+#include "HOOMDTrajectoryWriter.h"
 #include "PDBDumpWriter.h"
 #include "MOL2DumpWriter.h"
 #include "DCDDumpWriter.h"
@@ -179,6 +181,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #include "DomainDecomposition.h"
+#include "LoadBalancer.h"
 
 #ifdef ENABLE_CUDA
 #include "CommunicatorGPU.h"
@@ -503,6 +506,7 @@ BOOST_PYTHON_MODULE(hoomd)
     export_SimpleCubicInitializer();
     export_HOOMDInitializer();
     export_HOOMDBinaryInitializer();
+    export_HOOMDTrajectoryReader();
     export_RandomGenerator();
 
     // computes
@@ -588,6 +592,7 @@ BOOST_PYTHON_MODULE(hoomd)
     export_IMDInterface();
     export_HOOMDDumpWriter();
     export_HOOMDBinaryDumpWriter();
+    export_HOOMDTrajectoryWriter();
     export_PDBDumpWriter();
     export_DCDDumpWriter();
     export_MOL2DumpWriter();
@@ -639,6 +644,7 @@ BOOST_PYTHON_MODULE(hoomd)
 #ifdef ENABLE_MPI
     export_Communicator();
     export_DomainDecomposition();
+    export_LoadBalancer();
 #ifdef ENABLE_CUDA
     export_CommunicatorGPU();
 #endif // ENABLE_CUDA
@@ -60,6 +60,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "System.h"
 #include "SignalHandler.h"
+#include "AsyncWriter.h"
 
 #include <boost/python.hpp>
 using namespace boost::python;
@@ -555,6 +556,9 @@ void System::run(unsigned int nsteps, unsigned int cb_frequency,
                 return;
                 }
             }
+
+        // finish the files that analyzers have handed to the background writer
+        AsyncWriter::flushShared();
         } // end try
     catch (std::exception const & ex)
         {
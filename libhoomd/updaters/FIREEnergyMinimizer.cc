@@ -60,6 +60,10 @@ using namespace boost::python;
 #include "FIREEnergyMinimizer.h"
 #include "TwoStepNVE.h"
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
 // windows feels the need to #define min and max
 #ifdef WIN32
 #undef min
@@ -220,12 +224,15 @@ void FIREEnergyMinimizer::update(unsigned int timesteps)
     if (m_converged)
         return;
 
-    unsigned int group_size = m_group->getNumMembers();
-    if (group_size == 0)
+    // the global group size decides, so that all ranks take part in the reductions below
+    unsigned int group_size_global = m_group->getNumMembersGlobal();
+    if (group_size_global == 0)
         return;
 
     IntegratorTwoStep::update(timesteps);
 
+    unsigned int group_size = m_group->getNumMembers();
+
     Scalar P(0.0);
     Scalar vnorm(0.0);
     Scalar fnorm(0.0);
@@ -244,7 +251,13 @@ void FIREEnergyMinimizer::update(unsigned int timesteps)
         unsigned int j = m_group->getMemberIndex(group_idx);
         pe_total += (double)h_net_force.data[j].w;
         }
-    energy = pe_total/Scalar(group_size);
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &pe_total, 1, MPI_DOUBLE, MPI_SUM, m_exec_conf->getMPICommunicator());
+    #endif
+
+    energy = pe_total/Scalar(group_size_global);
     }
 
 
@@ -265,10 +278,22 @@ void FIREEnergyMinimizer::update(unsigned int timesteps)
         vnorm += h_vel.data[j].x*h_vel.data[j].x+ h_vel.data[j].y*h_vel.data[j].y + h_vel.data[j].z*h_vel.data[j].z;
         }
 
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        // sum the power and the squared norms over all ranks
+        Scalar sums[3] = {P, fnorm, vnorm};
+        MPI_Allreduce(MPI_IN_PLACE, sums, 3, MPI_HOOMD_SCALAR, MPI_SUM, m_exec_conf->getMPICommunicator());
+        P = sums[0];
+        fnorm = sums[1];
+        vnorm = sums[2];
+        }
+    #endif
+
     fnorm = sqrt(fnorm);
     vnorm = sqrt(vnorm);
 
-    if ((fnorm/sqrt(Scalar(m_sysdef->getNDimensions()*group_size)) < m_ftol && fabs(energy-m_old_energy) < m_etol) && m_n_since_start >= m_run_minsteps)
+    if ((fnorm/sqrt(Scalar(m_sysdef->getNDimensions()*group_size_global)) < m_ftol && fabs(energy-m_old_energy) < m_etol) && m_n_since_start >= m_run_minsteps)
         {
         m_converged = true;
         return;
@@ -60,6 +60,10 @@ using namespace boost::python;
 #include "FIREEnergyMinimizerRigid.h"
 #include "TwoStepNVERigid.h"
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
 /*! \file FIREEnergyMinimizerRigid.h
     \brief Contains code for the FIREEnergyMinimizerRigid class
 */
@@ -151,12 +155,14 @@ void FIREEnergyMinimizerRigid::update(unsigned int timestep)
     if (m_converged)
         return;
 
-    unsigned int group_size = m_group->getNumMembers();
-    if (group_size == 0)
+    unsigned int group_size_global = m_group->getNumMembersGlobal();
+    if (group_size_global == 0)
         return;
 
     IntegratorTwoStep::update(timestep);
 
+    unsigned int group_size = m_group->getNumMembers();
+
     if (timestep % m_nevery != 0)
         return;
 
@@ -185,7 +191,13 @@ void FIREEnergyMinimizerRigid::update(unsigned int timestep)
         unsigned int j = m_group->getMemberIndex(group_idx);
         pe_total += (double)h_net_force.data[j].w;
         }
-    energy = pe_total/Scalar(group_size);
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &pe_total, 1, MPI_DOUBLE, MPI_SUM, m_exec_conf->getMPICommunicator());
+    #endif
+
+    energy = pe_total/Scalar(group_size_global);
     }
 
     if (m_was_reset)
@@ -202,6 +214,7 @@ void FIREEnergyMinimizerRigid::update(unsigned int timestep)
     ArrayHandle<Scalar4> torque_handle(m_rigid_data->getTorque(), access_location::host, access_mode::read);
 
     // Calculates the powers
+    // the body data is replicated on all ranks, so these sums need no reduction
     for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
         {
         unsigned int body = m_body_group->getMemberIndex(group_idx);
@@ -233,7 +246,9 @@ void FIREEnergyMinimizerRigid::update(unsigned int timestep)
 
     if ((fnorm/sqrt(m_sysdef->getNDimensions() * m_n_bodies) < m_ftol && wnorm/sqrt(m_sysdef->getNDimensions() * m_n_bodies) < m_wtol  && fabs(energy-m_old_energy) < m_etol) && m_n_since_start >= m_run_minsteps)
         {
-        printf("Converged: f = %g (ftol = %g); w= %g (wtol = %g); e = %g (etol = %g)\n", fnorm/sqrt(m_sysdef->getNDimensions() * m_n_bodies), m_ftol, wnorm/sqrt(m_sysdef->getNDimensions() * m_n_bodies), m_wtol, fabs(energy-m_old_energy), m_etol);
+        m_exec_conf->msg->notice(2) << "Converged: f = " << fnorm/sqrt(m_sysdef->getNDimensions() * m_n_bodies) << " (ftol = " << m_ftol
+                                    << "); w= " << wnorm/sqrt(m_sysdef->getNDimensions() * m_n_bodies) << " (wtol = " << m_wtol
+                                    << "); e = " << fabs(energy-m_old_energy) << " (etol = " << m_etol << ")" << endl;
         m_converged = true;
         return;
         }
@@ -78,7 +78,8 @@ using namespace std;
 /*! \param sysdef System to update
     \param deltaT Time step to use
 */
-Integrator::Integrator(boost::shared_ptr<SystemDefinition> sysdef, Scalar deltaT) : Updater(sysdef), m_deltaT(deltaT)
+Integrator::Integrator(boost::shared_ptr<SystemDefinition> sysdef, Scalar deltaT)
+    : Updater(sysdef), m_deltaT(deltaT), m_reduced_virial(false)
     {
     if (m_deltaT <= 0.0)
         m_exec_conf->msg->warning() << "integrate.*: A timestep of less than 0.0 was specified" << endl;
@@ -92,6 +93,8 @@ Integrator::~Integrator()
         m_request_flags_connection.disconnect();
     if (m_callback_connection.connected())
         m_callback_connection.disconnect();
+    if (m_interior_callback_connection.connected())
+        m_interior_callback_connection.disconnect();
     #endif
     }
 
@@ -101,9 +104,84 @@ void Integrator::addForceCompute(boost::shared_ptr<ForceCompute> fc)
     {
     assert(fc);
     m_forces.push_back(fc);
+    m_force_periods.push_back(1);
     fc->setDeltaT(m_deltaT);
     }
 
+/*! \param fc ForceCompute to set the period of. It must already have been added with addForceCompute()
+    \param period The force is evaluated on steps that are a multiple of \a period
+
+    The force compute is given the outer time step \a period*deltaT. See Integrator for a description of the
+    multiple time step scheme.
+*/
+void Integrator::setForcePeriod(boost::shared_ptr<ForceCompute> fc, unsigned int period)
+    {
+    if (period == 0)
+        {
+        m_exec_conf->msg->error() << "integrate.*: The period of a force must be at least 1" << endl;
+        throw runtime_error("Error setting force period");
+        }
+
+    for (unsigned int i = 0; i < m_forces.size(); i++)
+        {
+        if (m_forces[i] == fc)
+            {
+            m_force_periods[i] = period;
+            fc->setDeltaT(m_deltaT*Scalar(period));
+            return;
+            }
+        }
+
+    m_exec_conf->msg->error() << "integrate.*: Cannot set the period of a force that is not added to the integrator"
+                              << endl;
+    throw runtime_error("Error setting force period");
+    }
+
+/*! \param fc Force compute to add the virial of
+    \param virial Virial total (6 components) to add to
+
+    Adds the external virial of \a fc and, if it computed its virial in reduced virial mode, its virial summed over
+    all particles.
+*/
+void Integrator::addVirialTotals(boost::shared_ptr<ForceCompute> fc, Scalar *virial)
+    {
+    for (unsigned int k = 0; k < 6; k++)
+        virial[k] += fc->getExternalVirial(k);
+
+    if (fc->isVirialReduced())
+        for (unsigned int k = 0; k < 6; k++)
+            virial[k] += fc->getVirialTotal(k);
+    }
+
+/*! \returns The index in m_forces of the first force compute in accumulate mode that is evaluated every step, or -1
+
+    That force compute is computed directly into the net force arrays, which avoids summing it.
+*/
+int Integrator::findNetForceCompute() const
+    {
+    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force++)
+        if (m_forces[cur_force]->isAccumulating() && m_force_periods[cur_force] == 1)
+            return (int)cur_force;
+    return -1;
+    }
+
+/*! The scratch arrays are only allocated once a force compute in accumulate mode cannot be computed directly into the
+    net force, and are resized when the maximum number of particles changes.
+*/
+void Integrator::allocateScratchArrays()
+    {
+    unsigned int max_n = m_pdata->getMaxN();
+    if (m_scratch_force.getNumElements() == max_n)
+        return;
+
+    GPUArray<Scalar4> force(max_n, exec_conf);
+    GPUArray<Scalar> virial(max_n, 6, exec_conf);
+    GPUArray<Scalar4> torque(max_n, exec_conf);
+    m_scratch_force.swap(force);
+    m_scratch_virial.swap(virial);
+    m_scratch_torque.swap(torque);
+    }
+
 /*! \param fc ForceConstraint to add
 */
 void Integrator::addForceConstraint(boost::shared_ptr<ForceConstraint> fc)
@@ -119,6 +197,7 @@ void Integrator::addForceConstraint(boost::shared_ptr<ForceConstraint> fc)
 void Integrator::removeForceComputes()
     {
     m_forces.clear();
+    m_force_periods.clear();
     m_constraint_forces.clear();
     }
 
@@ -130,7 +209,7 @@ void Integrator::setDeltaT(Scalar deltaT)
         m_exec_conf->msg->warning() << "integrate.*: A timestep of less than 0.0 was specified" << endl;
 
     for (unsigned int i=0; i < m_forces.size(); i++)
-        m_forces[i]->setDeltaT(deltaT);
+        m_forces[i]->setDeltaT(deltaT*Scalar(m_force_periods[i]));
 
     for (unsigned int i=0; i < m_constraint_forces.size(); i++)
         m_constraint_forces[i]->setDeltaT(deltaT);
@@ -350,9 +429,10 @@ Scalar Integrator::computeTotalMomentum(unsigned int timestep)
 */
 void Integrator::computeNetForce(unsigned int timestep)
     {
-    std::vector< boost::shared_ptr<ForceCompute> >::iterator force_compute;
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+    // forces in accumulate mode are computed while summing the net force
+    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force++)
+        if (isForceActive(cur_force, timestep) && !m_forces[cur_force]->isAccumulating())
+            m_forces[cur_force]->compute(timestep);
 
     if (m_prof)
         {
@@ -360,20 +440,31 @@ void Integrator::computeNetForce(unsigned int timestep)
         m_prof->push("Net force");
         }
 
-    Scalar external_virial[6];
+    // access the net force and virial arrays
+    const GPUArray<Scalar4>& net_force  = m_pdata->getNetForce();
+    const GPUArray<Scalar>&  net_virial = m_pdata->getNetVirial();
+    const GPUArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
+
         {
-        // access the net force and virial arrays
-        const GPUArray<Scalar4>& net_force  = m_pdata->getNetForce();
-        const GPUArray<Scalar>&  net_virial = m_pdata->getNetVirial();
-        const GPUArray<Scalar4>& net_torque = m_pdata->getNetTorqueArray();
+        // start by zeroing the net force and virial arrays
         ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::overwrite);
         ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::overwrite);
         ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, access_mode::overwrite);
-
-        // start by zeroing the net force and virial arrays
         memset((void *)h_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
         memset((void *)h_net_virial.data, 0, sizeof(Scalar)*net_virial.getNumElements());
         memset((void *)h_net_torque.data, 0, sizeof(Scalar4)*net_torque.getNumElements());
+        }
+
+    // the first force in accumulate mode writes the net force directly
+    int net_force_compute = findNetForceCompute();
+    if (net_force_compute >= 0)
+        m_forces[net_force_compute]->computeInto(timestep, net_force, net_virial, net_torque);
+
+    Scalar external_virial[6];
+        {
+        ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_net_torque(net_torque, access_location::host, access_mode::readwrite);
 
         for (unsigned int i = 0; i < 6; ++i)
            external_virial[i] = Scalar(0.0);
@@ -385,39 +476,70 @@ void Integrator::computeNetForce(unsigned int timestep)
         assert(6*nparticles <= net_virial.getNumElements());
         assert(nparticles <= net_torque.getNumElements());
 
-        for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
+        for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force++)
             {
-            //phasing out ForceDataArrays
-            //ForceDataArrays force_arrays = (*force_compute)->acquire();
-            GPUArray<Scalar4>& h_force_array = (*force_compute)->getForceArray();
-            GPUArray<Scalar>& h_virial_array = (*force_compute)->getVirialArray();
-            GPUArray<Scalar4>& h_torque_array = (*force_compute)->getTorqueArray();
+            // forces on an outer level are skipped between evaluations and applied as an impulse when evaluated
+            if (!isForceActive(cur_force, timestep))
+                continue;
+            boost::shared_ptr<ForceCompute> force_compute = m_forces[cur_force];
+            Scalar scale = Scalar(m_force_periods[cur_force]);
+
+            // already in the net force
+            if ((int)cur_force == net_force_compute)
+                {
+                addVirialTotals(force_compute, external_virial);
+                continue;
+                }
+
+            // other forces in accumulate mode are computed into the scratch arrays
+            bool accumulate = force_compute->isAccumulating();
+            if (accumulate)
+                {
+                allocateScratchArrays();
+                    {
+                    ArrayHandle<Scalar4> h_force(m_scratch_force, access_location::host, access_mode::overwrite);
+                    ArrayHandle<Scalar> h_virial(m_scratch_virial, access_location::host, access_mode::overwrite);
+                    ArrayHandle<Scalar4> h_torque(m_scratch_torque, access_location::host, access_mode::overwrite);
+                    memset((void *)h_force.data, 0, sizeof(Scalar4)*m_scratch_force.getNumElements());
+                    memset((void *)h_virial.data, 0, sizeof(Scalar)*m_scratch_virial.getNumElements());
+                    memset((void *)h_torque.data, 0, sizeof(Scalar4)*m_scratch_torque.getNumElements());
+                    }
+                force_compute->computeInto(timestep, m_scratch_force, m_scratch_virial, m_scratch_torque);
+                }
+
+            GPUArray<Scalar4>& h_force_array = accumulate ? m_scratch_force : force_compute->getForceArray();
+            GPUArray<Scalar>& h_virial_array = accumulate ? m_scratch_virial : force_compute->getVirialArray();
+            GPUArray<Scalar4>& h_torque_array = accumulate ? m_scratch_torque : force_compute->getTorqueArray();
 
             ArrayHandle<Scalar4> h_force(h_force_array,access_location::host,access_mode::read);
             ArrayHandle<Scalar> h_virial(h_virial_array,access_location::host,access_mode::read);
             ArrayHandle<Scalar4> h_torque(h_torque_array,access_location::host,access_mode::read);
 
+            // a force in reduced virial mode has only summed up its virial
+            addVirialTotals(force_compute, external_virial);
+            bool sum_virial = !force_compute->isVirialReduced();
+
             unsigned int virial_pitch = h_virial_array.getPitch();
             for (unsigned int j = 0; j < nparticles; j++)
                 {
-                h_net_force.data[j].x += h_force.data[j].x;
-                h_net_force.data[j].y += h_force.data[j].y;
-                h_net_force.data[j].z += h_force.data[j].z;
+                h_net_force.data[j].x += scale*h_force.data[j].x;
+                h_net_force.data[j].y += scale*h_force.data[j].y;
+                h_net_force.data[j].z += scale*h_force.data[j].z;
                 h_net_force.data[j].w += h_force.data[j].w;
 
-                h_net_torque.data[j].x += h_torque.data[j].x;
-                h_net_torque.data[j].y += h_torque.data[j].y;
-                h_net_torque.data[j].z += h_torque.data[j].z;
+                h_net_torque.data[j].x += scale*h_torque.data[j].x;
+                h_net_torque.data[j].y += scale*h_torque.data[j].y;
+                h_net_torque.data[j].z += scale*h_torque.data[j].z;
                 h_net_torque.data[j].w += h_torque.data[j].w;
 
-                for (unsigned int k = 0; k < 6; k++)
+                if (sum_virial)
                     {
-                    h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
+                    for (unsigned int k = 0; k < 6; k++)
+                        {
+                        h_net_virial.data[k*net_virial_pitch+j] += h_virial.data[k*virial_pitch+j];
+                        }
                     }
                 }
-
-            for (unsigned int k = 0; k < 6; k++)
-                external_virial[k] += (*force_compute)->getExternalVirial(k);
             }
         }
 
@@ -506,11 +628,30 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         throw runtime_error("Error computing accelerations");
         }
 
-    // compute all the normal forces first
-    std::vector< boost::shared_ptr<ForceCompute> >::iterator force_compute;
+    // compute all the normal forces first, skipping forces on an outer level between their evaluations
+    // forces in accumulate mode are computed while summing the net force
+    std::vector< boost::shared_ptr<ForceCompute> > active_forces;
+    std::vector< Scalar > active_scales;
+    std::vector< boost::shared_ptr<ForceCompute> > accumulated_forces;
+    std::vector< Scalar > accumulated_scales;
+    int net_force_compute = findNetForceCompute();
+    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force++)
+        {
+        if (!isForceActive(cur_force, timestep) || (int)cur_force == net_force_compute)
+            continue;
 
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->compute(timestep);
+        if (m_forces[cur_force]->isAccumulating())
+            {
+            accumulated_forces.push_back(m_forces[cur_force]);
+            accumulated_scales.push_back(Scalar(m_force_periods[cur_force]));
+            }
+        else
+            {
+            m_forces[cur_force]->compute(timestep);
+            active_forces.push_back(m_forces[cur_force]);
+            active_scales.push_back(Scalar(m_force_periods[cur_force]));
+            }
+        }
 
     if (m_prof)
         {
@@ -518,17 +659,36 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         m_prof->push(exec_conf, "Net force");
         }
 
+    // access the net force and virial arrays
+    const GPUArray< Scalar4 >& net_force  = m_pdata->getNetForce();
+    const GPUArray< Scalar4 >& net_torque = m_pdata->getNetTorqueArray();
+    const GPUArray< Scalar >&  net_virial = m_pdata->getNetVirial();
+
+    // the first force in accumulate mode writes the net force directly
+    if (net_force_compute >= 0)
+        {
+            {
+            ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::overwrite);
+            ArrayHandle<Scalar>  d_net_virial(net_virial, access_location::device, access_mode::overwrite);
+            ArrayHandle<Scalar4> d_net_torque(net_torque, access_location::device, access_mode::overwrite);
+            cudaMemset(d_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
+            cudaMemset(d_net_torque.data, 0, sizeof(Scalar4)*net_torque.getNumElements());
+            cudaMemset(d_net_virial.data, 0, sizeof(Scalar)*net_virial.getNumElements());
+            if (exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        m_forces[net_force_compute]->computeInto(timestep, net_force, net_virial, net_torque);
+        }
+
     Scalar external_virial[6];
         {
-        // access the net force and virial arrays
-        const GPUArray< Scalar4 >& net_force  = m_pdata->getNetForce();
-        const GPUArray< Scalar4 >& net_torque = m_pdata->getNetTorqueArray();
-        const GPUArray< Scalar >&  net_virial = m_pdata->getNetVirial();
         unsigned int net_virial_pitch = net_virial.getPitch();
 
-        ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::overwrite);
-        ArrayHandle<Scalar>  d_net_virial(net_virial, access_location::device, access_mode::overwrite);
-        ArrayHandle<Scalar4> d_net_torque(net_torque, access_location::device, access_mode::overwrite);
+        // the net force is only read in if it already holds a force in accumulate mode
+        access_mode::Enum net_mode = (net_force_compute >= 0) ? access_mode::readwrite : access_mode::overwrite;
+        ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, net_mode);
+        ArrayHandle<Scalar>  d_net_virial(net_virial, access_location::device, net_mode);
+        ArrayHandle<Scalar4> d_net_torque(net_torque, access_location::device, net_mode);
 
         unsigned int nparticles = m_pdata->getN();
         assert(nparticles <= net_force.getNumElements());
@@ -542,7 +702,7 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         // there is no need to zero out the initial net force and virial here, the first call to the addition kernel
         // will do that
         // ahh!, but we do need to zer out the net force and virial if there are 0 forces!
-        if (m_forces.size() == 0)
+        if (active_forces.size() == 0 && net_force_compute < 0)
             {
             // start by zeroing the net force and virial arrays
             cudaMemset(d_net_force.data, 0, sizeof(Scalar4)*net_force.getNumElements());
@@ -555,90 +715,96 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
         // now, add up the accelerations
         // sum all the forces into the net force
         // perform the sum in groups of 6 to avoid kernel launch and memory access overheads
-        for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force += 6)
+        for (unsigned int cur_force = 0; cur_force < active_forces.size(); cur_force += 6)
             {
             // grab the device pointers for the current set
             gpu_force_list force_list;
 
-            const GPUArray<Scalar4>& d_force_array0 = m_forces[cur_force]->getForceArray();
+            const GPUArray<Scalar4>& d_force_array0 = active_forces[cur_force]->getForceArray();
             ArrayHandle<Scalar4> d_force0(d_force_array0,access_location::device,access_mode::read);
-            const GPUArray<Scalar>& d_virial_array0 = m_forces[cur_force]->getVirialArray();
+            const GPUArray<Scalar>& d_virial_array0 = active_forces[cur_force]->getVirialArray();
             ArrayHandle<Scalar> d_virial0(d_virial_array0,access_location::device,access_mode::read);
-            const GPUArray<Scalar4>& d_torque_array0 = m_forces[cur_force]->getTorqueArray();
+            const GPUArray<Scalar4>& d_torque_array0 = active_forces[cur_force]->getTorqueArray();
             ArrayHandle<Scalar4> d_torque0(d_torque_array0,access_location::device,access_mode::read);
             force_list.f0 = d_force0.data;
-            force_list.v0 = d_virial0.data;
+            force_list.v0 = active_forces[cur_force]->isVirialReduced() ? NULL : d_virial0.data;
             force_list.vpitch0 = d_virial_array0.getPitch();
             force_list.t0 = d_torque0.data;
+            force_list.s0 = active_scales[cur_force];
 
-            if (cur_force+1 < m_forces.size())
+            if (cur_force+1 < active_forces.size())
                 {
-                const GPUArray<Scalar4>& d_force_array1 = m_forces[cur_force+1]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array1 = active_forces[cur_force+1]->getForceArray();
                 ArrayHandle<Scalar4> d_force1(d_force_array1,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array1 = m_forces[cur_force+1]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array1 = active_forces[cur_force+1]->getVirialArray();
                 ArrayHandle<Scalar> d_virial1(d_virial_array1,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array1 = m_forces[cur_force+1]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array1 = active_forces[cur_force+1]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque1(d_torque_array1,access_location::device,access_mode::read);
                 force_list.f1 = d_force1.data;
-                force_list.v1 = d_virial1.data;
+                force_list.v1 = active_forces[cur_force+1]->isVirialReduced() ? NULL : d_virial1.data;
                 force_list.vpitch1 = d_virial_array1.getPitch();
                 force_list.t1 = d_torque1.data;
+                force_list.s1 = active_scales[cur_force+1];
                 }
-            if (cur_force+2 < m_forces.size())
+            if (cur_force+2 < active_forces.size())
                 {
-                const GPUArray<Scalar4>& d_force_array2 = m_forces[cur_force+2]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array2 = active_forces[cur_force+2]->getForceArray();
                 ArrayHandle<Scalar4> d_force2(d_force_array2,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array2 = m_forces[cur_force+2]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array2 = active_forces[cur_force+2]->getVirialArray();
                 ArrayHandle<Scalar> d_virial2(d_virial_array2,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array2 = m_forces[cur_force+2]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array2 = active_forces[cur_force+2]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque2(d_torque_array2,access_location::device,access_mode::read);
                 force_list.f2 = d_force2.data;
-                force_list.v2 = d_virial2.data;
+                force_list.v2 = active_forces[cur_force+2]->isVirialReduced() ? NULL : d_virial2.data;
                 force_list.vpitch2 = d_virial_array2.getPitch();
                 force_list.t2 = d_torque2.data;
+                force_list.s2 = active_scales[cur_force+2];
                 }
-            if (cur_force+3 < m_forces.size())
+            if (cur_force+3 < active_forces.size())
                 {
-                const GPUArray<Scalar4>& d_force_array3 = m_forces[cur_force+3]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array3 = active_forces[cur_force+3]->getForceArray();
                 ArrayHandle<Scalar4> d_force3(d_force_array3,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array3 = m_forces[cur_force+3]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array3 = active_forces[cur_force+3]->getVirialArray();
                 ArrayHandle<Scalar> d_virial3(d_virial_array3,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array3 = m_forces[cur_force+3]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array3 = active_forces[cur_force+3]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque3(d_torque_array3,access_location::device,access_mode::read);
                 force_list.f3 = d_force3.data;
-                force_list.v3 = d_virial3.data;
+                force_list.v3 = active_forces[cur_force+3]->isVirialReduced() ? NULL : d_virial3.data;
                 force_list.vpitch3 = d_virial_array3.getPitch();
                 force_list.t3 = d_torque3.data;
+                force_list.s3 = active_scales[cur_force+3];
                 }
-            if (cur_force+4 < m_forces.size())
+            if (cur_force+4 < active_forces.size())
                 {
-                const GPUArray<Scalar4>& d_force_array4 = m_forces[cur_force+4]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array4 = active_forces[cur_force+4]->getForceArray();
                 ArrayHandle<Scalar4> d_force4(d_force_array4,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array4 = m_forces[cur_force+4]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array4 = active_forces[cur_force+4]->getVirialArray();
                 ArrayHandle<Scalar> d_virial4(d_virial_array4,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array4 = m_forces[cur_force+4]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array4 = active_forces[cur_force+4]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque4(d_torque_array4,access_location::device,access_mode::read);
                 force_list.f4 = d_force4.data;
-                force_list.v4 = d_virial4.data;
+                force_list.v4 = active_forces[cur_force+4]->isVirialReduced() ? NULL : d_virial4.data;
                 force_list.vpitch4 = d_virial_array4.getPitch();
                 force_list.t4 = d_torque4.data;
+                force_list.s4 = active_scales[cur_force+4];
                 }
-            if (cur_force+5 < m_forces.size())
+            if (cur_force+5 < active_forces.size())
                 {
-                const GPUArray<Scalar4>& d_force_array5 = m_forces[cur_force+5]->getForceArray();
+                const GPUArray<Scalar4>& d_force_array5 = active_forces[cur_force+5]->getForceArray();
                 ArrayHandle<Scalar4> d_force5(d_force_array5,access_location::device,access_mode::read);
-                const GPUArray<Scalar>& d_virial_array5 = m_forces[cur_force+5]->getVirialArray();
+                const GPUArray<Scalar>& d_virial_array5 = active_forces[cur_force+5]->getVirialArray();
                 ArrayHandle<Scalar> d_virial5(d_virial_array5,access_location::device,access_mode::read);
-                const GPUArray<Scalar4>& d_torque_array5 = m_forces[cur_force+5]->getTorqueArray();
+                const GPUArray<Scalar4>& d_torque_array5 = active_forces[cur_force+5]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque5(d_torque_array5,access_location::device,access_mode::read);
                 force_list.f5 = d_force5.data;
-                force_list.v5 = d_virial5.data;
+                force_list.v5 = active_forces[cur_force+5]->isVirialReduced() ? NULL : d_virial5.data;
                 force_list.vpitch5 = d_virial_array5.getPitch();
                 force_list.t5 = d_torque5.data;
+                force_list.s5 = active_scales[cur_force+5];
                 }
 
-            // clear on the first iteration only
-            bool clear = (cur_force == 0);
+            // clear on the first iteration only, unless the net force already holds a force in accumulate mode
+            bool clear = (cur_force == 0 && net_force_compute < 0);
 
             // access flags
             PDataFlags flags = this->m_pdata->getFlags();
@@ -655,12 +821,55 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
             if (exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
             }
+
+        // the remaining forces in accumulate mode are computed into the scratch arrays one at a time
+        for (unsigned int cur_force = 0; cur_force < accumulated_forces.size(); cur_force++)
+            {
+            allocateScratchArrays();
+                {
+                ArrayHandle<Scalar4> d_force(m_scratch_force, access_location::device, access_mode::overwrite);
+                ArrayHandle<Scalar> d_virial(m_scratch_virial, access_location::device, access_mode::overwrite);
+                ArrayHandle<Scalar4> d_torque(m_scratch_torque, access_location::device, access_mode::overwrite);
+                cudaMemset(d_force.data, 0, sizeof(Scalar4)*m_scratch_force.getNumElements());
+                cudaMemset(d_virial.data, 0, sizeof(Scalar)*m_scratch_virial.getNumElements());
+                cudaMemset(d_torque.data, 0, sizeof(Scalar4)*m_scratch_torque.getNumElements());
+                }
+            accumulated_forces[cur_force]->computeInto(timestep, m_scratch_force, m_scratch_virial, m_scratch_torque);
+
+            ArrayHandle<Scalar4> d_force(m_scratch_force, access_location::device, access_mode::read);
+            ArrayHandle<Scalar> d_virial(m_scratch_virial, access_location::device, access_mode::read);
+            ArrayHandle<Scalar4> d_torque(m_scratch_torque, access_location::device, access_mode::read);
+
+            gpu_force_list force_list;
+            force_list.f0 = d_force.data;
+            force_list.v0 = accumulated_forces[cur_force]->isVirialReduced() ? NULL : d_virial.data;
+            force_list.vpitch0 = m_scratch_virial.getPitch();
+            force_list.t0 = d_torque.data;
+            force_list.s0 = accumulated_scales[cur_force];
+
+            PDataFlags flags = this->m_pdata->getFlags();
+
+            gpu_integrator_sum_net_force(d_net_force.data,
+                                         d_net_virial.data,
+                                         net_virial_pitch,
+                                         d_net_torque.data,
+                                         force_list,
+                                         nparticles,
+                                         false,
+                                         flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial]);
+
+            if (exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
         }
 
     // add up external virials
-    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force ++)
-        for (unsigned int k = 0; k < 6; k++)
-            external_virial[k] += m_forces[cur_force]->getExternalVirial(k);
+    for (unsigned int cur_force = 0; cur_force < active_forces.size(); cur_force ++)
+        addVirialTotals(active_forces[cur_force], external_virial);
+    for (unsigned int cur_force = 0; cur_force < accumulated_forces.size(); cur_force ++)
+        addVirialTotals(accumulated_forces[cur_force], external_virial);
+    if (net_force_compute >= 0)
+        addVirialTotals(m_forces[net_force_compute], external_virial);
 
     for (unsigned int k = 0; k < 6; k++)
         m_pdata->setExternalVirial(k, external_virial[k]);
@@ -785,7 +994,7 @@ void Integrator::computeNetForceGPU(unsigned int timestep)
                 }
 
             // clear only on the first iteration AND if there are zero forces
-            bool clear = (cur_force == 0) && (m_forces.size() == 0);
+            bool clear = (cur_force == 0) && (active_forces.size() == 0);
 
             // access flags
             PDataFlags flags = this->m_pdata->getFlags();
@@ -876,21 +1085,32 @@ void Integrator::setCommunicator(boost::shared_ptr<Communicator> comm)
 
     if (! m_callback_connection.connected() && m_comm)
         m_callback_connection = comm->addComputeCallback(bind(&Integrator::computeCallback, this, _1));
+
+    if (! m_interior_callback_connection.connected() && m_comm)
+        m_interior_callback_connection = comm->addInteriorComputeCallback(
+            bind(&Integrator::computeInteriorCallback, this, _1));
     }
 
 void Integrator::computeCallback(unsigned int timestep)
     {
-    // pre-compute all active forces
-    std::vector< boost::shared_ptr<ForceCompute> >::iterator force_compute;
-
-    for (force_compute = m_forces.begin(); force_compute != m_forces.end(); ++force_compute)
-        (*force_compute)->preCompute(timestep);
+    // pre-compute all active forces, forces in accumulate mode have no arrays to pre-compute into
+    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force++)
+        if (isForceActive(cur_force, timestep) && !m_forces[cur_force]->isAccumulating())
+            m_forces[cur_force]->preCompute(timestep);
 
     // pre-compute all active constraint forces
     std::vector< boost::shared_ptr<ForceConstraint> >::iterator force_constraint;
     for (force_constraint = m_constraint_forces.begin(); force_constraint != m_constraint_forces.end(); ++force_constraint)
         (*force_constraint)->preCompute(timestep);
     }
+
+void Integrator::computeInteriorCallback(unsigned int timestep)
+    {
+    // pre-compute the forces on particles without ghost neighbors, while the ghosts are being updated
+    for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force++)
+        if (isForceActive(cur_force, timestep) && !m_forces[cur_force]->isAccumulating())
+            m_forces[cur_force]->preComputeInterior(timestep);
+    }
 #endif
 
 void export_Integrator()
@@ -898,6 +1118,8 @@ void export_Integrator()
     class_<Integrator, boost::shared_ptr<Integrator>, bases<Updater>, boost::noncopyable>
     ("Integrator", init< boost::shared_ptr<SystemDefinition>, Scalar >())
     .def("addForceCompute", &Integrator::addForceCompute)
+    .def("setForcePeriod", &Integrator::setForcePeriod)
+    .def("setReducedVirial", &Integrator::setReducedVirial)
     .def("addForceConstraint", &Integrator::addForceConstraint)
     .def("removeForceComputes", &Integrator::removeForceComputes)
     .def("setDeltaT", &Integrator::setDeltaT)
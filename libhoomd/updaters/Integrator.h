@@ -93,6 +93,21 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     via the constraint forces can be totaled up with a call to getNDOFRemoved for convenience in derived classes
     implementing correct counting in getNDOF().
 
+    Forces may be evaluated less often than every step with setForcePeriod(), which implements the impulse form of the
+    multiple time step r-RESPA method (Tuckerman, Berne and Martyna 1992). A force with period \a k is only computed on
+    steps that are a multiple of \a k, and on those steps its force and torque enter the net force multiplied by \a k.
+    The two half-step kicks that bracket such a step then sum to the impulse \a k*deltaT*F of the outer step, while the
+    forces with period 1 are integrated with the inner step deltaT. Nesting periods (i.e. bonds every step, short
+    ranged pair forces every 2 steps and PPPM every 4) gives multilevel r-RESPA. The energy and virial of a force are
+    not scaled and only appear in the net force on steps where it is computed, so thermodynamic quantities are complete
+    on steps that are a multiple of all the periods.
+
+    Force computes in accumulate mode (ForceCompute::setAccumulate()) do not keep their own force arrays. The first of
+    them that is evaluated every step is computed directly into the net force, virial and torque arrays of the
+    ParticleData. Any further ones are computed one after the other into a single set of scratch arrays owned by the
+    Integrator and added to the net force from there. Forces and constraint forces that keep their own arrays are
+    summed as usual.
+
     Integrators take "ownership" of the particle's accellerations. Any other updater
     that modifies the particles accelerations will produce undefined results. If
     accelerations are to be modified, they must be done through forces, and added to
@@ -121,6 +136,20 @@ class Integrator : public Updater
         //! Add a ForceCompute to the list
         virtual void addForceCompute(boost::shared_ptr<ForceCompute> fc);
 
+        //! Set the number of steps between evaluations of a ForceCompute
+        void setForcePeriod(boost::shared_ptr<ForceCompute> fc, unsigned int period);
+
+        //! Allow the forces to only sum up their virial over all particles
+        /*! \param reduced_virial Set to true to sum the virial of supporting computes over all particles only
+
+            Integrators that support it enable ParticleData::setReducedVirial() in prepRun(). The per-particle virial
+            is incomplete in this mode, so ComputeThermo only reports the pressure of the group of all particles.
+        */
+        void setReducedVirial(bool reduced_virial)
+            {
+            m_reduced_virial = reduced_virial;
+            }
+
         //! Add a ForceConstraint to the list
         virtual void addForceConstraint(boost::shared_ptr<ForceConstraint> fc);
 
@@ -165,14 +194,41 @@ class Integrator : public Updater
 
         //! Callback for pre-computing the forces
         void computeCallback(unsigned int timestep);
+
+        //! Callback for pre-computing the forces that do not depend on ghosts
+        void computeInteriorCallback(unsigned int timestep);
         #endif
 
     protected:
         Scalar m_deltaT;                                            //!< The time step
         std::vector< boost::shared_ptr<ForceCompute> > m_forces;    //!< List of all the force computes
+        std::vector< unsigned int > m_force_periods;                //!< Steps between evaluations of each force compute
+        bool m_reduced_virial;                                      //!< True if the virial may be summed over all particles only
 
         std::vector< boost::shared_ptr<ForceConstraint> > m_constraint_forces;    //!< List of all the constraints
 
+        GPUArray<Scalar4> m_scratch_force;      //!< Force array for force computes in accumulate mode
+        GPUArray<Scalar> m_scratch_virial;      //!< Virial array for force computes in accumulate mode
+        GPUArray<Scalar4> m_scratch_torque;     //!< Torque array for force computes in accumulate mode
+
+        //! Test if a force compute is evaluated on the given step
+        /*! \param i Index of the force compute in m_forces
+            \param timestep Time step to test
+        */
+        bool isForceActive(unsigned int i, unsigned int timestep) const
+            {
+            return timestep % m_force_periods[i] == 0;
+            }
+
+        //! Add the external virial and virial total of a force compute
+        void addVirialTotals(boost::shared_ptr<ForceCompute> fc, Scalar *virial);
+
+        //! Find the force compute that is computed directly into the net force
+        int findNetForceCompute() const;
+
+        //! Allocate the scratch arrays for force computes in accumulate mode
+        void allocateScratchArrays();
+
         //! helper function to compute initial accelerations
         void computeAccelerations(unsigned int timestep);
 
@@ -193,6 +249,7 @@ class Integrator : public Updater
         #ifdef ENABLE_MPI
         boost::signals2::connection m_request_flags_connection;     //!< Connection to Communicator to request communication flags
         boost::signals2::connection m_callback_connection;          //!< Connection to Commmunicator for compute callback
+        boost::signals2::connection m_interior_callback_connection; //!< Connection to Commmunicator for interior compute callback
         #endif
     };
 
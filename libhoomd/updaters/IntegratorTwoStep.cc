@@ -301,6 +301,9 @@ unsigned int IntegratorTwoStep::getNDOF(boost::shared_ptr<ParticleGroup> group)
 */
 void IntegratorTwoStep::prepRun(unsigned int timestep)
     {
+    // the rigid body virial correction needs the per-particle virial
+    m_pdata->setReducedVirial(m_reduced_virial && m_sysdef->getRigidData()->getNumBodies() == 0);
+
     // if we haven't been called before, then the net force and accelerations have not been set and we need to calculate them
     if (m_first_step)
         {
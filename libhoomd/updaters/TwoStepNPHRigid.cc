@@ -211,7 +211,7 @@ void TwoStepNPHRigid::setup()
 
     // initialize barostat parameters
 
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
     Scalar3 L = box.getL();
 
     Scalar vol;   // volume
@@ -264,6 +264,11 @@ void TwoStepNPHRigid::setup()
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         if (h_body.data[i] == NO_BODY) non_rigid_count++;
 
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &non_rigid_count, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+    #endif
+
     unsigned int rigid_dof = m_sysdef->getRigidData()->getNumDOF();
     m_dof = dimension * non_rigid_count + rigid_dof;
 
@@ -289,7 +294,7 @@ void TwoStepNPHRigid::integrateStepOne(unsigned int timestep)
         m_prof->push("NPH rigid step 1");
 
     // get box
-    BoxDim box = m_pdata->getBox();
+    BoxDim box = m_pdata->getGlobalBox();
 
     Scalar tmp, akin_t, akin_r, scale, scale_t, scale_r, scale_v;
     Scalar4 mbody, tbody, fquat;
@@ -435,7 +440,7 @@ void TwoStepNPHRigid::integrateStepTwo(unsigned int timestep)
         m_prof->push("NPH rigid step 2");
 
     // get box
-    BoxDim box = m_pdata->getBox();
+    BoxDim box = m_pdata->getGlobalBox();
     Scalar3 L = box.getL();
 
     Scalar tmp, scale_t, scale_r, akin_t, akin_r;
@@ -262,7 +262,7 @@ void TwoStepNPTRigid::setup()
 
     // initialize barostat parameters
 
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
     Scalar3 L = box.getL();
 
     Scalar vol;   // volume
@@ -314,6 +314,11 @@ void TwoStepNPTRigid::setup()
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         if (h_body.data[i] == NO_BODY) non_rigid_count++;
 
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &non_rigid_count, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+    #endif
+
     unsigned int rigid_dof = m_sysdef->getRigidData()->getNumDOF();
     m_dof = dimension * non_rigid_count + rigid_dof;
 
@@ -339,7 +344,7 @@ void TwoStepNPTRigid::integrateStepOne(unsigned int timestep)
         m_prof->push("NPT rigid step 1");
 
     // get box
-    BoxDim box = m_pdata->getBox();
+    BoxDim box = m_pdata->getGlobalBox();
 
     Scalar tmp, akin_t, akin_r, scale, scale_t, scale_r, scale_v;
     Scalar4 mbody, tbody, fquat;
@@ -489,7 +494,7 @@ void TwoStepNPTRigid::integrateStepTwo(unsigned int timestep)
         m_prof->push("NPT rigid step 2");
 
     // get box
-    BoxDim box = m_pdata->getBox();
+    BoxDim box = m_pdata->getGlobalBox();
     Scalar3 L = box.getL();
 
     Scalar tmp, scale_t, scale_r, akin_t, akin_r;
@@ -250,6 +250,10 @@ void TwoStepNVERigid::setup()
             // get the index of particle in the particle arrays
             unsigned int pidx = particle_indices_handle.data[body * indices_pitch + j];
 
+            // members on other ranks are summed up there
+            if (pidx == NO_INDEX)
+                continue;
+
             // get the particle mass
             Scalar mass_one = h_vel.data[pidx].w;
 
@@ -294,6 +298,15 @@ void TwoStepNVERigid::setup()
 
         }
 
+    #ifdef ENABLE_MPI
+    // complete the sums over the members on all ranks
+    if (m_pdata->getDomainDecomposition())
+        {
+        reduceBodySums(vel_handle.data, angmom_handle.data);
+        reduceBodySums(force_handle.data, torque_handle.data);
+        }
+    #endif
+
     for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
         {
         unsigned int body = m_body_group->getMemberIndex(group_idx);
@@ -347,7 +360,7 @@ void TwoStepNVERigid::integrateStepOne(unsigned int timestep)
         m_prof->push("NVE rigid step 1");
 
     // get box
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
 
     // now we can get on with the velocity verlet: initial integration
     {
@@ -575,6 +588,10 @@ void TwoStepNVERigid::computeForceAndTorque(unsigned int timestep)
             // get the actual index of particle in the particle arrays
             unsigned int pidx = particle_indices_handle.data[body * indices_pitch + j];
 
+            // members on other ranks are summed up there
+            if (pidx == NO_INDEX)
+                continue;
+
             // access the force on the particle
             Scalar fx = h_net_force.data[pidx].x;
             Scalar fy = h_net_force.data[pidx].y;
@@ -609,10 +626,60 @@ void TwoStepNVERigid::computeForceAndTorque(unsigned int timestep)
             }
         }
 
+    #ifdef ENABLE_MPI
+    // bodies may straddle domain boundaries, complete the sums over the members on all ranks
+    if (m_pdata->getDomainDecomposition())
+        reduceBodySums(force_handle.data, torque_handle.data);
+    #endif
+
     if (m_prof)
         m_prof->pop();
     }
 
+#ifdef ENABLE_MPI
+/*! \param h_first First per-body array (host pointer)
+    \param h_second Second per-body array (host pointer)
+
+    The x, y and z components of both arrays are summed over all ranks for every body in the group, using a single
+    collective call. Afterwards, all ranks hold the same values.
+*/
+void TwoStepNVERigid::reduceBodySums(Scalar4 *h_first, Scalar4 *h_second)
+    {
+    m_body_sum_buf.resize(6*m_n_bodies);
+
+    for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
+        {
+        unsigned int body = m_body_group->getMemberIndex(group_idx);
+
+        m_body_sum_buf[6*group_idx+0] = h_first[body].x;
+        m_body_sum_buf[6*group_idx+1] = h_first[body].y;
+        m_body_sum_buf[6*group_idx+2] = h_first[body].z;
+        m_body_sum_buf[6*group_idx+3] = h_second[body].x;
+        m_body_sum_buf[6*group_idx+4] = h_second[body].y;
+        m_body_sum_buf[6*group_idx+5] = h_second[body].z;
+        }
+
+    MPI_Allreduce(MPI_IN_PLACE,
+                  &m_body_sum_buf.front(),
+                  6*m_n_bodies,
+                  MPI_HOOMD_SCALAR,
+                  MPI_SUM,
+                  m_exec_conf->getMPICommunicator());
+
+    for (unsigned int group_idx = 0; group_idx < m_n_bodies; group_idx++)
+        {
+        unsigned int body = m_body_group->getMemberIndex(group_idx);
+
+        h_first[body].x = m_body_sum_buf[6*group_idx+0];
+        h_first[body].y = m_body_sum_buf[6*group_idx+1];
+        h_first[body].z = m_body_sum_buf[6*group_idx+2];
+        h_second[body].x = m_body_sum_buf[6*group_idx+3];
+        h_second[body].y = m_body_sum_buf[6*group_idx+4];
+        h_second[body].z = m_body_sum_buf[6*group_idx+5];
+        }
+    }
+#endif
+
 /*! Checks that every particle in the group is valid. This method may be called by anyone wishing to make this
     error check.
 
@@ -621,11 +688,15 @@ void TwoStepNVERigid::computeForceAndTorque(unsigned int timestep)
 */
 void TwoStepNVERigid::validateGroup()
     {
+    // check the local members only, ParticleData::getBody() is a collective call in multi-processor simulations
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+
     for (unsigned int gidx = 0; gidx < m_group->getNumMembers(); gidx++)
         {
-        unsigned int tag = m_group->getMemberTag(gidx);
-        if (m_pdata->getBody(tag) == NO_BODY)
+        unsigned int idx = m_group->getMemberIndex(gidx);
+        if (h_body.data[idx] == NO_BODY)
             {
+            unsigned int tag = m_group->getMemberTag(gidx);
             m_exec_conf->msg->error() << "integreate.*_rigid: Particle " << tag << " does not belong to a rigid body. "
                  << "This integration method does not operate on free particles." << endl;
 
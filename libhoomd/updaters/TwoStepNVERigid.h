@@ -98,6 +98,11 @@ class TwoStepNVERigid : public IntegrationMethodTwoStep
         //! Computes the body forces and torques
         void computeForceAndTorque(unsigned int timestep);
 
+        #ifdef ENABLE_MPI
+        //! Sums per-body values of the local body members over all ranks
+        void reduceBodySums(Scalar4 *h_first, Scalar4 *h_second);
+        #endif
+
         //! Get the number of degrees of freedom granted to a given group
         virtual unsigned int getNDOF(boost::shared_ptr<ParticleGroup> query_group);
 
@@ -198,6 +203,10 @@ class TwoStepNVERigid : public IntegrationMethodTwoStep
         unsigned int iter;                          //!< Number of iterations
         unsigned int order;                         //!< Number of thermostat per chain
 
+        #ifdef ENABLE_MPI
+        std::vector<Scalar> m_body_sum_buf;         //!< Buffer for summing body values over all ranks
+        #endif
+
         Scalar  dilation;                           //!< Box size change
         Scalar  epsilon;                            //!< Volume scaling "position"
         Scalar  epsilon_dot;                        //!< Volume scaling "velocity"
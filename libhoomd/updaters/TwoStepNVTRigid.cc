@@ -304,7 +304,7 @@ void TwoStepNVTRigid::integrateStepOne(unsigned int timestep)
         m_prof->push("NVT rigid step 1");
 
     // get box
-    const BoxDim& box = m_pdata->getBox();
+    const BoxDim& box = m_pdata->getGlobalBox();
     Scalar tmp, akin_t, akin_r, scale_t, scale_r;
     Scalar4 mbody, tbody, fquat;
     Scalar dtfm, dt_half;
@@ -63,6 +63,10 @@ using namespace boost;
 #include "FIREEnergyMinimizerGPU.cuh"
 #include "TwoStepNVEGPU.h"
 
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
 // windows feels the need to #define min and max
 #ifdef WIN32
 #undef min
@@ -156,6 +160,10 @@ void FIREEnergyMinimizerGPU::update(unsigned int timesteps)
     if (m_converged)
         return;
 
+    unsigned int group_size_global = m_group->getNumMembersGlobal();
+    if (group_size_global == 0)
+        return;
+
     IntegratorTwoStep::update(timesteps);
 
     Scalar P(0.0);
@@ -169,7 +177,10 @@ void FIREEnergyMinimizerGPU::update(unsigned int timesteps)
     if (m_prof)
         m_prof->push(exec_conf, "FIRE compute total energy");
 
-    unsigned int group_size = m_group->getIndexArray().getNumElements();
+    // the index array is sized for all group members, only the local ones are summed over
+    unsigned int group_size = m_group->getNumMembers();
+    m_num_blocks = group_size / m_block_size + 1;
+
     ArrayHandle< unsigned int > d_index_array(m_group->getIndexArray(), access_location::device, access_mode::read);
 
         {
@@ -190,7 +201,14 @@ void FIREEnergyMinimizerGPU::update(unsigned int timesteps)
         }
 
     ArrayHandle<Scalar> h_sumE(m_sum, access_location::host, access_mode::read);
-    energy = h_sumE.data[0]/Scalar(group_size);
+    Scalar pe_total = h_sumE.data[0];
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        MPI_Allreduce(MPI_IN_PLACE, &pe_total, 1, MPI_HOOMD_SCALAR, MPI_SUM, exec_conf->getMPICommunicator());
+    #endif
+
+    energy = pe_total/Scalar(group_size_global);
 
     if (m_prof)
         m_prof->pop(exec_conf);
@@ -234,15 +252,25 @@ void FIREEnergyMinimizerGPU::update(unsigned int timesteps)
         }
 
     ArrayHandle<Scalar> h_sum(m_sum3, access_location::host, access_mode::read);
-    P = h_sum.data[0];
-    vnorm = sqrt(h_sum.data[1]);
-    fnorm = sqrt(h_sum.data[2]);
+    Scalar sums[3] = {h_sum.data[0], h_sum.data[1], h_sum.data[2]};
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        // sum the power and the squared norms over all ranks
+        MPI_Allreduce(MPI_IN_PLACE, sums, 3, MPI_HOOMD_SCALAR, MPI_SUM, exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    P = sums[0];
+    vnorm = sqrt(sums[1]);
+    fnorm = sqrt(sums[2]);
 
     if (m_prof)
         m_prof->pop(exec_conf);
 
 
-    if ((fnorm/sqrt(Scalar(m_sysdef->getNDimensions()*group_size)) < m_ftol && fabs(energy-m_old_energy) < m_etol) && m_n_since_start >= m_run_minsteps)
+    if ((fnorm/sqrt(Scalar(m_sysdef->getNDimensions()*group_size_global)) < m_ftol && fabs(energy-m_old_energy) < m_etol) && m_n_since_start >= m_run_minsteps)
         {
         m_converged = true;
         return;
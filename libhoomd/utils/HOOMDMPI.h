@@ -337,6 +337,104 @@ void gather_v(const T& in_value, std::vector<T> & out_values, unsigned int root,
     delete[] sbuf;
     }
 
+//! Wrapper around MPI_Gatherv for vectors of plain old data types
+/*! Unlike gather_v(), the values are not serialized, but sent directly as a contiguous MPI datatype of the
+    size of \a T. This avoids the copies into and out of the archives, and the message sizes are limited by the
+    number of elements rather than the number of bytes.
+
+    \param in_values Values of this rank
+    \param out_values Output, on the root rank the values of all ranks concatenated in rank order
+    \param root Rank that receives the values
+    \param mpi_comm MPI communicator
+*/
+template<typename T>
+void gather_pod_v(const std::vector<T>& in_values, std::vector<T>& out_values, unsigned int root, const MPI_Comm mpi_comm)
+    {
+    int rank;
+    int size;
+    MPI_Comm_rank(mpi_comm, &rank);
+    MPI_Comm_size(mpi_comm, &size);
+
+    MPI_Datatype mpi_type;
+    MPI_Type_contiguous(sizeof(T), MPI_BYTE, &mpi_type);
+    MPI_Type_commit(&mpi_type);
+
+    int send_count = in_values.size();
+    std::vector<int> recv_counts;
+    std::vector<int> displs;
+    if (rank == (int) root)
+        {
+        recv_counts.resize(size);
+        displs.resize(size);
+        }
+
+    // gather the number of elements of every rank
+    MPI_Gather(&send_count, 1, MPI_INT, (rank == (int) root) ? &recv_counts.front() : NULL, 1, MPI_INT, root, mpi_comm);
+
+    if (rank == (int) root)
+        {
+        unsigned int len = 0;
+        for (unsigned int i = 0; i < (unsigned int) size; i++)
+            {
+            displs[i] = len;
+            len += recv_counts[i];
+            }
+        out_values.resize(len);
+        }
+
+    // MPI requires valid buffer addresses even for empty messages
+    T dummy;
+    T *sbuf = send_count ? const_cast<T *>(&in_values.front()) : &dummy;
+    T *rbuf = (rank == (int) root && ! out_values.empty()) ? &out_values.front() : &dummy;
+
+    MPI_Gatherv(sbuf, send_count, mpi_type, rbuf, (rank == (int) root) ? &recv_counts.front() : NULL,
+        (rank == (int) root) ? &displs.front() : NULL, mpi_type, root, mpi_comm);
+
+    MPI_Type_free(&mpi_type);
+    }
+
+//! Wrapper around MPI_Allgatherv for vectors of plain old data types
+/*! This is the all-to-all variant of gather_pod_v().
+
+    \param in_values Values of this rank
+    \param out_values Output, on every rank the values of all ranks concatenated in rank order
+    \param mpi_comm MPI communicator
+*/
+template<typename T>
+void all_gather_pod_v(const std::vector<T>& in_values, std::vector<T>& out_values, const MPI_Comm mpi_comm)
+    {
+    int size;
+    MPI_Comm_size(mpi_comm, &size);
+
+    MPI_Datatype mpi_type;
+    MPI_Type_contiguous(sizeof(T), MPI_BYTE, &mpi_type);
+    MPI_Type_commit(&mpi_type);
+
+    int send_count = in_values.size();
+    std::vector<int> recv_counts(size);
+    std::vector<int> displs(size);
+
+    // gather the number of elements of every rank
+    MPI_Allgather(&send_count, 1, MPI_INT, &recv_counts.front(), 1, MPI_INT, mpi_comm);
+
+    unsigned int len = 0;
+    for (unsigned int i = 0; i < (unsigned int) size; i++)
+        {
+        displs[i] = len;
+        len += recv_counts[i];
+        }
+    out_values.resize(len);
+
+    // MPI requires valid buffer addresses even for empty messages
+    T dummy;
+    T *sbuf = send_count ? const_cast<T *>(&in_values.front()) : &dummy;
+    T *rbuf = ! out_values.empty() ? &out_values.front() : &dummy;
+
+    MPI_Allgatherv(sbuf, send_count, mpi_type, rbuf, &recv_counts.front(), &displs.front(), mpi_type, mpi_comm);
+
+    MPI_Type_free(&mpi_type);
+    }
+
 //! Wrapper around MPI_Allgatherv
 template<typename T>
 void all_gather_v(const T& in_value, std::vector<T> & out_values, const MPI_Comm mpi_comm)
@@ -103,7 +103,10 @@ from math import sqrt
 #       (group.charged). However, note that this group is static and determined at the time charge.pppm() is specified.
 #       If you are going to add charged particles at a later point in the simulation with the data access API,
 #       ensure that this group includes those particles as well.
-# \MPI_NOT_SUPPORTED
+# \note In MPI simulations, the mesh is split evenly along the processor grid. Every local mesh block must be at
+#       least as wide as the layer of ghost cells around it, which is about \a order/2 + 2 mesh points plus half
+#       the neighbor list buffer. Multi-processor PPPM is only supported on the CPU.
+# \MPI_SUPPORTED
 class pppm(force._force):
     ## Specify long-ranged electrostatic interactions between particles
     #
@@ -118,10 +121,10 @@ class pppm(force._force):
     def __init__(self, group):
         util.print_status_line();
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("charge.pppm is not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("charge.pppm is not supported in multi-processor simulations on the GPU.\n\n")
                 raise RuntimeError("Error initializing PPPM.")
 
         # initialize the base class
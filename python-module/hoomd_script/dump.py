@@ -79,6 +79,7 @@ class xml(analyze._analyzer):
     # \param params (optional) Any number of parameters that set_params() accepts
     # \param time_step (optional) Time step to write into the file (overrides the current simulation step). time_step
     #                  is ignored for periodic updates
+    # \param background Set to False to write the periodic dumps on the main thread
     #
     # \b Examples:
     # \code
@@ -98,8 +99,11 @@ class xml(analyze._analyzer):
     # If \a period is not specified, then no periodic updates will occur. Instead, the file
     # \a filename is written immediately. \a time_step is passed on to write()
     #
+    # By default, periodic dumps only copy the particle data during the run and the files are formatted and written
+    # on a background thread while the simulation continues. All files are complete when run() returns.
+    #
     # \a period can be a function: see \ref variable_period_docs for details
-    def __init__(self, filename="dump", period=None, time_step=None, **params):
+    def __init__(self, filename="dump", period=None, time_step=None, background=True, **params):
         util.print_status_line();
 
         # initialize base class
@@ -107,6 +111,7 @@ class xml(analyze._analyzer):
 
         # create the c++ mirror class
         self.cpp_analyzer = hoomd.HOOMDDumpWriter(globals.system_definition, filename);
+        self.cpp_analyzer.setAsyncOutput(background);
         util._disable_status_lines = True;
         self.set_params(**params);
         util._disable_status_lines = False;
@@ -285,10 +290,13 @@ class bin(analyze._analyzer):
     # \param file1 (optional) First alternating file name to write
     # \param file2 (optional) Second alternating file name to write
     # \param compress Set to False to disable gzip compression
+    # \param background Set to False to compress and write the periodic dumps on the main thread
+    # \param aligned Set to True to write uncompressed files that init.read_bin can memory-map
     #
     # \b Examples:
     # \code
     # dump.bin(file1="restart.1.bin.gz", file2="restart.2.bin.gz", period=1e5)
+    # dump.bin(file1="restart.1.bin", file2="restart.2.bin", period=1e5, aligned=True)
     # dump.bin(filename="particles", period=1000)
     # bin = dump.bin(filename="particles", period=1e5, compress=False)
     # bin = dump.bin()
@@ -308,6 +316,14 @@ class bin(analyze._analyzer):
     # of the files, the other is still available for use. Make sure to include a .gz file extension if compression
     # is enabled.
     #
+    # By default, periodic dumps are compressed and written on a background thread while the simulation continues.
+    # All files are complete when run() returns.
+    #
+    # If \a aligned is True, files are written uncompressed (\a compress is ignored) in a layout that init.read_bin
+    # maps into memory instead of reading it. This greatly reduces the startup time and memory use of restarts of large
+    # systems. Aligned files can also be written and read in multi-processor simulations, where every rank reads only
+    # the particles in its own domain.
+    #
     # Binary files include the \b entire state of the system, including the time step, particle positions,
     # velocities, et cetera, and the internal state variables of any relevant integration methods. All %data is saved
     # exactly as it appears in memory so that loading the %data with init.read_bin is as close as possible as one
@@ -329,14 +345,14 @@ class bin(analyze._analyzer):
     # limit. If you need to store data in a system and version independent manner, use dump.xml().
     #
     # \a period can be a function: see \ref variable_period_docs for details
-    def __init__(self, filename="dump", period=None, file1=None, file2=None, compress=True):
+    def __init__(self, filename="dump", period=None, file1=None, file2=None, compress=True, background=True, aligned=False):
         util.print_status_line();
         globals.msg.warning("dump.bin is deprecated and will be removed in the next release");
 
         # Error out in MPI simulations
-        if (hoomd.is_MPI_available()):
+        if (hoomd.is_MPI_available()) and not aligned:
             if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("dump.bin is not supported in multi-processor simulations.\n\n")
+                globals.msg.error("dump.bin only supports multi-processor simulations with aligned=True.\n\n")
                 raise RuntimeError("Error writing restart data.")
 
         # initialize base class
@@ -344,7 +360,9 @@ class bin(analyze._analyzer):
 
         # create the c++ mirror class
         self.cpp_analyzer = hoomd.HOOMDBinaryDumpWriter(globals.system_definition, filename);
-        self.cpp_analyzer.enableCompression(compress)
+        self.cpp_analyzer.enableCompression(compress and not aligned)
+        self.cpp_analyzer.enableAlignedOutput(aligned);
+        self.cpp_analyzer.setAsyncOutput(background);
 
         # handle the alternation setting
         # first, check that they are both set
@@ -508,6 +526,9 @@ class dcd(analyze._analyzer):
     #        unwrapped so that the body is continuous. The center of mass of the body remains in the simulation box, but
     #        some particles may be written just outside it. \a unwrap_rigid is ignored if \a unwrap_full is True.
     # \param angle_z When True, the particle orientation angle is written to the z component (only useful for 2D simulations)
+    # \param mpiio When True (the default), in multi-processor simulations every rank writes the coordinates of its own
+    #        particles directly to the file with MPI-IO. When False, the coordinates are gathered and written by the
+    #        root processor.
     #
     # \b Examples:
     # \code
@@ -522,7 +543,7 @@ class dcd(analyze._analyzer):
     #   consistent timeline
     #
     # \a period can be a function: see \ref variable_period_docs for details
-    def __init__(self, filename, period, group=None, overwrite=False, unwrap_full=False, unwrap_rigid=False, angle_z=False):
+    def __init__(self, filename, period, group=None, overwrite=False, unwrap_full=False, unwrap_rigid=False, angle_z=False, mpiio=True):
         util.print_status_line();
 
         # initialize base class
@@ -544,6 +565,7 @@ class dcd(analyze._analyzer):
         self.cpp_analyzer.setUnwrapFull(unwrap_full);
         self.cpp_analyzer.setUnwrapRigid(unwrap_rigid);
         self.cpp_analyzer.setAngleZ(angle_z);
+        self.cpp_analyzer.setMPIIO(mpiio);
         self.setupAnalyzer(period);
 
     def enable(self):
@@ -560,6 +582,53 @@ class dcd(analyze._analyzer):
         raise RuntimeError('Error changing updater period');
 
 
+## Writes a multi-frame HOOMD trajectory file
+#
+# Every \a period time steps, a frame is appended to the file. Each frame stores the box and the particle
+# positions, and optionally the velocities, images and orientations. Particle types, masses, charges, diameters,
+# bodies and the bonded topology are only stored in the frames in which they change.
+#
+# The file keeps an index of all frames, so that any frame of a trajectory can be read without reading the
+# frames before it. Use init.read_bin() with the \a frame argument to continue a simulation from a frame.
+#
+# All values are written in native HOOMD-blue units, see \ref page_units for more information.
+#
+# \MPI_SUPPORTED
+class traj(analyze._analyzer):
+    ## Initialize the trajectory writer
+    #
+    # \param filename File name to write
+    # \param period Number of time steps between frames
+    # \param overwrite When False, (the default) frames are appended to an existing file. When True, an existing file
+    #        \a filename will be overwritten.
+    # \param velocity Set to False to not write particle velocities
+    # \param image Set to False to not write particle images
+    # \param orientation Set to True to write particle orientations
+    # \param compress Set to True to zlib compress the data of every frame
+    # \param background Set to False to compress and write the frames on the main thread
+    #
+    # \b Examples:
+    # \code
+    # dump.traj(filename="trajectory.traj", period=1000)
+    # traj = dump.traj(filename="trajectory.traj", period=1e5, orientation=True, compress=True)
+    # \endcode
+    #
+    # \a period can be a function: see \ref variable_period_docs for details
+    def __init__(self, filename, period, overwrite=False, velocity=True, image=True, orientation=False, compress=False, background=True):
+        util.print_status_line();
+
+        # initialize base class
+        analyze._analyzer.__init__(self);
+
+        # create the c++ mirror class
+        self.cpp_analyzer = hoomd.HOOMDTrajectoryWriter(globals.system_definition, filename, overwrite);
+        self.cpp_analyzer.setOutputVelocity(velocity);
+        self.cpp_analyzer.setOutputImage(image);
+        self.cpp_analyzer.setOutputOrientation(orientation);
+        self.cpp_analyzer.enableCompression(compress);
+        self.cpp_analyzer.setAsyncOutput(background);
+        self.setupAnalyzer(period);
+
 ## Writes simulation snapshots in the PBD format
 #
 # Every \a period time steps, a new file will be created. The state of the
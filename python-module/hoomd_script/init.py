@@ -302,12 +302,15 @@ def read_xml(filename, time_step = None, wrap_coordinates = False):
 #
 # \param filename File to read
 # \param time_step Override time_step value in the bin file
+# \param frame Index of the frame to read when \a filename is a trajectory written by dump.traj. Negative values
+#        count from the end, the default reads the last frame.
 #
 # \b Examples:
 # \code
 # init.read_bin(filename="data.bin.gz")
 # init.read_bin(filename="directory/data.bin")
 # system = init.read_bin(filename="data.bin.gz")
+# system = init.read_bin(filename="trajectory.traj", frame=10)
 # \endcode
 #
 # All particles, bonds, etc...  are read from the binary file given, setting the initial condition of the simulation.
@@ -319,6 +322,13 @@ def read_xml(filename, time_step = None, wrap_coordinates = False):
 # The presence or lack of a .gz extension determines whether init.read_bin will attempt to decompress the %data
 # before reading it.
 #
+# Files written by dump.bin with aligned=True are detected automatically and mapped into memory. The particle %data
+# is copied straight from the mapped file into the simulation, and in multi-processor runs every rank copies only the
+# particles in its own domain. The file must be accessible from all ranks.
+#
+# Trajectory files written by dump.traj are detected automatically. They store the particle and topology %data, but
+# no walls, rigid body or integrator state.
+#
 # The result of init.read_bin can be saved in a variable and later used to read and/or change particle properties
 # later in the script. See hoomd_script.data for more information.
 #
@@ -326,8 +336,8 @@ def read_xml(filename, time_step = None, wrap_coordinates = False):
 #          of new features in HOOMD-blue that it does not support.
 #              * Triclinic boxes
 #
-# \sa dump.bin
-def read_bin(filename, time_step = None):
+# \sa dump.bin, dump.traj
+def read_bin(filename, time_step = None, frame = -1):
     util.print_status_line();
     globals.msg.warning("init.read_bin is deprecated and will be removed in the next release");
 
@@ -340,14 +350,13 @@ def read_bin(filename, time_step = None):
         raise RuntimeError('Error initializing');
 
     # read in the data
-    initializer = hoomd.HOOMDBinaryInitializer(my_exec_conf,filename);
-    snapshot = initializer.getSnapshot()
+    initializer = hoomd.HOOMDBinaryInitializer(my_exec_conf,filename,frame);
 
-    my_domain_decomposition = _create_domain_decomposition(snapshot.global_box);
+    my_domain_decomposition = _create_domain_decomposition(initializer.getBox());
     if my_domain_decomposition is not None:
-        globals.system_definition = hoomd.SystemDefinition(snapshot, my_exec_conf, my_domain_decomposition);
+        globals.system_definition = initializer.createSystemDefinition(my_exec_conf, my_domain_decomposition);
     else:
-        globals.system_definition = hoomd.SystemDefinition(snapshot, my_exec_conf);
+        globals.system_definition = initializer.createSystemDefinition(my_exec_conf);
 
     # initialize the system
     if time_step is None:
@@ -800,6 +809,10 @@ def _create_exec_conf():
     if globals.options.gpu_error_checking:
        exec_conf.setCUDAErrorChecking(True);
 
+    # override the number of CPU threads if requested
+    if globals.options.ncpu is not None and not exec_conf.isCUDAEnabled():
+       exec_conf.setNumThreads(globals.options.ncpu);
+
     globals.exec_conf = exec_conf;
 
     return exec_conf;
@@ -323,13 +323,29 @@ class _integration_method:
 class mode_standard(_integrator):
     ## Specifies the standard integration mode
     # \param dt Each time step of the simulation run() will advance the real time of the system forward by \a dt (in time units)
+    # \param accumulate Set to True to compute the forces in accumulate mode (see below)
+    # \param reduced_virial Set to True to only sum the virial over all particles (see below)
+    #
+    # By default, every force keeps its own per-particle force, virial and torque arrays, which are summed into the
+    # net force every step. In accumulate mode, the forces are instead computed directly into the net force and
+    # do not keep their own arrays. This saves memory and the bandwidth of the summation in large systems. A force
+    # allocates its own arrays again, and stays that way, as soon as its per-particle data is accessed with
+    # force_data or its energy is logged.
+    #
+    # The pressure only needs the virial summed over all particles. With \a reduced_virial, pair and bond forces
+    # sum up their virial while computing the forces instead of storing it for every particle, whenever the pressure
+    # is needed by analyze.log or integrate.npt. The pressure and pressure tensor of compute.thermo on a group that
+    # does not contain all particles are then not available and are logged as NaN. Do not combine \a reduced_virial
+    # with integrate.npt on a subset of the particles. It is ignored in systems with rigid bodies.
     #
     # \b Examples:
     # \code
     # integrate.mode_standard(dt=0.005)
     # integrator_mode = integrate.mode_standard(dt=0.001)
+    # integrate.mode_standard(dt=0.005, accumulate=True)
+    # integrate.mode_standard(dt=0.005, reduced_virial=True)
     # \endcode
-    def __init__(self, dt):
+    def __init__(self, dt, accumulate=False, reduced_virial=False):
         util.print_status_line();
 
         # initialize base class
@@ -337,12 +353,19 @@ class mode_standard(_integrator):
 
         # initialize the reflected c++ class
         self.cpp_integrator = hoomd.IntegratorTwoStep(globals.system_definition, dt);
+        self.cpp_integrator.setReducedVirial(reduced_virial);
         self.supports_methods = True;
 
+        # forces evaluated less often than every step
+        self.force_periods = {};
+        self.accumulate = accumulate;
+
         globals.system.setIntegrator(self.cpp_integrator);
 
     ## Changes parameters of an existing integration mode
     # \param dt New time step delta (if set) (in time units)
+    # \param accumulate Set to True to compute the forces in accumulate mode (if set)
+    # \param reduced_virial Set to True to only sum the virial over all particles (if set)
     #
     # To change the parameters of an existing integration mode, you must save it in a variable when it is
     # specified, like so:
@@ -353,14 +376,68 @@ class mode_standard(_integrator):
     # \b Examples:
     # \code
     # integrator_mode.set_params(dt=0.007)
+    # integrator_mode.set_params(accumulate=True)
+    # integrator_mode.set_params(reduced_virial=True)
     # \endcode
-    def set_params(self, dt=None):
+    def set_params(self, dt=None, accumulate=None, reduced_virial=None):
         util.print_status_line();
         self.check_initialization();
 
         # change the parameters
         if dt is not None:
             self.cpp_integrator.setDeltaT(dt);
+        if accumulate is not None:
+            self.accumulate = accumulate;
+        if reduced_virial is not None:
+            self.cpp_integrator.setReducedVirial(reduced_virial);
+
+    ## Evaluates a force only every few time steps (multiple time step integration)
+    # \param force Force to set the period of
+    # \param period The force is evaluated on time steps that are a multiple of \a period
+    #
+    # set_respa() implements the impulse form of the r-RESPA multiple time step method \cite Tuckerman1992.
+    # Forces that vary slowly or are expensive to compute, such as charge.pppm or pair forces with a long cutoff,
+    # can be evaluated every \a period steps while stiff, cheap forces such as bonds are evaluated every step.
+    # On the steps where the force is evaluated, it is applied as an impulse of \a period * \a dt. Choosing periods
+    # that are multiples of each other (i.e. 1 for bonds, 2 for pair forces and 4 for PPPM) gives a nested
+    # multilevel scheme. Set \a period to 1 to evaluate the force every step again.
+    #
+    # The energy and virial of a force only contribute to logged quantities on the steps where it is evaluated.
+    # Log thermodynamic quantities with a period that is a multiple of all the force periods. For the same reason,
+    # integrate.npt and integrate.nph see the pressure contribution of these forces only every \a period steps.
+    #
+    # \b Examples:
+    # \code
+    # integrator_mode = integrate.mode_standard(dt=0.005)
+    # pppm = charge.pppm(group=group.charged())
+    # integrator_mode.set_respa(pppm, period=4)
+    # integrator_mode.set_respa(lj, period=2)
+    # \endcode
+    def set_respa(self, force, period):
+        util.print_status_line();
+        self.check_initialization();
+
+        if int(period) < 1:
+            globals.msg.error("integrate.mode_standard: period must be at least 1\n");
+            raise RuntimeError('Error setting force period');
+
+        if int(period) == 1:
+            self.force_periods.pop(force, None);
+        else:
+            self.force_periods[force] = int(period);
+
+    ## \internal
+    # \brief Updates the forces and their periods in the reflected c++ class
+    def update_forces(self):
+        _integrator.update_forces(self);
+
+        for f, period in self.force_periods.items():
+            if f.enabled:
+                self.cpp_integrator.setForcePeriod(f.cpp_force, period);
+
+        for f in globals.forces:
+            if f.enabled:
+                f.cpp_force.setAccumulate(self.accumulate);
 
 ## NVT Integration via the Nos&eacute;-Hoover thermostat
 #
@@ -993,7 +1070,10 @@ class bdnvt(_integration_method):
 # integrate.nve_rigid is an integration method. It must be used in concert with an integration mode. It can be used while
 # the following modes are active:
 # - integrate.mode_standard
-# \MPI_NOT_SUPPORTED
+#
+# In multi-processor simulations, integrate.nve_rigid is only available on the CPU.
+#
+# \MPI_SUPPORTED
 class nve_rigid(_integration_method):
     ## Specifies the NVE integration method for rigid bodies
     # \param group Group of particles on which to apply this method.
@@ -1006,10 +1086,10 @@ class nve_rigid(_integration_method):
     def __init__(self, group):
         util.print_status_line();
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("integrate.nve_rigid not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.nve_rigid is not supported in multi-processor simulations on the GPU.\n\n")
                 raise RuntimeError("Error setting up integration method.")
 
         # initialize base class
@@ -1036,7 +1116,10 @@ class nve_rigid(_integration_method):
 # integrate.nvt_rigid is an integration method. It must be used in concert with an integration mode. It can be used while
 # the following modes are active:
 # - integrate.mode_standard
-# \MPI_NOT_SUPPORTED
+#
+# In multi-processor simulations, integrate.nvt_rigid is only available on the CPU.
+#
+# \MPI_SUPPORTED
 class nvt_rigid(_integration_method):
     ## Specifies the NVT integration method for rigid bodies
     # \param group Group of particles on which to apply this method.
@@ -1054,10 +1137,10 @@ class nvt_rigid(_integration_method):
     def __init__(self, group, T, tau):
         util.print_status_line();
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("integrate.nvt_rigid not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.nvt_rigid is not supported in multi-processor simulations on the GPU.\n\n")
                 raise RuntimeError("Error setting up integration method.")
 
         # initialize base class
@@ -1126,7 +1209,10 @@ class nvt_rigid(_integration_method):
 # integrate.bdnvt_rigid is an integration method. It must be used in concert with an integration mode. It can be used while
 # the following modes are active:
 # - integrate.mode_standard
-# \MPI_NOT_SUPPORTED
+#
+# In multi-processor simulations, integrate.bdnvt_rigid is only available on the CPU.
+#
+# \MPI_SUPPORTED
 class bdnvt_rigid(_integration_method):
     ## Specifies the BD NVT integrator for rigid bodies
     # \param group Group of particles on which to apply this method.
@@ -1148,10 +1234,10 @@ class bdnvt_rigid(_integration_method):
     def __init__(self, group, T, seed=0, gamma_diam=False):
         util.print_status_line();
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("integrate.bdnvt_rigid not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.bdnvt_rigid is not supported in multi-processor simulations on the GPU.\n\n")
                 raise RuntimeError("Error setting up integration method.")
 
         # initialize base class
@@ -1239,7 +1325,10 @@ class bdnvt_rigid(_integration_method):
 # integrate.npt_rigid is an integration method. It must be used in concert with an integration mode. It can be used while
 # the following modes are active:
 # - integrate.mode_standard
-# \MPI_NOT_SUPPORTED
+#
+# In multi-processor simulations, integrate.npt_rigid is only available on the CPU.
+#
+# \MPI_SUPPORTED
 class npt_rigid(_integration_method):
     ## Specifies the NVT integration method for rigid bodies
     # \param group Group of particles on which to apply this method.
@@ -1259,10 +1348,10 @@ class npt_rigid(_integration_method):
     def __init__(self, group, T, tau, P, tauP):
         util.print_status_line();
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("integrate.npt_rigid not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.npt_rigid is not supported in multi-processor simulations on the GPU.\n\n")
                 raise RuntimeError("Error setting up integration method.")
 
         # initialize base class
@@ -1331,7 +1420,10 @@ class npt_rigid(_integration_method):
 # integrate.nph_rigid is an integration method. It must be used in concert with an integration mode. It can be used while
 # the following modes are active:
 # - integrate.mode_standard
-# \MPI_NOT_SUPPORTED
+#
+# In multi-processor simulations, integrate.nph_rigid is only available on the CPU.
+#
+# \MPI_SUPPORTED
 class nph_rigid(_integration_method):
     ## Specifies the NPH integration method for rigid bodies
     # \param group Group of particles on which to apply this method.
@@ -1349,10 +1441,10 @@ class nph_rigid(_integration_method):
     def __init__(self, group, P, tauP):
         util.print_status_line();
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("integrate.nph_rigid is not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.nph_rigid is not supported in multi-processor simulations on the GPU.\n\n")
                 raise RuntimeError("Error setting up integration method.")
 
         # initialize base class
@@ -1435,7 +1527,7 @@ class nph_rigid(_integration_method):
 # attempts can be set by the user.
 #
 # \warning All other integration methods must be disabled before using the FIRE energy minimizer.
-# \MPI_NOT_SUPPORTED
+# \MPI_SUPPORTED
 class mode_minimize_fire(_integrator):
     ## Specifies the FIRE energy minimizer.
     # \param group Particle group to be applied FIRE
@@ -1460,12 +1552,6 @@ class mode_minimize_fire(_integrator):
     def __init__(self, group, dt, Nmin=None, finc=None, fdec=None, alpha_start=None, falpha=None, ftol = None, Etol= None, min_steps=None):
         util.print_status_line();
 
-        # Error out in MPI simulations
-        if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("mode_minimize_fire is not supported in multi-processor simulations.\n\n")
-                raise RuntimeError("Error setting up integration mode.")
-
         # initialize base class
         _integrator.__init__(self);
 
@@ -1510,7 +1596,9 @@ class mode_minimize_fire(_integrator):
 #
 # For the time being, energy minimization will be handled separately for rigid and non-rigid bodies
 #
-# \MPI_NOT_SUPPORTED
+# In multi-processor simulations, integrate.mode_minimize_rigid_fire is only available on the CPU.
+#
+# \MPI_SUPPORTED
 class mode_minimize_rigid_fire(_integrator):
     ## Specifies the FIRE energy minimizer.
     #
@@ -1535,6 +1623,12 @@ class mode_minimize_rigid_fire(_integrator):
     def __init__(self, group, dt, Nmin=None, finc=None, fdec=None, alpha_start=None, falpha=None, ftol = None, wtol=None, Etol= None):
         util.print_status_line();
 
+        # Error out in MPI simulations on the GPU
+        if (hoomd.is_MPI_available()):
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("integrate.mode_minimize_rigid_fire is not supported in multi-processor simulations on the GPU.\n\n")
+                raise RuntimeError("Error setting up integration mode.")
+
         # initialize base class
         _integrator.__init__(self);
 
@@ -75,6 +75,7 @@ class options:
         self.gpu = None;
         self.gpu_error_checking = None;
         self.min_cpu = None;
+        self.ncpu = None;
         self.ignore_display = None;
         self.user = [];
         self.notice_level = 2;
@@ -94,6 +95,7 @@ class options:
                    gpu=self.gpu,
                    gpu_error_checking=self.gpu_error_checking,
                    min_cpu=self.min_cpu,
+                   ncpu=self.ncpu,
                    ignore_display=self.ignore_display,
                    user=self.user,
                    notice_level=self.notice_level,
@@ -117,6 +119,7 @@ def _parse_command_line():
     parser.add_option("--gpu", dest="gpu", help="GPU on which to execute");
     parser.add_option("--gpu_error_checking", dest="gpu_error_checking", action="store_true", default=False, help="Enable error checking on the GPU");
     parser.add_option("--minimize-cpu-usage", dest="min_cpu", action="store_true", default=False, help="Enable to keep the CPU usage of HOOMD to a bare minimum (will degrade overall performance somewhat)");
+    parser.add_option("--ncpu", dest="ncpu", help="Number of CPU threads to use in --mode=cpu (defaults to OMP_NUM_THREADS)");
     parser.add_option("--ignore-display-gpu", dest="ignore_display", action="store_true", default=False, help="Attempt to avoid running on the display GPU");
     parser.add_option("--notice-level", dest="notice_level", help="Minimum level of notice messages to print");
     parser.add_option("--msg-file", dest="msg_file", help="Name of file to write messages to");
@@ -151,6 +154,16 @@ def _parse_command_line():
         except ValueError:
             parser.error('--gpu must be an integer')
 
+    # convert ncpu to an integer
+    if cmd_options.ncpu is not None:
+        try:
+            cmd_options.ncpu = int(cmd_options.ncpu);
+        except ValueError:
+            parser.error('--ncpu must be an integer')
+
+        if cmd_options.ncpu < 1:
+            parser.error('--ncpu must be at least 1')
+
     # convert notice_level to an integer
     if cmd_options.notice_level is not None:
         try:
@@ -193,6 +206,7 @@ def _parse_command_line():
     globals.options.gpu = cmd_options.gpu;
     globals.options.gpu_error_checking = cmd_options.gpu_error_checking;
     globals.options.min_cpu = cmd_options.min_cpu;
+    globals.options.ncpu = cmd_options.ncpu;
     globals.options.ignore_display = cmd_options.ignore_display;
 
     globals.options.nx = cmd_options.nx;
@@ -300,6 +314,31 @@ def set_min_cpu(min_cpu):
 
     globals.options.min_cpu = min_cpu;
 
+## Set the number of CPU threads
+#
+# \param ncpu Number of CPU threads to use when running on the CPU. Must be a positive integer.
+# \note When set to None, the number of threads is taken from the OMP_NUM_THREADS environment variable.
+# \note Overrides --ncpu on the command line.
+# \sa \ref page_command_line_options
+#
+def set_ncpu(ncpu):
+    if init.is_initialized():
+            globals.msg.error("Cannot change the number of CPU threads after initialization\n");
+            raise RuntimeError('Error setting option');
+
+    if ncpu is not None:
+        try:
+            ncpu = int(ncpu);
+        except ValueError:
+            globals.msg.error("ncpu must be an integer\n");
+            raise RuntimeError('Error setting option');
+
+        if ncpu < 1:
+            globals.msg.error("ncpu must be at least 1\n");
+            raise RuntimeError('Error setting option');
+
+    globals.options.ncpu = ncpu;
+
 ## Set the ignore display GPU flag
 #
 # \param ignore_display Specifies whether the display GPU should be ignored. (True or False)
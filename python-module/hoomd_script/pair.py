@@ -313,6 +313,10 @@ class coeff:
 # created when the first %pair %force is specified. The cutoff radius is set to the
 # maximum of that set for all defined %pair forces.
 #
+# Each type pair only stores the neighbors it needs: the neighbor list cutoff of a type pair is the largest
+# r_cut set for that pair by any defined %pair %force. In mixtures where only one type pair is long ranged,
+# the other pairs do not pay for the long cutoff.
+#
 # Any bonds defined in the simulation are automatically used to exclude bonded particle
 # pairs from appearing in the neighbor list. Use the command reset_exclusions() to change this behavior.
 #
@@ -373,7 +377,9 @@ class nlist:
     ## \internal
     # \brief Adds a subscriber to the neighbor list
     # \param callable is a 0 argument callable object that returns the minimum r_cut needed by the subscriber
-    # All \a callables will be called at the beginning of each run() to determine the maximum r_cut needed for that run.
+    # All \a callables will be called at the beginning of each run() to determine the r_cut needed for that run.
+    # A \a callable may return a single r_cut that applies to all type pairs, a dictionary of r_cut values keyed
+    # by (type_i, type_j) name pairs, or None if it does not need the neighbor list for the run.
     #
     def subscribe(self, callable):
         self.subscriber_callbacks.append(callable);
@@ -382,13 +388,45 @@ class nlist:
     # \brief Updates r_cut based on the subscriber's requests
     #
     def update_rcut(self):
-        r_cut_max = 0.0;
+        # loop only over current particle types
+        ntypes = globals.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(globals.system_definition.getParticleData().getNameByType(i));
+
+        # each type pair needs the largest r_cut requested for it by any subscriber
+        r_cut_pair = {};
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                r_cut_pair[(i,j)] = 0.0;
+
         for c in self.subscriber_callbacks:
-            r_cut_max = max(r_cut_max, c());
+            r_cut = c();
+            if r_cut is None:
+                continue;
+
+            for i in range(0,ntypes):
+                for j in range(i,ntypes):
+                    if isinstance(r_cut, dict):
+                        if (type_list[i], type_list[j]) in r_cut:
+                            r_cut_ij = r_cut[(type_list[i], type_list[j])];
+                        else:
+                            r_cut_ij = r_cut[(type_list[j], type_list[i])];
+                    else:
+                        r_cut_ij = r_cut;
+
+                    r_cut_pair[(i,j)] = max(r_cut_pair[(i,j)], r_cut_ij);
+
+        r_cut_max = 0.0;
+        for r_cut_ij in r_cut_pair.values():
+            r_cut_max = max(r_cut_max, r_cut_ij);
 
         self.r_cut = r_cut_max;
         self.cpp_nlist.setRCut(self.r_cut, self.r_buff);
 
+        for (i,j), r_cut_ij in r_cut_pair.items():
+            self.cpp_nlist.setRCutPair(i, j, r_cut_ij);
+
     ## \internal
     # \brief Sets the default bond exclusions, but only if the defaults have not been overridden
     def update_exclusions_defaults(self):
@@ -412,6 +450,7 @@ class nlist:
     #        run() commands. (in distance units)
     # \param dist_check When set to False, disable the distance checking logic and always regenerate the nlist every
     #        \a check_period steps
+    # \param compact (if set) When set to True, store the neighbor list compactly. Only available on the CPU.
     #
     # set_params() changes one or more parameters of the neighbor list. \a r_buff and \a check_period
     # can have a significant effect on performance. As \a r_buff is made larger, the neighbor list needs
@@ -443,6 +482,11 @@ class nlist:
     # than necessary if
     # d_max is greater than 1.0.
     #
+    # By default, memory is reserved for the same number of neighbors for every particle: the largest number any
+    # particle has. In very heterogeneous systems (dense clusters in a dilute gas, or a few very large particles with
+    # diameter filtering) this wastes a lot of memory. With \a compact = True, each particle only takes as much
+    # memory as it has neighbors. The compact storage is only available on the CPU.
+    #
     # A single global neighbor list is created for the entire simulation.
     #
     # \b Examples:
@@ -451,8 +495,9 @@ class nlist:
     # nlist.set_params(check_period = 11)
     # nlist.set_params(r_buff = 0.7, check_period = 4)
     # nlist.set_params(d_max = 3.0)
+    # nlist.set_params(compact = True)
     # \endcode
-    def set_params(self, r_buff=None, check_period=None, d_max=None, dist_check=True):
+    def set_params(self, r_buff=None, check_period=None, d_max=None, dist_check=True, compact=None):
         util.print_status_line();
 
         if self.cpp_nlist is None:
@@ -470,6 +515,9 @@ class nlist:
         if d_max is not None:
             self.cpp_nlist.setMaximumDiameter(d_max);
 
+        if compact is not None:
+            self.cpp_nlist.setCompactStorage(compact);
+
     ## Resets all exclusions in the neighborlist
     #
     # \param exclusions Select which interactions should be excluded from the %pair interaction calculation.
@@ -797,6 +845,28 @@ class pair(force._force):
 
         return max_rcut;
 
+    ## \internal
+    # \brief Get the r_cut value set for each type pair
+    # \returns A dictionary of r_cut values keyed by (type_i, type_j) name pairs, or None if the %force is disabled
+    #          and not logged
+    # \pre update_coeffs must be called before get_rcut to verify that the coeffs are set
+    def get_rcut(self):
+        if not self.log:
+            return None;
+
+        # go through the list of only the active particle types in the sim
+        ntypes = globals.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(globals.system_definition.getParticleData().getNameByType(i));
+
+        r_cut_dict = {};
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                r_cut_dict[(type_list[i], type_list[j])] = self.pair_coeff.get(type_list[i], type_list[j], 'r_cut');
+
+        return r_cut_dict;
+
 ## Lennard-Jones %pair %force
 #
 # The command pair.lj specifies that a Lennard-Jones type %pair %force should be added to every
@@ -867,7 +937,7 @@ class lj(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -959,7 +1029,7 @@ class gauss(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -1074,7 +1144,7 @@ class slj(pair):
             globals.msg.notice(2, "Notice: slj set d_max=" + str(d_max) + "\n");
 
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut());
+        neighbor_list.subscribe(self.get_rcut);
         neighbor_list.cpp_nlist.setMaximumDiameter(d_max);
 
         # create the c++ mirror class
@@ -1191,7 +1261,7 @@ class yukawa(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -1275,7 +1345,7 @@ class ewald(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -1518,7 +1588,7 @@ class table(force._force):
 
         # update the neighbor list with a dummy 0 r_cut. The r_cut will be properly updated before the first run()
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -1573,6 +1643,27 @@ class table(force._force):
 
         return maxrmax;
 
+    ## \internal
+    # \brief Get the rmax value set for each type pair
+    # \returns A dictionary of rmax values keyed by (type_i, type_j) name pairs, or None if the %force is disabled
+    #          and not logged
+    def get_rcut(self):
+        if not self.log:
+            return None;
+
+        # loop only over current particle types
+        ntypes = globals.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(globals.system_definition.getParticleData().getNameByType(i));
+
+        r_cut_dict = {};
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                r_cut_dict[(type_list[i], type_list[j])] = self.pair_coeff.get(type_list[i], type_list[j], "rmax");
+
+        return r_cut_dict;
+
     def update_coeffs(self):
         # check that the pair coefficents are valid
         if not self.pair_coeff.verify(["func", "rmin", "rmax", "coeff"]):
@@ -1735,7 +1826,7 @@ class morse(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -1848,7 +1939,7 @@ class dpd(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -1967,7 +2058,7 @@ class dpd_conservative(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -2009,7 +2100,9 @@ class dpd_conservative(pair):
 # (commands eam/alloy and eam/fs) here: http://lammps.sandia.gov/doc/pair_eam.html
 # and are also described here: http://enpub.fulton.asu.edu/cms/potentials/submain/format.htm
 #
-# \MPI_NOT_SUPPORTED
+# In multi-processor simulations, pair.eam is only available on the CPU.
+#
+# \MPI_SUPPORTED
 class eam(force._force):
     ## Specify the EAM %pair %force
     #
@@ -2022,10 +2115,10 @@ class eam(force._force):
     def __init__(self, file, type):
         util.print_status_line();
 
-        # Error out in MPI simulations
+        # Error out in MPI simulations on the GPU
         if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("pair.eam is not supported in multi-processor simulations.\n\n")
+            if globals.system_definition.getParticleData().getDomainDecomposition() and globals.exec_conf.isCUDAEnabled():
+                globals.msg.error("pair.eam is not supported in multi-processor simulations on the GPU.\n\n")
                 raise RuntimeError("Error setting up pair potential.")
 
         # initialize the base class
@@ -2168,7 +2261,7 @@ class dpdlj(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -2309,7 +2402,7 @@ class force_shifted_lj(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -2381,7 +2474,7 @@ class moliere(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -2458,7 +2551,7 @@ class zbl(pair):
 
         # update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
@@ -2520,7 +2613,7 @@ class tersoff(pair):
 
         #update the neighbor list
         neighbor_list = _update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # this potential cannot handle a half neighbor list
         neighbor_list.cpp_nlist.setStorageMode(hoomd.NeighborList.storageMode.full);
@@ -549,5 +549,75 @@ class box_resize(_updater):
         if scale_particles is not None:
             self.cpp_updater.setParams(scale_particles);
 
+## Balances the number of particles per rank in a domain decomposition
+#
+# Every \a period time steps, the number of particles in every slab of domains along each direction is counted, and
+# the boundaries between the slabs are shifted so that each slab holds the same number of particles. The domains
+# remain a cartesian grid, and the particles are migrated to their new domains in the next time step. This improves
+# the performance of MPI simulations of inhomogeneous systems (droplets, interfaces, sedimentation), where a uniform
+# domain decomposition leaves some ranks with many more particles than others.
+#
+# A boundary is moved by at most a third of the width of the adjacent domains per update, so strongly inhomogeneous
+# systems are balanced over several updates. Domains are kept at least about twice as wide as the ghost layer.
+#
+# The load imbalance (the maximum number of particles on any rank divided by the average) is available to
+# analyze.log as \b load_imbalance.
+#
+# \MPI_SUPPORTED
+class balance(_updater):
+    ## Initialize the load balancer
+    #
+    # \param x Set to False to keep the domain boundaries along x fixed
+    # \param y Set to False to keep the domain boundaries along y fixed
+    # \param z Set to False to keep the domain boundaries along z fixed
+    # \param tolerance Boundaries along a direction are only adjusted if the maximum number of particles in a slab
+    #        exceeds the average by more than this factor
+    # \param period Domain boundaries are adjusted every \a period time steps
+    #
+    # \b Examples:
+    # \code
+    # update.balance()
+    # balancer = update.balance(x=False, y=False, tolerance=1.1, period=500)
+    # \endcode
+    #
+    # update.balance can only be used in simulations run with a domain decomposition.
+    def __init__(self, x=True, y=True, z=True, tolerance=1.05, period=1000):
+        util.print_status_line();
+
+        # initialize base class
+        _updater.__init__(self);
+
+        if not hoomd.is_MPI_available():
+            globals.msg.error("update.balance requires HOOMD-blue to be compiled with MPI support.\n");
+            raise RuntimeError("Error initializing load balancer");
+
+        cpp_decomposition = globals.system_definition.getParticleData().getDomainDecomposition();
+        if cpp_decomposition is None:
+            globals.msg.error("update.balance requires a domain decomposition (run with more than one MPI rank).\n");
+            raise RuntimeError("Error initializing load balancer");
+
+        # create the c++ mirror class
+        self.cpp_updater = hoomd.LoadBalancer(globals.system_definition, cpp_decomposition);
+        self.cpp_updater.setTolerance(tolerance);
+        self.cpp_updater.enableDirection(0, x);
+        self.cpp_updater.enableDirection(1, y);
+        self.cpp_updater.enableDirection(2, z);
+        self.setupUpdater(period);
+
+    ## Change load balancer parameters
+    #
+    # \param tolerance New tolerance (if set)
+    #
+    # \b Examples:
+    # \code
+    # balancer.set_params(tolerance=1.2)
+    # \endcode
+    def set_params(self, tolerance=None):
+        util.print_status_line();
+        self.check_initialization();
+
+        if tolerance is not None:
+            self.cpp_updater.setTolerance(tolerance);
+
 # Global current id counter to assign updaters unique names
 _updater.cur_id = 0;
@@ -97,7 +97,10 @@ from hoomd_script import util;
 #
 # The cutoff radius \f$ r_{\mathrm{cut}} \f$ is set once when wall.lj is specified (see __init__())
 #
-# \MPI_NOT_SUPPORTED
+# In multi-processor simulations, every processor only evaluates the walls that come within \f$ r_{\mathrm{cut}} \f$
+# of its domain.
+#
+# \MPI_SUPPORTED
 class lj(force._force):
     ## Specify the Lennard-Jones %wall %force
     #
@@ -112,12 +115,6 @@ class lj(force._force):
     def __init__(self, r_cut):
         util.print_status_line();
 
-        # Error out in MPI simulations
-        if (hoomd.is_MPI_available()):
-            if globals.system_definition.getParticleData().getDomainDecomposition():
-                globals.msg.error("wall.lj is not supported in multi-processor simulations.\n\n")
-                raise RuntimeError("Error setting up wall potential.")
-
         # initialize the base class
         force._force.__init__(self);
 
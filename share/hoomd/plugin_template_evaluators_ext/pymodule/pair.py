@@ -100,7 +100,7 @@ class lj2(pair.pair):
 
         # update the neighbor list
         neighbor_list = pair._update_global_nlist(r_cut);
-        neighbor_list.subscribe(lambda: self.log*self.get_max_rcut())
+        neighbor_list.subscribe(self.get_rcut)
 
         # create the c++ mirror class
         if not globals.exec_conf.isCUDAEnabled():
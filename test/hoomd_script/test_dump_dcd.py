@@ -27,6 +27,13 @@ class dmp_dcd_tests (unittest.TestCase):
         if (comm.get_rank() == 0):
             os.remove('dump_dcd')
 
+    # tests mpiio option
+    def test_mpiio(self):
+        dump.dcd(filename="dump_dcd", period=100, mpiio=False);
+        run(100)
+        if (comm.get_rank() == 0):
+            os.remove('dump_dcd')
+
     # tests unwrap_rigid option
     def test_unwrap_rigid(self):
         # only supported in single-processor mode
@@ -0,0 +1,41 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd_script import *
+import unittest
+import os
+
+# unit tests for dump.traj
+class dmp_traj_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        init.create_random(N=100, phi_p=0.05);
+
+        sorter.set_params(grid=8)
+
+    # tests basic creation of the dump
+    def test(self):
+        dump.traj(filename="dump_traj", period=100, overwrite=True);
+        run(100)
+        if (comm.get_rank() == 0):
+            os.remove('dump_traj')
+
+    # tests the optional blocks and compression
+    def test_options(self):
+        dump.traj(filename="dump_traj", period=10, overwrite=True, velocity=False, image=False, orientation=True, compress=True);
+        run(100)
+        if (comm.get_rank() == 0):
+            os.remove('dump_traj')
+
+    # tests writing on the main thread
+    def test_foreground(self):
+        dump.traj(filename="dump_traj", period=10, overwrite=True, background=False);
+        run(100)
+        if (comm.get_rank() == 0):
+            os.remove('dump_traj')
+
+    def tearDown(self):
+        init.reset();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
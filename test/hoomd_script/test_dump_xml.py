@@ -21,6 +21,21 @@ class dmp_xml_tests (unittest.TestCase):
     def test_variable(self):
         dump.xml(filename="dump_xml", period=lambda n: n*100);
 
+    # tests writing on the main thread
+    def test_foreground(self):
+        dump.xml(filename="dump_xml", period=100, background=False);
+
+    # test that the files written in the background are complete after run()
+    def test_background(self):
+        xml = dump.xml(filename="dump_xml_bg", period=5, all=True);
+        run(10);
+        for step in [0, 5]:
+            fname = "dump_xml_bg.%010d.xml" % step;
+            f = open(fname);
+            self.assertTrue(f.read().endswith("</hoomd_xml>\n"));
+            f.close();
+            os.remove(fname);
+
     # test set_params
     def test_set_params(self):
         xml = dump.xml(filename="dump_xml", period=100);
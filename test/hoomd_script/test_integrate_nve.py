@@ -10,7 +10,7 @@ class integrate_nve_tests (unittest.TestCase):
     def setUp(self):
         print
         init.create_random(N=100, phi_p=0.05);
-        force.constant(fx=0.1, fy=0.1, fz=0.1)
+        self.const = force.constant(fx=0.1, fy=0.1, fz=0.1)
 
         sorter.set_params(grid=8)
 
@@ -38,6 +38,47 @@ class integrate_nve_tests (unittest.TestCase):
         nve.set_params(limit=0.1);
         nve.set_params(zero_force=False);
 
+    # test multiple time step integration
+    def test_respa(self):
+        all = group.all();
+        mode = integrate.mode_standard(dt=0.005);
+        mode.set_respa(self.const, period=4);
+        integrate.nve(all);
+        run(10);
+        mode.set_respa(self.const, period=1);
+        run(10);
+        self.assertRaises(RuntimeError, mode.set_respa, self.const, period=0);
+
+    # test computing the forces in accumulate mode
+    def test_accumulate(self):
+        all = group.all();
+        lj = pair.lj(r_cut=3.0);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        mode = integrate.mode_standard(dt=0.005, accumulate=True);
+        integrate.nve(all);
+        run(10);
+        f = lj.forces[0].force;
+        run(10);
+        mode.set_params(accumulate=False);
+        run(10);
+        del lj
+
+    # test summing only the total virial for the pressure
+    def test_reduced_virial(self):
+        all = group.all();
+        lj = pair.lj(r_cut=3.0);
+        lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+        mode = integrate.mode_standard(dt=0.005, reduced_virial=True);
+        integrate.nve(all);
+        log = analyze.log(quantities=['pressure'], period=1, filename="test_reduced_virial.log", overwrite=True);
+        run(10);
+        mode.set_params(reduced_virial=False);
+        run(10);
+        del lj
+        del log
+        if comm.get_rank() == 0:
+            os.remove("test_reduced_virial.log");
+
     # test w/ empty group
     def test_empty(self):
         empty = group.cuboid(name="empty", xmin=-100, xmax=-100, ymin=-100, ymax=-100, zmin=-100, zmax=-100)
@@ -46,6 +87,7 @@ class integrate_nve_tests (unittest.TestCase):
         run(1);
 
     def tearDown(self):
+        del self.const
         init.reset();
 
 
@@ -0,0 +1,169 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+//! name the boost unit test module
+#define BOOST_TEST_MODULE BinaryAlignedTestsMPI
+#include "boost_utf_configure.h"
+
+#include "HOOMDMath.h"
+#include "ExecutionConfiguration.h"
+#include "SystemDefinition.h"
+#include "SnapshotSystemData.h"
+#include "HOOMDBinaryDumpWriter.h"
+#include "HOOMDBinaryInitializer.h"
+#include "DomainDecomposition.h"
+#include "saruprng.h"
+
+#include <boost/python.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstdio>
+
+using namespace boost;
+using namespace std;
+
+//! Write an aligned restart file in parallel, and read it back with every rank reading its own particles
+void test_binary_aligned_mpi(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+{
+    // random system with distinct values for every particle
+    unsigned int N = 1000;
+    Scalar L = Scalar(20.0);
+    boost::shared_ptr<SnapshotSystemData> snap(new SnapshotSystemData());
+    snap->global_box = BoxDim(L);
+    snap->particle_data.resize(N);
+    snap->particle_data.type_mapping.push_back("A");
+    snap->particle_data.type_mapping.push_back("B");
+    snap->bond_data.resize(N/2);
+    snap->bond_data.type_mapping = std::vector<std::string>(1, "polymer");
+
+    Saru saru(12345);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        snap->particle_data.pos[i] = make_scalar3(saru.s<Scalar>(-L/Scalar(2.0), L/Scalar(2.0)),
+                                                  saru.s<Scalar>(-L/Scalar(2.0), L/Scalar(2.0)),
+                                                  saru.s<Scalar>(-L/Scalar(2.0), L/Scalar(2.0)));
+        snap->particle_data.vel[i] = make_scalar3(saru.s<Scalar>(-1.0, 1.0), Scalar(i), Scalar(0.0));
+        snap->particle_data.image[i] = make_int3(i % 3, -int(i % 2), 0);
+        snap->particle_data.type[i] = i % 2;
+        snap->particle_data.charge[i] = Scalar(i)/Scalar(N);
+        }
+
+    for (unsigned int i = 0; i < N/2; i++)
+        {
+        snap->bond_data.groups[i].tag[0] = 2*i;
+        snap->bond_data.groups[i].tag[1] = 2*i+1;
+        }
+
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, snap->global_box.getL()));
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf, decomposition));
+
+    string fname("test_binary_aligned_mpi.bin");
+    boost::shared_ptr<HOOMDBinaryDumpWriter> writer(new HOOMDBinaryDumpWriter(sysdef, "test_binary_aligned_mpi"));
+    writer->enableAlignedOutput(true);
+    writer->writeFile(fname, 100);
+
+    MPI_Barrier(exec_conf->getMPICommunicator());
+
+    // read the file back into a new system
+    HOOMDBinaryInitializer init(exec_conf, fname);
+    boost::shared_ptr<DomainDecomposition> decomposition2(new DomainDecomposition(exec_conf, init.getBox().getL()));
+    boost::shared_ptr<SystemDefinition> sysdef2 = init.createSystemDefinition(exec_conf, decomposition2);
+    boost::shared_ptr<ParticleData> pdata2 = sysdef2->getParticleData();
+
+    // every rank holds only its own particles
+    BOOST_CHECK_EQUAL(pdata2->getNGlobal(), N);
+    BOOST_CHECK_EQUAL(pdata2->getN(), sysdef->getParticleData()->getN());
+    BOOST_CHECK_EQUAL(pdata2->getNTypes(), (unsigned int)2);
+    BOOST_CHECK_EQUAL(sysdef2->getBondData()->getNGlobal(), N/2);
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata2->getPositions(), access_location::host, access_mode::read);
+    BoxDim local_box = pdata2->getBox();
+    for (unsigned int i = 0; i < pdata2->getN(); i++)
+        {
+        Scalar3 f = local_box.makeFraction(make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z));
+        BOOST_CHECK(f.x >= Scalar(0.0) && f.x < Scalar(1.0));
+        BOOST_CHECK(f.y >= Scalar(0.0) && f.y < Scalar(1.0));
+        BOOST_CHECK(f.z >= Scalar(0.0) && f.z < Scalar(1.0));
+        }
+    }
+
+    // the snapshot of the new system matches the original one
+    SnapshotParticleData snap2;
+    pdata2->takeSnapshot(snap2);
+
+    if (exec_conf->getRank() == 0)
+        {
+        BOOST_CHECK_EQUAL(init.getTimeStep(), (unsigned int)100);
+        BOOST_REQUIRE_EQUAL(snap2.size, N);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            BOOST_CHECK_EQUAL(snap2.pos[i].x, snap->particle_data.pos[i].x);
+            BOOST_CHECK_EQUAL(snap2.pos[i].y, snap->particle_data.pos[i].y);
+            BOOST_CHECK_EQUAL(snap2.pos[i].z, snap->particle_data.pos[i].z);
+            BOOST_CHECK_EQUAL(snap2.vel[i].x, snap->particle_data.vel[i].x);
+            BOOST_CHECK_EQUAL(snap2.vel[i].y, snap->particle_data.vel[i].y);
+            BOOST_CHECK_EQUAL(snap2.image[i].x, snap->particle_data.image[i].x);
+            BOOST_CHECK_EQUAL(snap2.image[i].y, snap->particle_data.image[i].y);
+            BOOST_CHECK_EQUAL(snap2.type[i], snap->particle_data.type[i]);
+            BOOST_CHECK_EQUAL(snap2.charge[i], snap->particle_data.charge[i]);
+            }
+        }
+
+    MPI_Barrier(exec_conf->getMPICommunicator());
+    if (exec_conf->getRank() == 0)
+        remove(fname.c_str());
+}
+
+//! Tests the aligned binary restart format with MPI domain decomposition
+BOOST_AUTO_TEST_CASE( HOOMDBinaryAligned_MPI_test )
+    {
+    test_binary_aligned_mpi(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
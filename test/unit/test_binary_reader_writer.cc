@@ -57,6 +57,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "HOOMDBinaryDumpWriter.h"
 #include "HOOMDBinaryInitializer.h"
 #include "BondedGroupData.h"
+#include "SnapshotSystemData.h"
 
 #include <iostream>
 #include <sstream>
@@ -67,6 +68,8 @@ using namespace boost::filesystem;
 using namespace boost;
 
 #include <fstream>
+#include <vector>
+#include <iterator>
 using namespace std;
 
 //! Name the unit test module
@@ -277,6 +280,119 @@ BOOST_AUTO_TEST_CASE( HOOMDBinaryReaderWriterBasicTests )
     remove_all("test.0000000010.bin");
     }
 
+//! Tests writing and reading the aligned (memory-mapped) binary format
+BOOST_AUTO_TEST_CASE( HOOMDBinaryReaderWriterAlignedTests )
+    {
+    boost::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    // triclinic system with distinct values for every particle
+    BoxDim box(Scalar(10.0), Scalar(12.0), Scalar(14.0));
+    box.setTiltFactors(Scalar(0.1), Scalar(-0.2), Scalar(0.3));
+    unsigned int N = 100;
+
+    boost::shared_ptr<SnapshotSystemData> snap(new SnapshotSystemData());
+    snap->global_box = box;
+    snap->dimensions = 3;
+    SnapshotParticleData& pdata = snap->particle_data;
+    pdata.resize(N);
+    pdata.type_mapping.push_back("A");
+    pdata.type_mapping.push_back("B");
+    for (unsigned int i = 0; i < N; i++)
+        {
+        Scalar f = Scalar(i)/Scalar(N);
+        pdata.pos[i] = box.makeCoordinates(make_scalar3(Scalar(0.05) + Scalar(0.9)*f, Scalar(0.95) - Scalar(0.9)*f,
+                                                        Scalar(0.5)*f + Scalar(0.1)));
+        pdata.vel[i] = make_scalar3(f, -f, Scalar(2.0)*f);
+        pdata.accel[i] = make_scalar3(-f, f, Scalar(3.0)*f);
+        pdata.type[i] = i % 2;
+        pdata.mass[i] = Scalar(1.0) + f;
+        pdata.charge[i] = f - Scalar(0.5);
+        pdata.diameter[i] = Scalar(2.0) - f;
+        pdata.image[i] = make_int3(i % 3, -int(i % 5), i % 7);
+        pdata.body[i] = NO_BODY;
+        pdata.orientation[i] = make_scalar4(Scalar(1.0), f, Scalar(0.0), Scalar(0.0));
+        }
+
+    snap->bond_data.resize(2);
+    snap->bond_data.type_mapping = std::vector<std::string>(1, "polymer");
+    snap->bond_data.groups[0].tag[0] = 3; snap->bond_data.groups[0].tag[1] = 4;
+    snap->bond_data.groups[1].tag[0] = 4; snap->bond_data.groups[1].tag[1] = 5;
+
+    snap->wall_data.push_back(Wall(1,0,0, 0,1,0));
+
+    IntegratorVariables iv;
+    iv.type = "nvt";
+    iv.variable.push_back(Scalar(1.5));
+    snap->integrator_data.push_back(iv);
+
+    boost::shared_ptr<SystemDefinition> sysdef1(new SystemDefinition(snap, exec_conf));
+
+    boost::shared_ptr<HOOMDBinaryDumpWriter> writer(new HOOMDBinaryDumpWriter(sysdef1, "test_aligned"));
+    writer->enableAlignedOutput(true);
+    writer->writeFile("test_aligned.bin", 42);
+
+    BOOST_REQUIRE(HOOMDBinaryInitializer::isAlignedFile("test_aligned.bin"));
+
+    HOOMDBinaryInitializer init(exec_conf, "test_aligned.bin");
+    BOOST_CHECK_EQUAL(init.getTimeStep(), (unsigned int)42);
+
+    // initialize a system directly from the mapped file, and one from a copy in a snapshot
+    boost::shared_ptr<SystemDefinition> sysdef2 = init.createSystemDefinition(exec_conf);
+    boost::shared_ptr<SnapshotSystemData> snap_copy = init.getSnapshot();
+    BOOST_CHECK_EQUAL(snap_copy->particle_data.size, N);
+
+    boost::shared_ptr<ParticleData> pdata2 = sysdef2->getParticleData();
+    BOOST_REQUIRE_EQUAL(pdata2->getN(), N);
+    BOOST_CHECK_EQUAL(pdata2->getNTypes(), (unsigned int)2);
+    BOOST_CHECK_EQUAL(pdata2->getNameByType(1), "B");
+    MY_BOOST_CHECK_CLOSE(pdata2->getGlobalBox().getTiltFactorXY(), Scalar(0.1), tol);
+    MY_BOOST_CHECK_CLOSE(pdata2->getGlobalBox().getTiltFactorXZ(), Scalar(-0.2), tol);
+    MY_BOOST_CHECK_CLOSE(pdata2->getGlobalBox().getTiltFactorYZ(), Scalar(0.3), tol);
+
+    SnapshotParticleData pdata_out;
+    pdata2->takeSnapshot(pdata_out);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        BOOST_CHECK_EQUAL(pdata_out.pos[i].x, pdata.pos[i].x);
+        BOOST_CHECK_EQUAL(pdata_out.pos[i].y, pdata.pos[i].y);
+        BOOST_CHECK_EQUAL(pdata_out.pos[i].z, pdata.pos[i].z);
+        BOOST_CHECK_EQUAL(pdata_out.vel[i].z, pdata.vel[i].z);
+        BOOST_CHECK_EQUAL(pdata_out.accel[i].z, pdata.accel[i].z);
+        BOOST_CHECK_EQUAL(pdata_out.type[i], pdata.type[i]);
+        BOOST_CHECK_EQUAL(pdata_out.mass[i], pdata.mass[i]);
+        BOOST_CHECK_EQUAL(pdata_out.charge[i], pdata.charge[i]);
+        BOOST_CHECK_EQUAL(pdata_out.diameter[i], pdata.diameter[i]);
+        BOOST_CHECK_EQUAL(pdata_out.image[i].x, pdata.image[i].x);
+        BOOST_CHECK_EQUAL(pdata_out.image[i].y, pdata.image[i].y);
+        BOOST_CHECK_EQUAL(pdata_out.image[i].z, pdata.image[i].z);
+        BOOST_CHECK_EQUAL(pdata_out.body[i], pdata.body[i]);
+        BOOST_CHECK_EQUAL(pdata_out.orientation[i].y, pdata.orientation[i].y);
+
+        BOOST_CHECK_EQUAL(snap_copy->particle_data.pos[i].x, pdata.pos[i].x);
+        BOOST_CHECK_EQUAL(snap_copy->particle_data.charge[i], pdata.charge[i]);
+        }
+
+    BOOST_REQUIRE_EQUAL(sysdef2->getBondData()->getNGlobal(), (unsigned int)2);
+    BOOST_CHECK_EQUAL(sysdef2->getBondData()->getNameByType(0), "polymer");
+    BOOST_CHECK_EQUAL(sysdef2->getBondData()->getMembersByIndex(1).tag[1], (unsigned int)5);
+    BOOST_CHECK_EQUAL(sysdef2->getWallData()->getNumWalls(), (unsigned int)1);
+    BOOST_REQUIRE_EQUAL(sysdef2->getIntegratorData()->getNumIntegrators(), (unsigned int)1);
+    BOOST_CHECK_EQUAL(sysdef2->getIntegratorData()->getIntegratorVariables(0).type, "nvt");
+    BOOST_CHECK_EQUAL(sysdef2->getIntegratorData()->getIntegratorVariables(0).variable[0], Scalar(1.5));
+
+    // a truncated file is rejected
+    {
+    ifstream in("test_aligned.bin", ios::in | ios::binary);
+    vector<char> data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    ofstream out("test_aligned_truncated.bin", ios::out | ios::binary);
+    out.write(&data[0], data.size()/2);
+    }
+    BOOST_CHECK_THROW(HOOMDBinaryInitializer(exec_conf, "test_aligned_truncated.bin"), runtime_error);
+
+    remove_all("test_aligned.bin");
+    remove_all("test_aligned_truncated.bin");
+    }
+
 #ifdef WIN32
 #pragma warning( pop )
 #endif
@@ -65,10 +65,13 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ExecutionConfiguration.h"
 #include "Communicator.h"
 #include "DomainDecomposition.h"
+#include "LoadBalancer.h"
 
 #include "ConstForceCompute.h"
 #include "TwoStepNVE.h"
 #include "IntegratorTwoStep.h"
+#include "AllPairPotentials.h"
+#include "NeighborListBinned.h"
 
 #ifdef ENABLE_CUDA
 #include "CommunicatorGPU.h"
@@ -2634,6 +2637,575 @@ void test_communicator_ghost_fields(communicator_creator comm_creator, boost::sh
         }
     }
 
+//! Test that the pair forces computed while the ghosts are updated agree with a full computation
+void test_communicator_interior_forces(communicator_creator comm_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    BOOST_REQUIRE_EQUAL(size,8);
+
+    // a jittered simple cubic lattice
+    unsigned int n_side = 12;
+    unsigned int N = n_side*n_side*n_side;
+    Scalar L = Scalar(n_side);
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N,          // number of particles
+                                                             BoxDim(L),  // box dimensions
+                                                             1,          // number of particle types
+                                                             0,          // number of bond types
+                                                             0,          // number of angle types
+                                                             0,          // number of dihedral types
+                                                             0,          // number of dihedral types
+                                                             exec_conf));
+
+    boost::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    SnapshotParticleData snap(N);
+    snap.type_mapping.push_back("A");
+
+    srand(12345);
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        Scalar x = Scalar(i % n_side) + Scalar(0.2)*((Scalar)rand()/(Scalar)RAND_MAX - Scalar(0.5));
+        Scalar y = Scalar((i/n_side) % n_side) + Scalar(0.2)*((Scalar)rand()/(Scalar)RAND_MAX - Scalar(0.5));
+        Scalar z = Scalar(i/n_side/n_side) + Scalar(0.2)*((Scalar)rand()/(Scalar)RAND_MAX - Scalar(0.5));
+        snap.pos[i] = make_scalar3(x - L/Scalar(2.0) + Scalar(0.5), y - L/Scalar(2.0) + Scalar(0.5),
+                                   z - L/Scalar(2.0) + Scalar(0.5));
+        }
+
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL()));
+    boost::shared_ptr<Communicator> comm = comm_creator(sysdef, decomposition);
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+
+    // a half neighbor list, to also check the accumulation of forces on neighbors
+    Scalar r_cut = Scalar(1.5);
+    boost::shared_ptr<NeighborList> nlist(new NeighborListBinned(sysdef, r_cut, Scalar(0.4)));
+    nlist->setStorageMode(NeighborList::half);
+    nlist->setCommunicator(comm);
+
+    boost::shared_ptr<PotentialPairLJ> fc(new PotentialPairLJ(sysdef, nlist));
+    fc->setRcut(0, 0, r_cut);
+    fc->setParams(0, 0, make_scalar2(Scalar(4.0), Scalar(4.0)));
+    fc->setCommunicator(comm);
+
+    comm->addCommFlagsRequest(boost::bind(&PotentialPairLJ::getRequestedCommFlags, fc.get(), _1));
+    comm->addInteriorComputeCallback(boost::bind(&PotentialPairLJ::preComputeInterior, fc.get(), _1));
+
+    // the first step migrates particles and exchanges ghosts, the neighbor list is built
+    comm->communicate(0);
+    fc->compute(0);
+
+    // displace the particles by less than half the buffer, so that the ghosts are only updated in the next step
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        for (unsigned int idx = 0; idx < pdata->getN(); ++idx)
+            {
+            h_pos.data[idx].x += Scalar(0.05);
+            h_pos.data[idx].y -= Scalar(0.03);
+            h_pos.data[idx].z += Scalar(0.02);
+            }
+        }
+
+    comm->communicate(1);
+    fc->compute(1);
+
+    BOOST_CHECK(!nlist->hasBeenUpdated(1));
+    BOOST_CHECK(nlist->getNInterior() > 0);
+    BOOST_CHECK(nlist->getNInterior() < pdata->getN());
+
+    std::vector<Scalar4> force_split(pdata->getN());
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        std::copy(h_force.data, h_force.data + pdata->getN(), force_split.begin());
+        }
+
+    // recompute all forces in a single pass
+    fc->forceCompute(1);
+
+        {
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+        for (unsigned int idx = 0; idx < pdata->getN(); ++idx)
+            {
+            BOOST_CHECK_SMALL(force_split[idx].x - h_force.data[idx].x, Scalar(1e-5));
+            BOOST_CHECK_SMALL(force_split[idx].y - h_force.data[idx].y, Scalar(1e-5));
+            BOOST_CHECK_SMALL(force_split[idx].z - h_force.data[idx].z, Scalar(1e-5));
+            BOOST_CHECK_SMALL(force_split[idx].w - h_force.data[idx].w, Scalar(1e-5));
+            }
+        }
+    }
+
+//! Test that the forces with a half neighbor list and ghost force reduction agree with those of a full list
+void test_communicator_ghost_forces(communicator_creator comm_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    BOOST_REQUIRE_EQUAL(size,8);
+
+    // a jittered simple cubic lattice
+    unsigned int n_side = 10;
+    unsigned int N = n_side*n_side*n_side;
+    Scalar L = Scalar(n_side);
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N,          // number of particles
+                                                             BoxDim(L),  // box dimensions
+                                                             1,          // number of particle types
+                                                             0,          // number of bond types
+                                                             0,          // number of angle types
+                                                             0,          // number of dihedral types
+                                                             0,          // number of dihedral types
+                                                             exec_conf));
+
+    boost::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+    pdata->setFlags(~PDataFlags(0));
+
+    SnapshotParticleData snap(N);
+    snap.type_mapping.push_back("A");
+
+    srand(54321);
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        Scalar x = Scalar(i % n_side) + Scalar(0.2)*((Scalar)rand()/(Scalar)RAND_MAX - Scalar(0.5));
+        Scalar y = Scalar((i/n_side) % n_side) + Scalar(0.2)*((Scalar)rand()/(Scalar)RAND_MAX - Scalar(0.5));
+        Scalar z = Scalar(i/n_side/n_side) + Scalar(0.2)*((Scalar)rand()/(Scalar)RAND_MAX - Scalar(0.5));
+        snap.pos[i] = make_scalar3(x - L/Scalar(2.0) + Scalar(0.5), y - L/Scalar(2.0) + Scalar(0.5),
+                                   z - L/Scalar(2.0) + Scalar(0.5));
+        }
+
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL()));
+    boost::shared_ptr<Communicator> comm = comm_creator(sysdef, decomposition);
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+
+    // the same potential with a half and a full neighbor list
+    Scalar r_cut = Scalar(1.5);
+    boost::shared_ptr<PotentialPairLJ> fc[2];
+    for (unsigned int s = 0; s < 2; s++)
+        {
+        boost::shared_ptr<NeighborList> nlist(new NeighborListBinned(sysdef, r_cut, Scalar(0.4)));
+        nlist->setStorageMode(s == 0 ? NeighborList::half : NeighborList::full);
+        nlist->setCommunicator(comm);
+
+        fc[s] = boost::shared_ptr<PotentialPairLJ>(new PotentialPairLJ(sysdef, nlist));
+        fc[s]->setRcut(0, 0, r_cut);
+        fc[s]->setParams(0, 0, make_scalar2(Scalar(4.0), Scalar(4.0)));
+        fc[s]->setCommunicator(comm);
+        comm->addCommFlagsRequest(boost::bind(&PotentialPairLJ::getRequestedCommFlags, fc[s].get(), _1));
+        }
+
+    comm->communicate(0);
+    BOOST_REQUIRE(pdata->getNGhosts() > 0);
+
+    fc[0]->compute(0);
+    fc[1]->compute(0);
+
+    ArrayHandle<Scalar4> h_force_half(fc[0]->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_virial_half(fc[0]->getVirialArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_force_full(fc[1]->getForceArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_virial_full(fc[1]->getVirialArray(), access_location::host, access_mode::read);
+    unsigned int pitch_half = fc[0]->getVirialArray().getPitch();
+    unsigned int pitch_full = fc[1]->getVirialArray().getPitch();
+
+    for (unsigned int idx = 0; idx < pdata->getN(); ++idx)
+        {
+        BOOST_CHECK_SMALL(h_force_half.data[idx].x - h_force_full.data[idx].x, Scalar(1e-5));
+        BOOST_CHECK_SMALL(h_force_half.data[idx].y - h_force_full.data[idx].y, Scalar(1e-5));
+        BOOST_CHECK_SMALL(h_force_half.data[idx].z - h_force_full.data[idx].z, Scalar(1e-5));
+        BOOST_CHECK_SMALL(h_force_half.data[idx].w - h_force_full.data[idx].w, Scalar(1e-5));
+        for (unsigned int l = 0; l < 6; l++)
+            BOOST_CHECK_SMALL(h_virial_half.data[l*pitch_half+idx] - h_virial_full.data[l*pitch_full+idx], Scalar(1e-5));
+        }
+    }
+
+//! Test that per-particle values are copied to the ghosts
+void test_communicator_ghost_values(communicator_creator comm_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    BOOST_REQUIRE_EQUAL(size,8);
+
+    // a simple cubic lattice
+    unsigned int n_side = 8;
+    unsigned int N = n_side*n_side*n_side;
+    Scalar L = Scalar(n_side);
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N,          // number of particles
+                                                             BoxDim(L),  // box dimensions
+                                                             1,          // number of particle types
+                                                             0,          // number of bond types
+                                                             0,          // number of angle types
+                                                             0,          // number of dihedral types
+                                                             0,          // number of dihedral types
+                                                             exec_conf));
+
+    boost::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    SnapshotParticleData snap(N);
+    snap.type_mapping.push_back("A");
+    for (unsigned int i = 0; i < n_side; i++)
+        for (unsigned int j = 0; j < n_side; j++)
+            for (unsigned int k = 0; k < n_side; k++)
+                snap.pos[i*n_side*n_side + j*n_side + k] = make_scalar3(-L/Scalar(2.0) + Scalar(0.5) + Scalar(i),
+                                                                          -L/Scalar(2.0) + Scalar(0.5) + Scalar(j),
+                                                                          -L/Scalar(2.0) + Scalar(0.5) + Scalar(k));
+
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL()));
+    boost::shared_ptr<Communicator> comm = comm_creator(sysdef, decomposition);
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+
+    // a ghost layer that also contains the corner ghosts
+    comm->setGhostLayerWidth(Scalar(1.2));
+    comm->migrateParticles();
+    comm->exchangeGhosts();
+    BOOST_REQUIRE(pdata->getNGhosts() > 0);
+
+    GPUArray<Scalar> values(pdata->getN() + pdata->getNGhosts(), exec_conf);
+        {
+        ArrayHandle<Scalar> h_values(values, access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        for (unsigned int idx = 0; idx < pdata->getN(); ++idx)
+            h_values.data[idx] = Scalar(2*h_tag.data[idx] + 1);
+        for (unsigned int idx = pdata->getN(); idx < pdata->getN() + pdata->getNGhosts(); ++idx)
+            h_values.data[idx] = Scalar(-1.0);
+        }
+
+    comm->updateGhostValues(values);
+
+    ArrayHandle<Scalar> h_values(values, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+    for (unsigned int idx = 0; idx < pdata->getN() + pdata->getNGhosts(); ++idx)
+        BOOST_CHECK_EQUAL(h_values.data[idx], Scalar(2*h_tag.data[idx] + 1));
+    }
+
+//! Test that the ghost update with persistent requests agrees with the non-persistent one
+void test_communicator_persistent_update(communicator_creator comm_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    BOOST_REQUIRE_EQUAL(size,8);
+
+    // a simple cubic lattice
+    unsigned int n_side = 8;
+    unsigned int N = n_side*n_side*n_side;
+    Scalar L = Scalar(n_side);
+
+    SnapshotParticleData snap(N);
+    snap.type_mapping.push_back("A");
+    for (unsigned int i = 0; i < n_side; i++)
+        for (unsigned int j = 0; j < n_side; j++)
+            for (unsigned int k = 0; k < n_side; k++)
+                snap.pos[i*n_side*n_side + j*n_side + k] = make_scalar3(-L/Scalar(2.0) + Scalar(0.5) + Scalar(i),
+                                                                          -L/Scalar(2.0) + Scalar(0.5) + Scalar(j),
+                                                                          -L/Scalar(2.0) + Scalar(0.5) + Scalar(k));
+
+    // two identical systems, one with persistent and one with non-persistent communication
+    boost::shared_ptr<ParticleData> pdata[2];
+    boost::shared_ptr<Communicator> comm[2];
+    for (unsigned int s = 0; s < 2; s++)
+        {
+        boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N,          // number of particles
+                                                                 BoxDim(L),  // box dimensions
+                                                                 1,          // number of particle types
+                                                                 0,          // number of bond types
+                                                                 0,          // number of angle types
+                                                                 0,          // number of dihedral types
+                                                                 0,          // number of dihedral types
+                                                                 exec_conf));
+        pdata[s] = sysdef->getParticleData();
+
+        boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata[s]->getBox().getL()));
+        comm[s] = comm_creator(sysdef, decomposition);
+        pdata[s]->setDomainDecomposition(decomposition);
+        pdata[s]->initializeFromSnapshot(snap);
+        comm[s]->setGhostLayerWidth(Scalar(1.2));
+        comm[s]->setPersistentGhostUpdate(s == 0);
+
+        CommFlags flags(0);
+        flags[comm_flag::position] = 1;
+        flags[comm_flag::tag] = 1;
+        comm[s]->setFlags(flags);
+
+        comm[s]->migrateParticles();
+        comm[s]->exchangeGhosts();
+        BOOST_CHECK(pdata[s]->getNGhosts() > 0);
+        }
+
+    BOOST_REQUIRE_EQUAL(pdata[0]->getNGhosts(), pdata[1]->getNGhosts());
+
+    Scalar3 dx = make_scalar3(0.01,-0.02,0.015);
+    for (unsigned int step = 1; step <= 6; step++)
+        {
+        for (unsigned int s = 0; s < 2; s++)
+            {
+            // the velocities are also updated from the fourth step on
+            if (step == 4)
+                {
+                CommFlags flags = comm[s]->getFlags();
+                flags[comm_flag::velocity] = 1;
+                comm[s]->setFlags(flags);
+                }
+
+                {
+                ArrayHandle<Scalar4> h_pos(pdata[s]->getPositions(), access_location::host, access_mode::readwrite);
+                ArrayHandle<Scalar4> h_vel(pdata[s]->getVelocities(), access_location::host, access_mode::readwrite);
+                ArrayHandle<unsigned int> h_tag(pdata[s]->getTags(), access_location::host, access_mode::read);
+                for (unsigned int idx = 0; idx < pdata[s]->getN(); idx++)
+                    {
+                    h_pos.data[idx].x += dx.x;
+                    h_pos.data[idx].y += dx.y;
+                    h_pos.data[idx].z += dx.z;
+                    h_vel.data[idx].x = Scalar(h_tag.data[idx] + step);
+                    }
+                }
+
+            comm[s]->beginUpdateGhosts(step);
+            comm[s]->finishUpdateGhosts(step);
+            }
+
+        // compare the ghosts to the expected positions, and the two systems to each other
+        ArrayHandle<Scalar4> h_pos_0(pdata[0]->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel_0(pdata[0]->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag_0(pdata[0]->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_pos_1(pdata[1]->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag_1(pdata[1]->getRTags(), access_location::host, access_mode::read);
+
+        const BoxDim& global_box = pdata[0]->getGlobalBox();
+        for (unsigned int idx = pdata[0]->getN(); idx < pdata[0]->getN() + pdata[0]->getNGhosts(); idx++)
+            {
+            unsigned int tag = h_tag_0.data[idx];
+            Scalar3 expected = snap.pos[tag];
+            Scalar3 delta = make_scalar3(h_pos_0.data[idx].x - expected.x - Scalar(step)*dx.x,
+                                         h_pos_0.data[idx].y - expected.y - Scalar(step)*dx.y,
+                                         h_pos_0.data[idx].z - expected.z - Scalar(step)*dx.z);
+            delta = global_box.minImage(delta);
+            MY_BOOST_CHECK_SMALL(delta.x, tol_small);
+            MY_BOOST_CHECK_SMALL(delta.y, tol_small);
+            MY_BOOST_CHECK_SMALL(delta.z, tol_small);
+
+            unsigned int idx_1 = h_rtag_1.data[tag];
+            BOOST_REQUIRE(idx_1 >= pdata[1]->getN() && idx_1 < pdata[1]->getN() + pdata[1]->getNGhosts());
+            BOOST_CHECK_EQUAL(h_pos_0.data[idx].x, h_pos_1.data[idx_1].x);
+            BOOST_CHECK_EQUAL(h_pos_0.data[idx].y, h_pos_1.data[idx_1].y);
+            BOOST_CHECK_EQUAL(h_pos_0.data[idx].z, h_pos_1.data[idx_1].z);
+
+            if (step >= 4)
+                MY_BOOST_CHECK_CLOSE(h_vel_0.data[idx].x, Scalar(tag + step), tol);
+            }
+        }
+    }
+
+//! Test that the snapshots gathered from all ranks are complete and in tag order
+void test_communicator_snapshot_gather(communicator_creator comm_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    BOOST_REQUIRE_EQUAL(size,8);
+
+    // create a system with eight particles
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(8,           // number of particles
+                                                             BoxDim(2.0), // box dimensions
+                                                             2,           // number of particle types
+                                                             1,           // number of bond types
+                                                             0,           // number of angle types
+                                                             0,           // number of dihedral types
+                                                             0,           // number of dihedral types
+                                                             exec_conf));
+
+    boost::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // place one particle in every domain, with distinct properties
+    for (unsigned int i = 0; i < 8; i++)
+        {
+        Scalar x = (i & 1) ? Scalar(0.4) : Scalar(-0.4);
+        Scalar y = (i & 2) ? Scalar(0.4) : Scalar(-0.4);
+        Scalar z = (i & 4) ? Scalar(0.4) : Scalar(-0.4);
+        pdata->setPosition(i, make_scalar3(x,y,z),false);
+        pdata->setVelocity(i, make_scalar3(Scalar(i),Scalar(2*i),Scalar(3*i)));
+        pdata->setType(i, i % 2);
+        pdata->setMass(i, Scalar(1+i));
+        pdata->setCharge(i, Scalar(10+i));
+        pdata->setDiameter(i, Scalar(20+i));
+        pdata->setOrientation(i, make_scalar4(Scalar(i),Scalar(1),Scalar(2),Scalar(3)));
+        }
+
+    // bond the particles together, forming a cube
+    boost::shared_ptr<BondData> bdata(sysdef->getBondData());
+    bdata->addBondedGroup(Bond(0,0,1));
+    bdata->addBondedGroup(Bond(0,0,2));
+    bdata->addBondedGroup(Bond(0,0,4));
+    bdata->addBondedGroup(Bond(0,1,3));
+    bdata->addBondedGroup(Bond(0,1,5));
+    bdata->addBondedGroup(Bond(0,2,3));
+    bdata->addBondedGroup(Bond(0,2,6));
+    bdata->addBondedGroup(Bond(0,3,7));
+    bdata->addBondedGroup(Bond(0,4,5));
+    bdata->addBondedGroup(Bond(0,4,6));
+    bdata->addBondedGroup(Bond(0,5,7));
+    bdata->addBondedGroup(Bond(0,6,7));
+
+    SnapshotParticleData snap(8);
+    pdata->takeSnapshot(snap);
+
+    BondData::Snapshot bdata_snap(12);
+    bdata->takeSnapshot(bdata_snap);
+
+    // initialize a 2x2x2 domain decomposition
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL()));
+    boost::shared_ptr<Communicator> comm = comm_creator(sysdef, decomposition);
+    comm->setGhostLayerWidth(Scalar(0.1));
+
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+    bdata->initializeFromSnapshot(bdata_snap);
+
+    // move particle 0 into the domain of particle 7, across the periodic boundaries
+    Scalar3 new_pos = make_scalar3(0.8, 0.7, 0.6);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(pdata->getRTags(), access_location::host, access_mode::read);
+        unsigned int idx = h_rtag.data[0];
+        if (idx < pdata->getN())
+            {
+            h_pos.data[idx].x = Scalar(-1.2);
+            h_pos.data[idx].y = Scalar(-1.3);
+            h_pos.data[idx].z = Scalar(-1.4);
+            }
+        }
+
+    comm->migrateParticles();
+
+    SnapshotParticleData snap_gathered(8);
+    pdata->takeSnapshot(snap_gathered);
+
+    BondData::Snapshot bdata_snap_gathered(12);
+    bdata->takeSnapshot(bdata_snap_gathered);
+
+    if (exec_conf->getRank() == 0)
+        {
+        for (unsigned int i = 0; i < 8; i++)
+            {
+            Scalar3 pos = (i == 0) ? new_pos : snap.pos[i];
+            MY_BOOST_CHECK_CLOSE(snap_gathered.pos[i].x, pos.x, tol);
+            MY_BOOST_CHECK_CLOSE(snap_gathered.pos[i].y, pos.y, tol);
+            MY_BOOST_CHECK_CLOSE(snap_gathered.pos[i].z, pos.z, tol);
+
+            int3 image = (i == 0) ? make_int3(-1,-1,-1) : make_int3(0,0,0);
+            BOOST_CHECK_EQUAL(snap_gathered.image[i].x, image.x);
+            BOOST_CHECK_EQUAL(snap_gathered.image[i].y, image.y);
+            BOOST_CHECK_EQUAL(snap_gathered.image[i].z, image.z);
+
+            MY_BOOST_CHECK_CLOSE(snap_gathered.vel[i].z, Scalar(3*i), tol);
+            BOOST_CHECK_EQUAL(snap_gathered.type[i], i % 2);
+            MY_BOOST_CHECK_CLOSE(snap_gathered.mass[i], Scalar(1+i), tol);
+            MY_BOOST_CHECK_CLOSE(snap_gathered.charge[i], Scalar(10+i), tol);
+            MY_BOOST_CHECK_CLOSE(snap_gathered.diameter[i], Scalar(20+i), tol);
+            MY_BOOST_CHECK_CLOSE(snap_gathered.orientation[i].x, Scalar(i), tol);
+            }
+
+        for (unsigned int i = 0; i < 12; i++)
+            {
+            BOOST_CHECK_EQUAL(bdata_snap_gathered.type_id[i], bdata_snap.type_id[i]);
+            BOOST_CHECK_EQUAL(bdata_snap_gathered.groups[i].tag[0], bdata_snap.groups[i].tag[0]);
+            BOOST_CHECK_EQUAL(bdata_snap_gathered.groups[i].tag[1], bdata_snap.groups[i].tag[1]);
+            }
+        }
+    }
+
+//! Test that the LoadBalancer equalizes the number of particles per rank
+void test_load_balancer(communicator_creator comm_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    BOOST_REQUIRE_EQUAL(size,8);
+
+    // a slab of particles that fills only the lower quarter of the box along z
+    unsigned int n_xy = 16;
+    unsigned int n_z = 4;
+    unsigned int N = n_xy*n_xy*n_z;
+    Scalar L = Scalar(16.0);
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(N,          // number of particles
+                                                             BoxDim(L),  // box dimensions
+                                                             1,          // number of particle types
+                                                             0,          // number of bond types
+                                                             0,          // number of angle types
+                                                             0,          // number of dihedral types
+                                                             0,          // number of dihedral types
+                                                             exec_conf));
+
+    boost::shared_ptr<ParticleData> pdata(sysdef->getParticleData());
+
+    // put more particles into the lower half of the box along x
+    for (unsigned int i = 0; i < n_xy; i++)
+        for (unsigned int j = 0; j < n_xy; j++)
+            for (unsigned int k = 0; k < n_z; k++)
+                {
+                Scalar x = -L/Scalar(2.0) + Scalar(0.25) + Scalar(0.6)*Scalar(i);
+                if (i >= 12)
+                    x = Scalar(i)-Scalar(8.0);
+                Scalar y = -L/Scalar(2.0) + Scalar(0.5) + Scalar(j);
+                Scalar z = -L/Scalar(2.0) + Scalar(0.5) + Scalar(k);
+                pdata->setPosition(i*n_xy*n_z + j*n_z + k, make_scalar3(x,y,z),false);
+                }
+
+    SnapshotParticleData snap(N);
+    pdata->takeSnapshot(snap);
+
+    // initialize a 2x2x2 domain decomposition
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, pdata->getBox().getL()));
+    boost::shared_ptr<Communicator> comm = comm_creator(sysdef, decomposition);
+    pdata->setDomainDecomposition(decomposition);
+    pdata->initializeFromSnapshot(snap);
+
+    Scalar ghost_layer_width = Scalar(1.0);
+    comm->setGhostLayerWidth(ghost_layer_width);
+
+    boost::shared_ptr<LoadBalancer> balancer(new LoadBalancer(sysdef, decomposition));
+    balancer->setCommunicator(comm);
+
+    // all particles are in the lower half of the box along z, and three quarters of them in the lower half along x
+    Scalar imbalance_before = balancer->getImbalance();
+    MY_BOOST_CHECK_CLOSE(imbalance_before, 3.0, tol);
+
+    for (unsigned int i = 0; i < 20; i++)
+        {
+        balancer->update(i);
+        comm->migrateParticles();
+        }
+
+    Scalar imbalance_after = balancer->getImbalance();
+    BOOST_CHECK(imbalance_after < Scalar(1.2));
+    BOOST_CHECK(imbalance_after < imbalance_before);
+
+    // no particles have been lost
+    unsigned int n_global = pdata->getN();
+    MPI_Allreduce(MPI_IN_PLACE, &n_global, 1, MPI_UNSIGNED, MPI_SUM, MPI_COMM_WORLD);
+    BOOST_CHECK_EQUAL(n_global, N);
+
+    // every particle is inside its local box
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        const BoxDim& local_box = pdata->getBox();
+        for (unsigned int idx = 0; idx < pdata->getN(); ++idx)
+            {
+            Scalar3 f = local_box.makeFraction(make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z));
+            BOOST_CHECK(f.x >= Scalar(0.0) && f.x < Scalar(1.0));
+            BOOST_CHECK(f.y >= Scalar(0.0) && f.y < Scalar(1.0));
+            BOOST_CHECK(f.z >= Scalar(0.0) && f.z < Scalar(1.0));
+            }
+        }
+
+    // the boundaries along z are consistent with the local box
+    const std::vector<Scalar>& cum_frac_z = decomposition->getCumulativeFractions(2);
+    BOOST_REQUIRE_EQUAL(cum_frac_z.size(), 3);
+    BOOST_CHECK(cum_frac_z[1] < Scalar(0.5));
+    MY_BOOST_CHECK_CLOSE(pdata->getBox().getL().z,
+        (cum_frac_z[decomposition->getGridPos().z+1]-cum_frac_z[decomposition->getGridPos().z])*L, tol);
+    }
+
 //! Communicator creator for unit tests
 boost::shared_ptr<Communicator> base_class_communicator_creator(boost::shared_ptr<SystemDefinition> sysdef,
                                                          boost::shared_ptr<DomainDecomposition> decomposition)
@@ -2698,6 +3270,42 @@ BOOST_AUTO_TEST_CASE( communicator_ghost_fields_test )
     test_communicator_ghost_fields(communicator_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+BOOST_AUTO_TEST_CASE( load_balancer_test )
+    {
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_load_balancer(communicator_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+BOOST_AUTO_TEST_CASE( communicator_interior_forces_test )
+    {
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_interior_forces(communicator_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+BOOST_AUTO_TEST_CASE( communicator_ghost_forces_test )
+    {
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_ghost_forces(communicator_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+BOOST_AUTO_TEST_CASE( communicator_ghost_values_test )
+    {
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_ghost_values(communicator_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+BOOST_AUTO_TEST_CASE( communicator_persistent_update_test )
+    {
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_persistent_update(communicator_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+BOOST_AUTO_TEST_CASE( communicator_snapshot_gather_test )
+    {
+    communicator_creator communicator_creator_base = bind(base_class_communicator_creator, _1, _2);
+    test_communicator_snapshot_gather(communicator_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 
 //! Tests particle distribution on GPU
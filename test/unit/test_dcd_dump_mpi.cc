@@ -0,0 +1,152 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! name the boost unit test module
+#define BOOST_TEST_MODULE DCDDumpWriterTestsMPI
+#include "boost_utf_configure.h"
+
+#include "HOOMDMath.h"
+#include "ExecutionConfiguration.h"
+#include "SystemDefinition.h"
+#include "SnapshotSystemData.h"
+#include "DCDDumpWriter.h"
+#include "Communicator.h"
+#include "DomainDecomposition.h"
+#include "saruprng.h"
+
+#include <boost/python.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <fstream>
+#include <vector>
+
+using namespace boost;
+using namespace std;
+
+//! Read a whole file into memory
+static vector<char> read_file(const string& fname)
+    {
+    ifstream f(fname.c_str(), ios::in | ios::binary);
+    return vector<char>((istreambuf_iterator<char>(f)), istreambuf_iterator<char>());
+    }
+
+//! Compare the DCD files written collectively with MPI-IO and by the root processor
+void test_dcd_dump_mpi(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+{
+    // random system
+    unsigned int N = 1000;
+    Scalar L = Scalar(20.0);
+    boost::shared_ptr<SnapshotSystemData> snap(new SnapshotSystemData());
+    snap->global_box = BoxDim(L);
+    snap->particle_data.resize(N);
+    snap->particle_data.type_mapping.push_back("A");
+
+    Saru saru(12345);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        snap->particle_data.pos[i] = make_scalar3(saru.s<Scalar>(-L/Scalar(2.0), L/Scalar(2.0)),
+                                                  saru.s<Scalar>(-L/Scalar(2.0), L/Scalar(2.0)),
+                                                  saru.s<Scalar>(-L/Scalar(2.0), L/Scalar(2.0)));
+        snap->particle_data.image[i] = make_int3(i % 3, -int(i % 2), 0);
+        }
+
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, snap->global_box.getL()));
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf, decomposition));
+    boost::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+
+    // write only a part of the particles
+    boost::shared_ptr<ParticleSelector> selector(new ParticleSelectorTag(sysdef, 100, 599));
+    boost::shared_ptr<ParticleGroup> group(new ParticleGroup(sysdef, selector));
+    unsigned int n_group = 500;
+
+    string fname_mpiio("test_dcd_dump_mpi_mpiio.dcd");
+    string fname_root("test_dcd_dump_mpi_root.dcd");
+
+    boost::shared_ptr<DCDDumpWriter> writer_mpiio(new DCDDumpWriter(sysdef, fname_mpiio, 10, group, true));
+    writer_mpiio->setCommunicator(comm);
+    writer_mpiio->setUnwrapFull(true);
+
+    boost::shared_ptr<DCDDumpWriter> writer_root(new DCDDumpWriter(sysdef, fname_root, 10, group, true));
+    writer_root->setCommunicator(comm);
+    writer_root->setUnwrapFull(true);
+    writer_root->setMPIIO(false);
+
+    for (unsigned int timestep = 0; timestep <= 20; timestep += 10)
+        {
+        writer_mpiio->analyze(timestep);
+        writer_root->analyze(timestep);
+        }
+
+    MPI_Barrier(exec_conf->getMPICommunicator());
+
+    if (exec_conf->getRank() == 0)
+        {
+        vector<char> data_mpiio = read_file(fname_mpiio);
+        vector<char> data_root = read_file(fname_root);
+
+        // file header, and three frames with a header and three coordinate blocks
+        unsigned int frame_size = 56 + 3*(2*sizeof(unsigned int) + n_group*sizeof(float));
+        BOOST_REQUIRE_EQUAL(data_root.size(), 276 + 3*frame_size);
+        BOOST_REQUIRE_EQUAL(data_mpiio.size(), data_root.size());
+
+        // the files are identical, except for the creation time string in the header
+        for (unsigned int i = 0; i < data_root.size(); i++)
+            if (i < 180 || i >= 260)
+                BOOST_CHECK_EQUAL(data_mpiio[i], data_root[i]);
+
+        remove(fname_mpiio.c_str());
+        remove(fname_root.c_str());
+        }
+}
+
+//! Tests the collective DCD output with MPI domain decomposition
+BOOST_AUTO_TEST_CASE( DCDDumpWriter_MPI_test )
+    {
+    test_dcd_dump_mpi(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
@@ -0,0 +1,220 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! name the boost unit test module
+#define BOOST_TEST_MODULE FIREEnergyMinimizerTestsMPI
+#include "boost_utf_configure.h"
+
+#include "HOOMDMath.h"
+#include "ExecutionConfiguration.h"
+#include "System.h"
+#include "FIREEnergyMinimizer.h"
+#include "AllPairPotentials.h"
+#include "NeighborListBinned.h"
+#include "RandomGenerator.h"
+
+#include <boost/python.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <math.h>
+
+#include "Communicator.h"
+#include "DomainDecomposition.h"
+
+#ifdef ENABLE_CUDA
+#include "FIREEnergyMinimizerGPU.h"
+#include "CommunicatorGPU.h"
+#endif
+
+using namespace boost;
+
+//! Compares FIRE energy minimization with domain decomposition to a single-rank minimization
+void test_fire_energy_minimizer_mpi(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+{
+    // initialize random particle system
+    Scalar phi_p = 0.2;
+    unsigned int N = 2000;
+    Scalar L = pow(M_PI/6.0/phi_p*Scalar(N),1.0/3.0);
+    BoxDim box_g(L);
+    RandomGenerator rand_init(exec_conf, box_g, 12345, 3);
+    std::vector<string> types;
+    types.push_back("A");
+    std::vector<unsigned int> bonds;
+    std::vector<string> bond_types;
+    rand_init.addGenerator((int)N, boost::shared_ptr<PolymerParticleGenerator>(new PolymerParticleGenerator(exec_conf, 1.0, types, bonds, bonds, bond_types, 100, 3)));
+    rand_init.setSeparationRadius("A", .4);
+
+    rand_init.generate();
+
+    boost::shared_ptr<SnapshotSystemData> snap;
+    snap = rand_init.getSnapshot();
+
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf,snap->global_box.getL()));
+
+    boost::shared_ptr<SystemDefinition> sysdef_1(new SystemDefinition(snap, exec_conf,decomposition));
+
+    // initialize a second system (single proc) on rank zero
+    boost::shared_ptr<SystemDefinition> sysdef_2;
+    if (exec_conf->getRank() == 0)
+        sysdef_2 = boost::shared_ptr<SystemDefinition>(new SystemDefinition(snap, exec_conf));
+
+    boost::shared_ptr<ParticleData> pdata_1 = sysdef_1->getParticleData();
+
+    boost::shared_ptr<Communicator> comm;
+#ifdef ENABLE_CUDA
+    if (exec_conf->isCUDAEnabled())
+        comm = boost::shared_ptr<Communicator>(new CommunicatorGPU(sysdef_1, decomposition));
+    else
+#endif
+        comm = boost::shared_ptr<Communicator>(new Communicator(sysdef_1,decomposition));
+
+    boost::shared_ptr<ParticleSelector> selector_all_1(new ParticleSelectorTag(sysdef_1, 0, pdata_1->getNGlobal()-1));
+    boost::shared_ptr<ParticleGroup> group_all_1(new ParticleGroup(sysdef_1, selector_all_1));
+
+    boost::shared_ptr<ParticleGroup> group_all_2;
+    if (exec_conf->getRank() ==0)
+        {
+        boost::shared_ptr<ParticleSelector> selector_all_2(new ParticleSelectorTag(sysdef_2, 0, N-1));
+        group_all_2 = boost::shared_ptr<ParticleGroup>(new ParticleGroup(sysdef_2, selector_all_2));
+        }
+
+    Scalar r_cut = Scalar(2.5);
+    Scalar r_buff = Scalar(0.4);
+
+    // setup some values for alpha and sigma
+    Scalar epsilon = Scalar(1.0);
+    Scalar sigma = Scalar(1.0);
+    Scalar alpha = Scalar(1.0);
+    Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+    Scalar lj2 = alpha * Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+
+    boost::shared_ptr<NeighborList> nlist_1(new NeighborListBinned(sysdef_1, r_cut, r_buff));
+    nlist_1->setStorageMode(NeighborList::full);
+    nlist_1->setCommunicator(comm);
+    boost::shared_ptr<PotentialPairLJ> fc_1(new PotentialPairLJ(sysdef_1, nlist_1));
+    fc_1->setRcut(0, 0, r_cut);
+    fc_1->setParams(0,0,make_scalar2(lj1,lj2));
+    fc_1->setCommunicator(comm);
+
+    boost::shared_ptr<NeighborList> nlist_2;
+    boost::shared_ptr<PotentialPairLJ> fc_2;
+    if (exec_conf->getRank() == 0)
+        {
+        nlist_2 = boost::shared_ptr<NeighborList>(new NeighborListBinned(sysdef_2, r_cut, r_buff));
+        nlist_2->setStorageMode(NeighborList::full);
+        fc_2 = boost::shared_ptr<PotentialPairLJ>(new PotentialPairLJ(sysdef_2, nlist_2));
+        fc_2->setRcut(0, 0, r_cut);
+        fc_2->setParams(0,0,make_scalar2(lj1,lj2));
+        }
+
+    Scalar dt = Scalar(0.005);
+    boost::shared_ptr<FIREEnergyMinimizer> fire_1;
+    boost::shared_ptr<FIREEnergyMinimizer> fire_2;
+#ifdef ENABLE_CUDA
+    if (exec_conf->isCUDAEnabled())
+        {
+        fire_1 = boost::shared_ptr<FIREEnergyMinimizer>(new FIREEnergyMinimizerGPU(sysdef_1, group_all_1, dt));
+        if (exec_conf->getRank() == 0)
+            fire_2 = boost::shared_ptr<FIREEnergyMinimizer>(new FIREEnergyMinimizerGPU(sysdef_2, group_all_2, dt));
+        }
+    else
+#endif
+        {
+        fire_1 = boost::shared_ptr<FIREEnergyMinimizer>(new FIREEnergyMinimizer(sysdef_1, group_all_1, dt));
+        if (exec_conf->getRank() == 0)
+            fire_2 = boost::shared_ptr<FIREEnergyMinimizer>(new FIREEnergyMinimizer(sysdef_2, group_all_2, dt));
+        }
+
+    fire_1->addForceCompute(fc_1);
+    fire_1->setCommunicator(comm);
+    fire_1->prepRun(0);
+
+    if (exec_conf->getRank() == 0)
+        {
+        fire_2->addForceCompute(fc_2);
+        fire_2->prepRun(0);
+        }
+
+    // the adaptive time step and the convergence flag depend only on the global power and norms,
+    // so they have to follow the single-rank minimization exactly
+    for (unsigned int i = 0; i < 100; i++)
+        {
+        fire_1->update(i);
+        if (exec_conf->getRank() == 0)
+            {
+            fire_2->update(i);
+            MY_BOOST_CHECK_CLOSE(fire_1->getDeltaT(), fire_2->getDeltaT(), tol_small);
+            BOOST_CHECK_EQUAL(fire_1->hasConverged(), fire_2->hasConverged());
+            }
+        }
+
+    // compare the minimized energies
+    fc_1->compute(100);
+    Scalar energy_1 = fc_1->calcEnergySum();
+    if (exec_conf->getRank() == 0)
+        {
+        fc_2->compute(100);
+        Scalar energy_2 = fc_2->calcEnergySum();
+        MY_BOOST_CHECK_CLOSE(energy_1, energy_2, tol);
+        }
+}
+
+//! Tests MPI domain decomposition with the FIRE energy minimizer
+BOOST_AUTO_TEST_CASE( DomainDecomposition_FIRE_test )
+    {
+    test_fire_energy_minimizer_mpi(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_CUDA
+//! Tests MPI domain decomposition with the FIRE energy minimizer on the GPU
+BOOST_AUTO_TEST_CASE( DomainDecomposition_FIRE_test_GPU )
+    {
+    test_fire_energy_minimizer_mpi(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+#endif
@@ -61,6 +61,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AllBondPotentials.h"
 #include "ConstForceCompute.h"
 #include "SnapshotSystemData.h"
+#include "SFCPackUpdater.h"
 
 #include "Initializers.h"
 
@@ -493,6 +494,152 @@ void const_force_test(boost::shared_ptr<ExecutionConfiguration> exec_conf)
     }
     }
 
+//! Checks that the reduced virial mode of a bond force sums up the per-particle virial
+void bond_force_reduced_virial_tests(bondforce_creator bf_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // create a particle system with a chain of bonds
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    boost::shared_ptr<SnapshotSystemData> snap = rand_init.getSnapshot();
+    snap->bond_data.type_mapping.push_back("A");
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    boost::shared_ptr<PotentialBondHarmonic> fc = bf_creator(sysdef);
+    fc->setParams(0, make_scalar2(Scalar(300.0), Scalar(1.6)));
+
+    for (unsigned int i = 0; i < N-1; i++)
+        {
+        sysdef->getBondData()->addBondedGroup(Bond(0, i, i+1));
+        }
+
+    // sum up the per-particle virial as a reference
+    fc->compute(0);
+    BOOST_CHECK(!fc->isVirialReduced());
+    double ref_virial[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    GPUArray<Scalar4> ref_force(N, exec_conf);
+    {
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(),access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial(fc->getVirialArray(),access_location::host,access_mode::read);
+    ArrayHandle<Scalar4> h_ref_force(ref_force,access_location::host,access_mode::overwrite);
+    unsigned int pitch = fc->getVirialArray().getPitch();
+    for (unsigned int i = 0; i < N; i++)
+        {
+        h_ref_force.data[i] = h_force.data[i];
+        for (unsigned int j = 0; j < 6; j++)
+            ref_virial[j] += double(h_virial.data[j*pitch+i]);
+        }
+    }
+
+    // the reduced mode computes the same forces and only the total virial
+    pdata->setReducedVirial(true);
+    fc->compute(1);
+    BOOST_CHECK(fc->isVirialReduced());
+    {
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(),access_location::host,access_mode::read);
+    ArrayHandle<Scalar4> h_ref_force(ref_force,access_location::host,access_mode::read);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        MY_BOOST_CHECK_CLOSE(h_force.data[i].x, h_ref_force.data[i].x, tol);
+        MY_BOOST_CHECK_CLOSE(h_force.data[i].y, h_ref_force.data[i].y, tol);
+        MY_BOOST_CHECK_CLOSE(h_force.data[i].z, h_ref_force.data[i].z, tol);
+        MY_BOOST_CHECK_CLOSE(h_force.data[i].w, h_ref_force.data[i].w, tol);
+        }
+    }
+    for (unsigned int j = 0; j < 6; j++)
+        {
+        if (fabs(ref_virial[j]) > loose_tol)
+            MY_BOOST_CHECK_CLOSE(fc->getVirialTotal(j), ref_virial[j], tol);
+        else
+            MY_BOOST_CHECK_SMALL(fc->getVirialTotal(j), loose_tol);
+        }
+
+    // switching the mode off restores the per-particle virial
+    pdata->setReducedVirial(false);
+    fc->compute(2);
+    BOOST_CHECK(!fc->isVirialReduced());
+    }
+
+//! Checks that the bond index table follows the particle sort
+void bond_force_sort_tests(bondforce_creator bf_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // create a particle system with a chain of bonds
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    boost::shared_ptr<SnapshotSystemData> snap = rand_init.getSnapshot();
+    snap->bond_data.type_mapping.push_back("A");
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    boost::shared_ptr<BondData> bond_data = sysdef->getBondData();
+    pdata->setFlags(~PDataFlags(0));
+
+    boost::shared_ptr<PotentialBondHarmonic> fc = bf_creator(sysdef);
+    fc->setParams(0, make_scalar2(Scalar(300.0), Scalar(1.6)));
+
+    for (unsigned int i = 0; i < N-1; i++)
+        {
+        bond_data->addBondedGroup(Bond(0, i, i+1));
+        }
+
+    // forces by tag before the sort
+    fc->compute(0);
+    std::vector<Scalar4> ref_force(N);
+    {
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(),access_location::host,access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(),access_location::host,access_mode::read);
+    for (unsigned int i = 0; i < N; i++)
+        ref_force[h_tag.data[i]] = h_force.data[i];
+    }
+
+    // reorder the particles in memory
+    boost::shared_ptr<SFCPackUpdater> sorter(new SFCPackUpdater(sysdef));
+    sorter->update(0);
+
+    // the table must list every bond with the current particle indices, ordered by the lowest member index
+    {
+    ArrayHandle<BondData::members_t> h_bonds(bond_data->getIndexTable(),access_location::host,access_mode::read);
+    ArrayHandle<unsigned int> h_type(bond_data->getIndexTableTypes(),access_location::host,access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(),access_location::host,access_mode::read);
+
+    BOOST_REQUIRE_EQUAL(bond_data->getN(), N-1);
+    unsigned int last_idx = 0;
+    unsigned int n_wrong = 0;
+    for (unsigned int i = 0; i < N-1; i++)
+        {
+        unsigned int idx_a = h_bonds.data[i].idx[0];
+        unsigned int idx_b = h_bonds.data[i].idx[1];
+        BOOST_REQUIRE(idx_a < N && idx_b < N);
+        unsigned int tag_a = h_tag.data[idx_a];
+        unsigned int tag_b = h_tag.data[idx_b];
+        if (tag_b != tag_a+1 || h_type.data[i] != 0)
+            n_wrong++;
+
+        unsigned int first_idx = std::min(idx_a, idx_b);
+        BOOST_CHECK(first_idx >= last_idx);
+        last_idx = first_idx;
+        }
+    BOOST_CHECK_EQUAL(n_wrong, (unsigned int)0);
+    }
+
+    // the forces on each particle are the same after the sort
+    fc->compute(1);
+    {
+    ArrayHandle<Scalar4> h_force(fc->getForceArray(),access_location::host,access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(),access_location::host,access_mode::read);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        unsigned int tag = h_tag.data[i];
+        MY_BOOST_CHECK_CLOSE(h_force.data[i].x, ref_force[tag].x, tol);
+        MY_BOOST_CHECK_CLOSE(h_force.data[i].y, ref_force[tag].y, tol);
+        MY_BOOST_CHECK_CLOSE(h_force.data[i].z, ref_force[tag].z, tol);
+        MY_BOOST_CHECK_CLOSE(h_force.data[i].w, ref_force[tag].w, tol);
+        }
+    }
+    }
+
 //! PotentialBondHarmonic creator for bond_force_basic_tests()
 boost::shared_ptr<PotentialBondHarmonic> base_class_bf_creator(boost::shared_ptr<SystemDefinition> sysdef)
     {
@@ -514,6 +661,20 @@ BOOST_AUTO_TEST_CASE( PotentialBondHarmonic_basic )
     bond_force_basic_tests(bf_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! boost test case for the reduced virial mode of bond forces on the CPU
+BOOST_AUTO_TEST_CASE( PotentialBondHarmonic_reduced_virial )
+    {
+    bondforce_creator bf_creator = bind(base_class_bf_creator, _1);
+    bond_force_reduced_virial_tests(bf_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! boost test case for bond forces after a particle sort on the CPU
+BOOST_AUTO_TEST_CASE( PotentialBondHarmonic_sort )
+    {
+    bondforce_creator bf_creator = bind(base_class_bf_creator, _1);
+    bond_force_sort_tests(bf_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 //! boost test case for bond forces on the GPU
 BOOST_AUTO_TEST_CASE( PotentialBondHarmonicGPU_basic )
@@ -56,10 +56,12 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <math.h>
 #include "HOOMDDumpWriter.h"
 #include "HOOMDInitializer.h"
+#include "SnapshotSystemData.h"
 #include "BondedGroupData.h"
 
 #include <iostream>
 #include <sstream>
+#include <iomanip>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
 using namespace boost::filesystem;
@@ -1061,6 +1063,69 @@ BOOST_AUTO_TEST_CASE( HOOMDDumpWriter_tag_test )
         }
     }
 
+//! Tests that the files written on the AsyncWriter thread match the synchronously written ones
+BOOST_AUTO_TEST_CASE( HOOMDDumpWriter_async_test )
+    {
+    BoxDim box(Scalar(35.5), Scalar(37.5), Scalar(39.5));
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(100, box, 3, 1));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    sysdef->getBondData()->addBondedGroup(Bond(0, 0, 1));
+    sysdef->getBondData()->addBondedGroup(Bond(0, 2, 3));
+
+    boost::shared_ptr<HOOMDDumpWriter> writer_sync(new HOOMDDumpWriter(sysdef, "test_sync"));
+    boost::shared_ptr<HOOMDDumpWriter> writer_async(new HOOMDDumpWriter(sysdef, "test_async"));
+    writer_async->setAsyncOutput(true);
+
+    writer_sync->setOutputVelocity(true);
+    writer_sync->setOutputType(true);
+    writer_sync->setOutputBond(true);
+    writer_async->setOutputVelocity(true);
+    writer_async->setOutputType(true);
+    writer_async->setOutputBond(true);
+
+    for (unsigned int timestep = 0; timestep < 5; timestep++)
+        {
+            {
+            ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::overwrite);
+            for (unsigned int i = 0; i < pdata->getN(); i++)
+                {
+                h_pos.data[i] = make_scalar4(Scalar(0.1*i + timestep), Scalar(-0.2*i), Scalar(0.05*i*timestep),
+                                             __int_as_scalar(i % 3));
+                h_vel.data[i] = make_scalar4(Scalar(timestep), Scalar(i), Scalar(1.0), Scalar(1.0));
+                }
+            }
+
+        writer_sync->analyze(timestep);
+        writer_async->analyze(timestep);
+        }
+
+    // the particle data was modified after each call to analyze(), the files must still hold the staged data
+    AsyncWriter::flushShared();
+
+    for (unsigned int timestep = 0; timestep < 5; timestep++)
+        {
+        ostringstream suffix;
+        suffix << "." << setfill('0') << setw(10) << timestep << ".xml";
+
+        ifstream f_sync(("test_sync" + suffix.str()).c_str());
+        ifstream f_async(("test_async" + suffix.str()).c_str());
+        BOOST_REQUIRE(f_sync.good());
+        BOOST_REQUIRE(f_async.good());
+
+        stringstream s_sync, s_async;
+        s_sync << f_sync.rdbuf();
+        s_async << f_async.rdbuf();
+        BOOST_CHECK(s_sync.str().size() > 0);
+        BOOST_CHECK(s_sync.str() == s_async.str());
+
+        f_sync.close();
+        f_async.close();
+        remove_all("test_sync" + suffix.str());
+        remove_all("test_async" + suffix.str());
+        }
+    }
+
 //! Test basic functionality of HOOMDInitializer
 BOOST_AUTO_TEST_CASE( HOOMDInitializer_basic_tests )
     {
@@ -1393,6 +1458,101 @@ im_b 5 4 3 2\n\
     remove_all("test_input.xml");
     }
 
+//! Test that HOOMDInitializer reads values exactly as istringstream does, and handles comments and malformed files
+BOOST_AUTO_TEST_CASE( HOOMDInitializer_parse_tests )
+    {
+    // generate values with full precision and many digits
+    const unsigned int N = 100;
+    ostringstream pos_text, vel_text;
+    pos_text << setprecision(17);
+    vel_text << setprecision(9);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        pos_text << Scalar(i)*Scalar(0.1234567890123) - Scalar(5.0) << " " << Scalar(1.0)/Scalar(i+3) << " "
+                 << -Scalar(i)*Scalar(1e-7) << "\n";
+        // include an exponent and a comment in the middle of the section
+        vel_text << Scalar(i)*Scalar(1.5e-3) << " " << Scalar(0.0) << " " << Scalar(i+1)*Scalar(-2.5e2) << "\n";
+        if (i == N/2)
+            vel_text << "<!-- halfway < there -->\n";
+        }
+
+    ofstream f("test_parse.xml");
+    f << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      << "<!-- leading comment -->\n"
+      << "<hoomd_xml version='1.5'>\n"
+      << "<configuration time_step=\"12\">\n"
+      << "<box lx=\"20\" ly=\"20\" lz=\"20\"/>\n"
+      << "<unknown_node><child/></unknown_node>\n"
+      << "<position>" << pos_text.str() << "</position>\n"
+      << "<velocity num=\"" << N << "\">\n" << vel_text.str() << "</velocity>\n"
+      << "<type>\n";
+    for (unsigned int i = 0; i < N; i++)
+        f << ((i % 3) ? "B" : "A") << "\n";
+    // a trailing incomplete bond is dropped
+    f << "</type>\n"
+      << "<bond>polymer 0 1 polymer 1 2 polymer 2</bond>\n"
+      << "</configuration>\n"
+      << "</hoomd_xml>\n";
+    f.close();
+
+    boost::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    HOOMDInitializer init(exec_conf,"test_parse.xml");
+    boost::shared_ptr<SnapshotSystemData> snapshot = init.getSnapshot();
+
+    BOOST_CHECK_EQUAL(init.getTimeStep(), (unsigned int)12);
+    BOOST_REQUIRE_EQUAL(snapshot->particle_data.size, N);
+
+    // values must be bit for bit identical to those read by a stream
+    istringstream pos_in(pos_text.str()), vel_in(vel_text.str());
+    for (unsigned int i = 0; i < N; i++)
+        {
+        if (i == N/2+1)
+            {
+            string comment;
+            getline(vel_in, comment);
+            getline(vel_in, comment);
+            }
+
+        Scalar x,y,z;
+        pos_in >> x >> y >> z;
+        BOOST_CHECK_EQUAL(snapshot->particle_data.pos[i].x, x);
+        BOOST_CHECK_EQUAL(snapshot->particle_data.pos[i].y, y);
+        BOOST_CHECK_EQUAL(snapshot->particle_data.pos[i].z, z);
+
+        vel_in >> x >> y >> z;
+        BOOST_CHECK_EQUAL(snapshot->particle_data.vel[i].x, x);
+        BOOST_CHECK_EQUAL(snapshot->particle_data.vel[i].y, y);
+        BOOST_CHECK_EQUAL(snapshot->particle_data.vel[i].z, z);
+
+        BOOST_CHECK_EQUAL(snapshot->particle_data.type[i], (unsigned int)((i % 3) ? 1 : 0));
+        }
+
+    BOOST_REQUIRE_EQUAL(snapshot->particle_data.type_mapping.size(), (unsigned int)2);
+    BOOST_CHECK_EQUAL(snapshot->particle_data.type_mapping[0], string("A"));
+    BOOST_CHECK_EQUAL(snapshot->particle_data.type_mapping[1], string("B"));
+
+    BOOST_REQUIRE_EQUAL(snapshot->bond_data.groups.size(), (size_t)2);
+    BOOST_CHECK_EQUAL(snapshot->bond_data.groups[1].tag[0], (unsigned int)1);
+    BOOST_CHECK_EQUAL(snapshot->bond_data.groups[1].tag[1], (unsigned int)2);
+
+    // a mismatched end tag is an error
+    f.open("test_parse.xml");
+    f << "<hoomd_xml>\n<configuration>\n<box lx=\"20\" ly=\"20\" lz=\"20\"/>\n<position>\n0 0 0\n</velocity>\n"
+      << "</configuration>\n</hoomd_xml>\n";
+    f.close();
+    BOOST_CHECK_THROW(HOOMDInitializer(exec_conf, "test_parse.xml"), runtime_error);
+
+    // so is a missing root node
+    f.open("test_parse.xml");
+    f << "<hoomd>\n</hoomd>\n";
+    f.close();
+    BOOST_CHECK_THROW(HOOMDInitializer(exec_conf, "test_parse.xml"), runtime_error);
+
+    // and a missing file
+    remove_all("test_parse.xml");
+    BOOST_CHECK_THROW(HOOMDInitializer(exec_conf, "test_parse.xml"), runtime_error);
+    }
+
 #ifdef WIN32
 #pragma warning( pop )
 #endif
@@ -411,6 +411,203 @@ void lj_force_comparison_test(ljforce_creator lj_creator1, ljforce_creator lj_cr
     }
     }
 
+//! Unit test that the multithreaded CPU path and the compact neighbor list reproduce the single threaded forces
+void lj_force_threads_test(ljforce_creator lj_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 5000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    boost::shared_ptr<SnapshotSystemData> snap = rand_init.getSnapshot();
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    boost::shared_ptr<NeighborListBinned> nlist(new NeighborListBinned(sysdef, Scalar(3.0), Scalar(0.8)));
+
+    boost::shared_ptr<PotentialPairLJ> fc = lj_creator(sysdef, nlist);
+    fc->setRcut(0, 0, Scalar(3.0));
+
+    Scalar epsilon = Scalar(1.0);
+    Scalar sigma = Scalar(1.2);
+    Scalar alpha = Scalar(0.45);
+    Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+    Scalar lj2 = alpha * Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+    fc->setParams(0,0,make_scalar2(lj1,lj2));
+
+    // check both the full and the half neighbor list code paths
+    NeighborList::storageMode modes[] = {NeighborList::full, NeighborList::half};
+    unsigned int timestep = 0;
+    for (unsigned int m = 0; m < 2; m++)
+        {
+        nlist->setStorageMode(modes[m]);
+
+        // reference forces on a single thread
+        exec_conf->setNumThreads(1);
+        fc->compute(timestep++);
+        GPUArray<Scalar4> ref_force(N, exec_conf);
+        GPUArray<Scalar> ref_virial(N, 6, exec_conf);
+            {
+            ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_ref_force(ref_force, access_location::host, access_mode::overwrite);
+            ArrayHandle<Scalar> h_ref_virial(ref_virial, access_location::host, access_mode::overwrite);
+            unsigned int pitch = fc->getVirialArray().getPitch();
+            for (unsigned int i = 0; i < N; i++)
+                {
+                h_ref_force.data[i] = h_force.data[i];
+                for (unsigned int l = 0; l < 6; l++)
+                    h_ref_virial.data[l*ref_virial.getPitch()+i] = h_virial.data[l*pitch+i];
+                }
+            }
+
+        // repeat on several threads
+        exec_conf->setNumThreads(4);
+        fc->compute(timestep++);
+        GPUArray<Scalar4> first_force(N, exec_conf);
+            {
+            ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_ref_force(ref_force, access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_ref_virial(ref_virial, access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_first_force(first_force, access_location::host, access_mode::overwrite);
+            unsigned int pitch = fc->getVirialArray().getPitch();
+
+            double deltaf2 = 0.0;
+            double deltape2 = 0.0;
+            double deltav2 = 0.0;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                deltaf2 += double(h_force.data[i].x - h_ref_force.data[i].x) * double(h_force.data[i].x - h_ref_force.data[i].x);
+                deltaf2 += double(h_force.data[i].y - h_ref_force.data[i].y) * double(h_force.data[i].y - h_ref_force.data[i].y);
+                deltaf2 += double(h_force.data[i].z - h_ref_force.data[i].z) * double(h_force.data[i].z - h_ref_force.data[i].z);
+                deltape2 += double(h_force.data[i].w - h_ref_force.data[i].w) * double(h_force.data[i].w - h_ref_force.data[i].w);
+                for (unsigned int l = 0; l < 6; l++)
+                    {
+                    double dv = double(h_virial.data[l*pitch+i] - h_ref_virial.data[l*ref_virial.getPitch()+i]);
+                    deltav2 += dv*dv;
+                    }
+                h_first_force.data[i] = h_force.data[i];
+                }
+            BOOST_CHECK_SMALL(deltaf2 / double(N), double(tol_small));
+            BOOST_CHECK_SMALL(deltape2 / double(N), double(tol_small));
+            BOOST_CHECK_SMALL(deltav2 / double(N), double(tol_small));
+            }
+
+        // the multithreaded result must be reproducible
+        fc->compute(timestep++);
+            {
+            ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_first_force(first_force, access_location::host, access_mode::read);
+            unsigned int n_differ = 0;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                if (h_force.data[i].x != h_first_force.data[i].x || h_force.data[i].y != h_first_force.data[i].y ||
+                    h_force.data[i].z != h_first_force.data[i].z || h_force.data[i].w != h_first_force.data[i].w)
+                    n_differ++;
+                }
+            BOOST_CHECK_EQUAL(n_differ, (unsigned int)0);
+            }
+
+        // the compact neighbor list stores the same neighbors in the same order, so the forces must be identical
+        nlist->setCompactStorage(true);
+        fc->compute(timestep++);
+            {
+            ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_first_force(first_force, access_location::host, access_mode::read);
+            unsigned int n_differ = 0;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                if (h_force.data[i].x != h_first_force.data[i].x || h_force.data[i].y != h_first_force.data[i].y ||
+                    h_force.data[i].z != h_first_force.data[i].z || h_force.data[i].w != h_first_force.data[i].w)
+                    n_differ++;
+                }
+            BOOST_CHECK_EQUAL(n_differ, (unsigned int)0);
+            }
+        nlist->setCompactStorage(false);
+        }
+    }
+
+//! Unit test that the reduced virial mode sums up the same virial as the per-particle virial array
+void lj_force_reduced_virial_test(ljforce_creator lj_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // create a random particle system to sum forces on
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    boost::shared_ptr<SnapshotSystemData> snap = rand_init.getSnapshot();
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    boost::shared_ptr<NeighborListBinned> nlist(new NeighborListBinned(sysdef, Scalar(3.0), Scalar(0.8)));
+
+    boost::shared_ptr<PotentialPairLJ> fc = lj_creator(sysdef, nlist);
+    fc->setRcut(0, 0, Scalar(3.0));
+
+    Scalar epsilon = Scalar(1.0);
+    Scalar sigma = Scalar(1.2);
+    Scalar alpha = Scalar(0.45);
+    Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+    Scalar lj2 = alpha * Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+    fc->setParams(0,0,make_scalar2(lj1,lj2));
+
+    // check both the full and the half neighbor list code paths on one and several threads
+    NeighborList::storageMode modes[] = {NeighborList::full, NeighborList::half};
+    unsigned int threads[] = {1, 4};
+    unsigned int timestep = 0;
+    for (unsigned int m = 0; m < 2; m++)
+        for (unsigned int t = 0; t < 2; t++)
+            {
+            nlist->setStorageMode(modes[m]);
+            exec_conf->setNumThreads(threads[t]);
+
+            // reference virial summed from the per-particle array
+            pdata->setReducedVirial(false);
+            fc->compute(timestep++);
+            BOOST_CHECK(!fc->isVirialReduced());
+            double ref_virial[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+            GPUArray<Scalar4> ref_force(N, exec_conf);
+                {
+                ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+                ArrayHandle<Scalar> h_virial(fc->getVirialArray(), access_location::host, access_mode::read);
+                ArrayHandle<Scalar4> h_ref_force(ref_force, access_location::host, access_mode::overwrite);
+                unsigned int pitch = fc->getVirialArray().getPitch();
+                for (unsigned int i = 0; i < N; i++)
+                    {
+                    h_ref_force.data[i] = h_force.data[i];
+                    for (unsigned int l = 0; l < 6; l++)
+                        ref_virial[l] += double(h_virial.data[l*pitch+i]);
+                    }
+                }
+
+            // the reduced mode must produce the same forces and the same total virial
+            pdata->setReducedVirial(true);
+            fc->compute(timestep++);
+            BOOST_CHECK(fc->isVirialReduced());
+                {
+                ArrayHandle<Scalar4> h_force(fc->getForceArray(), access_location::host, access_mode::read);
+                ArrayHandle<Scalar4> h_ref_force(ref_force, access_location::host, access_mode::read);
+                unsigned int n_differ = 0;
+                for (unsigned int i = 0; i < N; i++)
+                    {
+                    if (h_force.data[i].x != h_ref_force.data[i].x || h_force.data[i].y != h_ref_force.data[i].y ||
+                        h_force.data[i].z != h_ref_force.data[i].z || h_force.data[i].w != h_ref_force.data[i].w)
+                        n_differ++;
+                    }
+                BOOST_CHECK_EQUAL(n_differ, (unsigned int)0);
+                }
+            for (unsigned int l = 0; l < 6; l++)
+                {
+                if (fabs(ref_virial[l]) > loose_tol)
+                    MY_BOOST_CHECK_CLOSE(fc->getVirialTotal(l), ref_virial[l], tol);
+                else
+                    MY_BOOST_CHECK_SMALL(fc->getVirialTotal(l), loose_tol);
+                }
+            }
+    pdata->setReducedVirial(false);
+    }
+
 //! Test the ability of the lj force compute to compute forces with different shift modes
 void lj_force_shift_test(ljforce_creator lj_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
     {
@@ -616,6 +813,20 @@ BOOST_AUTO_TEST_CASE( PotentialPairLJ_shift )
     lj_force_shift_test(lj_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! boost test case for comparing the multithreaded and single threaded CPU code paths
+BOOST_AUTO_TEST_CASE( PotentialPairLJ_threads )
+    {
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    lj_force_threads_test(lj_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! boost test case for summing the virial in reduced virial mode on the CPU
+BOOST_AUTO_TEST_CASE( PotentialPairLJ_reduced_virial )
+    {
+    ljforce_creator lj_creator_base = bind(base_class_lj_creator, _1, _2);
+    lj_force_reduced_virial_test(lj_creator_base, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 # ifdef ENABLE_CUDA
 //! boost test case for particle test on GPU
 BOOST_AUTO_TEST_CASE( LJForceGPU_particle )
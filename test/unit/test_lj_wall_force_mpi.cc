@@ -0,0 +1,175 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! name the boost unit test module
+#define BOOST_TEST_MODULE LJWallForceTestsMPI
+#include "boost_utf_configure.h"
+
+#include "HOOMDMath.h"
+#include "ExecutionConfiguration.h"
+#include "System.h"
+#include "LJWallForceCompute.h"
+#include "WallData.h"
+#include "RandomGenerator.h"
+
+#include <boost/python.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <math.h>
+
+#include "Communicator.h"
+#include "DomainDecomposition.h"
+
+using namespace boost;
+
+//! Compares the LJ wall forces computed with domain decomposition to a single-rank computation
+void test_lj_wall_force_mpi(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+{
+    // initialize random particle system
+    Scalar phi_p = 0.2;
+    unsigned int N = 1000;
+    Scalar L = pow(M_PI/6.0/phi_p*Scalar(N),1.0/3.0);
+    BoxDim box_g(L);
+    RandomGenerator rand_init(exec_conf, box_g, 12345, 3);
+    std::vector<string> types;
+    types.push_back("A");
+    std::vector<unsigned int> bonds;
+    std::vector<string> bond_types;
+    rand_init.addGenerator((int)N, boost::shared_ptr<PolymerParticleGenerator>(new PolymerParticleGenerator(exec_conf, 1.0, types, bonds, bonds, bond_types, 100, 3)));
+    rand_init.setSeparationRadius("A", .4);
+
+    rand_init.generate();
+
+    boost::shared_ptr<SnapshotSystemData> snap;
+    snap = rand_init.getSnapshot();
+
+    // the walls are only known to rank zero, and are distributed with the snapshot
+    if (exec_conf->getRank() == 0)
+        {
+        snap->wall_data.push_back(Wall(0.0, 0.0, -0.4*L, 0.0, 0.0, 1.0));
+        snap->wall_data.push_back(Wall(0.25*L, 0.0, 0.0, -1.0, 0.0, 0.0));
+        snap->wall_data.push_back(Wall(0.1*L, 0.0, 0.0, 1.0, 1.0, 1.0));
+        }
+
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf,snap->global_box.getL()));
+
+    boost::shared_ptr<SystemDefinition> sysdef_1(new SystemDefinition(snap, exec_conf,decomposition));
+    BOOST_CHECK_EQUAL(sysdef_1->getWallData()->getNumWalls(), (unsigned int)3);
+
+    // initialize a second system (single proc) on rank zero
+    boost::shared_ptr<SystemDefinition> sysdef_2;
+    if (exec_conf->getRank() == 0)
+        sysdef_2 = boost::shared_ptr<SystemDefinition>(new SystemDefinition(snap, exec_conf));
+
+    boost::shared_ptr<Communicator> comm(new Communicator(sysdef_1,decomposition));
+
+    Scalar r_cut = Scalar(3.0);
+    Scalar epsilon = Scalar(1.15);
+    Scalar sigma = Scalar(1.0);
+    Scalar alpha = Scalar(1.0);
+    Scalar lj1 = Scalar(4.0) * epsilon * pow(sigma,Scalar(12.0));
+    Scalar lj2 = alpha * Scalar(4.0) * epsilon * pow(sigma,Scalar(6.0));
+
+    boost::shared_ptr<LJWallForceCompute> fc_1(new LJWallForceCompute(sysdef_1, r_cut));
+    fc_1->setParams(0, lj1, lj2);
+    fc_1->setCommunicator(comm);
+    fc_1->compute(0);
+
+    boost::shared_ptr<LJWallForceCompute> fc_2;
+    if (exec_conf->getRank() == 0)
+        {
+        fc_2 = boost::shared_ptr<LJWallForceCompute>(new LJWallForceCompute(sysdef_2, r_cut));
+        fc_2->setParams(0, lj1, lj2);
+        fc_2->compute(0);
+        }
+
+    // every particle has to see the same walls as in the single-rank computation
+    unsigned int n_interacting = 0;
+    for (unsigned int tag = 0; tag < N; tag++)
+        {
+        Scalar3 f_1 = fc_1->getForce(tag);
+        Scalar e_1 = fc_1->getEnergy(tag);
+
+        if (exec_conf->getRank() == 0)
+            {
+            Scalar3 f_2 = fc_2->getForce(tag);
+            Scalar e_2 = fc_2->getEnergy(tag);
+
+            if (e_2 != Scalar(0.0))
+                n_interacting++;
+
+            if (fabs(f_2.x) < tol_small)
+                BOOST_CHECK_SMALL(f_1.x, tol_small);
+            else
+                MY_BOOST_CHECK_CLOSE(f_1.x, f_2.x, tol_small);
+            if (fabs(f_2.y) < tol_small)
+                BOOST_CHECK_SMALL(f_1.y, tol_small);
+            else
+                MY_BOOST_CHECK_CLOSE(f_1.y, f_2.y, tol_small);
+            if (fabs(f_2.z) < tol_small)
+                BOOST_CHECK_SMALL(f_1.z, tol_small);
+            else
+                MY_BOOST_CHECK_CLOSE(f_1.z, f_2.z, tol_small);
+            if (fabs(e_2) < tol_small)
+                BOOST_CHECK_SMALL(e_1, tol_small);
+            else
+                MY_BOOST_CHECK_CLOSE(e_1, e_2, tol_small);
+            }
+        }
+
+    // make sure the test is not trivial
+    if (exec_conf->getRank() == 0)
+        BOOST_CHECK(n_interacting > 0);
+}
+
+//! Tests MPI domain decomposition with the LJ wall force
+BOOST_AUTO_TEST_CASE( DomainDecomposition_LJWall_test )
+    {
+    test_lj_wall_force_mpi(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
@@ -320,6 +320,63 @@ void neighborlist_exclusion_tests(boost::shared_ptr<ExecutionConfiguration> exec
         }
     }
 
+//! Tests that the neighbor list honors individual cutoffs for each type pair
+template <class NL>
+void neighborlist_type_rcut_tests(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // 4 particles of two types in a huge box
+    boost::shared_ptr<SystemDefinition> sysdef_4(new SystemDefinition(4, BoxDim(25.0), 2, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata_4 = sysdef_4->getParticleData();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata_4->getPositions(), access_location::host, access_mode::readwrite);
+
+    h_pos.data[0] = make_scalar4(0.0, 0.0, 0.0, __int_as_scalar(0));
+    h_pos.data[1] = make_scalar4(2.5, 0.0, 0.0, __int_as_scalar(0));
+    h_pos.data[2] = make_scalar4(0.0, 2.0, 0.0, __int_as_scalar(1));
+    h_pos.data[3] = make_scalar4(0.0, -1.5, 0.0, __int_as_scalar(1));
+    }
+
+    boost::shared_ptr<NeighborList> nlist_4(new NL(sysdef_4, 3.0, 0.25));
+    nlist_4->setStorageMode(NeighborList::full);
+
+    // every type pair starts out with the maximum cutoff
+    BOOST_CHECK_EQUAL(nlist_4->getRCutPair(0,1), Scalar(3.0));
+
+    nlist_4->setRCutPair(0, 1, 1.5);
+    nlist_4->setRCutPair(1, 1, 1.0);
+    BOOST_CHECK_EQUAL(nlist_4->getRCutPair(1,0), Scalar(1.5));
+    BOOST_CHECK_EQUAL(nlist_4->getRCutPair(0,0), Scalar(3.0));
+    nlist_4->compute(0);
+
+    // 0-1 is within the A-A cutoff, 0-3 within the A-B cutoff, and 0-2 is only within the maximum cutoff
+        {
+        ArrayHandle<unsigned int> h_n_neigh(nlist_4->getNNeighArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(nlist_4->getNListArray(), access_location::host, access_mode::read);
+        Index2D nli = nlist_4->getNListIndexer();
+
+        BOOST_REQUIRE_EQUAL_UINT(h_n_neigh.data[0], 2);
+        BOOST_CHECK_EQUAL_UINT(h_nlist.data[nli(0,0)] + h_nlist.data[nli(0,1)], 4);
+        BOOST_REQUIRE_EQUAL_UINT(h_n_neigh.data[1], 1);
+        BOOST_CHECK_EQUAL_UINT(h_nlist.data[nli(1,0)], 0);
+        BOOST_CHECK_EQUAL_UINT(h_n_neigh.data[2], 0);
+        BOOST_REQUIRE_EQUAL_UINT(h_n_neigh.data[3], 1);
+        BOOST_CHECK_EQUAL_UINT(h_nlist.data[nli(3,0)], 0);
+        }
+
+    // setting the maximum cutoff resets all type pairs, only 2-3 are too far apart
+    nlist_4->setRCut(3.0, 0.25);
+    nlist_4->compute(1);
+        {
+        ArrayHandle<unsigned int> h_n_neigh(nlist_4->getNNeighArray(), access_location::host, access_mode::read);
+
+        BOOST_CHECK_EQUAL_UINT(h_n_neigh.data[0], 3);
+        BOOST_CHECK_EQUAL_UINT(h_n_neigh.data[1], 3);
+        BOOST_CHECK_EQUAL_UINT(h_n_neigh.data[2], 2);
+        BOOST_CHECK_EQUAL_UINT(h_n_neigh.data[3], 2);
+        }
+    }
+
 //! Tests the ability of the neighbor list to exclude particles from the same body
 template <class NL>
 void neighborlist_body_filter_tests(boost::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -561,6 +618,150 @@ void neighborlist_comparison_test(boost::shared_ptr<ExecutionConfiguration> exec
         }
     }
 
+//! Tests that the compact storage holds the same neighbors as the default layout
+template <class NL>
+void neighborlist_compact_test(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // construct the particle system
+    RandomInitializer init(1000, Scalar(0.2), Scalar(0.9), "A");
+    boost::shared_ptr<SnapshotSystemData> snap = init.getSnapshot();
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    const unsigned int N = pdata->getN();
+
+    boost::shared_ptr<NeighborList> nlist_dense(new NL(sysdef, Scalar(3.0), Scalar(0.4)));
+    boost::shared_ptr<NeighborList> nlist_compact(new NL(sysdef, Scalar(3.0), Scalar(0.4)));
+    nlist_compact->setCompactStorage(true);
+    BOOST_REQUIRE(nlist_compact->getCompactStorage());
+
+    // exclusions exercise the filtering of the compact list
+    for (unsigned int i=0; i < N-1; i++)
+        {
+        nlist_dense->addExclusion(i,i+1);
+        nlist_compact->addExclusion(i,i+1);
+        }
+
+    for (unsigned int mode = 0; mode < 2; mode++)
+        {
+        NeighborList::storageMode storage_mode = (mode == 0) ? NeighborList::half : NeighborList::full;
+        nlist_dense->setStorageMode(storage_mode);
+        nlist_compact->setStorageMode(storage_mode);
+        nlist_dense->compute(mode);
+        nlist_compact->compute(mode);
+
+        ArrayHandle<unsigned int> h_n_neigh_dense(nlist_dense->getNNeighArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist_dense(nlist_dense->getNListArray(), access_location::host, access_mode::read);
+        Index2D nli = nlist_dense->getNListIndexer();
+
+        ArrayHandle<unsigned int> h_n_neigh(nlist_compact->getNNeighArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(nlist_compact->getNListArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_head_list(nlist_compact->getHeadList(), access_location::host, access_mode::read);
+        BOOST_REQUIRE_EQUAL_UINT(nlist_compact->getNListStride(), 1);
+
+        // the compact list must be no larger than the total number of neighbors (plus some slack)
+        unsigned int n_total = 0;
+        for (unsigned int i = 0; i < N; i++)
+            n_total += h_n_neigh.data[i];
+        BOOST_CHECK(nlist_compact->getNListArray().getNumElements() < nli.getNumElements());
+
+        unsigned int n_differ = 0;
+        for (unsigned int i = 0; i < N; i++)
+            {
+            if (h_n_neigh.data[i] != h_n_neigh_dense.data[i])
+                {
+                n_differ++;
+                continue;
+                }
+            BOOST_REQUIRE(h_head_list.data[i] + h_n_neigh.data[i] <= n_total + n_total/8);
+            for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+                if (h_nlist.data[h_head_list.data[i] + k] != h_nlist_dense.data[nli(i,k)])
+                    n_differ++;
+            }
+        BOOST_CHECK_EQUAL_UINT(n_differ, 0);
+        }
+    }
+
+//! Strong scaling test of the multithreaded neighbor list build
+/*! The same system is binned and the neighbor list built with an increasing number of threads. The resulting lists
+    must be identical (including the order of the neighbors) to the single threaded build, and the build time for each
+    thread count is printed.
+*/
+template <class NL>
+void neighborlist_threads_test(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // construct the particle system
+    RandomInitializer init(4000, Scalar(0.2), Scalar(0.9), "A");
+    boost::shared_ptr<SnapshotSystemData> snap = init.getSnapshot();
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    const unsigned int N = pdata->getN();
+
+    boost::shared_ptr<NeighborList> nlist(new NL(sysdef, Scalar(3.0), Scalar(0.4)));
+
+    // setup some exclusions to also exercise the filtering
+    for (unsigned int i=0; i < N-1; i++)
+        nlist->addExclusion(i,i+1);
+
+    std::vector<unsigned int> ref_n_neigh;
+    std::vector<unsigned int> ref_nlist;
+    double ref_time = 0.0;
+
+    unsigned int thread_counts[] = {1, 2, 4, 8};
+    for (unsigned int t = 0; t < 4; t++)
+        {
+        exec_conf->setNumThreads(thread_counts[t]);
+
+        nlist->setStorageMode(NeighborList::half);
+        nlist->forceUpdate();
+        nlist->compute(t);
+
+        ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(), access_location::host, access_mode::read);
+        Index2D nli = nlist->getNListIndexer();
+
+        if (t == 0)
+            {
+            // store the single threaded list as the reference
+            ref_n_neigh.resize(N);
+            ref_nlist.resize(nli.getNumElements());
+            for (unsigned int i = 0; i < N; i++)
+                {
+                ref_n_neigh[i] = h_n_neigh.data[i];
+                for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+                    ref_nlist[nli(i,k)] = h_nlist.data[nli(i,k)];
+                }
+            }
+        else
+            {
+            // every row must match exactly
+            unsigned int n_differ = 0;
+            for (unsigned int i = 0; i < N; i++)
+                {
+                if (h_n_neigh.data[i] != ref_n_neigh[i])
+                    {
+                    n_differ++;
+                    continue;
+                    }
+                for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+                    if (h_nlist.data[nli(i,k)] != ref_nlist[nli(i,k)])
+                        n_differ++;
+                }
+            BOOST_CHECK_EQUAL_UINT(n_differ, 0);
+            }
+        }
+
+    // time the cell list + neighbor list build for each thread count
+    for (unsigned int t = 0; t < 4; t++)
+        {
+        exec_conf->setNumThreads(thread_counts[t]);
+        double time = nlist->benchmark(5);
+        if (t == 0)
+            ref_time = time;
+        cout << "nlist build with " << thread_counts[t] << " threads: " << time << " ms, speedup "
+             << ref_time / time << endl;
+        }
+    }
+
 //! Test that a NeighborList can successfully exclude a ridiculously large number of particles
 template <class NL>
 void neighborlist_large_ex_tests(boost::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -619,6 +820,16 @@ BOOST_AUTO_TEST_CASE( NeighborList_large_ex )
     {
     neighborlist_large_ex_tests<NeighborList>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! compact storage test case for base class
+BOOST_AUTO_TEST_CASE( NeighborList_compact )
+    {
+    neighborlist_compact_test<NeighborList>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! type pair cutoff test case for base class
+BOOST_AUTO_TEST_CASE( NeighborList_type_rcut )
+    {
+    neighborlist_type_rcut_tests<NeighborList>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! body filter test case for base class
 BOOST_AUTO_TEST_CASE( NeighborList_body_filter)
     {
@@ -645,6 +856,11 @@ BOOST_AUTO_TEST_CASE( NeighborListBinned_large_ex )
     {
     neighborlist_large_ex_tests<NeighborListBinned>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! type pair cutoff test case for binned class
+BOOST_AUTO_TEST_CASE( NeighborListBinned_type_rcut )
+    {
+    neighborlist_type_rcut_tests<NeighborListBinned>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 //! body filter test case for binned class
 BOOST_AUTO_TEST_CASE( NeighborListBinned_body_filter)
     {
@@ -660,6 +876,16 @@ BOOST_AUTO_TEST_CASE( NeighborListBinned_comparison )
     {
     neighborlist_comparison_test<NeighborList, NeighborListBinned>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! compact storage test case for binned class
+BOOST_AUTO_TEST_CASE( NeighborListBinned_compact )
+    {
+    neighborlist_compact_test<NeighborListBinned>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+//! strong scaling test case for binned class
+BOOST_AUTO_TEST_CASE( NeighborListBinned_threads )
+    {
+    neighborlist_threads_test<NeighborListBinned>(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
 
 #ifdef ENABLE_CUDA
 
@@ -60,6 +60,7 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/shared_ptr.hpp>
 
 #include "ConstForceCompute.h"
+#include "ComputeThermo.h"
 #include "TwoStepNVE.h"
 #ifdef ENABLE_CUDA
 #include "TwoStepNVEGPU.h"
@@ -164,6 +165,278 @@ void nve_updater_integrate_tests(twostepnve_creator nve_creator, boost::shared_p
         }
     }
 
+//! Integrate with a force on an outer r-RESPA level and compare to an analytical solution
+void nve_updater_respa_tests(twostepnve_creator nve_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // 2 particles in a huge box so boundary conditions don't come into play
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(2, BoxDim(1000.0), 4, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    boost::shared_ptr<ParticleSelector> selector_all(new ParticleSelectorTag(sysdef, 0, pdata->getN()-1));
+    boost::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    h_pos.data[0].x = 0.0;
+    h_pos.data[0].y = 1.0;
+    h_pos.data[0].z = 2.0;
+    h_vel.data[0].x = 3.0;
+    h_vel.data[0].y = 2.0;
+    h_vel.data[0].z = 1.0;
+
+    h_pos.data[1].x = 10.0;
+    h_pos.data[1].y = 11.0;
+    h_pos.data[1].z = 12.0;
+    h_vel.data[1].x = 13.0;
+    h_vel.data[1].y = 12.0;
+    h_vel.data[1].z = 11.0;
+    }
+
+    Scalar deltaT = Scalar(0.0001);
+    boost::shared_ptr<TwoStepNVE> two_step_nve = nve_creator(sysdef, group_all);
+    boost::shared_ptr<IntegratorTwoStep> nve_up(new IntegratorTwoStep(sysdef, deltaT));
+    nve_up->addIntegrationMethod(two_step_nve);
+
+    // fc1 is evaluated every step, fc2 every 4 steps
+    const unsigned int period = 4;
+    boost::shared_ptr<ConstForceCompute> fc1(new ConstForceCompute(sysdef, 1.5, 0.0, 0.0));
+    nve_up->addForceCompute(fc1);
+    boost::shared_ptr<ConstForceCompute> fc2(new ConstForceCompute(sysdef, 0.0, 2.5, 0.0));
+    nve_up->addForceCompute(fc2);
+    nve_up->setForcePeriod(fc2, period);
+
+    // the period must be positive, and the force must be added
+    BOOST_CHECK_THROW(nve_up->setForcePeriod(fc2, 0), runtime_error);
+    boost::shared_ptr<ConstForceCompute> fc3(new ConstForceCompute(sysdef, 0.0, 0.0, 1.0));
+    BOOST_CHECK_THROW(nve_up->setForcePeriod(fc3, 2), runtime_error);
+
+    nve_up->prepRun(0);
+
+    for (unsigned int i = 0; i < 500; i++)
+        {
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_net_force(pdata->getNetForce(), access_location::host, access_mode::read);
+
+        // the outer force enters the net force as an impulse on the steps where it is evaluated
+        Scalar fy = (i % period == 0) ? Scalar(period)*Scalar(2.5) : Scalar(0.0);
+        MY_BOOST_CHECK_CLOSE(h_net_force.data[0].x, 1.5, tol);
+        MY_BOOST_CHECK_SMALL(fabs(h_net_force.data[0].y - fy), tol_small);
+
+        // the inner force is integrated exactly every step, the outer force at the end of every outer step
+        Scalar t = Scalar(i) * deltaT;
+        MY_BOOST_CHECK_CLOSE(h_pos.data[0].x, 0.0 + 3.0 * t + 1.0/2.0 * 1.5 * t*t, loose_tol);
+        MY_BOOST_CHECK_CLOSE(h_vel.data[0].x, 3.0 + 1.5 * t, loose_tol);
+        MY_BOOST_CHECK_CLOSE(h_pos.data[1].x, 10.0 + 13.0 * t + 1.0/2.0 * 1.5 * t*t, loose_tol);
+
+        if (i % period == 0)
+            {
+            MY_BOOST_CHECK_CLOSE(h_pos.data[0].y, 1.0 + 2.0 * t + 1.0/2.0 * 2.5 * t*t, loose_tol);
+            MY_BOOST_CHECK_CLOSE(h_vel.data[0].y, 2.0 + 2.5 * t, loose_tol);
+            MY_BOOST_CHECK_CLOSE(h_pos.data[1].y, 11.0 + 12.0 * t + 1.0/2.0 * 2.5 * t*t, loose_tol);
+            MY_BOOST_CHECK_CLOSE(h_vel.data[1].y, 12.0 + 2.5 * t, loose_tol);
+            }
+
+        MY_BOOST_CHECK_CLOSE(h_pos.data[0].z, 2.0 + 1.0 * t, loose_tol);
+        MY_BOOST_CHECK_CLOSE(h_vel.data[0].z, 1.0, loose_tol);
+        }
+
+        nve_up->update(i);
+        }
+    }
+
+//! Helper to add LJ forces and a constant force to an integrator for nve_updater_accumulate_tests()
+std::vector< boost::shared_ptr<ForceCompute> > accumulate_test_forces(boost::shared_ptr<SystemDefinition> sysdef,
+                                                                      boost::shared_ptr<IntegratorTwoStep> integrator)
+    {
+    boost::shared_ptr<NeighborList> nlist(new NeighborList(sysdef, Scalar(3.0), Scalar(0.8)));
+    std::vector< boost::shared_ptr<ForceCompute> > forces;
+
+    // three LJ potentials with different parameters, the last one is evaluated every other step
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        boost::shared_ptr<PotentialPairLJ> lj(new PotentialPairLJ(sysdef, nlist));
+        Scalar sigma = Scalar(0.9) + Scalar(0.1)*Scalar(i);
+        lj->setRcut(0, 0, Scalar(3.0) - Scalar(0.5)*Scalar(i));
+        lj->setParams(0, 0, make_scalar2(Scalar(4.0)*pow(sigma,Scalar(12.0)), Scalar(4.0)*pow(sigma,Scalar(6.0))));
+        integrator->addForceCompute(lj);
+        forces.push_back(lj);
+        }
+    integrator->setForcePeriod(forces[2], 2);
+
+    // a constant force keeps its own arrays
+    boost::shared_ptr<ConstForceCompute> fc(new ConstForceCompute(sysdef, 0.5, -0.5, 0.25));
+    integrator->addForceCompute(fc);
+    forces.push_back(fc);
+
+    return forces;
+    }
+
+//! Compare the net force of forces computed in accumulate mode to the summed per-force arrays
+void nve_updater_accumulate_tests(twostepnve_creator nve_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // create two identical random particle systems to simulate
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    rand_init.setSeed(12345);
+    boost::shared_ptr<SnapshotSystemData> snap = rand_init.getSnapshot();
+
+    boost::shared_ptr<SystemDefinition> sysdef1(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata1 = sysdef1->getParticleData();
+    boost::shared_ptr<ParticleSelector> selector_all1(new ParticleSelectorTag(sysdef1, 0, pdata1->getN()-1));
+    boost::shared_ptr<ParticleGroup> group_all1(new ParticleGroup(sysdef1, selector_all1));
+
+    boost::shared_ptr<SystemDefinition> sysdef2(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata2 = sysdef2->getParticleData();
+    boost::shared_ptr<ParticleSelector> selector_all2(new ParticleSelectorTag(sysdef2, 0, pdata2->getN()-1));
+    boost::shared_ptr<ParticleGroup> group_all2(new ParticleGroup(sysdef2, selector_all2));
+
+    // request the virial so that it is summed
+    PDataFlags flags;
+    flags[pdata_flag::pressure_tensor] = 1;
+    pdata1->setFlags(flags);
+    pdata2->setFlags(flags);
+
+    boost::shared_ptr<IntegratorTwoStep> nve1(new IntegratorTwoStep(sysdef1, Scalar(0.001)));
+    nve1->addIntegrationMethod(nve_creator(sysdef1, group_all1));
+    std::vector< boost::shared_ptr<ForceCompute> > forces1 = accumulate_test_forces(sysdef1, nve1);
+
+    boost::shared_ptr<IntegratorTwoStep> nve2(new IntegratorTwoStep(sysdef2, Scalar(0.001)));
+    nve2->addIntegrationMethod(nve_creator(sysdef2, group_all2));
+    std::vector< boost::shared_ptr<ForceCompute> > forces2 = accumulate_test_forces(sysdef2, nve2);
+
+    for (unsigned int i = 0; i < forces2.size(); i++)
+        forces2[i]->setAccumulate(true);
+
+    // the constant force does not support accumulate mode
+    BOOST_CHECK(forces2[0]->isAccumulating());
+    BOOST_CHECK(forces2[2]->isAccumulating());
+    BOOST_CHECK(!forces2[3]->isAccumulating());
+
+    nve1->prepRun(0);
+    nve2->prepRun(0);
+
+    for (unsigned int i = 0; i < 12; i++)
+        {
+        // request per-force data half way through
+        if (i == 6)
+            {
+            MY_BOOST_CHECK_CLOSE(forces2[1]->calcEnergySum(), forces1[1]->calcEnergySum(), tol_small);
+            Scalar3 f1 = forces1[2]->getForce(10);
+            Scalar3 f2 = forces2[2]->getForce(10);
+            MY_BOOST_CHECK_CLOSE(f2.x, f1.x, tol_small);
+            MY_BOOST_CHECK_CLOSE(f2.y, f1.y, tol_small);
+            MY_BOOST_CHECK_CLOSE(f2.z, f1.z, tol_small);
+
+            // once requested, the per-force arrays are kept
+            BOOST_CHECK(!forces2[1]->isAccumulating());
+            forces2[1]->setAccumulate(true);
+            BOOST_CHECK(!forces2[1]->isAccumulating());
+            BOOST_CHECK(forces2[0]->isAccumulating());
+            }
+
+        {
+        ArrayHandle<Scalar4> h_net_force1(pdata1->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_net_virial1(pdata1->getNetVirial(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_net_force2(pdata2->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_net_virial2(pdata2->getNetVirial(), access_location::host, access_mode::read);
+        unsigned int pitch1 = pdata1->getNetVirial().getPitch();
+        unsigned int pitch2 = pdata2->getNetVirial().getPitch();
+
+        for (unsigned int j = 0; j < N; j++)
+            {
+            MY_BOOST_CHECK_SMALL(fabs(h_net_force2.data[j].x - h_net_force1.data[j].x), tol_small);
+            MY_BOOST_CHECK_SMALL(fabs(h_net_force2.data[j].y - h_net_force1.data[j].y), tol_small);
+            MY_BOOST_CHECK_SMALL(fabs(h_net_force2.data[j].z - h_net_force1.data[j].z), tol_small);
+            MY_BOOST_CHECK_SMALL(fabs(h_net_force2.data[j].w - h_net_force1.data[j].w), tol_small);
+            for (unsigned int k = 0; k < 6; k++)
+                MY_BOOST_CHECK_SMALL(fabs(h_net_virial2.data[k*pitch2+j] - h_net_virial1.data[k*pitch1+j]), tol_small);
+            }
+        }
+
+        nve1->update(i);
+        nve2->update(i);
+        }
+    }
+
+//! Compare the pressure computed in reduced virial mode to the one from the per-particle virial
+void nve_updater_reduced_virial_tests(twostepnve_creator nve_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // create two identical random particle systems to simulate
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    rand_init.setSeed(12345);
+    boost::shared_ptr<SnapshotSystemData> snap = rand_init.getSnapshot();
+
+    boost::shared_ptr<SystemDefinition> sysdef1(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata1 = sysdef1->getParticleData();
+    boost::shared_ptr<ParticleSelector> selector_all1(new ParticleSelectorTag(sysdef1, 0, pdata1->getN()-1));
+    boost::shared_ptr<ParticleGroup> group_all1(new ParticleGroup(sysdef1, selector_all1));
+
+    boost::shared_ptr<SystemDefinition> sysdef2(new SystemDefinition(snap, exec_conf));
+    boost::shared_ptr<ParticleData> pdata2 = sysdef2->getParticleData();
+    boost::shared_ptr<ParticleSelector> selector_all2(new ParticleSelectorTag(sysdef2, 0, pdata2->getN()-1));
+    boost::shared_ptr<ParticleGroup> group_all2(new ParticleGroup(sysdef2, selector_all2));
+    boost::shared_ptr<ParticleSelector> selector_half2(new ParticleSelectorTag(sysdef2, 0, N/2-1));
+    boost::shared_ptr<ParticleGroup> group_half2(new ParticleGroup(sysdef2, selector_half2));
+
+    PDataFlags flags;
+    flags[pdata_flag::isotropic_virial] = 1;
+    flags[pdata_flag::pressure_tensor] = 1;
+    pdata1->setFlags(flags);
+    pdata2->setFlags(flags);
+
+    boost::shared_ptr<ComputeThermo> thermo1(new ComputeThermo(sysdef1, group_all1));
+    boost::shared_ptr<ComputeThermo> thermo2(new ComputeThermo(sysdef2, group_all2));
+    boost::shared_ptr<ComputeThermo> thermo_half2(new ComputeThermo(sysdef2, group_half2));
+
+    boost::shared_ptr<IntegratorTwoStep> nve1(new IntegratorTwoStep(sysdef1, Scalar(0.001)));
+    nve1->addIntegrationMethod(nve_creator(sysdef1, group_all1));
+    accumulate_test_forces(sysdef1, nve1);
+
+    boost::shared_ptr<IntegratorTwoStep> nve2(new IntegratorTwoStep(sysdef2, Scalar(0.001)));
+    nve2->addIntegrationMethod(nve_creator(sysdef2, group_all2));
+    std::vector< boost::shared_ptr<ForceCompute> > forces2 = accumulate_test_forces(sysdef2, nve2);
+    nve2->setReducedVirial(true);
+
+    // the first force is also computed directly into the net force
+    forces2[0]->setAccumulate(true);
+
+    nve1->prepRun(0);
+    nve2->prepRun(0);
+    BOOST_CHECK(pdata2->getReducedVirial());
+
+    for (unsigned int i = 0; i < 12; i++)
+        {
+        thermo1->compute(i);
+        thermo2->compute(i);
+        thermo_half2->compute(i);
+
+        // all LJ forces only summed up their virial
+        BOOST_CHECK(forces2[0]->isVirialReduced());
+        BOOST_CHECK(forces2[1]->isVirialReduced());
+
+        MY_BOOST_CHECK_CLOSE(thermo2->getPressure(), thermo1->getPressure(), tol);
+        PressureTensor p1 = thermo1->getPressureTensor();
+        PressureTensor p2 = thermo2->getPressureTensor();
+        MY_BOOST_CHECK_CLOSE(p2.xx, p1.xx, tol);
+        MY_BOOST_CHECK_CLOSE(p2.xy, p1.xy, tol);
+        MY_BOOST_CHECK_CLOSE(p2.xz, p1.xz, tol);
+        MY_BOOST_CHECK_CLOSE(p2.yy, p1.yy, tol);
+        MY_BOOST_CHECK_CLOSE(p2.yz, p1.yz, tol);
+        MY_BOOST_CHECK_CLOSE(p2.zz, p1.zz, tol);
+
+        // the pressure of a subset of the particles is not available
+        BOOST_CHECK(isnan(thermo_half2->getPressure()));
+
+        nve1->update(i);
+        nve2->update(i);
+        }
+    }
+
 //! Check that the particle movement limit works
 void nve_updater_limit_tests(twostepnve_creator nve_creator, boost::shared_ptr<ExecutionConfiguration> exec_conf)
     {
@@ -410,6 +683,27 @@ BOOST_AUTO_TEST_CASE( TwoStepNVE_integrate_tests )
     nve_updater_integrate_tests(nve_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! boost test case for base class r-RESPA tests
+BOOST_AUTO_TEST_CASE( TwoStepNVE_respa_tests )
+    {
+    twostepnve_creator nve_creator = bind(base_class_nve_creator, _1, _2);
+    nve_updater_respa_tests(nve_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! boost test case for base class accumulate mode tests
+BOOST_AUTO_TEST_CASE( TwoStepNVE_accumulate_tests )
+    {
+    twostepnve_creator nve_creator = bind(base_class_nve_creator, _1, _2);
+    nve_updater_accumulate_tests(nve_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! boost test case for base class reduced virial tests
+BOOST_AUTO_TEST_CASE( TwoStepNVE_reduced_virial_tests )
+    {
+    twostepnve_creator nve_creator = bind(base_class_nve_creator, _1, _2);
+    nve_updater_reduced_virial_tests(nve_creator, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 //! boost test case for base class limit tests
 BOOST_AUTO_TEST_CASE( TwoStepNVE_limit_tests )
     {
@@ -432,6 +726,20 @@ BOOST_AUTO_TEST_CASE( TwoStepNVEGPU_integrate_tests )
     nve_updater_integrate_tests(nve_creator_gpu, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 
+//! boost test case for GPU r-RESPA tests
+BOOST_AUTO_TEST_CASE( TwoStepNVEGPU_respa_tests )
+    {
+    twostepnve_creator nve_creator_gpu = bind(gpu_nve_creator, _1, _2);
+    nve_updater_respa_tests(nve_creator_gpu, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
+//! boost test case for GPU accumulate mode tests
+BOOST_AUTO_TEST_CASE( TwoStepNVEGPU_accumulate_tests )
+    {
+    twostepnve_creator nve_creator_gpu = bind(gpu_nve_creator, _1, _2);
+    nve_updater_accumulate_tests(nve_creator_gpu, boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
 //! boost test case for base class limit tests
 BOOST_AUTO_TEST_CASE( TwoStepNVEGPU_limit_tests )
     {
@@ -0,0 +1,171 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+//! name the boost unit test module
+#define BOOST_TEST_MODULE PPPMForceComputeTestsMPI
+#include "boost_utf_configure.h"
+
+#include "HOOMDMath.h"
+#include "ExecutionConfiguration.h"
+#include "SystemDefinition.h"
+#include "SnapshotSystemData.h"
+#include "PPPMForceCompute.h"
+#include "NeighborList.h"
+#include "saruprng.h"
+
+#include <boost/python.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <math.h>
+
+#include "DomainDecomposition.h"
+
+using namespace boost;
+
+//! Compare the PPPM forces, energies and virials of a domain decomposed system with those of a single processor
+void test_pppm_force_mpi(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+{
+    // random system of unit charges of alternating sign
+    unsigned int N = 1000;
+    Scalar L = Scalar(20.0);
+    boost::shared_ptr<SnapshotSystemData> snap(new SnapshotSystemData());
+    snap->global_box = BoxDim(L);
+    snap->particle_data.resize(N);
+    snap->particle_data.type_mapping.push_back("A");
+
+    Saru saru(12345);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        snap->particle_data.pos[i] = make_scalar3(saru.s<Scalar>(-L/Scalar(2.0), L/Scalar(2.0)),
+                                                  saru.s<Scalar>(-L/Scalar(2.0), L/Scalar(2.0)),
+                                                  saru.s<Scalar>(-L/Scalar(2.0), L/Scalar(2.0)));
+        snap->particle_data.charge[i] = (i % 2) ? Scalar(1.0) : Scalar(-1.0);
+        }
+
+    // the decomposed system
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, snap->global_box.getL()));
+    boost::shared_ptr<SystemDefinition> sysdef_1(new SystemDefinition(snap, exec_conf, decomposition));
+    boost::shared_ptr<ParticleData> pdata_1 = sysdef_1->getParticleData();
+    pdata_1->setFlags(~PDataFlags(0));
+
+    // the reference system on rank zero
+    boost::shared_ptr<SystemDefinition> sysdef_2;
+    boost::shared_ptr<ParticleData> pdata_2;
+    if (exec_conf->getRank() == 0)
+        {
+        sysdef_2 = boost::shared_ptr<SystemDefinition>(new SystemDefinition(snap, exec_conf));
+        pdata_2 = sysdef_2->getParticleData();
+        pdata_2->setFlags(~PDataFlags(0));
+        }
+
+    // use a different, not evenly divisible, number of mesh points along every direction
+    int Nx = 30;
+    int Ny = 32;
+    int Nz = 36;
+    int order = 5;
+    Scalar kappa = Scalar(1.0);
+    Scalar r_cut = Scalar(3.0);
+    Scalar r_buff = Scalar(0.4);
+
+    boost::shared_ptr<NeighborList> nlist_1(new NeighborList(sysdef_1, r_cut, r_buff));
+    boost::shared_ptr<ParticleSelector> selector_all_1(new ParticleSelectorTag(sysdef_1, 0, N-1));
+    boost::shared_ptr<ParticleGroup> group_all_1(new ParticleGroup(sysdef_1, selector_all_1));
+    boost::shared_ptr<PPPMForceCompute> fc_1(new PPPMForceCompute(sysdef_1, nlist_1, group_all_1));
+    fc_1->setParams(Nx, Ny, Nz, order, kappa, r_cut);
+    fc_1->compute(0);
+
+    boost::shared_ptr<PPPMForceCompute> fc_2;
+    if (exec_conf->getRank() == 0)
+        {
+        boost::shared_ptr<NeighborList> nlist_2(new NeighborList(sysdef_2, r_cut, r_buff));
+        boost::shared_ptr<ParticleSelector> selector_all_2(new ParticleSelectorTag(sysdef_2, 0, N-1));
+        boost::shared_ptr<ParticleGroup> group_all_2(new ParticleGroup(sysdef_2, selector_all_2));
+        fc_2 = boost::shared_ptr<PPPMForceCompute>(new PPPMForceCompute(sysdef_2, nlist_2, group_all_2));
+        fc_2->setParams(Nx, Ny, Nz, order, kappa, r_cut);
+        fc_2->compute(0);
+        }
+
+    // compare the forces on every particle
+    Scalar energy_1 = Scalar(0.0);
+    Scalar energy_2 = Scalar(0.0);
+    Scalar virial_1[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    Scalar virial_2[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for (unsigned int tag = 0; tag < N; tag++)
+        {
+        Scalar3 f_1 = fc_1->getForce(tag);
+        energy_1 += fc_1->getEnergy(tag);
+        for (unsigned int k = 0; k < 6; k++)
+            virial_1[k] += fc_1->getVirial(tag, k);
+
+        if (exec_conf->getRank() == 0)
+            {
+            Scalar3 f_2 = fc_2->getForce(tag);
+            energy_2 += fc_2->getEnergy(tag);
+            for (unsigned int k = 0; k < 6; k++)
+                virial_2[k] += fc_2->getVirial(tag, k);
+
+            MY_BOOST_CHECK_SMALL(f_1.x - f_2.x, tol_small);
+            MY_BOOST_CHECK_SMALL(f_1.y - f_2.y, tol_small);
+            MY_BOOST_CHECK_SMALL(f_1.z - f_2.z, tol_small);
+            }
+        }
+
+    if (exec_conf->getRank() == 0)
+        {
+        MY_BOOST_CHECK_CLOSE(energy_1, energy_2, tol_small);
+        for (unsigned int k = 0; k < 6; k++)
+            MY_BOOST_CHECK_SMALL(virial_1[k] - virial_2[k], tol_small);
+        }
+}
+
+//! Tests PPPM with MPI domain decomposition
+BOOST_AUTO_TEST_CASE( PPPMForceCompute_MPI_test )
+    {
+    test_pppm_force_mpi(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
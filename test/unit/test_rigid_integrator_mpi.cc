@@ -0,0 +1,271 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+//! name the boost unit test module
+#define BOOST_TEST_MODULE RigidIntegratorTestsMPI
+#include "boost_utf_configure.h"
+
+#include "HOOMDMath.h"
+#include "ExecutionConfiguration.h"
+#include "System.h"
+#include "TwoStepNVERigid.h"
+#include "IntegratorTwoStep.h"
+#include "AllPairPotentials.h"
+#include "NeighborListBinned.h"
+#include "SnapshotSystemData.h"
+
+#include <boost/python.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <math.h>
+#include <vector>
+
+#include "Communicator.h"
+#include "DomainDecomposition.h"
+
+using namespace boost;
+
+//! Compare rigid body trajectories with domain decomposition to a single processor run
+/*! Trimers on a lattice are placed such that many of them straddle domain and periodic boundaries.
+*/
+void test_nve_rigid_integrator_mpi(boost::shared_ptr<ExecutionConfiguration> exec_conf)
+{
+    // 4x4x4 trimers, alternating between the x, y and z axis
+    unsigned int n_side = 4;
+    unsigned int n_bodies = n_side*n_side*n_side;
+    unsigned int N = 3*n_bodies;
+    Scalar L = Scalar(12.0);
+
+    boost::shared_ptr<SnapshotSystemData> snap(new SnapshotSystemData());
+    snap->global_box = BoxDim(L);
+    snap->particle_data.resize(N);
+    snap->particle_data.type_mapping.push_back("A");
+
+    srand(12345);
+    for (unsigned int body = 0; body < n_bodies; body++)
+        {
+        unsigned int i = body % n_side;
+        unsigned int j = (body / n_side) % n_side;
+        unsigned int k = body / n_side / n_side;
+        Scalar3 center = make_scalar3(-L/Scalar(2.0) + Scalar(0.3) + Scalar(3.0)*i,
+                                      -L/Scalar(2.0) + Scalar(0.3) + Scalar(3.0)*j,
+                                      -L/Scalar(2.0) + Scalar(0.3) + Scalar(3.0)*k);
+        unsigned int axis = (i + j + k) % 3;
+
+        for (unsigned int m = 0; m < 3; m++)
+            {
+            unsigned int tag = 3*body + m;
+            Scalar offset = Scalar(0.9)*(Scalar(m) - Scalar(1.0));
+            Scalar3 pos = center;
+            if (axis == 0) pos.x += offset;
+            else if (axis == 1) pos.y += offset;
+            else pos.z += offset;
+
+            int3 img = make_int3(0,0,0);
+            snap->global_box.wrap(pos, img);
+
+            snap->particle_data.pos[tag] = pos;
+            snap->particle_data.image[tag] = img;
+            snap->particle_data.body[tag] = body;
+            snap->particle_data.vel[tag] = make_scalar3((Scalar)rand()/(Scalar)RAND_MAX - Scalar(0.5),
+                                                        (Scalar)rand()/(Scalar)RAND_MAX - Scalar(0.5),
+                                                        (Scalar)rand()/(Scalar)RAND_MAX - Scalar(0.5));
+            }
+        }
+
+    boost::shared_ptr<DomainDecomposition> decomposition(new DomainDecomposition(exec_conf, snap->global_box.getL()));
+    boost::shared_ptr<SystemDefinition> sysdef_1(new SystemDefinition(snap, exec_conf, decomposition));
+    boost::shared_ptr<ParticleData> pdata_1 = sysdef_1->getParticleData();
+
+    // initialize a second system (single proc) on rank zero
+    boost::shared_ptr<SystemDefinition> sysdef_2;
+    boost::shared_ptr<ParticleData> pdata_2;
+    if (exec_conf->getRank() == 0)
+        {
+        sysdef_2 = boost::shared_ptr<SystemDefinition>(new SystemDefinition(snap, exec_conf));
+        pdata_2 = sysdef_2->getParticleData();
+        }
+
+    BOOST_REQUIRE_EQUAL(sysdef_1->getRigidData()->getNumBodies(), n_bodies);
+
+    boost::shared_ptr<Communicator> comm(new Communicator(sysdef_1, decomposition));
+
+    boost::shared_ptr<ParticleSelector> selector_all_1(new ParticleSelectorTag(sysdef_1, 0, N-1));
+    boost::shared_ptr<ParticleGroup> group_all_1(new ParticleGroup(sysdef_1, selector_all_1));
+
+    Scalar r_cut = Scalar(2.5);
+    Scalar r_buff = Scalar(0.4);
+    Scalar lj1 = Scalar(4.0);
+    Scalar lj2 = Scalar(4.0);
+
+    boost::shared_ptr<NeighborList> nlist_1(new NeighborListBinned(sysdef_1, r_cut, r_buff));
+    nlist_1->setStorageMode(NeighborList::full);
+    nlist_1->setFilterBody(true);
+    nlist_1->setCommunicator(comm);
+    boost::shared_ptr<PotentialPairLJ> fc_1(new PotentialPairLJ(sysdef_1, nlist_1));
+    fc_1->setRcut(0, 0, r_cut);
+    fc_1->setParams(0, 0, make_scalar2(lj1,lj2));
+
+    Scalar deltaT = Scalar(0.005);
+    boost::shared_ptr<IntegratorTwoStep> nve_1(new IntegratorTwoStep(sysdef_1, deltaT));
+    nve_1->addIntegrationMethod(boost::shared_ptr<TwoStepNVERigid>(new TwoStepNVERigid(sysdef_1, group_all_1)));
+    nve_1->addForceCompute(fc_1);
+    nve_1->setCommunicator(comm);
+
+    boost::shared_ptr<IntegratorTwoStep> nve_2;
+    if (exec_conf->getRank() == 0)
+        {
+        boost::shared_ptr<ParticleSelector> selector_all_2(new ParticleSelectorTag(sysdef_2, 0, N-1));
+        boost::shared_ptr<ParticleGroup> group_all_2(new ParticleGroup(sysdef_2, selector_all_2));
+
+        boost::shared_ptr<NeighborList> nlist_2(new NeighborListBinned(sysdef_2, r_cut, r_buff));
+        nlist_2->setStorageMode(NeighborList::full);
+        nlist_2->setFilterBody(true);
+        boost::shared_ptr<PotentialPairLJ> fc_2(new PotentialPairLJ(sysdef_2, nlist_2));
+        fc_2->setRcut(0, 0, r_cut);
+        fc_2->setParams(0, 0, make_scalar2(lj1,lj2));
+
+        nve_2 = boost::shared_ptr<IntegratorTwoStep>(new IntegratorTwoStep(sysdef_2, deltaT));
+        nve_2->addIntegrationMethod(boost::shared_ptr<TwoStepNVERigid>(new TwoStepNVERigid(sysdef_2, group_all_2)));
+        nve_2->addForceCompute(fc_2);
+        }
+
+    nve_1->prepRun(0);
+    if (exec_conf->getRank() == 0)
+        nve_2->prepRun(0);
+
+    for (unsigned int step = 0; step < 50; step++)
+        {
+        nve_1->update(step);
+        if (exec_conf->getRank() == 0)
+            nve_2->update(step);
+        }
+
+    // every rank holds all bodies, compare them to the single processor run
+    boost::shared_ptr<RigidData> rdata_1 = sysdef_1->getRigidData();
+    std::vector<Scalar> body_state;
+        {
+        ArrayHandle<Scalar4> h_com_1(rdata_1->getCOM(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel_1(rdata_1->getVel(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom_1(rdata_1->getAngMom(), access_location::host, access_mode::read);
+        for (unsigned int body = 0; body < n_bodies; body++)
+            {
+            body_state.push_back(h_com_1.data[body].x);
+            body_state.push_back(h_com_1.data[body].y);
+            body_state.push_back(h_com_1.data[body].z);
+            body_state.push_back(h_vel_1.data[body].x);
+            body_state.push_back(h_vel_1.data[body].y);
+            body_state.push_back(h_vel_1.data[body].z);
+            body_state.push_back(h_angmom_1.data[body].x);
+            body_state.push_back(h_angmom_1.data[body].y);
+            body_state.push_back(h_angmom_1.data[body].z);
+            }
+        }
+
+    // all ranks have to agree on the body state
+    std::vector<Scalar> body_state_root(body_state);
+    MPI_Bcast(&body_state_root.front(), body_state_root.size(), MPI_HOOMD_SCALAR, 0, exec_conf->getMPICommunicator());
+    for (unsigned int i = 0; i < body_state.size(); i++)
+        BOOST_CHECK_EQUAL(body_state[i], body_state_root[i]);
+
+    if (exec_conf->getRank() == 0)
+        {
+        boost::shared_ptr<RigidData> rdata_2 = sysdef_2->getRigidData();
+        ArrayHandle<Scalar4> h_com_2(rdata_2->getCOM(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel_2(rdata_2->getVel(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom_2(rdata_2->getAngMom(), access_location::host, access_mode::read);
+
+        for (unsigned int body = 0; body < n_bodies; body++)
+            {
+            Scalar3 dr = make_scalar3(body_state[9*body+0] - h_com_2.data[body].x,
+                                      body_state[9*body+1] - h_com_2.data[body].y,
+                                      body_state[9*body+2] - h_com_2.data[body].z);
+            dr = snap->global_box.minImage(dr);
+            BOOST_CHECK_SMALL(dr.x, Scalar(1e-6));
+            BOOST_CHECK_SMALL(dr.y, Scalar(1e-6));
+            BOOST_CHECK_SMALL(dr.z, Scalar(1e-6));
+
+            BOOST_CHECK_SMALL(body_state[9*body+3] - h_vel_2.data[body].x, Scalar(1e-6));
+            BOOST_CHECK_SMALL(body_state[9*body+4] - h_vel_2.data[body].y, Scalar(1e-6));
+            BOOST_CHECK_SMALL(body_state[9*body+5] - h_vel_2.data[body].z, Scalar(1e-6));
+
+            BOOST_CHECK_SMALL(body_state[9*body+6] - h_angmom_2.data[body].x, Scalar(1e-6));
+            BOOST_CHECK_SMALL(body_state[9*body+7] - h_angmom_2.data[body].y, Scalar(1e-6));
+            BOOST_CHECK_SMALL(body_state[9*body+8] - h_angmom_2.data[body].z, Scalar(1e-6));
+            }
+        }
+
+    // the constituent particles follow the bodies on every rank
+    SnapshotParticleData snap_1(N);
+    SnapshotParticleData snap_2(N);
+    pdata_1->takeSnapshot(snap_1);
+    if (exec_conf->getRank() == 0)
+        {
+        pdata_2->takeSnapshot(snap_2);
+        for (unsigned int tag = 0; tag < N; tag++)
+            {
+            Scalar3 dr = make_scalar3(snap_1.pos[tag].x - snap_2.pos[tag].x,
+                                      snap_1.pos[tag].y - snap_2.pos[tag].y,
+                                      snap_1.pos[tag].z - snap_2.pos[tag].z);
+            dr = snap->global_box.minImage(dr);
+            BOOST_CHECK_SMALL(dr.x, Scalar(1e-6));
+            BOOST_CHECK_SMALL(dr.y, Scalar(1e-6));
+            BOOST_CHECK_SMALL(dr.z, Scalar(1e-6));
+
+            BOOST_CHECK_SMALL(snap_1.vel[tag].x - snap_2.vel[tag].x, Scalar(1e-6));
+            BOOST_CHECK_SMALL(snap_1.vel[tag].y - snap_2.vel[tag].y, Scalar(1e-6));
+            BOOST_CHECK_SMALL(snap_1.vel[tag].z - snap_2.vel[tag].z, Scalar(1e-6));
+            }
+        }
+}
+
+//! Tests MPI domain decomposition with the NVE rigid integrator
+BOOST_AUTO_TEST_CASE( DomainDecomposition_NVE_rigid_test )
+    {
+    test_nve_rigid_integrator_mpi(boost::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
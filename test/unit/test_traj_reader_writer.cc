@@ -0,0 +1,268 @@
+/*
+Highly Optimized Object-oriented Many-particle Dynamics -- Blue Edition
+(HOOMD-blue) Open Source Software License Copyright 2009-2014 The Regents of
+the University of Michigan All rights reserved.
+
+HOOMD-blue may contain modifications ("Contributions") provided, and to which
+copyright is held, by various Contributors who have granted The Regents of the
+University of Michigan the right to modify and/or distribute such Contributions.
+
+You may redistribute, use, and create derivate works of HOOMD-blue, in source
+and binary forms, provided you abide by the following conditions:
+
+* Redistributions of source code must retain the above copyright notice, this
+list of conditions, and the following disclaimer both in the code and
+prominently in any materials provided with the distribution.
+
+* Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions, and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+* All publications and presentations based on HOOMD-blue, including any reports
+or published results obtained, in whole or in part, with HOOMD-blue, will
+acknowledge its use according to the terms posted at the time of submission on:
+http://codeblue.umich.edu/hoomd-blue/citations.html
+
+* Any electronic documents citing HOOMD-Blue will link to the HOOMD-Blue website:
+http://codeblue.umich.edu/hoomd-blue/
+
+* Apart from the above required attributions, neither the name of the copyright
+holder nor the names of HOOMD-blue's contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+Disclaimer
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDER AND CONTRIBUTORS ``AS IS'' AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, AND/OR ANY
+WARRANTIES THAT THIS SOFTWARE IS FREE OF INFRINGEMENT ARE DISCLAIMED.
+
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef WIN32
+#pragma warning( push )
+#pragma warning( disable : 4103 4244 )
+#endif
+
+#include "HOOMDTrajectoryWriter.h"
+#include "HOOMDTrajectoryReader.h"
+#include "HOOMDBinaryInitializer.h"
+#include "BondedGroupData.h"
+
+#include <boost/filesystem/operations.hpp>
+using namespace boost::filesystem;
+#include <boost/shared_ptr.hpp>
+using namespace boost;
+
+using namespace std;
+
+//! Name the unit test module
+#define BOOST_TEST_MODULE TrajectoryReaderWriterTest
+#include "boost_utf_configure.h"
+
+/*! \file test_traj_reader_writer.cc
+    \brief Unit tests for HOOMDTrajectoryWriter and HOOMDTrajectoryReader
+    \ingroup unit_tests
+*/
+
+//! Set recognizable positions, velocities and images for frame \a frame
+void set_frame_data(boost::shared_ptr<ParticleData> pdata, unsigned int frame)
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<int3> h_image(pdata->getImages(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        unsigned int tag = h_tag.data[i];
+        h_pos.data[i].x = Scalar(0.01*tag) + Scalar(frame);
+        h_pos.data[i].y = Scalar(-0.02*tag);
+        h_pos.data[i].z = Scalar(0.5*frame);
+        h_vel.data[i].x = Scalar(tag);
+        h_vel.data[i].y = Scalar(frame);
+        h_vel.data[i].z = Scalar(-1.0);
+        h_image.data[i] = make_int3(tag, -int(frame), 1);
+        }
+    }
+
+//! Checks the positions, velocities and images read from frame \a frame
+void check_frame_data(boost::shared_ptr<SnapshotSystemData> snap, unsigned int frame)
+    {
+    const SnapshotParticleData& pdata = snap->particle_data;
+    for (unsigned int tag = 0; tag < pdata.size; tag++)
+        {
+        MY_BOOST_CHECK_CLOSE(pdata.pos[tag].x, Scalar(0.01*tag) + Scalar(frame), tol);
+        MY_BOOST_CHECK_SMALL(pdata.pos[tag].y - Scalar(-0.02*tag), tol_small);
+        MY_BOOST_CHECK_SMALL(pdata.pos[tag].z - Scalar(0.5*frame), tol_small);
+        MY_BOOST_CHECK_SMALL(pdata.vel[tag].x - Scalar(tag), tol_small);
+        MY_BOOST_CHECK_SMALL(pdata.vel[tag].y - Scalar(frame), tol_small);
+        MY_BOOST_CHECK_SMALL(pdata.vel[tag].z - Scalar(-1.0), tol_small);
+        BOOST_CHECK_EQUAL(pdata.image[tag].x, int(tag));
+        BOOST_CHECK_EQUAL(pdata.image[tag].y, -int(frame));
+        BOOST_CHECK_EQUAL(pdata.image[tag].z, 1);
+        }
+    }
+
+//! Tests random access to frames, and blocks that are only written when they change
+void traj_basic_test(bool compress)
+    {
+    BoxDim box(Scalar(20.0), Scalar(21.0), Scalar(22.0));
+    box.setTiltFactors(Scalar(0.1), Scalar(0.2), Scalar(0.3));
+
+    boost::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(100, box, 2, 1, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setType(7, 1);
+    sysdef->getBondData()->addBondedGroup(Bond(0, 0, 1));
+
+    remove_all("test.traj");
+    boost::shared_ptr<HOOMDTrajectoryWriter> writer(new HOOMDTrajectoryWriter(sysdef, "test.traj", true));
+    writer->enableCompression(compress);
+
+    std::vector<uintmax_t> sizes;
+    for (unsigned int frame = 0; frame < 6; frame++)
+        {
+        set_frame_data(pdata, frame);
+
+        // change the topology and one type half way through
+        if (frame == 3)
+            {
+            pdata->setType(7, 0);
+            sysdef->getBondData()->addBondedGroup(Bond(0, 2, 3));
+            }
+
+        writer->analyze(100*frame);
+        sizes.push_back(file_size("test.traj"));
+        }
+
+    // without compression, frames that only contain the dynamic blocks have the same size
+    if (!compress)
+        {
+        BOOST_CHECK_EQUAL(sizes[2] - sizes[1], sizes[1] - sizes[0]);
+        BOOST_CHECK(sizes[3] - sizes[2] > sizes[2] - sizes[1]);
+        BOOST_CHECK_EQUAL(sizes[4] - sizes[3], sizes[2] - sizes[1]);
+        BOOST_CHECK_EQUAL(sizes[5] - sizes[4], sizes[2] - sizes[1]);
+        }
+
+    HOOMDTrajectoryReader reader(exec_conf, "test.traj");
+    BOOST_REQUIRE_EQUAL(reader.getNumFrames(), (unsigned int)6);
+
+    // read the frames in reverse order
+    for (int frame = 5; frame >= 0; frame--)
+        {
+        BOOST_CHECK_EQUAL(reader.getTimeStep(frame), (unsigned int)(100*frame));
+
+        boost::shared_ptr<SnapshotSystemData> snap = reader.readFrame(frame);
+        BOOST_REQUIRE_EQUAL(snap->particle_data.size, (unsigned int)100);
+        check_frame_data(snap, frame);
+
+        Scalar3 L = snap->global_box.getL();
+        MY_BOOST_CHECK_CLOSE(L.x, Scalar(20.0), tol);
+        MY_BOOST_CHECK_CLOSE(L.y, Scalar(21.0), tol);
+        MY_BOOST_CHECK_CLOSE(L.z, Scalar(22.0), tol);
+        MY_BOOST_CHECK_CLOSE(snap->global_box.getTiltFactorYZ(), Scalar(0.3), tol);
+        BOOST_CHECK_EQUAL(snap->dimensions, (unsigned int)3);
+
+        BOOST_REQUIRE_EQUAL(snap->particle_data.type_mapping.size(), (size_t)2);
+        BOOST_CHECK_EQUAL(snap->particle_data.type_mapping[1], pdata->getNameByType(1));
+        BOOST_CHECK_EQUAL(snap->particle_data.type[7], (unsigned int)(frame < 3 ? 1 : 0));
+
+        const BondData::Snapshot& bonds = snap->bond_data;
+        BOOST_REQUIRE_EQUAL(bonds.groups.size(), (size_t)(frame < 3 ? 1 : 2));
+        BOOST_CHECK_EQUAL(bonds.groups[0].tag[0], (unsigned int)0);
+        BOOST_CHECK_EQUAL(bonds.groups[0].tag[1], (unsigned int)1);
+        if (frame >= 3)
+            {
+            BOOST_CHECK_EQUAL(bonds.groups[1].tag[0], (unsigned int)2);
+            BOOST_CHECK_EQUAL(bonds.groups[1].tag[1], (unsigned int)3);
+            }
+        }
+
+    remove_all("test.traj");
+    }
+
+//! Tests uncompressed trajectories
+BOOST_AUTO_TEST_CASE( HOOMDTrajectory_basic )
+    {
+    traj_basic_test(false);
+    }
+
+//! Tests compressed trajectories
+BOOST_AUTO_TEST_CASE( HOOMDTrajectory_compressed )
+    {
+    traj_basic_test(true);
+    }
+
+//! Tests appending to a file, recovery of a file without index, and initializing from a trajectory
+BOOST_AUTO_TEST_CASE( HOOMDTrajectory_append )
+    {
+    BoxDim box(Scalar(20.0));
+    boost::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    boost::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(50, box, 1, 0, 0, 0, 0, exec_conf));
+    boost::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    remove_all("test.traj");
+        {
+        boost::shared_ptr<HOOMDTrajectoryWriter> writer(new HOOMDTrajectoryWriter(sysdef, "test.traj", true));
+        for (unsigned int frame = 0; frame < 2; frame++)
+            {
+            set_frame_data(pdata, frame);
+            writer->analyze(frame);
+            }
+        }
+
+        {
+        boost::shared_ptr<HOOMDTrajectoryWriter> writer(new HOOMDTrajectoryWriter(sysdef, "test.traj", false));
+        for (unsigned int frame = 2; frame < 4; frame++)
+            {
+            set_frame_data(pdata, frame);
+            writer->analyze(frame);
+            }
+        }
+
+        {
+        HOOMDTrajectoryReader reader(exec_conf, "test.traj");
+        BOOST_REQUIRE_EQUAL(reader.getNumFrames(), (unsigned int)4);
+        for (unsigned int frame = 0; frame < 4; frame++)
+            check_frame_data(reader.readFrame(frame), frame);
+        }
+
+    // simulate a job that was killed before the index was written
+    resize_file("test.traj", file_size("test.traj") - 8);
+        {
+        HOOMDTrajectoryReader reader(exec_conf, "test.traj");
+        BOOST_REQUIRE_EQUAL(reader.getNumFrames(), (unsigned int)4);
+        check_frame_data(reader.readFrame(3), 3);
+        }
+
+    // appending truncates the stale index
+        {
+        boost::shared_ptr<HOOMDTrajectoryWriter> writer(new HOOMDTrajectoryWriter(sysdef, "test.traj", false));
+        set_frame_data(pdata, 4);
+        writer->analyze(4);
+        }
+
+    HOOMDBinaryInitializer init_last(exec_conf, "test.traj");
+    BOOST_CHECK_EQUAL(init_last.getTimeStep(), (unsigned int)4);
+    check_frame_data(init_last.getSnapshot(), 4);
+
+    HOOMDBinaryInitializer init_first(exec_conf, "test.traj", 1);
+    BOOST_CHECK_EQUAL(init_first.getTimeStep(), (unsigned int)1);
+    check_frame_data(init_first.getSnapshot(), 1);
+
+    remove_all("test.traj");
+    }
+
+#ifdef WIN32
+#pragma warning( pop )
+#endif